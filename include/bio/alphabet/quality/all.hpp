@@ -18,6 +18,7 @@
 #include <bio/alphabet/quality/phred42.hpp>
 #include <bio/alphabet/quality/phred63.hpp>
 #include <bio/alphabet/quality/phred68legacy.hpp>
+#include <bio/alphabet/quality/phred8binned.hpp>
 #include <bio/alphabet/quality/qualified.hpp>
 
 /*!\defgroup quality Quality
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ * \brief Provides bio::alphabet::phred8binned.
+ */
+
+#pragma once
+
+#include <array>
+
+#include <bio/alphabet/quality/quality_base.hpp>
+
+// ------------------------------------------------------------------
+// phred8binned
+// ------------------------------------------------------------------
+
+namespace bio::alphabet
+{
+
+/*!\brief Quality type for phred scores binned with Illumina's 8-level scheme.
+ * \implements bio::alphabet::writable_quality
+ * \if DEV \implements bio::alphabet::detail::writable_constexpr_alphabet \endif
+ * \implements bio::meta::trivially_copyable
+ * \implements bio::meta::standard_layout
+ * \implements std::regular
+ *
+ * \ingroup quality
+ *
+ * \details
+ *
+ * This alphabet has only eight values, so a bio::ranges::bitcompressed_vector of it needs 3 bits per letter. Phred
+ * scores are binned on assignment (from phred values, characters or other quality types):
+ *
+ * | phred score | assigned score | character |
+ * |-------------|----------------|-----------|
+ * | ≤ 2         |  2             | `#`       |
+ * | 3 - 9       |  6             | `'`       |
+ * | 10 - 19     | 15             | `0`       |
+ * | 20 - 24     | 22             | `7`       |
+ * | 25 - 29     | 27             | `<`       |
+ * | 30 - 34     | 33             | `B`       |
+ * | 35 - 39     | 37             | `F`       |
+ * | ≥ 40        | 40             | `I`       |
+ *
+ * This is the binning of Illumina's HiSeq/NovaSeq instruments, except that scores below 2 are mapped to 2 (the
+ * score that "no call" bases receive). All characters starting from `!` are valid.
+ *
+ * \include test/snippet/alphabet/quality/phred8binned.cpp
+ */
+class phred8binned : public quality_base<phred8binned, 8>
+{
+private:
+    //!\brief The base class.
+    using base_t = quality_base<phred8binned, 8>;
+
+    //!\brief Befriend bio::alphabet::quality_base.
+    friend base_t;
+    //!\cond \brief Befriend bio::alphabet::base.
+    friend base_t::base_t;
+    //!\endcond
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    constexpr phred8binned() noexcept                                 = default; //!< Defaulted.
+    constexpr phred8binned(phred8binned const &) noexcept             = default; //!< Defaulted.
+    constexpr phred8binned(phred8binned &&) noexcept                  = default; //!< Defaulted.
+    constexpr phred8binned & operator=(phred8binned const &) noexcept = default; //!< Defaulted.
+    constexpr phred8binned & operator=(phred8binned &&) noexcept      = default; //!< Defaulted.
+    ~phred8binned() noexcept                                          = default; //!< Defaulted.
+
+    //!\brief Construct from phred value.
+    constexpr phred8binned(phred_type const p) : base_t{p} {}
+
+    // Inherit converting constructor
+    using base_t::base_t;
+    //!\}
+
+    /*!\name Member variables.
+     * \{
+     */
+    //!\brief The smallest phred score of each bin.
+    static constexpr std::array<phred_type, 8> bin_lower_bounds{0, 3, 10, 20, 25, 30, 35, 40};
+
+    //!\brief The phred score that represents each bin.
+    static constexpr std::array<phred_type, 8> bin_values{2, 6, 15, 22, 27, 33, 37, 40};
+
+    //!\brief The projection offset between char and phred score representation.
+    static constexpr char_type offset_char{'!'};
+    //!\}
+
+    //!\brief All characters starting from `!` are valid (and binned).
+    static constexpr bool char_is_valid(char_type const c) noexcept { return c >= offset_char; }
+
+private:
+    //!\brief Phred to rank conversion table (the binning).
+    static constexpr std::array<rank_type, 256> phred_to_rank = []() constexpr
+    {
+        std::array<rank_type, 256> ret{};
+
+        for (int64_t i = std::numeric_limits<phred_type>::lowest(); i <= std::numeric_limits<phred_type>::max(); ++i)
+        {
+            size_t r = 0;
+            while (r + 1 < alphabet_size && i >= bin_lower_bounds[r + 1])
+                ++r;
+            ret[static_cast<rank_type>(i)] = static_cast<rank_type>(r);
+        }
+        return ret;
+    }();
+
+    //!\brief Char to rank conversion table.
+    static constexpr std::array<rank_type, 256> char_to_rank = []() constexpr
+    {
+        std::array<rank_type, 256> ret{};
+
+        for (int64_t i = std::numeric_limits<char_type>::lowest(); i <= std::numeric_limits<char_type>::max(); ++i)
+        {
+            int64_t const phred = std::max<int64_t>(i - offset_char, 0);
+            ret[static_cast<rank_type>(i)] = phred_to_rank[static_cast<rank_type>(phred)];
+        }
+
+        return ret;
+    }();
+
+    //!\brief Rank to phred conversion table.
+    static constexpr std::array<phred_type, alphabet_size> rank_to_phred = bin_values;
+
+    //!\brief Rank to char conversion table.
+    static constexpr std::array<char_type, alphabet_size> rank_to_char = []() constexpr
+    {
+        std::array<char_type, alphabet_size> ret{};
+
+        for (size_t i = 0; i < alphabet_size; ++i)
+            ret[i] = bin_values[i] + offset_char;
+
+        return ret;
+    }();
+};
+
+} // namespace bio::alphabet
+
+// ------------------------------------------------------------------
+// literals
+// ------------------------------------------------------------------
+
+namespace bio::alphabet
+{
+
+inline namespace literals
+{
+
+/*!\name Literals
+ * \{
+ */
+
+/*!\brief The bio::alphabet::phred8binned char literal.
+ * \relates bio::alphabet::phred8binned
+ * \returns bio::alphabet::phred8binned
+ */
+consteval phred8binned operator""_phred8binned(char const c)
+{
+    if (!char_is_valid_for<phred8binned>(c))
+        throw std::invalid_argument{"Illegal character in character literal."};
+
+    return phred8binned{}.assign_char(c);
+}
+
+/*!\brief The bio::alphabet::phred8binned string literal.
+ * \relates bio::alphabet::phred8binned
+ * \returns std::vector<bio::alphabet::phred8binned>
+ *
+ * The characters are binned, e.g. `"IIJ!"_phred8binned` is equal to `"III#"_phred8binned`.
+ */
+template <meta::detail::literal_buffer_string str>
+constexpr std::vector<phred8binned> operator""_phred8binned()
+{
+    return detail::string_literal<str, phred8binned>();
+}
+//!\}
+
+} // namespace literals
+
+} // namespace bio::alphabet
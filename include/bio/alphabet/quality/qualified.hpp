@@ -149,6 +149,15 @@ public:
         return char_is_valid_for<sequence_alphabet_type>(c);
     }
 
+    //!\brief tag_invoke() wrapper around member.
+    friend constexpr phred_type tag_invoke(custom::to_phred, qualified const alph) noexcept { return alph.to_phred(); }
+
+    //!\brief tag_invoke() wrapper around member.
+    friend constexpr qualified & tag_invoke(custom::assign_phred_to, phred_type const p, qualified & alph) noexcept
+    {
+        return alph.assign_phred(p);
+    }
+
 protected:
     //!\privatesection
 
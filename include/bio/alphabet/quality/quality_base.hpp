@@ -82,7 +82,7 @@ public:
      * \{
      */
     //!\brief Return the alphabet's value in phred representation.
-    constexpr phred_type to_phred() const noexcept { return rank_to_phred[to_rank()]; }
+    constexpr phred_type to_phred() const noexcept { return derived_type::rank_to_phred[to_rank()]; }
     //!\}
 
     /*!\name Write functions
@@ -101,7 +101,7 @@ public:
      */
     constexpr derived_type & assign_phred(phred_type const p) noexcept
     {
-        return assign_rank(phred_to_rank[static_cast<rank_type>(p)]);
+        return assign_rank(derived_type::phred_to_rank[static_cast<rank_type>(p)]);
     }
     //!\}
 
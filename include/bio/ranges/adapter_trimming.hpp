@@ -0,0 +1,293 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::adapter_trimmer.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/alphabet/nucleotide/concept.hpp>
+#include <bio/alphabet/quality/concept.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief Whether `letter` has at least the quality `threshold` (same rules as bio::views::trim_quality).
+ * \ingroup range
+ */
+template <alphabet::quality qual_t, typename threshold_t>
+constexpr bool passes_quality(qual_t const letter, threshold_t const threshold) noexcept
+{
+    if constexpr (std::same_as<threshold_t, qual_t>)
+    {
+        return alphabet::to_phred(letter) >= alphabet::to_phred(threshold);
+    }
+    else
+    {
+        using c_t = std::common_type_t<decltype(alphabet::to_phred(letter)), threshold_t>;
+        return static_cast<c_t>(alphabet::to_phred(letter)) >= static_cast<c_t>(threshold);
+    }
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Finds 3' adapters in reads and computes trim positions (optionally combined with quality trimming).
+ * \tparam alph_t The alphabet of the adapter and the reads, e.g. bio::alphabet::dna5.
+ * \ingroup range
+ *
+ * \details
+ *
+ * The adapter is searched in the 3' part of the read: it may be contained completely in the read, or the read may
+ * end with a prefix of the adapter (the rest of the adapter was not sequenced). The *adapter position* is the
+ * smallest position `p` such that the read from `p` on and the adapter agree on their overlap
+ * (`min(size(adapter), size(read) - p)` letters) with at most `⌊max_error_rate · overlap⌋` mismatches, and the
+ * overlap has at least `min_overlap` letters. If there is no such position, it is the size of the read. Only
+ * substitutions are considered errors, not insertions or deletions. For nucleotide alphabets, an `N` in the adapter
+ * matches every letter of the read.
+ *
+ * The read can be trimmed by `read | bio::views::slice(0, position)`.
+ *
+ * ### Quality trimming
+ *
+ * bio::ranges::adapter_trimmer::trim_position also performs the trimming of bio::views::trim_quality: the read is
+ * cut before the first letter below the quality threshold, and the adapter is searched in the remaining prefix
+ * (i.e. the end of the quality-trimmed read is the 3' end). Both are computed while reading the read once, and
+ * bio::ranges::adapter_trimmer::trim_positions processes a whole batch of reads.
+ *
+ * ### Algorithm
+ *
+ * The mismatch counts of all overlaps are computed at once for blocks of 128 positions: for every letter of the
+ * adapter, the block of the read (shifted by the letter's position) is compared with this letter and the results
+ * are added to a counter per position. These loops over bytes have no dependencies between positions and are
+ * vectorised by the compiler. The first position whose count is within the error limit is returned.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/adapter_trimming.cpp
+ */
+template <alphabet::alphabet alph_t>
+class adapter_trimmer
+{
+private:
+    static_assert(alphabet::size<alph_t> <= 256, "adapter_trimmer only supports alphabets with up to 256 letters.");
+
+    //!\brief The number of positions whose overlaps are scored at once.
+    static constexpr size_t block_size  = 128;
+    //!\brief The maximum size of the adapter (mismatch counts are stored in bytes).
+    static constexpr size_t max_adapter = 255;
+
+    //!\brief The size of the adapter.
+    size_t               m = 0;
+    //!\brief The positions and ranks of the adapter letters that are not wildcards.
+    std::vector<std::pair<size_t, uint8_t>> columns;
+    //!\brief The number of mismatches allowed for an overlap of `i` letters.
+    std::vector<uint8_t> max_errors;
+    //!\brief The minimum overlap.
+    size_t               min_overlap = 0;
+
+    //!\brief The rank of a letter of the read as `alph_t` (e.g. the sequence part of a bio::alphabet::qualified).
+    template <typename letter_t>
+    static constexpr uint8_t rank_of(letter_t const & letter) noexcept
+    {
+        if constexpr (std::same_as<std::remove_cvref_t<letter_t>, alph_t>)
+            return alphabet::to_rank(letter);
+        else
+            return alphabet::to_rank(static_cast<alph_t>(letter));
+    }
+
+    //!\brief The adapter position in the first `n` letters of `seq`.
+    template <typename seq_t>
+    size_t search(seq_t && seq, size_t const n) const
+    {
+        uint8_t read[block_size + max_adapter];
+        uint8_t counts[block_size];
+
+        for (size_t block = 0; block + min_overlap <= n; block += block_size)
+        {
+            size_t const positions = std::min(block_size, n - block);
+            size_t const letters   = std::min(positions + m - 1, n - block);
+
+            for (size_t t = 0; t < letters; ++t)
+                read[t] = rank_of(seq[block + t]);
+
+            std::fill_n(counts, positions, 0);
+            for (auto const & [i, rank] : columns)
+            {
+                if (i >= letters)
+                    break;
+                size_t const count = std::min(positions, letters - i);
+                for (size_t t = 0; t < count; ++t)
+                    counts[t] += read[t + i] != rank;
+            }
+
+            for (size_t t = 0; t < positions; ++t)
+            {
+                size_t const overlap = std::min(m, n - block - t);
+                if (overlap < min_overlap)
+                    return n;
+                if (counts[t] <= max_errors[overlap])
+                    return block + t;
+            }
+        }
+        return n;
+    }
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    adapter_trimmer()                                    = default; //!< Defaulted.
+    adapter_trimmer(adapter_trimmer const &)             = default; //!< Defaulted.
+    adapter_trimmer(adapter_trimmer &&)                  = default; //!< Defaulted.
+    adapter_trimmer & operator=(adapter_trimmer const &) = default; //!< Defaulted.
+    adapter_trimmer & operator=(adapter_trimmer &&)      = default; //!< Defaulted.
+    ~adapter_trimmer()                                   = default; //!< Defaulted.
+
+    /*!\brief Prepare the adapter.
+     * \param[in] adapter        The adapter sequence (1 to 255 letters).
+     * \param[in] max_error_rate The maximum fraction of mismatches in an overlap, in `[0, 1)`.
+     * \param[in] min_overlap_   The minimum number of letters of the adapter that need to overlap the read; larger
+     *                           values are reduced to the size of the adapter.
+     * \throws std::invalid_argument If one of the arguments is out of range.
+     */
+    template <std::ranges::input_range adapter_t>
+        requires std::same_as<std::ranges::range_value_t<adapter_t>, alph_t>
+    explicit adapter_trimmer(adapter_t && adapter, double const max_error_rate = 0.1, size_t const min_overlap_ = 3)
+    {
+        if (!(max_error_rate >= 0 && max_error_rate < 1))
+            throw std::invalid_argument{"The maximum error rate of the adapter_trimmer must be in [0, 1)."};
+        if (min_overlap_ == 0)
+            throw std::invalid_argument{"The minimum overlap of the adapter_trimmer must be at least 1."};
+
+        for (alph_t const l : adapter)
+        {
+            bool wildcard = false;
+            if constexpr (alphabet::nucleotide<alph_t>)
+                wildcard = alphabet::to_char(l) == 'N';
+            if (!wildcard)
+                columns.emplace_back(m, alphabet::to_rank(l));
+            ++m;
+        }
+
+        if (m == 0 || m > max_adapter)
+            throw std::invalid_argument{"The adapter of the adapter_trimmer must have between 1 and 255 letters."};
+
+        min_overlap = std::min(min_overlap_, m);
+        max_errors.resize(m + 1);
+        for (size_t i = 0; i <= m; ++i)
+            max_errors[i] = static_cast<uint8_t>(std::floor(max_error_rate * i));
+    }
+    //!\}
+
+    /*!\brief The position where the adapter begins in `seq`, or `size(seq)`.
+     * \param[in] seq The read; a sized random access range over `alph_t` (or a type that converts to it, like
+     *                bio::alphabet::qualified<alph_t, ...>).
+     */
+    template <std::ranges::random_access_range seq_t>
+        requires std::ranges::sized_range<seq_t>
+    size_t adapter_position(seq_t && seq) const
+    {
+        return search(seq, std::ranges::size(seq));
+    }
+
+    /*!\brief The position to trim `seq` at after quality trimming and adapter trimming.
+     * \param[in] seq       The read; a sized random access range over `alph_t`.
+     * \param[in] qual      The qualities of the read; an input range over bio::alphabet::quality.
+     * \param[in] threshold The minimum quality (an integral phred score or a letter of the quality alphabet).
+     * \returns The position of the adapter in the quality-trimmed read (or the size of the quality-trimmed read).
+     */
+    template <std::ranges::random_access_range seq_t, std::ranges::input_range qual_t, typename threshold_t>
+        requires(std::ranges::sized_range<seq_t> && alphabet::quality<std::ranges::range_value_t<qual_t>>)
+    size_t trim_position(seq_t && seq, qual_t && qual, threshold_t const threshold) const
+    {
+        size_t const n   = std::ranges::size(seq);
+        size_t       end = 0;
+        for (auto it = std::ranges::begin(qual); end < n && it != std::ranges::end(qual); ++it, ++end)
+            if (!detail::passes_quality(*it, threshold))
+                break;
+        return search(seq, end);
+    }
+
+    /*!\brief The position to trim `read` at after quality trimming and adapter trimming.
+     * \param[in] read      The read; a sized random access range over e.g. bio::alphabet::qualified<alph_t, ...>.
+     * \param[in] threshold The minimum quality (an integral phred score or a letter of the quality alphabet).
+     * \returns The position of the adapter in the quality-trimmed read (or the size of the quality-trimmed read).
+     */
+    template <std::ranges::random_access_range read_t, typename threshold_t>
+        requires(std::ranges::sized_range<read_t> && alphabet::quality<std::ranges::range_value_t<read_t>>)
+    size_t trim_position(read_t && read, threshold_t const threshold) const
+    {
+        return trim_position(read, read, threshold);
+    }
+
+    /*!\brief The trim positions of a batch of reads.
+     * \param[in] seqs      A range of reads (see #trim_position).
+     * \param[in] quals     A range of quality strings, one per read.
+     * \param[in] threshold The minimum quality.
+     * \throws std::invalid_argument If the number of reads and quality strings differ.
+     */
+    template <std::ranges::input_range seqs_t, std::ranges::input_range quals_t, typename threshold_t>
+        requires(std::ranges::random_access_range<std::ranges::range_reference_t<seqs_t>> &&
+                 std::ranges::input_range<std::ranges::range_reference_t<quals_t>>)
+    std::vector<size_t> trim_positions(seqs_t && seqs, quals_t && quals, threshold_t const threshold) const
+    {
+        std::vector<size_t> ret;
+        if constexpr (std::ranges::sized_range<seqs_t>)
+            ret.reserve(std::ranges::size(seqs));
+
+        auto q_it = std::ranges::begin(quals);
+        for (auto && seq : seqs)
+        {
+            if (q_it == std::ranges::end(quals))
+                throw std::invalid_argument{"trim_positions() needs one quality string per read."};
+            ret.push_back(trim_position(seq, *q_it, threshold));
+            ++q_it;
+        }
+        if (q_it != std::ranges::end(quals))
+            throw std::invalid_argument{"trim_positions() needs one quality string per read."};
+        return ret;
+    }
+
+    /*!\brief The trim positions of a batch of reads with qualified letters.
+     * \param[in] reads     A range of reads over e.g. bio::alphabet::qualified<alph_t, ...>.
+     * \param[in] threshold The minimum quality.
+     */
+    template <std::ranges::input_range reads_t, typename threshold_t>
+        requires std::ranges::random_access_range<std::ranges::range_reference_t<reads_t>>
+    std::vector<size_t> trim_positions(reads_t && reads, threshold_t const threshold) const
+    {
+        std::vector<size_t> ret;
+        if constexpr (std::ranges::sized_range<reads_t>)
+            ret.reserve(std::ranges::size(reads));
+        for (auto && read : reads)
+            ret.push_back(trim_position(read, threshold));
+        return ret;
+    }
+};
+
+//!\brief Deduce the alphabet from the adapter.
+template <std::ranges::input_range adapter_t, typename... args_t>
+adapter_trimmer(adapter_t &&, args_t...) -> adapter_trimmer<std::ranges::range_value_t<adapter_t>>;
+
+} // namespace bio::ranges
@@ -13,8 +13,17 @@
 
 #pragma once
 
+#include <bio/ranges/adapter_trimming.hpp>
+#include <bio/ranges/bin_quality.hpp>
+#include <bio/ranges/cigar_conversion.hpp>
 #include <bio/ranges/container/all.hpp>
+#include <bio/ranges/edit_distance.hpp>
+#include <bio/ranges/hamming_distance.hpp>
+#include <bio/ranges/parallel/all.hpp>
+#include <bio/ranges/reverse_complement.hpp>
+#include <bio/ranges/suffix_array.hpp>
 #include <bio/ranges/views/all.hpp>
+#include <bio/ranges/zip_components.hpp>
 
 /*!\defgroup range Ranges
  * \brief The ranges module provides general purpose containers, decorators and views.
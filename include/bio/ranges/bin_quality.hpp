@@ -0,0 +1,407 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::quality_bins, bio::ranges::bin_quality and the P-block/R-block quality algorithms.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/quality/concept.hpp>
+#include <bio/alphabet/quality/phred8binned.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief A table that maps phred scores to binned phred scores.
+ * \ingroup range
+ *
+ * \details
+ *
+ * A binning is defined by the smallest phred score of each bin (ascending) and the score that all members of the bin
+ * are replaced with. Scores below the first lower bound belong to the first bin. Internally, the mapping is stored as
+ * a table with one entry per possible phred score.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/bin_quality.cpp
+ */
+class quality_bins
+{
+public:
+    //!\brief The type of phred scores.
+    using phred_type = int8_t;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    constexpr quality_bins() noexcept                                 = default; //!< The identity mapping.
+    constexpr quality_bins(quality_bins const &) noexcept             = default; //!< Defaulted.
+    constexpr quality_bins(quality_bins &&) noexcept                  = default; //!< Defaulted.
+    constexpr quality_bins & operator=(quality_bins const &) noexcept = default; //!< Defaulted.
+    constexpr quality_bins & operator=(quality_bins &&) noexcept      = default; //!< Defaulted.
+    ~quality_bins() noexcept                                          = default; //!< Defaulted.
+
+    /*!\brief Construct from the lower bounds and the values of the bins.
+     * \param[in] lower_bounds The smallest phred score of each bin; must be strictly ascending.
+     * \param[in] values       The phred score that represents each bin.
+     * \throws std::invalid_argument If the arguments are empty, differ in size or the bounds are not ascending.
+     */
+    constexpr quality_bins(std::span<phred_type const> const lower_bounds, std::span<phred_type const> const values)
+    {
+        if (lower_bounds.empty() || lower_bounds.size() != values.size())
+            throw std::invalid_argument{"quality_bins needs the same (non-zero) number of lower bounds and values."};
+        if (std::ranges::adjacent_find(lower_bounds, std::ranges::greater_equal{}) != lower_bounds.end())
+            throw std::invalid_argument{"The lower bounds of quality_bins need to be strictly ascending."};
+
+        size_t bin = 0;
+        for (int p = std::numeric_limits<phred_type>::lowest(); p <= std::numeric_limits<phred_type>::max(); ++p)
+        {
+            while (bin + 1 < lower_bounds.size() && p >= lower_bounds[bin + 1])
+                ++bin;
+            table[static_cast<uint8_t>(p)] = values[bin];
+        }
+    }
+
+    //!\overload
+    constexpr quality_bins(std::initializer_list<phred_type> const lower_bounds,
+                           std::initializer_list<phred_type> const values) :
+      quality_bins{std::span{lower_bounds.begin(), lower_bounds.size()}, std::span{values.begin(), values.size()}}
+    {}
+
+    //!\brief Illumina's 8-level binning; identical to the binning of bio::alphabet::phred8binned.
+    static constexpr quality_bins illumina8() noexcept
+    {
+        return quality_bins{alphabet::phred8binned::bin_lower_bounds, alphabet::phred8binned::bin_values};
+    }
+    //!\}
+
+    //!\brief The binned phred score of `p`.
+    constexpr phred_type operator()(phred_type const p) const noexcept { return table[static_cast<uint8_t>(p)]; }
+
+    //!\brief Two binnings are equal if they map all scores to the same values.
+    constexpr friend bool operator==(quality_bins const &, quality_bins const &) noexcept = default;
+
+private:
+    //!\brief The binned score for every score (indexed by the score cast to uint8_t).
+    std::array<phred_type, 256> table = []() constexpr
+    {
+        std::array<phred_type, 256> ret{};
+        for (int p = std::numeric_limits<phred_type>::lowest(); p <= std::numeric_limits<phred_type>::max(); ++p)
+            ret[static_cast<uint8_t>(p)] = static_cast<phred_type>(p);
+        return ret;
+    }();
+};
+
+} // namespace bio::ranges
+
+namespace bio::ranges::detail
+{
+
+/*!\brief For every rank of `alph_t`, the rank after binning the phred score.
+ * \details
+ *
+ * This also works for composites (e.g. bio::alphabet::qualified) whose other components remain unchanged.
+ */
+template <alphabet::writable_quality alph_t>
+std::vector<alphabet::rank_t<alph_t>> binned_rank_table(quality_bins const & bins)
+{
+    std::vector<alphabet::rank_t<alph_t>> ret(alphabet::size<alph_t>);
+    for (size_t r = 0; r < ret.size(); ++r)
+    {
+        alph_t a = alphabet::assign_rank_to(static_cast<alphabet::rank_t<alph_t>>(r), alph_t{});
+        alphabet::assign_phred_to(bins(alphabet::to_phred(a)), a);
+        ret[r] = alphabet::to_rank(a);
+    }
+    return ret;
+}
+
+/*!\brief Bin single-byte ranks with a fixed number of compare-and-add steps.
+ * \tparam steps The number of steps; unused steps have a threshold that no rank reaches.
+ * \details
+ *
+ * All ranks are smaller than 127, so they can be compared as signed bytes (which is a single instruction on x86).
+ */
+template <size_t steps, typename alph_t>
+void bin_ranks_by_steps(std::span<alph_t> const         alphs,
+                        std::span<int8_t const> const  thresholds,
+                        std::span<uint8_t const> const deltas,
+                        uint8_t const                  first) noexcept
+{
+    std::array<int8_t, steps>  t;
+    std::array<uint8_t, steps> d;
+    std::ranges::copy(thresholds.first(steps), t.begin());
+    std::ranges::copy(deltas.first(steps), d.begin());
+
+    for (alph_t & a : alphs)
+    {
+        int8_t const rank = static_cast<int8_t>(alphabet::to_rank(a));
+        uint8_t      out  = first;
+        for (size_t k = 0; k < steps; ++k)
+            out += (rank >= t[k]) ? d[k] : uint8_t{0};
+        alphabet::assign_rank_to(out, a);
+    }
+}
+
+/*!\brief Bin a contiguous range of single-byte ranks.
+ * \param[in,out] alphs The range.
+ * \param[in]     table The result of bio::ranges::detail::binned_rank_table().
+ * \details
+ *
+ * A mapping of ranks can be written as `table[0] + Σ_k (rank >= t_k) * (table[t_k] - table[t_k - 1])` where the
+ * `t_k` are the ranks at which the table changes. For up to 16 steps, this is evaluated with byte comparisons and
+ * additions (no table lookups) which the compiler vectorises. Mappings with more steps (e.g. fine-grained bins) are
+ * looked up per element.
+ */
+template <typename alph_t>
+    requires(alphabet::size<alph_t> < 127)
+void bin_ranks_contiguous(std::span<alph_t> const alphs, std::span<uint8_t const> const table) noexcept
+{
+    constexpr size_t max_steps = 16;
+
+    std::array<int8_t, max_steps>  thresholds;
+    std::array<uint8_t, max_steps> deltas;
+    thresholds.fill(std::numeric_limits<int8_t>::max());
+    deltas.fill(0);
+
+    size_t steps = 0;
+    for (size_t r = 1; r < table.size(); ++r)
+    {
+        if (table[r] != table[r - 1])
+        {
+            if (steps == max_steps)
+            {
+                for (alph_t & a : alphs)
+                    alphabet::assign_rank_to(table[alphabet::to_rank(a)], a);
+                return;
+            }
+
+            thresholds[steps] = static_cast<int8_t>(r);
+            deltas[steps]     = static_cast<uint8_t>(table[r] - table[r - 1]);
+            ++steps;
+        }
+    }
+
+    if (steps <= 2)
+        bin_ranks_by_steps<2>(alphs, thresholds, deltas, table[0]);
+    else if (steps <= 4)
+        bin_ranks_by_steps<4>(alphs, thresholds, deltas, table[0]);
+    else if (steps <= 8)
+        bin_ranks_by_steps<8>(alphs, thresholds, deltas, table[0]);
+    else
+        bin_ranks_by_steps<16>(alphs, thresholds, deltas, table[0]);
+}
+
+/*!\brief Find the end of the next block and its representative score.
+ * \param[in] it     Beginning of the block (must not be equal to `end`).
+ * \param[in] end    End of the range.
+ * \param[in] policy Decides whether scores fit into one block and computes the representative.
+ * \returns The end of the block and the score that all elements of the block are replaced with.
+ * \details
+ *
+ * Blocks are extended greedily, i.e. each block is as long as possible.
+ */
+template <typename it_t, typename sen_t, typename policy_t>
+constexpr std::pair<it_t, int8_t> next_quality_block(it_t it, sen_t const & end, policy_t const & policy)
+{
+    int lo = alphabet::to_phred(*it);
+    int hi = lo;
+
+    for (++it; it != end; ++it)
+    {
+        int const p      = alphabet::to_phred(*it);
+        int const new_lo = std::min(lo, p);
+        int const new_hi = std::max(hi, p);
+        if (!policy.fits(new_lo, new_hi))
+            break;
+        lo = new_lo;
+        hi = new_hi;
+    }
+
+    return {std::move(it), policy.representative(lo, hi)};
+}
+
+//!\brief The block definition of bio::ranges::pblock_quality.
+struct pblock_policy
+{
+    //!\brief The maximum absolute error.
+    int max_error = 0;
+
+    //!\brief The range of scores in a block is at most twice the error.
+    constexpr bool fits(int const lo, int const hi) const noexcept { return hi - lo <= 2 * max_error; }
+
+    //!\brief The mid-range of the block.
+    constexpr int8_t representative(int const lo, int const hi) const noexcept
+    {
+        return static_cast<int8_t>(std::midpoint(lo, hi));
+    }
+};
+
+//!\brief The block definition of bio::ranges::rblock_quality.
+struct rblock_policy
+{
+    //!\brief The square of the maximum relative error.
+    double max_ratio = 1;
+
+    //!\brief The ratio of the highest and the lowest score of a block is at most `max_ratio`.
+    constexpr bool fits(int const lo, int const hi) const noexcept { return hi <= lo * max_ratio; }
+
+    //!\brief The (rounded) geometric mean of the lowest and the highest score of the block.
+    int8_t representative(int const lo, int const hi) const noexcept
+    {
+        if (lo <= 0)
+            return static_cast<int8_t>(lo);
+        double const mean = std::round(std::sqrt(static_cast<double>(lo) * hi));
+        return static_cast<int8_t>(std::clamp<double>(mean, lo, hi));
+    }
+};
+
+//!\brief Replace the scores of each block in `rng` by the block's representative.
+template <std::ranges::forward_range rng_t, typename policy_t>
+void block_quality(rng_t && rng, policy_t const & policy)
+{
+    auto       it  = std::ranges::begin(rng);
+    auto const end = std::ranges::end(rng);
+
+    while (it != end)
+    {
+        auto [block_end, rep] = next_quality_block(it, end, policy);
+        for (; it != block_end; ++it)
+        {
+            std::ranges::range_reference_t<rng_t> ref = *it;
+            alphabet::assign_phred_to(rep, ref);
+        }
+    }
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\name Quality binning
+ * \{
+ */
+
+/*!\brief Bin the quality scores of a range (in-place).
+ * \ingroup range
+ * \tparam rng_t Type of the range; a std::ranges::forward_range over a bio::alphabet::writable_quality.
+ * \param[in,out] rng  The range.
+ * \param[in]     bins The binning; see bio::ranges::quality_bins.
+ *
+ * \details
+ *
+ * Every phred score `p` in `rng` is replaced by `bins(p)`. The mapping is first translated into a mapping of ranks,
+ * so the scores are never computed explicitly. This also works for ranges over composites of a quality (e.g.
+ * bio::alphabet::dna4q); the other components remain unchanged.
+ *
+ * For contiguous ranges over single-byte alphabets (like bio::alphabet::phred63), a vectorised kernel is used that
+ * consists only of byte comparisons and additions. Otherwise, the new rank is looked up per element.
+ *
+ * To bin into a smaller alphabet, use bio::views::convert, e.g. to bio::alphabet::phred8binned.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/bin_quality.cpp
+ */
+template <std::ranges::forward_range rng_t>
+    requires alphabet::writable_quality<std::ranges::range_reference_t<rng_t>>
+void bin_quality(rng_t && rng, quality_bins const & bins)
+{
+    using alph_t = std::ranges::range_value_t<rng_t>;
+
+    if constexpr (alphabet::size<alph_t> > std::numeric_limits<uint16_t>::max())
+    {
+        for (auto && q : rng)
+            alphabet::assign_phred_to(bins(alphabet::to_phred(q)), q);
+    }
+    else
+    {
+        std::vector<alphabet::rank_t<alph_t>> const table = detail::binned_rank_table<alph_t>(bins);
+
+        if constexpr (std::ranges::contiguous_range<rng_t> && std::same_as<alphabet::rank_t<alph_t>, uint8_t> &&
+                      (alphabet::size<alph_t> < 127) && std::same_as<std::ranges::range_reference_t<rng_t>, alph_t &>)
+        {
+            detail::bin_ranks_contiguous(std::span<alph_t>{std::ranges::data(rng), std::ranges::size(rng)}, table);
+        }
+        else
+        {
+            for (auto && q : rng)
+                alphabet::assign_rank_to(table[alphabet::to_rank(q)], q);
+        }
+    }
+}
+
+/*!\brief Replace quality scores with the P-block scheme, i.e. with a maximum absolute error (in-place).
+ * \ingroup range
+ * \tparam rng_t Type of the range; a std::ranges::forward_range over a bio::alphabet::writable_quality.
+ * \param[in,out] rng       The range.
+ * \param[in]     max_error The maximum absolute difference between an original and a new score.
+ * \throws std::invalid_argument If `max_error` is negative.
+ *
+ * \details
+ *
+ * The range is split greedily into blocks where the difference between the highest and the lowest score is at most
+ * `2 * max_error`. All scores of a block are replaced by the block's mid-range `(lowest + highest) / 2`. Long blocks
+ * of equal scores compress well with subsequent entropy coding.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/bin_quality.cpp
+ */
+template <std::ranges::forward_range rng_t>
+    requires alphabet::writable_quality<std::ranges::range_reference_t<rng_t>>
+void pblock_quality(rng_t && rng, int const max_error)
+{
+    if (max_error < 0)
+        throw std::invalid_argument{"The maximum error of pblock_quality must not be negative."};
+
+    detail::block_quality(rng, detail::pblock_policy{max_error});
+}
+
+/*!\brief Replace quality scores with the R-block scheme, i.e. with a maximum relative error (in-place).
+ * \ingroup range
+ * \tparam rng_t Type of the range; a std::ranges::forward_range over a bio::alphabet::writable_quality.
+ * \param[in,out] rng       The range.
+ * \param[in]     max_ratio The maximum ratio between an original and a new score (or vice versa); at least 1.
+ * \throws std::invalid_argument If `max_ratio` is smaller than 1.
+ *
+ * \details
+ *
+ * The range is split greedily into blocks where the highest score is at most `max_ratio²` times the lowest score.
+ * All scores of a block are replaced by the block's (rounded) geometric mean `√(lowest · highest)`. Blocks that
+ * contain a score of 0 (or lower) consist only of equal scores.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/bin_quality.cpp
+ */
+template <std::ranges::forward_range rng_t>
+    requires alphabet::writable_quality<std::ranges::range_reference_t<rng_t>>
+void rblock_quality(rng_t && rng, double const max_ratio)
+{
+    if (!(max_ratio >= 1))
+        throw std::invalid_argument{"The maximum ratio of rblock_quality must be at least 1."};
+
+    detail::block_quality(rng, detail::rblock_policy{max_ratio * max_ratio});
+}
+//!\}
+
+} // namespace bio::ranges
@@ -0,0 +1,581 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::cigar_to_gapped and bio::ranges::gapped_to_cigar.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/cigar/cigar.hpp>
+#include <bio/alphabet/gap/gapped.hpp>
+#include <bio/ranges/detail/byte_words.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief The number of letters and columns described by a CIGAR string.
+ * \ingroup range
+ */
+struct cigar_lengths
+{
+    size_t reference = 0; //!< The number of reference letters in the alignment (`M`, `=`, `X`, `D`, `N`).
+    size_t query     = 0; //!< The number of query letters in the alignment (`M`, `=`, `X`, `I`).
+    size_t columns   = 0; //!< The number of alignment columns (all but `S` and `H`).
+
+    //!\brief Defaulted.
+    friend bool operator==(cigar_lengths const &, cigar_lengths const &) = default;
+};
+
+} // namespace bio::ranges
+
+namespace bio::ranges::detail
+{
+
+//!\brief The largest count of a bio::alphabet::cigar.
+inline constexpr size_t cigar_max_count = (size_t{1} << 28) - 1;
+
+/*!\brief Append `count` times `op` to a CIGAR string, extending its last element if it has the same operation.
+ * \ingroup range
+ * \details
+ *
+ * Counts that do not fit into a bio::alphabet::cigar are split into multiple elements.
+ */
+inline void append_cigar(std::vector<alphabet::cigar> & cigar, size_t count, alphabet::cigar_op const op)
+{
+    if (count == 0)
+        return;
+
+    if (!cigar.empty() && get<1>(cigar.back()) == op)
+    {
+        size_t const extend = std::min<size_t>(count, cigar_max_count - get<0>(cigar.back()));
+        cigar.back()        = alphabet::cigar{static_cast<uint32_t>(get<0>(cigar.back()) + extend), op};
+        count -= extend;
+    }
+    for (; count > 0; count -= std::min(count, cigar_max_count))
+        cigar.emplace_back(static_cast<uint32_t>(std::min(count, cigar_max_count)), op);
+}
+
+/*!\brief Whether a gapped row of a bulk CIGAR conversion can be processed as an array of bytes.
+ * \ingroup range
+ */
+template <typename gapped_rng_t>
+concept bytewise_gapped_range =
+  std::ranges::contiguous_range<gapped_rng_t> && bytewise_comparable_letter<std::ranges::range_value_t<gapped_rng_t>>;
+
+/*!\brief Whether the letters of a sequence can be copied into a gapped row as bytes.
+ * \ingroup range
+ * \details
+ *
+ * This is the case for contiguous ranges of e.g. bio::alphabet::dna4 and bio::alphabet::gapped<bio::alphabet::dna4>,
+ * because the letters of bio::alphabet::gapped have the same rank (and thus byte) as in the ungapped alphabet.
+ */
+template <typename gapped_rng_t, typename seq_rng_t>
+concept bytewise_copyable_to_gapped =
+  bytewise_gapped_range<gapped_rng_t> && std::ranges::contiguous_range<seq_rng_t> &&
+  bytewise_comparable_letter<std::ranges::range_value_t<seq_rng_t>> &&
+  std::same_as<std::ranges::range_value_t<gapped_rng_t>, alphabet::gapped<std::ranges::range_value_t<seq_rng_t>>>;
+
+//!\brief The byte of a gap in `gapped_t`.
+template <typename gapped_t>
+inline constexpr unsigned char gap_byte = std::bit_cast<unsigned char>(gapped_t{alphabet::gap{}});
+
+/*!\brief Compute the column classes of a block of 64 columns of two rows stored as bytes.
+ * \details
+ *
+ * Bit i of the results is set iff column i is a gap in the reference row, a gap in the query row, or a mismatch
+ * between two letters, respectively.
+ */
+inline void classify_columns(unsigned char const * const ref,
+                             unsigned char const * const query,
+                             unsigned char const         ref_gap,
+                             unsigned char const         query_gap,
+                             uint64_t &                  ref_gaps,
+                             uint64_t &                  query_gaps,
+                             uint64_t &                  mismatches) noexcept
+{
+    uint64_t const ref_pattern   = repeat_byte(ref_gap);
+    uint64_t const query_pattern = repeat_byte(query_gap);
+
+    ref_gaps = query_gaps = mismatches = 0;
+    for (size_t i = 0; i < 64; i += 8)
+    {
+        uint64_t const r = load_word(ref + i);
+        uint64_t const q = load_word(query + i);
+        ref_gaps |= (~nonzero_bytes(r ^ ref_pattern) & 0xff) << i;
+        query_gaps |= (~nonzero_bytes(q ^ query_pattern) & 0xff) << i;
+        mismatches |= nonzero_bytes(r ^ q) << i;
+    }
+    mismatches &= ~(ref_gaps | query_gaps);
+}
+
+//!\brief The CIGAR operation of a column.
+inline alphabet::cigar_op column_op(bool const ref_gap, bool const query_gap, bool const mismatch, bool const extended)
+{
+    using alphabet::operator""_cigar_op;
+
+    if (ref_gap)
+        return query_gap ? 'P'_cigar_op : 'I'_cigar_op;
+    if (query_gap)
+        return 'D'_cigar_op;
+    if (!extended)
+        return 'M'_cigar_op;
+    return mismatch ? 'X'_cigar_op : '='_cigar_op;
+}
+
+//!\brief A row of a pairwise alignment that stores its gaps as stretches, e.g. bio::ranges::anchor_gaps.
+template <typename row_t>
+concept gap_stretch_row = requires(row_t const & row, size_t const k) {
+    { row.gap_stretch_count() } -> std::convertible_to<size_t>;
+    { std::get<1>(row.gap_stretch(k)) } -> std::convertible_to<size_t>;
+    std::ranges::begin(row.source());
+};
+
+//!\brief Walks over the gap stretches of a bio::ranges::detail::gap_stretch_row in order.
+struct gap_stretch_cursor
+{
+    size_t k           = 0; //!< The first stretch that ends behind the current column.
+    size_t gaps_before = 0; //!< The number of gaps before stretch #k.
+    size_t gap_begin   = 0; //!< The first column of stretch #k.
+    size_t gap_end     = 0; //!< The column behind stretch #k (0 if not loaded).
+
+    /*!\brief Move to column `pos` (which may not be smaller than in the previous call).
+     * \returns Whether column `pos` is a gap and the next column where this changes.
+     */
+    template <typename row_t>
+    std::pair<bool, size_t> advance(row_t const & row, size_t const pos)
+    {
+        while (k < row.gap_stretch_count() && gap_end <= pos)
+        {
+            if (gap_end > 0)
+            {
+                gaps_before += std::get<1>(row.gap_stretch(k));
+                if (++k == row.gap_stretch_count())
+                    break;
+            }
+            auto const [source_pos, length] = row.gap_stretch(k);
+            gap_begin                       = source_pos + gaps_before;
+            gap_end                         = gap_begin + length;
+        }
+        if (k == row.gap_stretch_count())
+            return {false, row.size()};
+        if (pos >= gap_begin)
+            return {true, gap_end};
+        return {false, gap_begin};
+    }
+};
+
+/*!\brief Append the CIGAR string of two bio::ranges::detail::gap_stretch_row to `ret`.
+ * \details
+ *
+ * Without `distinguish_mismatches`, the runtime is linear in the number of gap stretches, not in the size of the rows.
+ */
+template <typename ref_row_t, typename query_row_t>
+void gap_stretches_to_cigar(ref_row_t const &              reference_row,
+                            query_row_t const &            query_row,
+                            bool const                     distinguish_mismatches,
+                            std::vector<alphabet::cigar> & ret)
+{
+    auto append = [&ret](size_t const count, char const op_char)
+    { append_cigar(ret, count, alphabet::cigar_op{}.assign_char(op_char)); };
+
+    auto const ref_begin   = std::ranges::begin(reference_row.source());
+    auto const query_begin = std::ranges::begin(query_row.source());
+
+    gap_stretch_cursor r{};
+    gap_stretch_cursor q{};
+    size_t const       size = reference_row.size();
+    for (size_t pos = 0; pos < size;)
+    {
+        auto const [ref_gap, ref_next]     = r.advance(reference_row, pos);
+        auto const [query_gap, query_next] = q.advance(query_row, pos);
+        size_t const next                  = std::min(ref_next, query_next);
+
+        if (ref_gap && query_gap)
+        {
+            append(next - pos, 'P');
+        }
+        else if (ref_gap)
+        {
+            append(next - pos, 'I');
+        }
+        else if (query_gap)
+        {
+            append(next - pos, 'D');
+        }
+        else if (!distinguish_mismatches)
+        {
+            append(next - pos, 'M');
+        }
+        else
+        {
+            auto ref_it   = ref_begin + (pos - r.gaps_before);
+            auto query_it = query_begin + (pos - q.gaps_before);
+            for (size_t i = pos; i < next;)
+            {
+                bool const   eq = *ref_it == *query_it;
+                size_t const b  = i;
+                do
+                {
+                    ++i;
+                    ++ref_it;
+                    ++query_it;
+                }
+                while (i < next && (*ref_it == *query_it) == eq);
+                append(i - b, eq ? '=' : 'X');
+            }
+        }
+        pos = next;
+    }
+
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Compute the number of letters and columns described by a CIGAR string.
+ * \ingroup range
+ * \param[in] cigar A range over bio::alphabet::cigar.
+ * \returns The lengths as bio::ranges::cigar_lengths.
+ * \details
+ *
+ * Clipping (`S`, `H`) is not part of the alignment and not counted.
+ */
+template <std::ranges::input_range cigar_rng_t>
+    requires std::convertible_to<std::ranges::range_reference_t<cigar_rng_t>, alphabet::cigar>
+cigar_lengths get_cigar_lengths(cigar_rng_t && cigar)
+{
+    cigar_lengths ret;
+    for (alphabet::cigar const c : cigar)
+    {
+        size_t const count = get<0>(c);
+        switch (get<1>(c).to_char())
+        {
+            case 'M':
+            case '=':
+            case 'X':
+                ret.reference += count;
+                ret.query += count;
+                ret.columns += count;
+                break;
+            case 'I':
+                ret.query += count;
+                ret.columns += count;
+                break;
+            case 'D':
+            case 'N':
+                ret.reference += count;
+                ret.columns += count;
+                break;
+            case 'P':
+                ret.columns += count;
+                break;
+            default: // S, H
+                break;
+        }
+    }
+    return ret;
+}
+
+/*!\brief Create the two gapped rows of a pairwise alignment from a CIGAR string.
+ * \ingroup range
+ * \param[in]  cigar         The CIGAR string; a range over bio::alphabet::cigar.
+ * \param[in]  reference     The aligned part of the reference sequence.
+ * \param[in]  query         The aligned part of the query sequence, i.e. without soft-clipped letters.
+ * \param[out] reference_row The gapped reference row; a container of bio::alphabet::gapped.
+ * \param[out] query_row     The gapped query row; a container of bio::alphabet::gapped.
+ * \throws std::invalid_argument If the CIGAR string does not fit the lengths of the sequences, or if an output
+ *                               range that cannot be resized is too small.
+ *
+ * \details
+ *
+ * Insertions (`I`) are gaps in the reference row, deletions and skipped regions (`D`, `N`) are gaps in the query
+ * row and padding (`P`) is a gap in both rows. Clipping (`S`, `H`) is ignored.
+ *
+ * The number of columns is computed first and the rows are resized to it once (containers are expected to keep
+ * their capacity, so the rows can be reused for many alignments). Every CIGAR element is then converted as a whole:
+ * for contiguous ranges of single-byte alphabets (e.g. std::vector<bio::alphabet::dna4> and
+ * std::vector<bio::alphabet::gapped<bio::alphabet::dna4>>) this is one std::memcpy per stretch of letters and one
+ * std::memset per stretch of gaps.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/cigar_conversion.cpp
+ */
+template <std::ranges::forward_range      cigar_rng_t,
+          std::ranges::random_access_range ref_t,
+          std::ranges::random_access_range query_t,
+          std::ranges::random_access_range ref_row_t,
+          std::ranges::random_access_range query_row_t>
+    requires std::convertible_to<std::ranges::range_reference_t<cigar_rng_t>, alphabet::cigar> &&
+             std::ranges::sized_range<ref_t> && std::ranges::sized_range<query_t> &&
+             std::assignable_from<std::ranges::range_reference_t<ref_row_t>, alphabet::gap> &&
+             std::assignable_from<std::ranges::range_reference_t<query_row_t>, alphabet::gap>
+void cigar_to_gapped(cigar_rng_t && cigar,
+                     ref_t &&       reference,
+                     query_t &&     query,
+                     ref_row_t &&   reference_row,
+                     query_row_t && query_row)
+{
+    cigar_lengths const lengths = get_cigar_lengths(cigar);
+    if (lengths.reference != std::ranges::size(reference) || lengths.query != std::ranges::size(query))
+        throw std::invalid_argument{"The CIGAR string does not fit the lengths of the sequences."};
+
+    auto prepare = [&]<typename row_t>(row_t & row)
+    {
+        if constexpr (requires { row.resize(lengths.columns); })
+            row.resize(lengths.columns);
+        else if constexpr (std::ranges::sized_range<row_t>)
+            if (static_cast<size_t>(std::ranges::size(row)) < lengths.columns)
+                throw std::invalid_argument{"An output range of cigar_to_gapped is too small."};
+    };
+    prepare(reference_row);
+    prepare(query_row);
+
+    // copy `count` letters or write `count` gaps
+    auto copy = []<typename row_t, typename seq_t>(row_t & row, size_t const col, seq_t & seq, size_t & pos,
+                                                     size_t const count)
+    {
+        if constexpr (detail::bytewise_copyable_to_gapped<row_t, seq_t>)
+        {
+            std::memcpy(static_cast<void *>(std::ranges::data(row) + col), std::ranges::data(seq) + pos, count);
+        }
+        else
+        {
+            auto out = std::ranges::begin(row) + col;
+            auto in  = std::ranges::begin(seq) + pos;
+            for (size_t i = 0; i < count; ++i)
+                out[i] = in[i];
+        }
+        pos += count;
+    };
+    auto fill_gaps = []<typename row_t>(row_t & row, size_t const col, size_t const count)
+    {
+        if constexpr (detail::bytewise_gapped_range<row_t>)
+        {
+            std::memset(static_cast<void *>(std::ranges::data(row) + col),
+                        detail::gap_byte<std::ranges::range_value_t<row_t>>,
+                        count);
+        }
+        else
+        {
+            std::fill_n(std::ranges::begin(row) + col, count, alphabet::gap{});
+        }
+    };
+
+    size_t col       = 0;
+    size_t ref_pos   = 0;
+    size_t query_pos = 0;
+    for (alphabet::cigar const c : cigar)
+    {
+        size_t const count = get<0>(c);
+        switch (get<1>(c).to_char())
+        {
+            case 'M':
+            case '=':
+            case 'X':
+                copy(reference_row, col, reference, ref_pos, count);
+                copy(query_row, col, query, query_pos, count);
+                break;
+            case 'I':
+                fill_gaps(reference_row, col, count);
+                copy(query_row, col, query, query_pos, count);
+                break;
+            case 'D':
+            case 'N':
+                copy(reference_row, col, reference, ref_pos, count);
+                fill_gaps(query_row, col, count);
+                break;
+            case 'P':
+                fill_gaps(reference_row, col, count);
+                fill_gaps(query_row, col, count);
+                break;
+            default: // S, H
+                continue;
+        }
+        col += count;
+    }
+}
+
+/*!\brief Create the two gapped rows of a pairwise alignment from a CIGAR string.
+ * \ingroup range
+ * \param[in] cigar     The CIGAR string; a range over bio::alphabet::cigar.
+ * \param[in] reference The aligned part of the reference sequence.
+ * \param[in] query     The aligned part of the query sequence, i.e. without soft-clipped letters.
+ * \returns A pair of std::vector of bio::alphabet::gapped (reference row and query row).
+ * \throws std::invalid_argument If the CIGAR string does not fit the lengths of the sequences.
+ *
+ * \details
+ *
+ * See the overload with output parameters, which can reuse the memory of existing rows.
+ */
+template <std::ranges::forward_range      cigar_rng_t,
+          std::ranges::random_access_range ref_t,
+          std::ranges::random_access_range query_t>
+    requires std::convertible_to<std::ranges::range_reference_t<cigar_rng_t>, alphabet::cigar> &&
+             std::ranges::sized_range<ref_t> && std::ranges::sized_range<query_t> &&
+             alphabet::alphabet<std::ranges::range_value_t<ref_t>> &&
+             alphabet::alphabet<std::ranges::range_value_t<query_t>>
+auto cigar_to_gapped(cigar_rng_t && cigar, ref_t && reference, query_t && query)
+{
+    std::pair<std::vector<alphabet::gapped<std::ranges::range_value_t<ref_t>>>,
+              std::vector<alphabet::gapped<std::ranges::range_value_t<query_t>>>>
+      ret;
+    cigar_to_gapped(cigar, reference, query, ret.first, ret.second);
+    return ret;
+}
+
+/*!\brief Create a CIGAR string from the two gapped rows of a pairwise alignment.
+ * \ingroup range
+ * \param[in] reference_row          The gapped reference row; a range over bio::alphabet::gapped.
+ * \param[in] query_row              The gapped query row; a range over bio::alphabet::gapped.
+ * \param[in] distinguish_mismatches Whether to emit `=` and `X` instead of `M`.
+ * \returns The CIGAR string.
+ * \throws std::invalid_argument If the rows have different sizes.
+ *
+ * \details
+ *
+ * Columns with a gap only in the reference row are insertions (`I`), columns with a gap only in the query row are
+ * deletions (`D`) and columns with gaps in both rows are padding (`P`).
+ *
+ * For rows that store their gaps as stretches (bio::ranges::anchor_gaps), only the gap stretches are visited (and
+ * the columns between them if `distinguish_mismatches` is true).
+ *
+ * For contiguous ranges of single-byte alphabets (e.g. std::vector<bio::alphabet::gapped<bio::alphabet::dna4>>),
+ * the rows are compared 64 columns at a time: the gap and mismatch positions of the block are computed as bit masks
+ * (eight columns per 64-bit word) and only the positions where the operation changes are visited.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/cigar_conversion.cpp
+ */
+template <std::ranges::random_access_range ref_row_t, std::ranges::random_access_range query_row_t>
+    requires std::ranges::sized_range<ref_row_t> && std::ranges::sized_range<query_row_t> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<ref_row_t>,
+                                           std::ranges::range_reference_t<query_row_t>> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<ref_row_t>, alphabet::gap> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<query_row_t>, alphabet::gap>
+std::vector<alphabet::cigar> gapped_to_cigar(ref_row_t &&   reference_row,
+                                             query_row_t && query_row,
+                                             bool const     distinguish_mismatches = false)
+{
+    size_t const size = std::ranges::size(reference_row);
+    if (size != static_cast<size_t>(std::ranges::size(query_row)))
+        throw std::invalid_argument{"The rows of an alignment must have the same size."};
+
+    std::vector<alphabet::cigar> ret;
+    if (size == 0)
+        return ret;
+
+    if constexpr (detail::gap_stretch_row<std::remove_cvref_t<ref_row_t>> &&
+                  detail::gap_stretch_row<std::remove_cvref_t<query_row_t>>)
+    {
+        detail::gap_stretches_to_cigar(reference_row, query_row, distinguish_mismatches, ret);
+    }
+    else if constexpr (detail::bytewise_gapped_range<ref_row_t> && detail::bytewise_gapped_range<query_row_t> &&
+                  std::same_as<std::ranges::range_value_t<ref_row_t>, std::ranges::range_value_t<query_row_t>> &&
+                  std::endian::native == std::endian::little)
+    {
+        auto const * const  ref       = reinterpret_cast<unsigned char const *>(std::ranges::data(reference_row));
+        auto const * const  query     = reinterpret_cast<unsigned char const *>(std::ranges::data(query_row));
+        unsigned char const ref_gap   = detail::gap_byte<std::ranges::range_value_t<ref_row_t>>;
+        unsigned char const query_gap = detail::gap_byte<std::ranges::range_value_t<query_row_t>>;
+        uint64_t const      keep_mismatches = distinguish_mismatches ? ~uint64_t{0} : 0;
+
+        alphabet::cigar_op op{};
+        size_t             run_begin = 0;
+        uint64_t           prev_bits = 0; // the classes of the previous column (in bits 63)
+        for (size_t block = 0; block < size; block += 64)
+        {
+            uint64_t ref_gaps, query_gaps, mismatches;
+            if (size - block >= 64)
+            {
+                detail::classify_columns(ref + block, query + block, ref_gap, query_gap,
+                                         ref_gaps, query_gaps, mismatches);
+            }
+            else // pad by repeating the last column, i.e. without new runs
+            {
+                size_t const  n = size - block;
+                unsigned char ref_buf[64], query_buf[64];
+                std::memcpy(ref_buf, ref + block, n);
+                std::memcpy(query_buf, query + block, n);
+                std::memset(ref_buf + n, ref[size - 1], 64 - n);
+                std::memset(query_buf + n, query[size - 1], 64 - n);
+                detail::classify_columns(ref_buf, query_buf, ref_gap, query_gap, ref_gaps, query_gaps, mismatches);
+            }
+            mismatches &= keep_mismatches;
+
+            if (block == 0)
+            {
+                op        = detail::column_op(ref_gaps & 1, query_gaps & 1, mismatches & 1, distinguish_mismatches);
+                prev_bits = ((ref_gaps & 1) << 63) | ((query_gaps & 1) << 62) | ((mismatches & 1) << 61);
+            }
+
+            // bit i is set iff the operation of column i differs from that of column i - 1
+            uint64_t changes = (ref_gaps ^ ((ref_gaps << 1) | (prev_bits >> 63))) |
+                               (query_gaps ^ ((query_gaps << 1) | ((prev_bits >> 62) & 1))) |
+                               (mismatches ^ ((mismatches << 1) | ((prev_bits >> 61) & 1)));
+            prev_bits = (ref_gaps & (uint64_t{1} << 63)) | ((query_gaps >> 63) << 62) | ((mismatches >> 63) << 61);
+
+            for (; changes != 0; changes &= changes - 1)
+            {
+                size_t const i = std::countr_zero(changes);
+                detail::append_cigar(ret, block + i - run_begin, op);
+                run_begin = block + i;
+                op        = detail::column_op((ref_gaps >> i) & 1, (query_gaps >> i) & 1, (mismatches >> i) & 1,
+                                       distinguish_mismatches);
+            }
+        }
+        detail::append_cigar(ret, size - run_begin, op);
+    }
+    else
+    {
+        auto const ref   = std::ranges::begin(reference_row);
+        auto const query = std::ranges::begin(query_row);
+
+        auto op_at = [&](size_t const i)
+        {
+            bool const ref_gap   = ref[i] == alphabet::gap{};
+            bool const query_gap = query[i] == alphabet::gap{};
+            return detail::column_op(ref_gap,
+                                     query_gap,
+                                     distinguish_mismatches && !ref_gap && !query_gap && !(ref[i] == query[i]),
+                                     distinguish_mismatches);
+        };
+
+        alphabet::cigar_op op        = op_at(0);
+        size_t             run_begin = 0;
+        for (size_t i = 1; i < size; ++i)
+        {
+            if (alphabet::cigar_op const next = op_at(i); next != op)
+            {
+                detail::append_cigar(ret, i - run_begin, op);
+                run_begin = i;
+                op        = next;
+            }
+        }
+        detail::append_cigar(ret, size - run_begin, op);
+    }
+
+    return ret;
+}
+
+} // namespace bio::ranges
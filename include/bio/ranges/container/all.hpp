@@ -14,11 +14,23 @@
 #pragma once
 
 #include <bio/ranges/container/aligned_allocator.hpp>
+#include <bio/ranges/container/anchor_gaps.hpp>
+#include <bio/ranges/container/arena_resource.hpp>
 #include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/compressed_qualities.hpp>
 #include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/container/concatenated_sequences_builder.hpp>
+#include <bio/ranges/container/concatenated_sequences_sort.hpp>
 #include <bio/ranges/container/concept.hpp>
+#include <bio/ranges/container/delta_sequences.hpp>
+#include <bio/ranges/container/dictionary.hpp>
+#include <bio/ranges/container/page_allocator.hpp>
+#include <bio/ranges/container/record_batch.hpp>
+#include <bio/ranges/container/rle_vector.hpp>
+#include <bio/ranges/container/small_buffer_vector.hpp>
 #include <bio/ranges/container/small_string.hpp>
 #include <bio/ranges/container/small_vector.hpp>
+#include <bio/ranges/container/split_vector.hpp>
 
 /*!\defgroup container Container
  * \brief The container submodule contains special BioC++ containers and generic container concepts.
@@ -0,0 +1,550 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::anchor_gaps and bio::ranges::cigar_to_anchor_gaps().
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/cigar/cigar.hpp>
+#include <bio/alphabet/gap/gapped.hpp>
+#include <bio/meta/tuple.hpp>
+#include <bio/ranges/cigar_conversion.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief An alignment row stored as an ungapped sequence and the positions and lengths of its gaps.
+ * \tparam sequence_t The type of the ungapped sequence; must model std::ranges::random_access_range and
+ *                    std::ranges::sized_range (also when const) and its value type must model
+ *                    bio::alphabet::writable_alphabet.
+ * \ingroup container
+ *
+ * \details
+ *
+ * Instead of one bio::alphabet::gapped letter per column, this container stores the ungapped sequence (e.g. a
+ * std::ranges::ref_view of a std::vector<bio::alphabet::dna4>) and a sorted list of "anchors": for every stretch of
+ * gaps the position in the ungapped sequence that it precedes and the number of gaps up to and including the
+ * stretch. Its memory usage depends on the number of gap stretches `g` and not on the length of the alignment.
+ *
+ * Elements are bio::alphabet::gapped letters; they can be read but not assigned. Gaps are added and removed with
+ * insert_gap() and erase_gap().
+ *
+ * | Operation                                    | Complexity             |
+ * |----------------------------------------------|:----------------------:|
+ * | operator[]                                   | O(log g)               |
+ * | to_gapped_position(), to_ungapped_position() | O(log g)               |
+ * | iterating                                    | O(1) per column        |
+ * | insert_gap(), erase_gap()                    | O(g) (O(1) at the end) |
+ *
+ * A pair of rows can be created from a CIGAR string with bio::ranges::cigar_to_anchor_gaps() and be converted
+ * back with bio::ranges::gapped_to_cigar(); both only visit the gap stretches, not every column.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/anchor_gaps.cpp
+ *
+ * ### Thread safety
+ *
+ * This container provides no thread-safety beyond the promise given also by the STL that all
+ * calls to `const` member function are safe from multiple threads (as long as no thread calls
+ * a non-`const` member function at the same time).
+ */
+template <typename sequence_t>
+    requires(std::ranges::random_access_range<sequence_t const> && std::ranges::sized_range<sequence_t const> &&
+             alphabet::writable_alphabet<std::ranges::range_value_t<sequence_t const>>)
+class anchor_gaps
+{
+private:
+    //!\brief The letter type of the sequence.
+    using letter_type = std::ranges::range_value_t<sequence_t const>;
+
+    //!\brief A stretch of gaps.
+    struct anchor
+    {
+        size_t source_pos; //!< The position in the ungapped sequence that the gaps precede.
+        size_t cumulative; //!< The number of gaps in this and all previous stretches.
+
+        //!\brief Defaulted.
+        bool operator==(anchor const &) const = default;
+    };
+
+    //!\brief The ungapped sequence.
+    sequence_t          src{};
+    //!\brief The gap stretches, ordered by position.
+    std::vector<anchor> anchors;
+
+    //!\brief The number of gaps before stretch `k`.
+    size_t cumulative_before(size_t const k) const noexcept { return k == 0 ? 0 : anchors[k - 1].cumulative; }
+
+    //!\brief The first column of stretch `k`.
+    size_t gapped_begin(size_t const k) const noexcept { return anchors[k].source_pos + cumulative_before(k); }
+
+    //!\brief The column behind stretch `k`.
+    size_t gapped_end(size_t const k) const noexcept { return anchors[k].source_pos + anchors[k].cumulative; }
+
+    //!\brief The first stretch that ends behind column `pos` (anchors.size() if there is none).
+    size_t stretch_of(size_t const pos) const noexcept
+    {
+        auto const gapped_end_of = [](anchor const & a) { return a.source_pos + a.cumulative; };
+        return std::ranges::upper_bound(anchors, pos, {}, gapped_end_of) - anchors.begin();
+    }
+
+    /*!\brief The iterator type; it stores the current or next gap stretch.
+     * \implements std::random_access_iterator
+     */
+    class iterator_type
+    {
+    private:
+        //!\brief The container.
+        anchor_gaps const * host        = nullptr;
+        //!\brief The column.
+        size_t              pos         = 0;
+        //!\brief The first stretch that ends behind #pos.
+        size_t              k           = 0;
+        //!\brief The first column of stretch #k (maximum if there is none).
+        size_t              gap_begin   = 0;
+        //!\brief The column behind stretch #k (maximum if there is none).
+        size_t              gap_end     = 0;
+        //!\brief The number of gaps before stretch #k.
+        size_t              gaps_before = 0;
+
+        //!\brief Load the data of stretch #k.
+        constexpr void load_stretch() noexcept
+        {
+            gaps_before = host->cumulative_before(k);
+            if (k < host->anchors.size())
+            {
+                gap_begin = host->gapped_begin(k);
+                gap_end   = host->gapped_end(k);
+            }
+            else
+            {
+                gap_begin = gap_end = std::numeric_limits<size_t>::max();
+            }
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        using difference_type   = ptrdiff_t;                       //!< Signed integer.
+        using value_type        = alphabet::gapped<letter_type>;   //!< The gapped alphabet.
+        using reference         = value_type;                      //!< Elements are generated.
+        using pointer           = void;                            //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;         //!< Reference is not a reference type.
+        using iterator_concept  = std::random_access_iterator_tag; //!< Random access.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr iterator_type()                                  = default; //!< Defaulted.
+        constexpr iterator_type(iterator_type const &)             = default; //!< Defaulted.
+        constexpr iterator_type(iterator_type &&)                  = default; //!< Defaulted.
+        constexpr iterator_type & operator=(iterator_type const &) = default; //!< Defaulted.
+        constexpr iterator_type & operator=(iterator_type &&)      = default; //!< Defaulted.
+        ~iterator_type()                                           = default; //!< Defaulted.
+
+        //!\brief Construct from the container and a column.
+        constexpr iterator_type(anchor_gaps const & h, size_t const p) noexcept :
+          host{&h}, pos{p}, k{h.stretch_of(p)}
+        {
+            load_stretch();
+        }
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The current column.
+        constexpr reference operator*() const
+        {
+            if (pos >= gap_begin)
+                return value_type{alphabet::gap{}};
+            return value_type{static_cast<letter_type>(std::ranges::begin(host->src)[pos - gaps_before])};
+        }
+
+        //!\brief The column `d` positions further.
+        constexpr reference operator[](difference_type const d) const { return *(*this + d); }
+
+        //!\brief Pre-increment; moves to the next gap stretch if necessary.
+        constexpr iterator_type & operator++() noexcept
+        {
+            if (++pos == gap_end)
+            {
+                ++k;
+                load_stretch();
+            }
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        constexpr iterator_type operator++(int) noexcept
+        {
+            iterator_type tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        //!\brief Pre-decrement; moves to the previous gap stretch if necessary.
+        constexpr iterator_type & operator--() noexcept
+        {
+            if (k > 0 && pos == host->gapped_end(k - 1))
+            {
+                --k;
+                load_stretch();
+            }
+            --pos;
+            return *this;
+        }
+
+        //!\brief Post-decrement.
+        constexpr iterator_type operator--(int) noexcept
+        {
+            iterator_type tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        //!\brief Move by `d` positions.
+        constexpr iterator_type & operator+=(difference_type const d) noexcept
+        {
+            pos += d;
+            if (!(pos < gap_end && (k == 0 || pos >= host->gapped_end(k - 1))))
+            {
+                k = host->stretch_of(pos);
+                load_stretch();
+            }
+            return *this;
+        }
+
+        //!\brief Move by `-d` positions.
+        constexpr iterator_type & operator-=(difference_type const d) noexcept { return *this += -d; }
+
+        //!\brief Returns an iterator moved by `d` positions.
+        constexpr friend iterator_type operator+(iterator_type it, difference_type const d) noexcept
+        {
+            return it += d;
+        }
+
+        //!\copydoc operator+(iterator_type, difference_type const)
+        constexpr friend iterator_type operator+(difference_type const d, iterator_type it) noexcept
+        {
+            return it += d;
+        }
+
+        //!\brief Returns an iterator moved by `-d` positions.
+        constexpr friend iterator_type operator-(iterator_type it, difference_type const d) noexcept
+        {
+            return it -= d;
+        }
+
+        //!\brief The distance between two iterators.
+        constexpr friend difference_type operator-(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the positions.
+        constexpr friend bool operator==(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return lhs.pos == rhs.pos;
+        }
+
+        //!\brief Compare the positions.
+        constexpr friend auto operator<=>(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return lhs.pos <=> rhs.pos;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief The gapped alphabet.
+    using value_type      = alphabet::gapped<letter_type>;
+    //!\brief Elements are generated.
+    using reference       = value_type;
+    //!\brief Elements are generated.
+    using const_reference = value_type;
+    //!\brief The iterator type.
+    using iterator        = iterator_type;
+    //!\brief The iterator type.
+    using const_iterator  = iterator_type;
+    //!\brief A signed integer type.
+    using difference_type = ptrdiff_t;
+    //!\brief An unsigned integer type.
+    using size_type       = size_t;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    anchor_gaps()                                    = default; //!< Defaulted.
+    anchor_gaps(anchor_gaps const &)                 = default; //!< Defaulted.
+    anchor_gaps(anchor_gaps &&) noexcept             = default; //!< Defaulted.
+    anchor_gaps & operator=(anchor_gaps const &)     = default; //!< Defaulted.
+    anchor_gaps & operator=(anchor_gaps &&) noexcept = default; //!< Defaulted.
+    ~anchor_gaps()                                   = default; //!< Defaulted.
+
+    //!\brief Construct from the ungapped sequence (without gaps).
+    explicit anchor_gaps(sequence_t source) : src{std::move(source)} {}
+
+    //!\brief Construct from a std::ranges::viewable_range (if `sequence_t` is a view over it).
+    template <std::ranges::viewable_range rng_t>
+        requires(!std::same_as<std::remove_cvref_t<rng_t>, anchor_gaps> &&
+                 !std::same_as<std::remove_cvref_t<rng_t>, sequence_t> &&
+                 std::constructible_from<sequence_t, std::views::all_t<rng_t>>)
+    explicit anchor_gaps(rng_t && source) : src{std::views::all(std::forward<rng_t>(source))}
+    {}
+    //!\}
+
+    //!\brief The ungapped sequence.
+    sequence_t const & source() const noexcept { return src; }
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first column.
+    iterator begin() const noexcept { return iterator{*this, 0}; }
+    //!\copydoc begin()
+    iterator cbegin() const noexcept { return begin(); }
+
+    //!\brief Returns an iterator behind the last column.
+    iterator end() const noexcept { return iterator{*this, size()}; }
+    //!\copydoc end()
+    iterator cend() const noexcept { return end(); }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    //!\brief Returns the column `i`.
+    value_type operator[](size_type const i) const
+    {
+        assert(i < size());
+        size_t const k = stretch_of(i);
+        if (k < anchors.size() && i >= gapped_begin(k))
+            return value_type{alphabet::gap{}};
+        return value_type{static_cast<letter_type>(std::ranges::begin(src)[i - cumulative_before(k)])};
+    }
+
+    //!\brief Returns the column `i`.
+    //!\throws std::out_of_range If `i >= size()`.
+    value_type at(size_type const i) const
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in anchor_gaps."};
+        return (*this)[i];
+    }
+
+    //!\brief Returns the first column.
+    value_type front() const { return (*this)[0]; }
+
+    //!\brief Returns the last column.
+    value_type back() const { return (*this)[size() - 1]; }
+    //!\}
+
+    /*!\name Capacity and gaps
+     * \{
+     */
+    //!\brief The number of columns (letters and gaps).
+    size_type size() const noexcept { return std::ranges::size(src) + gap_count(); }
+
+    //!\brief Whether there are no columns.
+    bool empty() const noexcept { return size() == 0; }
+
+    //!\brief The number of gaps.
+    size_type gap_count() const noexcept { return anchors.empty() ? 0 : anchors.back().cumulative; }
+
+    //!\brief The number of stretches of consecutive gaps.
+    size_type gap_stretch_count() const noexcept { return anchors.size(); }
+
+    /*!\brief The i-th stretch of consecutive gaps.
+     * \returns The position in the ungapped sequence that the gaps precede and the number of gaps.
+     */
+    meta::tuple<size_type, size_type> gap_stretch(size_type const i) const noexcept
+    {
+        assert(i < anchors.size());
+        return {anchors[i].source_pos, anchors[i].cumulative - cumulative_before(i)};
+    }
+    //!\}
+
+    /*!\name Coordinate conversion
+     * \{
+     */
+    /*!\brief The column of the letter at position `i` in the ungapped sequence.
+     * \param[in] i A position in the ungapped sequence; `source().size()` returns size().
+     */
+    size_type to_gapped_position(size_type const i) const noexcept
+    {
+        assert(i <= std::ranges::size(src));
+        auto const it = std::ranges::upper_bound(anchors, i, {}, &anchor::source_pos);
+        return i + (it == anchors.begin() ? 0 : std::ranges::prev(it)->cumulative);
+    }
+
+    /*!\brief The position in the ungapped sequence of the letter in column `i`.
+     * \param[in] i A column; size() returns `source().size()`.
+     * \details
+     * If column `i` is a gap, the position of the next letter is returned.
+     */
+    size_type to_ungapped_position(size_type const i) const noexcept
+    {
+        assert(i <= size());
+        size_t const k = stretch_of(i);
+        if (k < anchors.size() && i >= gapped_begin(k))
+            return anchors[k].source_pos;
+        return i - cumulative_before(k);
+    }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    /*!\brief Insert gaps before column `pos`.
+     * \param[in] pos   The column; may be size().
+     * \param[in] count The number of gaps.
+     * \throws std::out_of_range If `pos > size()`.
+     */
+    void insert_gap(size_type const pos, size_type const count = 1)
+    {
+        if (pos > size())
+            throw std::out_of_range{"Trying to insert gaps behind the end of anchor_gaps."};
+        if (count == 0)
+            return;
+
+        size_t k = stretch_of(pos);
+        if (k > 0 && gapped_end(k - 1) == pos) // append to the previous stretch
+            --k;
+        else if (k == anchors.size() || pos < gapped_begin(k)) // new stretch
+            anchors.insert(anchors.begin() + k, anchor{pos - cumulative_before(k), cumulative_before(k)});
+
+        for (size_t j = k; j < anchors.size(); ++j)
+            anchors[j].cumulative += count;
+    }
+
+    /*!\brief Erase gaps in columns `[pos, pos + count)`.
+     * \param[in] pos   The first column.
+     * \param[in] count The number of gaps.
+     * \throws std::invalid_argument If one of the columns is not a gap.
+     */
+    void erase_gap(size_type const pos, size_type const count = 1)
+    {
+        if (count == 0)
+            return;
+
+        size_t const k = stretch_of(pos);
+        if (k == anchors.size() || pos < gapped_begin(k) || pos + count > gapped_end(k))
+            throw std::invalid_argument{"anchor_gaps::erase_gap() can only erase gaps."};
+
+        for (size_t j = k; j < anchors.size(); ++j)
+            anchors[j].cumulative -= count;
+        if (anchors[k].cumulative == cumulative_before(k))
+            anchors.erase(anchors.begin() + k);
+    }
+
+    //!\brief Removes all gaps.
+    void clear_gaps() noexcept { anchors.clear(); }
+    //!\}
+
+    //!\brief Compares the columns.
+    friend bool operator==(anchor_gaps const & lhs, anchor_gaps const & rhs)
+    {
+        return lhs.anchors == rhs.anchors && std::ranges::equal(lhs.src, rhs.src);
+    }
+};
+
+/*!\name Deduction guide
+ * \relates bio::ranges::anchor_gaps
+ * \{
+ */
+//!\brief Store a view of the sequence (or the sequence itself if it is an rvalue).
+template <std::ranges::viewable_range rng_t>
+anchor_gaps(rng_t &&) -> anchor_gaps<std::views::all_t<rng_t>>;
+//!\}
+
+/*!\brief Create the two rows of a pairwise alignment from a CIGAR string.
+ * \ingroup container
+ * \param[in] cigar     The CIGAR string; a range over bio::alphabet::cigar.
+ * \param[in] reference The aligned part of the reference sequence.
+ * \param[in] query     The aligned part of the query sequence, i.e. without soft-clipped letters.
+ * \returns A pair of bio::ranges::anchor_gaps (reference row and query row) that store views of the sequences (or
+ *          the sequences if they are rvalues).
+ * \throws std::invalid_argument If the CIGAR string does not fit the lengths of the sequences.
+ *
+ * \details
+ *
+ * Insertions (`I`) are gaps in the reference row, deletions and skipped regions (`D`, `N`) are gaps in the query row
+ * and padding (`P`) is a gap in both rows. Clipping (`S`, `H`) is ignored. The runtime is linear in the length of
+ * the CIGAR string, not of the sequences.
+ */
+template <std::ranges::input_range cigar_rng_t, std::ranges::viewable_range ref_t, std::ranges::viewable_range query_t>
+    requires std::convertible_to<std::ranges::range_reference_t<cigar_rng_t>, alphabet::cigar>
+auto cigar_to_anchor_gaps(cigar_rng_t && cigar, ref_t && reference, query_t && query)
+{
+    std::pair ret{anchor_gaps{std::forward<ref_t>(reference)}, anchor_gaps{std::forward<query_t>(query)}};
+    auto & [ref_row, query_row] = ret;
+
+    size_t ref_pos   = 0;
+    size_t query_pos = 0;
+    for (alphabet::cigar const c : cigar)
+    {
+        size_t const count = get<0>(c);
+        switch (get<1>(c).to_char())
+        {
+            case 'M':
+            case '=':
+            case 'X':
+                ref_pos += count;
+                query_pos += count;
+                break;
+            case 'I':
+                ref_row.insert_gap(ref_row.to_gapped_position(std::min(ref_pos, ref_row.source().size())), count);
+                query_pos += count;
+                break;
+            case 'D':
+            case 'N':
+                query_row.insert_gap(query_row.to_gapped_position(std::min(query_pos, query_row.source().size())),
+                                     count);
+                ref_pos += count;
+                break;
+            case 'P':
+                ref_row.insert_gap(ref_row.to_gapped_position(std::min(ref_pos, ref_row.source().size())), count);
+                query_row.insert_gap(query_row.to_gapped_position(std::min(query_pos, query_row.source().size())),
+                                     count);
+                break;
+            default: // S, H
+                break;
+        }
+    }
+
+    if (ref_pos != std::ranges::size(ref_row.source()) || query_pos != std::ranges::size(query_row.source()))
+        throw std::invalid_argument{"The CIGAR string does not fit the lengths of the sequences."};
+
+    return ret;
+}
+
+} // namespace bio::ranges
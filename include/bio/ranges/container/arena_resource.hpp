@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::arena_resource.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace bio::ranges
+{
+
+/*!\brief A monotonic memory resource whose memory can be reused after a reset.
+ * \ingroup container
+ *
+ * \details
+ *
+ * This is a std::pmr::memory_resource that hands out memory by advancing a pointer in a large block obtained
+ * from an upstream resource. Deallocation is a no-op; memory is only reclaimed by #reset() or #release().
+ *
+ * It is intended for batches of short-lived containers, e.g. the records of one batch in a parser:
+ *
+ *   1. Create the containers with a std::pmr::polymorphic_allocator that points to the arena (e.g.
+ *      bio::ranges::pmr::concatenated_sequences, bio::ranges::pmr::bitcompressed_vector,
+ *      bio::ranges::pmr::dictionary or any `std::pmr` container).
+ *   2. Process the batch and destroy the containers.
+ *   3. Call #reset() to make all memory available for the next batch.
+ *
+ * In contrast to std::pmr::monotonic_buffer_resource, #reset() does not return memory to the upstream resource. If
+ * more than one block was needed for a batch, the blocks are replaced by a single block that is large enough for the
+ * whole batch. So after the first batches, no upstream allocations happen at all.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/arena_resource.cpp
+ *
+ * ### Thread safety
+ *
+ * This resource is not thread-safe. Use one arena per thread.
+ */
+class arena_resource : public std::pmr::memory_resource
+{
+private:
+    //!\brief Header at the beginning of every block.
+    struct block
+    {
+        //!\brief The previously allocated block.
+        block * prev;
+        //!\brief The size of this block in bytes (including the header).
+        size_t  size;
+    };
+
+    //!\brief The alignment of blocks.
+    static constexpr size_t block_alignment = alignof(std::max_align_t);
+
+    //!\brief The upstream resource.
+    std::pmr::memory_resource * upstream      = nullptr;
+    //!\brief The most recently allocated block.
+    block *                     current_block = nullptr;
+    //!\brief The next free byte in the current block.
+    std::byte *                 cursor        = nullptr;
+    //!\brief One past the last byte in the current block.
+    std::byte *                 block_end     = nullptr;
+    //!\brief The size of the next block.
+    size_t                      next_size     = 0;
+    //!\brief The number of bytes handed out since the last reset.
+    size_t                      used          = 0;
+
+    //!\brief Allocate a new block of at least `min_size` bytes (including the header) from upstream.
+    void add_block(size_t const min_size)
+    {
+        size_t const size = std::max(next_size, min_size);
+        void * const mem  = upstream->allocate(size, block_alignment);
+
+        current_block = ::new (mem) block{current_block, size};
+        cursor        = static_cast<std::byte *>(mem) + sizeof(block);
+        block_end     = static_cast<std::byte *>(mem) + size;
+        next_size     = size * 2;
+    }
+
+    //!\brief The number of bytes in all blocks.
+    size_t total_size() const noexcept
+    {
+        size_t ret = 0;
+        for (block const * b = current_block; b != nullptr; b = b->prev)
+            ret += b->size;
+        return ret;
+    }
+
+    //!\brief Allocate memory from the current block or a new one.
+    void * do_allocate(size_t const bytes, size_t const alignment) override
+    {
+        std::uintptr_t const pos     = reinterpret_cast<std::uintptr_t>(cursor);
+        std::uintptr_t const aligned = (pos + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+        if (current_block == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(block_end)) // [[unlikely]]
+        {
+            add_block(sizeof(block) + bytes + std::max(alignment, block_alignment));
+            return do_allocate(bytes, alignment);
+        }
+
+        cursor = reinterpret_cast<std::byte *>(aligned + bytes);
+        used += bytes;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    //!\brief No-op; memory is reclaimed by reset() or release().
+    void do_deallocate(void *, size_t, size_t) noexcept override {}
+
+    //!\brief Resources are only equal if they are the same object.
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    arena_resource(arena_resource const &)             = delete; //!< Deleted.
+    arena_resource(arena_resource &&)                  = delete; //!< Deleted.
+    arena_resource & operator=(arena_resource const &) = delete; //!< Deleted.
+    arena_resource & operator=(arena_resource &&)      = delete; //!< Deleted.
+
+    //!\brief Returns all memory to the upstream resource.
+    ~arena_resource() override { release(); }
+
+    /*!\brief Construct with an initial block size and an upstream resource.
+     * \param[in] initial_size The size of the first block in bytes (no memory is allocated before the first request).
+     * \param[in] upstream_    The resource that blocks are allocated from.
+     */
+    explicit arena_resource(size_t const                      initial_size = 64 * 1024,
+                            std::pmr::memory_resource * const upstream_ = std::pmr::get_default_resource()) noexcept :
+      upstream{upstream_}, next_size{std::max(initial_size, sizeof(block) + block_alignment)}
+    {
+        assert(upstream != nullptr);
+    }
+    //!\}
+
+    /*!\brief Make all memory available for new allocations.
+     * \throws std::bad_alloc If the upstream allocation fails (the arena is empty afterwards, but usable).
+     *
+     * \details
+     *
+     * All memory allocated from this resource becomes invalid. If multiple blocks are in use, they are returned to
+     * the upstream resource and replaced by a single block of their combined size.
+     *
+     * ### Complexity
+     *
+     * Linear in the number of blocks (usually one).
+     */
+    void reset()
+    {
+        used = 0;
+        if (current_block == nullptr)
+            return;
+
+        if (current_block->prev == nullptr) // single block: rewind
+        {
+            cursor = reinterpret_cast<std::byte *>(current_block) + sizeof(block);
+            return;
+        }
+
+        size_t const total = total_size();
+        release();
+        next_size = total;
+        add_block(total);
+    }
+
+    /*!\brief Return all memory to the upstream resource.
+     *
+     * \details
+     *
+     * All memory allocated from this resource becomes invalid. The next block will be as large as the last one.
+     *
+     * ### Complexity
+     *
+     * Linear in the number of blocks.
+     */
+    void release() noexcept
+    {
+        if (current_block != nullptr)
+            next_size = std::max(next_size / 2, current_block->size);
+
+        while (current_block != nullptr)
+        {
+            block * const prev = current_block->prev;
+            upstream->deallocate(current_block, current_block->size, block_alignment);
+            current_block = prev;
+        }
+        cursor    = nullptr;
+        block_end = nullptr;
+        used      = 0;
+    }
+
+    //!\brief The number of bytes handed out since the last reset (without alignment padding).
+    size_t bytes_used() const noexcept { return used; }
+
+    //!\brief The number of bytes currently obtained from the upstream resource.
+    size_t bytes_reserved() const noexcept { return total_size(); }
+
+    //!\brief The upstream resource.
+    std::pmr::memory_resource * upstream_resource() const noexcept { return upstream; }
+};
+
+} // namespace bio::ranges
@@ -13,11 +13,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <climits>
 #include <concepts>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
+#include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include <bio/alphabet/proxy_base.hpp>
 #include <bio/ranges/detail/random_access_iterator.hpp>
@@ -29,8 +35,12 @@
 namespace bio::ranges
 {
 
+template <typename bitcompressed_vector_t>
+class bitcompressed_slice;
+
 /*!\brief A space-optimised version of std::vector that compresses multiple letters into a single byte.
  * \tparam alphabet_type The value type of the container, must satisfy bio::alphabet::writable_semialphabet and std::regular.
+ * \tparam allocator_t   The allocator of the underlying storage (rebound to `uint64_t`).
  * \implements bio::ranges::detail::reservible_container
  * \implements bio::cerealisable
  * \ingroup container
@@ -57,26 +67,34 @@ namespace bio::ranges
  * threads at the same time **is not safe** and will lead to corruption if both values are stored in the same
  * 64bit-block, i.e. if the distance between `i` and `j` is smaller than 64 / alphabet_size.
  */
-template <alphabet::writable_semialphabet alphabet_type>
+template <alphabet::writable_semialphabet alphabet_type, typename allocator_t = std::allocator<uint64_t>>
     requires std::regular<alphabet_type>
 class bitcompressed_vector
 {
-private:
+public:
+    /*!\name Packed representation
+     * \{
+     */
     //!\brief The number of bits needed to represent a single letter of the alphabet_type.
-    static constexpr size_t bits_per_letter = std::bit_width(alphabet::size<alphabet_type>);
+    static constexpr size_t bits_per_letter =
+      std::max<size_t>(1, std::bit_width(static_cast<uint64_t>(alphabet::size<alphabet_type>) - 1u));
+    //!\brief The number of letters that fit into a word of raw_data(); letters never span two words.
+    static constexpr size_t letters_per_word = sizeof(uint64_t) * CHAR_BIT / bits_per_letter;
+    //!\}
+
+private:
     static_assert(bits_per_letter <= 64, "alphabet must be representable in at most 64bit.");
 
     //!\brief The element type of the underyling storage vector.
     using word_type                            = uint64_t;
     //!\brief Size in bits of the word_type.
     static constexpr size_t   word_size        = sizeof(word_type) * CHAR_BIT;
-    //!\brief The number of letters that fit into a word.
-    static constexpr size_t   letters_per_word = word_size / bits_per_letter;
     //!\brief A bitmask that has only the last #bits_per_letter bits set.
     static constexpr uint64_t mask             = (1ull << bits_per_letter) - 1ull;
 
-    //!\brief Type of the underlying SDSL vector.
-    using data_type = std::vector<uint64_t>;
+    //!\brief Type of the underlying vector.
+    using data_type = std::vector<uint64_t,
+                                  typename std::allocator_traits<allocator_t>::template rebind_alloc<uint64_t>>;
 
     //!\brief The size!
     size_t size_ = 0;
@@ -103,6 +121,29 @@ private:
         word |= rank << offset;
     }
 
+    //!\brief The upper bits of the serialisation header (never set in the size stored by old archives).
+    static constexpr uint64_t serialisation_magic  = 0xB17C'0000'0000'0000ull;
+    //!\brief The serialisation header: magic, format version and #bits_per_letter.
+    static constexpr uint64_t serialisation_header = serialisation_magic | (1ull << 8) | bits_per_letter;
+
+    //!\brief Replace the content with `size` letters stored in the layout of archives without a header.
+    void load_legacy(data_type const & legacy, size_t const size)
+    {
+        constexpr size_t   legacy_bits = std::bit_width(static_cast<uint64_t>(alphabet::size<alphabet_type>));
+        constexpr size_t   legacy_lpw  = word_size / legacy_bits;
+        constexpr uint64_t legacy_mask = (1ull << legacy_bits) - 1ull;
+
+        if (legacy.size() != (size + legacy_lpw - 1) / legacy_lpw)
+            throw std::runtime_error{"The archive contains a bitcompressed_vector of inconsistent size."};
+
+        data_type converted(size / letters_per_word + (size % letters_per_word != 0), 0ull, data.get_allocator());
+        for (size_t i = 0; i < size; ++i)
+            set_rank(converted, i, (legacy[i / legacy_lpw] >> ((i % legacy_lpw) * legacy_bits)) & legacy_mask);
+
+        data  = std::move(converted);
+        size_ = size;
+    }
+
     //!\brief Zeros out the bits behind the last element in the last word.
     void clear_unused_bits_in_last_word()
     {
@@ -205,10 +246,8 @@ public:
     using size_type       = std::ranges::range_size_t<data_type>;
     //!\}
 
-    //!\cond
-    // this signals to range-v3 that something is a container :|
-    using allocator_type = void;
-    //!\endcond
+    //!\brief The allocator type (rebound to the word type).
+    using allocator_type = typename data_type::allocator_type;
 
     /*!\name Constructors, destructor and assignment
      * \{
@@ -220,6 +259,24 @@ public:
     constexpr bitcompressed_vector & operator=(bitcompressed_vector &&) noexcept = default; //!< Defaulted.
     ~bitcompressed_vector() noexcept                                             = default; //!< Defaulted.
 
+    /*!\brief Construct an empty vector that uses the given allocator.
+     * \param[in] alloc The allocator.
+     *
+     * \details
+     *
+     * This can be used to allocate from a std::pmr::memory_resource like bio::ranges::arena_resource, see
+     * bio::ranges::pmr::bitcompressed_vector.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    explicit bitcompressed_vector(allocator_type const & alloc) noexcept : data(alloc) {}
+
     /*!\brief Construct from a different range.
      * \tparam other_range_t The type of range to construct from; must satisfy std::ranges::input_range and
      *                       std::common_reference_with<std::ranges::range_value_t<other_range_t>, value_type>.
@@ -235,9 +292,25 @@ public:
      */
     template <meta::different_from<bitcompressed_vector> other_range_t>
         requires(std::ranges::input_range<other_range_t> && has_same_value_type_v<other_range_t>)
-    explicit bitcompressed_vector(other_range_t && range) :
-      bitcompressed_vector{std::ranges::begin(range), std::ranges::end(range)}
-    {}
+    explicit bitcompressed_vector(other_range_t && range)
+    {
+        // packed source with the same alphabet (and thus the same layout): copy word-wise
+        if constexpr (std::ranges::sized_range<other_range_t> &&
+                      requires { range.packed_ranks(size_type{}, size_type{}); })
+        {
+            size_type const n = std::ranges::size(range);
+            data.reserve(n / letters_per_word + 1);
+            for (size_type i = 0; i < n; i += letters_per_word)
+            {
+                size_type const count = std::min<size_type>(letters_per_word, n - i);
+                append_packed(range.packed_ranks(i, count), count);
+            }
+        }
+        else
+        {
+            insert(cend(), std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
 
     /*!\brief Construct with `count` times `value`.
      * \param[in] count Number of elements.
@@ -558,6 +631,79 @@ public:
 
     //!\copydoc raw_data()
     constexpr data_type const & raw_data() const noexcept { return data; }
+
+    //!\brief Returns a copy of the allocator.
+    allocator_type get_allocator() const noexcept { return data.get_allocator(); }
+
+    /*!\brief Retrieve the ranks of multiple consecutive elements at once.
+     * \param i     The position of the first element.
+     * \param count The number of elements; must be at most #letters_per_word.
+     * \returns A word that contains the rank of element `i + k` in the bits
+     * `[k * bits_per_letter, (k + 1) * bits_per_letter)` and zeros in all other bits.
+     *
+     * \details
+     *
+     * This reads at most two words from the underlying storage, independent of `count`. It is used by algorithms
+     * that can process multiple letters at once, e.g. comparisons.
+     *
+     * Accessing elements behind the last causes undefined behaviour. In debug mode an assertion checks the size of
+     * the container.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    uint64_t packed_ranks(size_type const i, size_type const count) const noexcept
+    {
+        assert(count <= letters_per_word);
+        assert(i + count <= size());
+        if (count == 0)
+            return 0;
+
+        size_t const in_first = letters_per_word - i % letters_per_word;
+        uint64_t     ret      = data[i / letters_per_word] >> ((i % letters_per_word) * bits_per_letter);
+        if (count > in_first)
+            ret |= data[i / letters_per_word + 1] << (in_first * bits_per_letter);
+
+        size_t const bits = count * bits_per_letter;
+        return bits == word_size ? ret : ret & ((1ull << bits) - 1ull);
+    }
+
+    /*!\brief A view on the elements in `[begin_pos, end_pos)` that supports packed access.
+     * \param begin_pos The position of the first element.
+     * \param end_pos   The position behind the last element.
+     * \returns A bio::ranges::bitcompressed_slice.
+     *
+     * \details
+     *
+     * Unlike `*this | bio::views::slice(begin_pos, end_pos)`, the returned view provides packed_ranks() and chunks().
+     * bio::ranges::concatenated_sequences uses these views as its elements.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    bitcompressed_slice<bitcompressed_vector> slice(size_type const begin_pos, size_type const end_pos) noexcept
+    {
+        assert(begin_pos <= end_pos && end_pos <= size());
+        return {*this, begin_pos, end_pos - begin_pos};
+    }
+
+    //!\copydoc slice()
+    bitcompressed_slice<bitcompressed_vector const> slice(size_type const begin_pos,
+                                                          size_type const end_pos) const noexcept
+    {
+        assert(begin_pos <= end_pos && end_pos <= size());
+        return {*this, begin_pos, end_pos - begin_pos};
+    }
     //!\}
 
     /*!\name Capacity
@@ -738,11 +884,12 @@ public:
      *
      * The behaviour is well-defined, even if begin_it and end_it are iterators into `*this`.
      *
-     * This function always reallocates, so all iterators and references are invalidated.
+     * This function always reallocates (except when appending at the end), so all iterators and references are
+     * invalidated.
      *
      * ### Complexity
      *
-     * Linear in the new size().
+     * Linear in the new size(). When appending at the end: amortised linear in the size of the inserted range.
      *
      * ### Exceptions
      *
@@ -754,10 +901,20 @@ public:
                  std::common_reference_with<std::iter_value_t<begin_iterator_type>, value_type>)
     {
         //TODO UPDATE DOCUMENTATION TO REFLECT THIS
+        size_t const pos_as_num     = std::distance(cbegin(), pos);
+        size_t const size_of_insert = std::distance(begin_it, end_it);
+
+        // appending does not need a temporary and has amortised cost; this is also safe for iterators into `*this`,
+        // because they refer to the container and not the storage, and source and target do not overlap
+        if (pos_as_num == size())
+        {
+            resize(size() + size_of_insert);
+            std::copy(begin_it, end_it, begin() + pos_as_num);
+            return begin() + pos_as_num;
+        }
+
         //TODO this is not ideal, always linear
-        size_t const         pos_as_num     = std::distance(cbegin(), pos);
-        size_t const         size_of_insert = std::distance(begin_it, end_it);
-        bitcompressed_vector tmp;
+        bitcompressed_vector tmp{get_allocator()};
         tmp.resize(size() + size_of_insert);
         //TODO use constrained algorithms here once proxy_base is out-iterator-compatible
         std::copy(cbegin(), pos, tmp.begin());
@@ -816,7 +973,7 @@ public:
         //TODO this is not ideal, always linear
         size_t const         begin_pos_of_removal = std::distance(cbegin(), begin_it);
         size_t const         size_of_removal      = std::distance(begin_it, end_it);
-        bitcompressed_vector tmp;
+        bitcompressed_vector tmp{get_allocator()};
         tmp.resize(size() - size_of_removal);
         //TODO use constrained algorithms here once proxy_base is out-iterator-compatible
         std::copy(cbegin(), begin_it, tmp.begin());
@@ -867,6 +1024,47 @@ public:
         ++size_;
     }
 
+    /*!\brief Appends multiple elements given as packed ranks.
+     * \param ranks The ranks in the layout returned by packed_ranks().
+     * \param count The number of elements; must be at most #letters_per_word.
+     *
+     * \details
+     *
+     * This writes at most two words of the underlying storage, independent of `count`. Together with packed_ranks()
+     * it allows copying between bit-compressed ranges one word at a time.
+     *
+     * If the new size() is greater than capacity() then all iterators and references (including the past-the-end
+     * iterator) are invalidated. Otherwise only the past-the-end iterator is invalidated.
+     *
+     * ### Complexity
+     *
+     * Amortised constant, worst-case linear in size().
+     *
+     * ### Exceptions
+     *
+     * Basic exception guarantee, i.e. guaranteed not to leak, but container may contain invalid data after exception is
+     * thrown.
+     */
+    void append_packed(uint64_t const ranks, size_type const count)
+    {
+        assert(count <= letters_per_word);
+        if (count == 0)
+            return;
+
+        size_t const offset = size_ % letters_per_word;
+        if (offset == 0)
+        {
+            data.push_back(ranks);
+        }
+        else
+        {
+            data.back() |= ranks << (offset * bits_per_letter);
+            if (count > letters_per_word - offset)
+                data.push_back(ranks >> ((letters_per_word - offset) * bits_per_letter));
+        }
+        size_ += count;
+    }
+
     /*!\brief Removes the last element of the container.
      *
      * Calling pop_back() on an empty container is undefined. In debug mode an assertion will be thrown.
@@ -981,18 +1179,201 @@ public:
 
     /*!\cond DEV
      * \brief Serialisation support function.
-     * \tparam archive_t Type of `archive`; must satisfy bio::typename.
-     * \param archive The archive being serialised from/to.
+     * \tparam archive_t Type of `archive`; must satisfy bio::cereal_output_archive.
+     * \param archive The archive being serialised to.
+     *
+     * \details
+     *
+     * The archive starts with a header that records the format version and #bits_per_letter, followed by the size
+     * and the words of raw_data().
+     *
+     * \attention These functions are never called directly, see \ref howto_use_cereal for more details.
+     */
+    template <typename archive_t>
+    void save(archive_t & archive) const
+    {
+        archive(serialisation_header);
+        archive(size_);
+        archive(data);
+    }
+
+    /*!\brief Serialisation support function.
+     * \tparam archive_t Type of `archive`; must satisfy bio::cereal_input_archive.
+     * \param archive The archive being serialised from.
+     * \throws std::runtime_error If the archive was written by an incompatible version.
+     *
+     * \details
+     *
+     * Archives written before the header was introduced start directly with the size and store every letter in
+     * `std::bit_width(alphabet::size<alphabet_type>)` bits; they are converted to the current layout on load.
      *
      * \attention These functions are never called directly, see \ref howto_use_cereal for more details.
      */
     template <typename archive_t>
-    void serialize(archive_t & archive)
+    void load(archive_t & archive)
     {
+        uint64_t header = 0;
+        archive(header);
+
+        if ((header & serialisation_magic) != serialisation_magic) // no header: the first value is the size
+        {
+            size_t const size = header;
+            data_type    legacy{data.get_allocator()};
+            archive(legacy);
+            load_legacy(legacy, size);
+            return;
+        }
+
+        if (header != serialisation_header)
+            throw std::runtime_error{"The archive contains a bitcompressed_vector in an unsupported format."};
+
         archive(size_);
         archive(data);
     }
     //!\endcond
 };
 
+/*!\brief A view on a contiguous part of a bio::ranges::bitcompressed_vector that supports packed access.
+ * \tparam bitcompressed_vector_t The type of the vector, possibly const-qualified.
+ * \implements std::ranges::view
+ * \implements std::ranges::borrowed_range
+ * \ingroup container
+ *
+ * \details
+ *
+ * This view behaves like `vector | bio::views::slice(b, e)`, but it additionally gives access to the packed
+ * representation: packed_ranks() returns the ranks of up to #letters_per_word consecutive elements in one word, and
+ * chunks() is a view of such words covering the whole slice. This allows algorithms to process one word instead of one
+ * letter at a time, e.g. hashing, copying or k-mer extraction (every k-mer with `k <= letters_per_word` is a single
+ * call to packed_ranks()).
+ *
+ * Slices are created by bio::ranges::bitcompressed_vector::slice() and are the element type of
+ * bio::ranges::concatenated_sequences over bio::ranges::bitcompressed_vector.
+ *
+ * Iterators of this view are iterators of the underlying vector, i.e. they remain valid after the view is destroyed.
+ */
+template <typename bitcompressed_vector_t>
+class bitcompressed_slice : public std::ranges::view_interface<bitcompressed_slice<bitcompressed_vector_t>>
+{
+private:
+    //!\brief The underlying vector.
+    bitcompressed_vector_t * host   = nullptr;
+    //!\brief The position of the first element in the underlying vector.
+    size_t                   offset = 0;
+    //!\brief The number of elements.
+    size_t                   size_  = 0;
+
+    //!\brief Befriend the const version so it can be constructed from this.
+    template <typename>
+    friend class bitcompressed_slice;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief The iterator type (the iterator type of the underlying vector).
+    using iterator        = detail::random_access_iterator<bitcompressed_vector_t>;
+    //!\brief A signed integer type (usually std::ptrdiff_t)
+    using difference_type = typename bitcompressed_vector_t::difference_type;
+    //!\brief An unsigned integer type (usually std::size_t)
+    using size_type       = typename bitcompressed_vector_t::size_type;
+    //!\}
+
+    /*!\name Packed representation
+     * \{
+     */
+    //!\copydoc bio::ranges::bitcompressed_vector::bits_per_letter
+    static constexpr size_t bits_per_letter  = bitcompressed_vector_t::bits_per_letter;
+    //!\copydoc bio::ranges::bitcompressed_vector::letters_per_word
+    static constexpr size_t letters_per_word = bitcompressed_vector_t::letters_per_word;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bitcompressed_slice() noexcept                                        = default; //!< Defaulted.
+    bitcompressed_slice(bitcompressed_slice const &) noexcept             = default; //!< Defaulted.
+    bitcompressed_slice(bitcompressed_slice &&) noexcept                  = default; //!< Defaulted.
+    bitcompressed_slice & operator=(bitcompressed_slice const &) noexcept = default; //!< Defaulted.
+    bitcompressed_slice & operator=(bitcompressed_slice &&) noexcept      = default; //!< Defaulted.
+    ~bitcompressed_slice() noexcept                                       = default; //!< Defaulted.
+
+    //!\brief Construct from the vector, the position of the first element and the number of elements.
+    bitcompressed_slice(bitcompressed_vector_t & host_, size_t const offset_, size_t const size__) noexcept :
+      host{&host_}, offset{offset_}, size_{size__}
+    {}
+
+    //!\brief Construct a const slice from a non-const slice.
+    template <typename other_vector_t>
+        requires(std::is_const_v<bitcompressed_vector_t> && std::same_as<bitcompressed_vector_t, other_vector_t const>)
+    bitcompressed_slice(bitcompressed_slice<other_vector_t> const & rhs) noexcept :
+      host{rhs.host}, offset{rhs.offset}, size_{rhs.size_}
+    {}
+    //!\}
+
+    /*!\name Range interface
+     * \{
+     */
+    //!\brief Returns an iterator to the first element.
+    iterator begin() const noexcept { return iterator{*host, offset}; }
+    //!\brief Returns an iterator behind the last element.
+    iterator end() const noexcept { return iterator{*host, offset + size_}; }
+    //!\brief Returns the number of elements.
+    size_type size() const noexcept { return size_; }
+    //!\}
+
+    /*!\name Packed access
+     * \{
+     */
+    /*!\brief Retrieve the ranks of multiple consecutive elements at once.
+     * \param i     The position of the first element (relative to the slice).
+     * \param count The number of elements; must be at most #letters_per_word.
+     * \returns The ranks; see bio::ranges::bitcompressed_vector::packed_ranks().
+     */
+    uint64_t packed_ranks(size_type const i, size_type const count) const noexcept
+    {
+        assert(i + count <= size_);
+        return host->packed_ranks(offset + i, count);
+    }
+
+    /*!\brief A view of words that each contain the ranks of #letters_per_word elements.
+     * \returns A std::ranges::random_access_range over `uint64_t`.
+     *
+     * \details
+     *
+     * The k-th word contains the elements `[k * letters_per_word, (k + 1) * letters_per_word)`; the last word
+     * may contain fewer elements (and the remaining bits are zero). Words are aligned to the beginning of the slice
+     * (not to the underlying storage), so each word is assembled from at most two stored words.
+     */
+    auto chunks() const noexcept
+    {
+        size_type const n = (size_ + letters_per_word - 1) / letters_per_word;
+        return std::views::iota(size_type{0}, n) |
+               std::views::transform(
+                 [s = *this](size_type const k)
+                 {
+                     size_type const i = k * letters_per_word;
+                     return s.packed_ranks(i, std::min<size_type>(letters_per_word, s.size() - i));
+                 });
+    }
+    //!\}
+};
+
+namespace pmr
+{
+
+/*!\brief A bio::ranges::bitcompressed_vector that allocates from a std::pmr::memory_resource.
+ * \ingroup container
+ */
+template <typename alphabet_type>
+using bitcompressed_vector = bio::ranges::bitcompressed_vector<alphabet_type, std::pmr::polymorphic_allocator<uint64_t>>;
+
+} // namespace pmr
+
 } // namespace bio::ranges
+
+//!\cond
+template <typename bitcompressed_vector_t>
+inline constexpr bool std::ranges::enable_borrowed_range<bio::ranges::bitcompressed_slice<bitcompressed_vector_t>> =
+  true;
+//!\endcond
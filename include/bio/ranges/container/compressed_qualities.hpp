@@ -0,0 +1,578 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::compressed_qualities.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/detail/rans.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief A read-only, entropy-coded container of quality strings with random access by record.
+ * \tparam alphabet_type The alphabet of the strings, typically a bio::alphabet::quality; must satisfy
+ *                       bio::alphabet::writable_semialphabet and have at most 256 letters.
+ * \ingroup container
+ *
+ * \details
+ *
+ * The strings (records) are grouped into blocks of roughly `block_size` letters. Every block is compressed
+ * independently with an order-1 rANS coder (see bio::ranges::detail::rans_order1), i.e. every letter is coded in the
+ * context of the preceding letter of the same record, with frequency tables derived from the block itself. An index
+ * stores the offset of every block and the number of its first record.
+ *
+ * Accessing a record decodes that record and at most seven records before it in the same lane of the coder (see
+ * bio::ranges::detail::rans_order1::checkpoint_interval). The decoding tables of the most recently accessed block
+ * are kept, so that further accesses to the same block do not rebuild them. Elements are returned by value (as
+ * `std::vector<alphabet_type>`); the container cannot be modified. Iterating decodes each block only once, and
+ * decode_block() appends a whole block to a bio::ranges::concatenated_sequences without intermediate copies per
+ * record.
+ *
+ * Smaller blocks give faster random access, larger blocks give better compression (every block stores its own
+ * frequency tables). Typical Illumina qualities compress to 25–35% of one byte per letter.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/compressed_qualities.cpp
+ *
+ * ### Thread safety
+ *
+ * This container provides no thread-safety beyond the promise given also by the STL that all
+ * calls to `const` member function are safe from multiple threads (as long as no thread calls
+ * a non-`const` member function at the same time); the decoding tables kept by operator[] are guarded by a
+ * mutex. Iterators cache the current block and must not be shared between threads.
+ */
+template <alphabet::writable_semialphabet alphabet_type>
+    requires(alphabet::size<alphabet_type> <= 256 && std::regular<alphabet_type>)
+class compressed_qualities
+{
+private:
+    //!\brief The alphabet size.
+    static constexpr size_t sigma = alphabet::size<alphabet_type>;
+
+    //!\brief The compressed blocks.
+    std::vector<uint8_t> data;
+    //!\brief The offset of every block in #data and the size of #data at the end.
+    std::vector<size_t>  block_offsets{0};
+    //!\brief The number of the first record of every block and the number of records at the end.
+    std::vector<size_t>  block_first_record{0};
+
+    //!\brief The decoder of a block.
+    struct block_decoder
+    {
+        //!\brief The block number.
+        size_t                       block;
+        //!\brief The decoder (refers to #data).
+        detail::rans_order1::decoder decoder;
+    };
+
+    //!\brief The decoder of the most recently accessed block (never modified; replaced by operator[]).
+    mutable std::shared_ptr<block_decoder const> cache;
+    //!\brief Guards #cache.
+    mutable std::mutex                           cache_mutex;
+
+    //!\brief Return the decoder of block `b` from the cache or create it (and cache it).
+    std::shared_ptr<block_decoder const> decoder_of(size_t const b) const
+    {
+        {
+            std::lock_guard lock{cache_mutex};
+            if (cache && cache->block == b)
+                return cache;
+        }
+
+        std::vector<size_t>   lengths;
+        uint8_t const * const ptr = read_lengths(b, lengths);
+        uint8_t const * const end = data.data() + block_offsets[b + 1];
+        auto                  ret = std::make_shared<block_decoder const>(
+          b,
+          detail::rans_order1::decoder{ptr, end, std::move(lengths), sigma});
+
+        std::lock_guard lock{cache_mutex};
+        cache = ret;
+        return ret;
+    }
+
+    //!\brief Compress the given records and append them as one block.
+    void append_block(std::span<uint8_t const> const ranks, std::span<size_t const> const lengths)
+    {
+        for (size_t const len : lengths)
+            detail::write_varint(data, len);
+        detail::rans_order1::encode(ranks, lengths, sigma, data);
+
+        block_offsets.push_back(data.size());
+        block_first_record.push_back(block_first_record.back() + lengths.size());
+    }
+
+    /*!\brief Read the record lengths of block `b`.
+     * \param[in]  b       The block.
+     * \param[out] lengths The lengths of the block's records (resized).
+     * \returns Pointer to the coded data of the block.
+     */
+    uint8_t const * read_lengths(size_t const b, std::vector<size_t> & lengths) const
+    {
+        uint8_t const *       ptr = data.data() + block_offsets[b];
+        uint8_t const * const end = data.data() + block_offsets[b + 1];
+
+        lengths.resize(block_first_record[b + 1] - block_first_record[b]);
+        for (size_t & len : lengths)
+            len = detail::read_varint(ptr, end);
+        return ptr;
+    }
+
+    //!\brief Convert ranks to alphabet letters.
+    static void ranks_to_letters(std::span<uint8_t const> const ranks, alphabet_type * out) noexcept
+    {
+        for (uint8_t const r : ranks)
+            alphabet::assign_rank_to(r, *out++);
+    }
+
+public:
+    /*!\name Member types
+     * \{
+     */
+    //!\brief The type of the elements (returned by value).
+    using value_type      = std::vector<alphabet_type>;
+    //!\brief Elements are returned by value.
+    using reference       = value_type;
+    //!\brief Elements are returned by value.
+    using const_reference = value_type;
+    //!\brief A signed integer type.
+    using difference_type = ptrdiff_t;
+    //!\brief An unsigned integer type.
+    using size_type       = size_t;
+
+    /*!\brief The iterator type of this container (a random access iterator over values).
+     * \details
+     *
+     * The iterator keeps the most recently decoded block alive, so that sequential iteration decodes every block
+     * only once. Its `iterator_category` is std::input_iterator_tag, because the elements are returned by value.
+     */
+    class iterator
+    {
+    private:
+        //!\brief A decoded block.
+        struct decoded_block
+        {
+            //!\brief The block number.
+            size_t                                             block;
+            //!\brief The records of the block.
+            concatenated_sequences<std::vector<alphabet_type>> records;
+        };
+
+        //!\brief The container.
+        compressed_qualities const *                 host{nullptr};
+        //!\brief The current record.
+        size_t                                       pos{0};
+        //!\brief The most recently decoded block (shared between copies of this iterator; never modified).
+        mutable std::shared_ptr<decoded_block const> cache;
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        using value_type        = compressed_qualities::value_type;      //!< The value type.
+        using reference         = compressed_qualities::value_type;      //!< Elements are returned by value.
+        using pointer           = void;                                  //!< Not provided.
+        using difference_type   = compressed_qualities::difference_type; //!< The difference type.
+        using iterator_category = std::input_iterator_tag;               //!< The legacy category.
+        using iterator_concept  = std::random_access_iterator_tag;       //!< The C++20 concept.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        iterator() noexcept                             = default; //!< Defaulted.
+        iterator(iterator const &) noexcept             = default; //!< Defaulted.
+        iterator(iterator &&) noexcept                  = default; //!< Defaulted.
+        iterator & operator=(iterator const &) noexcept = default; //!< Defaulted.
+        iterator & operator=(iterator &&) noexcept      = default; //!< Defaulted.
+        ~iterator() noexcept                            = default; //!< Defaulted.
+
+        //!\brief Construct from the container and a record number.
+        iterator(compressed_qualities const & h, size_t const p) noexcept : host{&h}, pos{p} {}
+        //!\}
+
+        //!\brief Decode and return the current record.
+        value_type operator*() const
+        {
+            size_t const b = host->block_of(pos);
+            if (!cache || cache->block != b)
+            {
+                auto tmp = std::make_shared<decoded_block>(b);
+                host->decode_block(b, tmp->records);
+                cache = std::move(tmp);
+            }
+
+            auto rec = cache->records[pos - host->block_first_record[b]];
+            return value_type(rec.begin(), rec.end());
+        }
+
+        //!\brief Decode and return the record at offset `n`.
+        value_type operator[](difference_type const n) const { return *(*this + n); }
+
+        /*!\name Arithmetic operators
+         * \{
+         */
+        //!\brief Pre-increment.
+        iterator & operator++() noexcept
+        {
+            ++pos;
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        iterator operator++(int) noexcept
+        {
+            iterator tmp{*this};
+            ++pos;
+            return tmp;
+        }
+
+        //!\brief Pre-decrement.
+        iterator & operator--() noexcept
+        {
+            --pos;
+            return *this;
+        }
+
+        //!\brief Post-decrement.
+        iterator operator--(int) noexcept
+        {
+            iterator tmp{*this};
+            --pos;
+            return tmp;
+        }
+
+        //!\brief Advance by `n`.
+        iterator & operator+=(difference_type const n) noexcept
+        {
+            pos += n;
+            return *this;
+        }
+
+        //!\brief Go back by `n`.
+        iterator & operator-=(difference_type const n) noexcept
+        {
+            pos -= n;
+            return *this;
+        }
+
+        //!\brief Advance by `n`.
+        friend iterator operator+(iterator it, difference_type const n) noexcept { return it += n; }
+
+        //!\brief Advance by `n`.
+        friend iterator operator+(difference_type const n, iterator it) noexcept { return it += n; }
+
+        //!\brief Go back by `n`.
+        friend iterator operator-(iterator it, difference_type const n) noexcept { return it -= n; }
+
+        //!\brief The distance between two iterators.
+        friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compares the positions.
+        friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept { return lhs.pos == rhs.pos; }
+
+        //!\brief Compares the positions.
+        friend auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept { return lhs.pos <=> rhs.pos; }
+        //!\}
+    };
+
+    //!\brief There is no mutable iterator.
+    using const_iterator = iterator;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    compressed_qualities()  = default; //!< Defaulted.
+    ~compressed_qualities() = default; //!< Defaulted.
+
+    //!\brief Copy the compressed data (not the cached decoder).
+    compressed_qualities(compressed_qualities const & other) :
+      data{other.data}, block_offsets{other.block_offsets}, block_first_record{other.block_first_record}
+    {}
+
+    //!\brief Move the compressed data (not the cached decoder).
+    compressed_qualities(compressed_qualities && other) noexcept :
+      data{std::move(other.data)},
+      block_offsets{std::move(other.block_offsets)},
+      block_first_record{std::move(other.block_first_record)}
+    {
+        other.cache.reset();
+    }
+
+    //!\brief Copy the compressed data (not the cached decoder).
+    compressed_qualities & operator=(compressed_qualities const & other)
+    {
+        if (this != &other)
+        {
+            data               = other.data;
+            block_offsets      = other.block_offsets;
+            block_first_record = other.block_first_record;
+            cache.reset();
+        }
+        return *this;
+    }
+
+    //!\brief Move the compressed data (not the cached decoder).
+    compressed_qualities & operator=(compressed_qualities && other) noexcept
+    {
+        if (this != &other)
+        {
+            data               = std::move(other.data);
+            block_offsets      = std::move(other.block_offsets);
+            block_first_record = std::move(other.block_first_record);
+            cache.reset();
+            other.cache.reset();
+        }
+        return *this;
+    }
+
+    //!\brief The default number of letters per block.
+    static constexpr size_t default_block_size = 1ull << 18;
+
+    /*!\brief Compress a range of strings.
+     * \param[in] records    The strings; a range of ranges over `alphabet_type`.
+     * \param[in] block_size The number of letters after which a new block is started.
+     * \throws std::invalid_argument If `block_size` is 0.
+     *
+     * \details
+     *
+     * A block contains at least one record, so a single record longer than `block_size` forms its own block.
+     */
+    template <std::ranges::input_range rng_t>
+        requires(std::ranges::input_range<std::ranges::range_reference_t<rng_t>> &&
+                 std::convertible_to<std::ranges::range_reference_t<std::ranges::range_reference_t<rng_t>>,
+                                     alphabet_type>)
+    explicit compressed_qualities(rng_t && records, size_t const block_size = default_block_size)
+    {
+        if (block_size == 0)
+            throw std::invalid_argument{"The block size of compressed_qualities must be greater than 0."};
+
+        std::vector<uint8_t> ranks;
+        std::vector<size_t>  lengths;
+        ranks.reserve(block_size);
+
+        for (auto && record : records)
+        {
+            size_t const before = ranks.size();
+            for (alphabet_type const l : record)
+                ranks.push_back(static_cast<uint8_t>(alphabet::to_rank(l)));
+            lengths.push_back(ranks.size() - before);
+
+            if (ranks.size() >= block_size)
+            {
+                append_block(ranks, lengths);
+                ranks.clear();
+                lengths.clear();
+            }
+        }
+
+        if (!lengths.empty())
+            append_block(ranks, lengths);
+
+        data.shrink_to_fit();
+    }
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first record.
+    iterator begin() const noexcept { return iterator{*this, 0}; }
+    //!\copydoc begin()
+    iterator cbegin() const noexcept { return begin(); }
+
+    //!\brief Returns an iterator behind the last record.
+    iterator end() const noexcept { return iterator{*this, size()}; }
+    //!\copydoc end()
+    iterator cend() const noexcept { return end(); }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    /*!\brief Decode and return the i-th record.
+     * \param[in] i The record number; must be smaller than size().
+     * \returns The record by value.
+     *
+     * \details
+     *
+     * ### Complexity
+     *
+     * Linear in the length of the record and of at most seven preceding records. If the record is not in the most
+     * recently accessed block, the decoding tables of its block are built first (linear in the number of records of
+     * the block and in the number of contexts that occur).
+     */
+    value_type operator[](size_type const i) const
+    {
+        assert(i < size());
+
+        size_t const                               b = block_of(i);
+        std::shared_ptr<block_decoder const> const d = decoder_of(b);
+
+        std::vector<uint8_t>           buffer;
+        std::span<uint8_t const> const ranks = d->decoder.decode_record(i - block_first_record[b], buffer);
+
+        value_type ret(ranks.size());
+        ranks_to_letters(ranks, ret.data());
+        return ret;
+    }
+
+    //!\brief Decode and return the i-th record.
+    //!\throws std::out_of_range If `i >= size()`.
+    value_type at(size_type const i) const
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in compressed_qualities."};
+        return (*this)[i];
+    }
+
+    //!\brief Decode and return the first record.
+    value_type front() const
+    {
+        assert(size() > 0);
+        return (*this)[0];
+    }
+
+    //!\brief Decode and return the last record.
+    value_type back() const
+    {
+        assert(size() > 0);
+        return (*this)[size() - 1];
+    }
+
+    /*!\brief Decode a whole block and append its records to `out`.
+     * \param[in]  b   The block number; must be smaller than block_count().
+     * \param[out] out The records of the block are appended to this.
+     */
+    template <typename out_t>
+        requires std::same_as<std::ranges::range_value_t<decltype(std::declval<out_t &>().raw_data().first)>,
+                              alphabet_type>
+    void decode_block(size_type const b, out_t & out) const
+    {
+        assert(b < block_count());
+
+        std::vector<size_t>   lengths;
+        uint8_t const * const ptr = read_lengths(b, lengths);
+
+        std::vector<uint8_t> ranks(std::accumulate(lengths.begin(), lengths.end(), size_t{0}));
+        detail::rans_order1::decode(ptr, data.data() + block_offsets[b + 1], lengths, sigma, ranks.data());
+
+        auto && [values, delimiters] = out.raw_data();
+        size_t const old_size        = values.size();
+        values.resize(old_size + ranks.size());
+        ranks_to_letters(ranks, values.data() + old_size);
+
+        for (size_t const len : lengths)
+            delimiters.push_back(delimiters.back() + len);
+    }
+
+    //!\brief Decode all records.
+    concatenated_sequences<std::vector<alphabet_type>> decode() const
+    {
+        concatenated_sequences<std::vector<alphabet_type>> ret;
+        ret.concat_reserve(letter_count());
+        ret.reserve(size());
+        for (size_t b = 0; b < block_count(); ++b)
+            decode_block(b, ret);
+        return ret;
+    }
+    //!\}
+
+    /*!\name Capacity and index
+     * \{
+     */
+    //!\brief The number of records.
+    size_type size() const noexcept { return block_first_record.back(); }
+
+    //!\brief Whether the container holds no records.
+    bool empty() const noexcept { return size() == 0; }
+
+    //!\brief The number of blocks.
+    size_type block_count() const noexcept { return block_offsets.size() - 1; }
+
+    //!\brief The size of the compressed data in bytes (excluding the index).
+    size_type compressed_size() const noexcept { return data.size(); }
+
+    //!\brief The total number of letters in all records (decodes the record lengths).
+    size_type letter_count() const
+    {
+        size_t ret = 0;
+        for (size_t b = 0; b < block_count(); ++b)
+        {
+            uint8_t const *       ptr = data.data() + block_offsets[b];
+            uint8_t const * const end = data.data() + block_offsets[b + 1];
+            for (size_t r = block_first_record[b]; r < block_first_record[b + 1]; ++r)
+                ret += detail::read_varint(ptr, end);
+        }
+        return ret;
+    }
+
+    /*!\brief The block that contains record `i`.
+     * \details
+     *
+     * ### Complexity
+     *
+     * Logarithmic in the number of blocks.
+     */
+    size_type block_of(size_type const i) const noexcept
+    {
+        assert(i < size());
+        return std::ranges::upper_bound(block_first_record, i) - block_first_record.begin() - 1;
+    }
+    //!\}
+
+    //!\brief Compares the compressed data.
+    bool operator==(compressed_qualities const & rhs) const noexcept
+    {
+        return data == rhs.data && block_offsets == rhs.block_offsets && block_first_record == rhs.block_first_record;
+    }
+
+    /*!\cond DEV
+     * \brief Serialisation support function.
+     * \tparam archive_t Type of `archive`; must satisfy bio::typename.
+     * \param archive The archive being serialised from/to.
+     *
+     * \attention These functions are never called directly, see \ref howto_use_cereal for more details.
+     */
+    template <typename archive_t>
+    void serialize(archive_t & archive)
+    {
+        archive(data, block_offsets, block_first_record);
+        cache.reset();
+    }
+    //!\endcond
+};
+
+} // namespace bio::ranges
@@ -13,13 +13,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iterator>
+#include <memory_resource>
 #include <ranges>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <bio/ranges/container/concept.hpp>
+#include <bio/ranges/detail/container_slice.hpp>
 #include <bio/ranges/detail/random_access_iterator.hpp>
 #include <bio/ranges/views/repeat_n.hpp>
 #include <bio/ranges/views/slice.hpp>
@@ -90,14 +93,26 @@ protected:
     //!\brief Where the delimiters are stored; begins with 0, has size of size() + 1.
     data_delimiters_type                    data_delimiters{0};
 
+    //!\brief Create an empty container that uses the same allocator as `c` (if it has one).
+    template <typename container_t>
+    static container_t make_empty(container_t const & c)
+    {
+        if constexpr (requires { container_t(c.get_allocator()); })
+            return container_t(c.get_allocator());
+        else
+            return container_t{};
+    }
+
 public:
     //!\publicsection
     /*!\name Member types
      * \{
      */
-    //!\brief A views::slice that represents "one element", typically a std::span.
+    //!\brief A views::slice that represents "one element", typically a std::span (a bio::ranges::bitcompressed_slice
+    //!       if the underlying container is a bio::ranges::bitcompressed_vector).
     //!\hideinitializer
-    using value_type = decltype(std::declval<std::decay_t<underlying_container_type> &>() | views::slice(0, 1));
+    using value_type =
+      decltype(detail::container_slice(std::declval<std::decay_t<underlying_container_type> &>(), 0, 1));
 
     //!\brief A proxy of type views::slice that represents the range on the concatenated vector.
     //!\hideinitializer
@@ -105,7 +120,7 @@ public:
 
     //!\brief An immutable proxy of type views::slice that represents the range on the concatenated vector.
     //!\hideinitializer
-    using const_reference = decltype(std::as_const(data_values) | views::slice(0, 1));
+    using const_reference = decltype(detail::container_slice(std::as_const(data_values), 0, 1));
 
     //!\brief The iterator type of this container (a random access iterator).
     //!\hideinitializer
@@ -184,6 +199,32 @@ public:
     //!\brief Default constructors.
     ~concatenated_sequences()                                                        = default;
 
+    /*!\brief Construct an empty container whose underlying containers use the given allocator.
+     * \tparam alloc_t An allocator type that both underlying containers can be constructed from (after conversion).
+     * \param alloc The allocator.
+     *
+     * \details
+     *
+     * This can be used to allocate from a std::pmr::memory_resource like bio::ranges::arena_resource, see
+     * bio::ranges::pmr::concatenated_sequences.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * Throws if the allocation of the first delimiter fails.
+     */
+    template <typename alloc_t>
+        requires(requires(alloc_t & a) { a.allocate(size_t{1}); } &&
+                 std::constructible_from<std::decay_t<underlying_container_type>, alloc_t const &> &&
+                 std::constructible_from<data_delimiters_type, alloc_t const &>)
+    explicit concatenated_sequences(alloc_t const & alloc) : data_values(alloc), data_delimiters(alloc)
+    {
+        data_delimiters.push_back(0);
+    }
+
     /*!\brief Construct/assign from a different range.
      * \tparam rng_of_rng_type The type of range to be inserted; must satisfy
      *         \ref range_value_t_is_compatible_with_value_type.
@@ -481,14 +522,14 @@ public:
     reference operator[](size_type const i)
     {
         assert(i < size());
-        return data_values | views::slice(data_delimiters[i], data_delimiters[i + 1]);
+        return detail::container_slice(data_values, data_delimiters[i], data_delimiters[i + 1]);
     }
 
     //!\copydoc operator[]()
     const_reference operator[](size_type const i) const
     {
         assert(i < size());
-        return data_values | views::slice(data_delimiters[i], data_delimiters[i + 1]);
+        return detail::container_slice(data_values, data_delimiters[i], data_delimiters[i + 1]);
     }
 
     /*!\brief Return the first element as a view. Calling front on an empty container is undefined.
@@ -555,10 +596,10 @@ public:
      *
      * Strong exception guarantee (never modifies data).
      */
-    reference concat() { return data_values | views::slice(static_cast<size_type>(0), concat_size()); }
+    reference concat() { return detail::container_slice(data_values, 0, concat_size()); }
 
     //!\copydoc concat()
-    const_reference concat() const { return data_values | views::slice(static_cast<size_type>(0), concat_size()); }
+    const_reference concat() const { return detail::container_slice(data_values, 0, concat_size()); }
 
     /*!\brief Provides direct, unsafe access to underlying data structures.
      * \returns An std::pair of the concatenated sequences and the delimiter string.
@@ -1232,6 +1273,89 @@ public:
     }
     //!\}
 
+    /*!\name Operations
+     * \brief Like std::list, this container provides member functions for operations that the standard algorithms
+     * cannot perform on it (because its elements are views). Sorting and removing duplicates are provided by
+     * bio/ranges/container/concatenated_sequences_sort.hpp.
+     * \{
+     */
+    /*!\brief Reorder the elements by a sequence of positions.
+     * \tparam order_t Type of the positions; must model std::ranges::forward_range over std::integral values.
+     * \param[in] order The positions of the current elements in the order they shall appear.
+     *
+     * \details
+     *
+     * After this call, the i-th element is the element that was previously at position `order[i]`. The positions
+     * need not be a permutation, i.e. elements can be dropped or repeated. This can be used to sort by an external
+     * key: sort a vector of positions by the key and pass it to this function.
+     *
+     * The new concatenation is built in a single pass with only one extra copy of the data (instead of one
+     * container per element); afterwards it replaces the old one.
+     *
+     * All iterators and references are invalidated.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `order` plus the new concat_size().
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee (no data is modified in case an exception is thrown).
+     */
+    template <std::ranges::forward_range order_t>
+        requires std::integral<std::ranges::range_value_t<order_t>>
+    void permute(order_t && order)
+    {
+        // new containers use the same allocators as the current ones
+        auto new_values     = make_empty(data_values);
+        auto new_delimiters = make_empty(data_delimiters);
+        new_delimiters.push_back(0);
+
+        size_type new_concat_size = 0;
+        for (auto const i : order)
+        {
+            assert(static_cast<size_type>(i) < size());
+            new_concat_size += data_delimiters[i + 1] - data_delimiters[i];
+        }
+
+        if constexpr (std::ranges::sized_range<order_t>)
+            new_delimiters.reserve(std::ranges::size(order) + 1);
+
+        if constexpr (requires { new_values.append_packed(data_values.packed_ranks(0, 0), 0); })
+        {
+            // packed storage: copy whole words instead of single letters
+            constexpr size_type lpw = std::decay_t<underlying_container_type>::letters_per_word;
+            new_values.reserve(new_concat_size);
+            for (auto const i : order)
+            {
+                auto const b = data_delimiters[i];
+                auto const e = data_delimiters[i + 1];
+                for (size_type p = b; p < e; p += lpw)
+                {
+                    size_type const count = std::min<size_type>(lpw, e - p);
+                    new_values.append_packed(data_values.packed_ranks(p, count), count);
+                }
+                new_delimiters.push_back(new_delimiters.back() + (e - b));
+            }
+        }
+        else
+        {
+            new_values.resize(new_concat_size);
+            auto out = std::ranges::begin(new_values);
+            for (auto const i : order)
+            {
+                auto const b = data_delimiters[i];
+                auto const e = data_delimiters[i + 1];
+                out = std::copy(std::ranges::begin(data_values) + b, std::ranges::begin(data_values) + e, out);
+                new_delimiters.push_back(new_delimiters.back() + (e - b));
+            }
+        }
+
+        std::swap(data_values, new_values);
+        std::swap(data_delimiters, new_delimiters);
+    }
+    //!\}
+
     /*!\name Comparison operators
      * \{
      */
@@ -1276,4 +1400,22 @@ public:
     //!\endcond
 };
 
+namespace pmr
+{
+
+/*!\brief A bio::ranges::concatenated_sequences whose delimiters are stored in a std::pmr::vector.
+ * \ingroup container
+ * \details
+ *
+ * The underlying container should also allocate from a std::pmr::memory_resource, e.g. `std::pmr::vector` or
+ * bio::ranges::pmr::bitcompressed_vector. Construct the container with a std::pmr::polymorphic_allocator to
+ * make both allocate from the same resource.
+ */
+template <typename underlying_container_type>
+using concatenated_sequences =
+  bio::ranges::concatenated_sequences<underlying_container_type,
+                                      std::pmr::vector<typename underlying_container_type::size_type>>;
+
+} // namespace pmr
+
 } // namespace bio::ranges
@@ -0,0 +1,323 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::concatenated_sequences_builder.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <bio/ranges/container/concatenated_sequences.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief A builder that fills a bio::ranges::concatenated_sequences from multiple threads without locking.
+ * \tparam underlying_container_type Type of the underlying container; must model std::ranges::contiguous_range.
+ * \tparam data_delimiters_type The delimiter type of the resulting bio::ranges::concatenated_sequences.
+ * \ingroup container
+ *
+ * \details
+ *
+ * The builder is created with a fixed capacity for the number of sequences and for the total number of letters.
+ * The letter storage is allocated once on construction and never moves afterwards, so that any number of threads
+ * can write into it concurrently. Threads reserve space by atomically bumping two cursors, one for the sequence slots
+ * (the delimiters) and one for the letters (the values):
+ *
+ * * #push_back() reserves exactly one slot and the letters of one sequence and copies the sequence.
+ * * #reserve() reserves a bio::ranges::concatenated_sequences_builder::segment of multiple slots and letters that
+ *   the calling thread can then fill without any further synchronisation (e.g. one parsed record batch).
+ *
+ * Once all threads are done, #finalize() moves the storage into a regular bio::ranges::concatenated_sequences.
+ * The letters are not copied; only the delimiters are brought into order.
+ *
+ * The order of the sequences in the resulting container is the order in which the letter space was reserved, i.e.
+ * it is not deterministic if multiple threads are involved. Sequences from the same segment are always stored
+ * consecutively and in the order they were added to the segment.
+ *
+ * \attention
+ * Concurrent writes to adjacent elements must be safe for the underlying container, so bit-compressed containers
+ * like bio::ranges::bitcompressed_vector cannot be used here.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/concatenated_sequences_builder.cpp
+ *
+ * ### Thread safety
+ *
+ * #push_back(), #reserve(), #size() and #concat_size() may be called concurrently. Segments returned by #reserve()
+ * may only be used by one thread at a time. #finalize() must not be called concurrently with any other member
+ * function and all segments must have been filled completely before it is called.
+ */
+template <typename underlying_container_type,
+          typename data_delimiters_type = std::vector<typename underlying_container_type::size_type>>
+    requires(std::ranges::contiguous_range<underlying_container_type> &&
+             detail::reservible_container<underlying_container_type> &&
+             detail::reservible_container<data_delimiters_type> &&
+             std::is_same_v<std::ranges::range_size_t<underlying_container_type>,
+                            std::ranges::range_value_t<data_delimiters_type>>)
+class concatenated_sequences_builder
+{
+public:
+    /*!\name Member types
+     * \{
+     */
+    //!\brief The type returned by #finalize().
+    using result_type = concatenated_sequences<underlying_container_type, data_delimiters_type>;
+    //!\brief An unsigned integer type (usually std::size_t)
+    using size_type   = std::ranges::range_size_t<data_delimiters_type>;
+    //!\brief The letter type.
+    using letter_type = std::ranges::range_value_t<underlying_container_type>;
+    //!\}
+
+private:
+    //!\brief Marks slots that were reserved but never written to.
+    static constexpr size_type unused_slot = std::numeric_limits<size_type>::max();
+
+    //!\brief The letter storage; sized to the concat capacity on construction.
+    underlying_container_type data_values;
+    //!\brief The begin positions of the sequences, indexed by slot (unordered).
+    data_delimiters_type      data_begins;
+
+    //!\brief The next free slot.
+    std::atomic<size_type> slot_cursor{0};
+    //!\brief The next free letter position.
+    std::atomic<size_type> value_cursor{0};
+
+    //!\brief Atomically advance `cursor` by `n` if this does not exceed `cap`; returns the old position.
+    static size_type bump(std::atomic<size_type> & cursor, size_type const n, size_type const cap)
+    {
+        size_type cur = cursor.load(std::memory_order_relaxed);
+        do
+        {
+            if (n > cap - cur)
+                throw std::length_error{"Capacity of concatenated_sequences_builder exceeded."};
+        }
+        while (!cursor.compare_exchange_weak(cur, cur + n, std::memory_order_relaxed));
+        return cur;
+    }
+
+    //!\brief Whether a range can be stored as one sequence.
+    template <typename rng_type>
+    static constexpr bool is_compatible =
+      std::ranges::forward_range<rng_type> &&
+      std::convertible_to<std::ranges::range_reference_t<rng_type>, letter_type>;
+
+public:
+    /*!\brief A reserved block of consecutive slots and letters that is filled by a single thread.
+     *
+     * \details
+     *
+     * Segments are returned by bio::ranges::concatenated_sequences_builder::reserve(). They must be filled with
+     * exactly the number of sequences and letters that were requested.
+     */
+    class segment
+    {
+    private:
+        //!\brief The host.
+        concatenated_sequences_builder * host = nullptr;
+        //!\brief The next slot to write to.
+        size_type                        slot = 0;
+        //!\brief One past the last slot of this segment.
+        size_type                        slot_end = 0;
+        //!\brief The next letter position to write to.
+        size_type                        pos = 0;
+        //!\brief One past the last letter position of this segment.
+        size_type                        pos_end = 0;
+
+        //!\brief Befriend the host so it can construct this type.
+        friend concatenated_sequences_builder;
+
+        //!\brief Construct from host and the reserved ranges.
+        segment(concatenated_sequences_builder * const host_,
+                size_type const                        slot_,
+                size_type const                        slot_end_,
+                size_type const                        pos_,
+                size_type const                        pos_end_) noexcept :
+          host{host_}, slot{slot_}, slot_end{slot_end_}, pos{pos_}, pos_end{pos_end_}
+        {}
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        segment() noexcept                            = default; //!< Defaulted.
+        segment(segment const &) noexcept             = default; //!< Defaulted.
+        segment(segment &&) noexcept                  = default; //!< Defaulted.
+        segment & operator=(segment const &) noexcept = default; //!< Defaulted.
+        segment & operator=(segment &&) noexcept      = default; //!< Defaulted.
+        ~segment() noexcept                           = default; //!< Defaulted.
+        //!\}
+
+        /*!\brief Copy a sequence into the next slot of the segment.
+         * \tparam rng_type A std::ranges::forward_range whose elements are convertible to the letter type.
+         * \param[in] value The sequence to add.
+         *
+         * \details
+         *
+         * The caller must make sure that the segment still has a free slot and that the sequence fits into the
+         * remaining letters of the segment (checked by assertions only).
+         *
+         * ### Complexity
+         *
+         * Linear in the size of `value`.
+         */
+        template <typename rng_type>
+            requires is_compatible<rng_type>
+        void push_back(rng_type && value)
+        {
+            size_type const len = std::ranges::distance(value);
+            assert(host != nullptr);
+            assert(slot < slot_end);
+            assert(len <= pos_end - pos);
+
+            host->data_begins[slot++] = pos;
+            std::ranges::copy(value, std::ranges::begin(host->data_values) + pos);
+            pos += len;
+        }
+
+        //!\brief The number of slots that have not been written to, yet.
+        size_type remaining_size() const noexcept { return slot_end - slot; }
+
+        //!\brief The number of letters that have not been written to, yet.
+        size_type remaining_concat_size() const noexcept { return pos_end - pos; }
+    };
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    concatenated_sequences_builder()                                                   = delete; //!< Deleted.
+    concatenated_sequences_builder(concatenated_sequences_builder const &)             = delete; //!< Deleted.
+    concatenated_sequences_builder(concatenated_sequences_builder &&)                  = delete; //!< Deleted.
+    concatenated_sequences_builder & operator=(concatenated_sequences_builder const &) = delete; //!< Deleted.
+    concatenated_sequences_builder & operator=(concatenated_sequences_builder &&)      = delete; //!< Deleted.
+    ~concatenated_sequences_builder()                                                  = default; //!< Defaulted.
+
+    /*!\brief Construct with a fixed capacity.
+     * \param[in] capacity        The maximum number of sequences.
+     * \param[in] concat_capacity The maximum number of letters summed over all sequences.
+     *
+     * ### Complexity
+     *
+     * Linear in `capacity` and `concat_capacity` (the storage is allocated and initialised).
+     */
+    concatenated_sequences_builder(size_type const capacity, size_type const concat_capacity)
+    {
+        data_values.resize(concat_capacity);
+        data_begins.resize(capacity, unused_slot);
+    }
+    //!\}
+
+    /*!\brief Reserve a segment of consecutive slots and letters.
+     * \param[in] count        The number of sequences in the segment.
+     * \param[in] concat_count The number of letters summed over the sequences in the segment.
+     * \returns A bio::ranges::concatenated_sequences_builder::segment that the sequences can be pushed to.
+     * \throws std::length_error If the remaining capacity is not sufficient.
+     *
+     * ### Complexity
+     *
+     * Constant (lock-free).
+     *
+     * ### Thread safety
+     *
+     * Thread-safe.
+     */
+    segment reserve(size_type const count, size_type const concat_count)
+    {
+        // slots are reserved first, so that a failed letter reservation does not leave a gap in the letters
+        size_type const slot = bump(slot_cursor, count, data_begins.size());
+        size_type const pos  = bump(value_cursor, concat_count, data_values.size());
+        return segment{this, slot, slot + count, pos, pos + concat_count};
+    }
+
+    /*!\brief Copy one sequence into the builder.
+     * \tparam rng_type A std::ranges::forward_range whose elements are convertible to the letter type.
+     * \param[in] value The sequence to add.
+     * \throws std::length_error If the remaining capacity is not sufficient.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `value`.
+     *
+     * ### Thread safety
+     *
+     * Thread-safe.
+     */
+    template <typename rng_type>
+        requires is_compatible<rng_type>
+    void push_back(rng_type && value)
+    {
+        reserve(1, std::ranges::distance(value)).push_back(std::forward<rng_type>(value));
+    }
+
+    //!\brief The number of slots reserved so far.
+    size_type size() const noexcept { return slot_cursor.load(std::memory_order_relaxed); }
+
+    //!\brief The number of letters reserved so far.
+    size_type concat_size() const noexcept { return value_cursor.load(std::memory_order_relaxed); }
+
+    //!\brief The maximum number of sequences.
+    size_type capacity() const noexcept { return data_begins.size(); }
+
+    //!\brief The maximum number of letters.
+    size_type concat_capacity() const noexcept { return data_values.size(); }
+
+    /*!\brief Move the data into a bio::ranges::concatenated_sequences.
+     * \returns The finished container.
+     *
+     * \details
+     *
+     * The letter storage is moved into the result and shrunk to the used size; it is not copied. Slots that were
+     * reserved but not written to (e.g. because a letter reservation failed) are dropped.
+     *
+     * After this call, the builder is empty and has no capacity.
+     *
+     * ### Complexity
+     *
+     * Linear in the number of sequences if only one thread added sequences; \f$O(n \log n)\f$ otherwise.
+     *
+     * ### Thread safety
+     *
+     * Not thread-safe.
+     */
+    result_type finalize() &&
+    {
+        result_type ret;
+        auto && [values, delimiters] = ret.raw_data();
+
+        data_values.resize(value_cursor.load(std::memory_order_relaxed));
+        values = std::move(data_values);
+
+        data_begins.resize(slot_cursor.load(std::memory_order_relaxed));
+        if (!std::ranges::is_sorted(data_begins))
+            std::ranges::sort(data_begins);
+        while (!data_begins.empty() && data_begins.back() == unused_slot)
+            data_begins.pop_back();
+        data_begins.push_back(values.size());
+        delimiters = std::move(data_begins);
+
+        data_values = underlying_container_type{};
+        data_begins = data_delimiters_type{};
+        slot_cursor.store(0, std::memory_order_relaxed);
+        value_cursor.store(0, std::memory_order_relaxed);
+        return ret;
+    }
+};
+
+} // namespace bio::ranges
@@ -0,0 +1,154 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::sort_sequences and bio::ranges::unique_sequences.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/detail/concatenated_sequences_sort.hpp>
+#include <bio/ranges/hash.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+namespace bio::ranges::detail
+{
+
+//!\brief Implementation of bio::ranges::sort_sequences(); `pool` may be `nullptr`.
+template <typename underlying_container_type, typename data_delimiters_type>
+void sort_sequences_impl(concatenated_sequences<underlying_container_type, data_delimiters_type> & seqs,
+                         thread_pool * const                                                     pool)
+{
+    using size_type = typename concatenated_sequences<underlying_container_type, data_delimiters_type>::size_type;
+
+    auto && [values, delimiters] = std::as_const(seqs).raw_data();
+    std::vector<size_type> order(seqs.size());
+    std::iota(order.begin(), order.end(), size_type{0});
+    sort_lexicographically(values, delimiters, order, pool);
+
+    if (!std::ranges::is_sorted(order))
+        seqs.permute(order);
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Sort the elements of a bio::ranges::concatenated_sequences lexicographically.
+ * \ingroup container
+ * \tparam underlying_container_type The underlying container; its reference type must model
+ *                                   bio::alphabet::semialphabet.
+ * \tparam data_delimiters_type      The container of the delimiters.
+ * \param[in,out] seqs The sequences.
+ *
+ * \details
+ *
+ * Elements are compared by the ranks of their letters; a shorter element that is a prefix of a longer element
+ * is ordered first. The order of the positions is computed by an MSD radix sort over the ranks and applied via
+ * bio::ranges::concatenated_sequences::permute(). If the underlying container is a
+ * bio::ranges::bitcompressed_vector, common prefixes and comparisons are processed on packed words instead of single
+ * letters.
+ *
+ * All iterators and references are invalidated.
+ *
+ * ### Complexity
+ *
+ * Linear in the concat_size() (times the alphabet size) for the radix passes. Alphabets with more than 256 letters
+ * are sorted by comparison sort.
+ *
+ * ### Exceptions
+ *
+ * Strong exception guarantee (no data is modified in case an exception is thrown).
+ */
+template <typename underlying_container_type, typename data_delimiters_type>
+    requires alphabet::semialphabet<std::ranges::range_reference_t<underlying_container_type>>
+void sort_sequences(concatenated_sequences<underlying_container_type, data_delimiters_type> & seqs)
+{
+    detail::sort_sequences_impl(seqs, nullptr);
+}
+
+/*!\brief Sort the elements of a bio::ranges::concatenated_sequences lexicographically, using the threads of a pool.
+ * \ingroup container
+ * \param[in,out] seqs The sequences.
+ * \param[in]     pool The thread pool.
+ *
+ * \details
+ *
+ * Like bio::ranges::sort_sequences(seqs), but the top-level buckets are sorted as tasks of the pool. May be called
+ * from within a task of the same pool.
+ */
+template <typename underlying_container_type, typename data_delimiters_type>
+    requires alphabet::semialphabet<std::ranges::range_reference_t<underlying_container_type>>
+void sort_sequences(concatenated_sequences<underlying_container_type, data_delimiters_type> & seqs,
+                    thread_pool &                                                           pool)
+{
+    detail::sort_sequences_impl(seqs, &pool);
+}
+
+/*!\brief Remove all duplicate elements of a bio::ranges::concatenated_sequences.
+ * \ingroup container
+ * \tparam underlying_container_type The underlying container; its reference type must model
+ *                                   bio::alphabet::semialphabet.
+ * \tparam data_delimiters_type      The container of the delimiters.
+ * \param[in,out] seqs The sequences.
+ * \returns The number of elements removed.
+ *
+ * \details
+ *
+ * In contrast to std::list::unique(), duplicates need not be adjacent: they are detected via a hash table.
+ * The first occurrence of every element is kept and the relative order of the kept elements is preserved.
+ *
+ * All iterators and references are invalidated if any elements are removed.
+ *
+ * ### Complexity
+ *
+ * Linear in the concat_size() on average.
+ *
+ * ### Exceptions
+ *
+ * Strong exception guarantee (no data is modified in case an exception is thrown).
+ */
+template <typename underlying_container_type, typename data_delimiters_type>
+    requires alphabet::semialphabet<std::ranges::range_reference_t<underlying_container_type>>
+size_t unique_sequences(concatenated_sequences<underlying_container_type, data_delimiters_type> & seqs)
+{
+    using seqs_t          = concatenated_sequences<underlying_container_type, data_delimiters_type>;
+    using size_type       = typename seqs_t::size_type;
+    using const_reference = typename seqs_t::const_reference;
+
+    seqs_t const & cseqs = seqs;
+    auto           hash  = [&cseqs](size_type const i) { return std::hash<const_reference>{}(cseqs[i]); };
+    auto           eq    = [&cseqs](size_type const i, size_type const j)
+    { return std::ranges::equal(cseqs[i], cseqs[j]); };
+
+    std::unordered_set<size_type, decltype(hash), decltype(eq)> seen{seqs.size(), hash, eq};
+    std::vector<size_type>                                      keep;
+    keep.reserve(seqs.size());
+    for (size_type i = 0; i < seqs.size(); ++i)
+        if (seen.insert(i).second)
+            keep.push_back(i);
+
+    size_t const removed = seqs.size() - keep.size();
+    if (removed > 0)
+        seqs.permute(keep);
+    return removed;
+}
+
+} // namespace bio::ranges
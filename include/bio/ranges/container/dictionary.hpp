@@ -16,9 +16,12 @@
 #include <array>
 #include <concepts>
 #include <initializer_list>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #if __has_include(<cereal/types/vector.hpp>)
 #    include <cereal/types/vector.hpp>
@@ -90,7 +93,7 @@ namespace bio::ranges
  * \include test/snippet/ranges/container/dictionary_het.cpp
  *
  */
-template <typename key_t, typename mapped_t>
+template <typename key_t, typename mapped_t, typename allocator_t = std::allocator<meta::tuple<key_t, mapped_t>>>
 class dictionary
 {
 public:
@@ -111,10 +114,8 @@ public:
     using const_iterator  = detail::random_access_iterator<dictionary const>; //!< The const_iterator type.
     //!\}
 
-    //!\cond
-    // this signals to range-v3 that something is a container :|
-    using allocator_type = void;
-    //!\endcond
+    //!\brief The allocator type (rebound to value_type).
+    using allocator_type = typename std::allocator_traits<allocator_t>::template rebind_alloc<value_type>;
 
     /*!\name Constructors, destructor and assignment
      * \{
@@ -126,6 +127,24 @@ public:
     dictionary & operator=(dictionary &&) noexcept = default; //!< Defaulted.
     ~dictionary()                                  = default; //!< Defaulted.
 
+    /*!\brief Construct an empty dictionary that uses the given allocator.
+     * \param[in] alloc The allocator; used for the element storage and for the hash table.
+     *
+     * \details
+     *
+     * This can be used to allocate from a std::pmr::memory_resource like bio::ranges::arena_resource, see
+     * bio::ranges::pmr::dictionary. Note that the keys and mapped values allocate through their own allocators.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * Throws if the hash table's allocation fails.
+     */
+    explicit dictionary(allocator_type const & alloc) : storage(alloc), key_to_index(alloc) {}
+
     /*!\brief Construct from a list of values of value_type.
      * \param[in] list The values to construct from.
      *
@@ -704,6 +723,9 @@ public:
      */
     size_type max_size() const noexcept { return storage.max_size(); }
 
+    //!\brief Returns a copy of the allocator.
+    allocator_type get_allocator() const noexcept { return storage.get_allocator(); }
+
     /*!\brief Returns the number of elements that the container is able to hold without reallocating (*see below*).
      * \returns The capacity of the currently allocated storage.
      *
@@ -906,9 +928,14 @@ private:
     };
 
     //!\brief Stores the elements.
-    std::vector<value_type>                                   storage;
+    std::vector<value_type, allocator_type> storage;
     //!\brief Map from key to index in storage.
-    std::unordered_map<key_t, size_t, hash_string, eq_string> key_to_index;
+    std::unordered_map<key_t,
+                       size_t,
+                       hash_string,
+                       eq_string,
+                       typename std::allocator_traits<allocator_t>::template rebind_alloc<std::pair<key_t const, size_t>>>
+      key_to_index;
 
     //!\brief Recompute the hash table.
     void recompute_hashes()
@@ -958,4 +985,16 @@ public:
     //!\endcond
 };
 
+namespace pmr
+{
+
+/*!\brief A bio::ranges::dictionary that allocates from a std::pmr::memory_resource.
+ * \ingroup container
+ */
+template <typename key_t, typename mapped_t>
+using dictionary =
+  bio::ranges::dictionary<key_t, mapped_t, std::pmr::polymorphic_allocator<meta::tuple<key_t, mapped_t>>>;
+
+} // namespace pmr
+
 } // namespace bio::ranges
@@ -0,0 +1,174 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::page_allocator.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <bio/core.hpp>
+#include <bio/ranges/container/aligned_allocator.hpp>
+#include <bio/ranges/detail/page_memory.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief Allocates large blocks of memory directly from the operating system, with huge pages and/or a NUMA
+ *        placement.
+ * \tparam value_t     The value type of the allocation.
+ * \tparam policy_v    How memory is obtained from the operating system, see bio::ranges::memory_policy.
+ * \tparam alignment_v The memory-alignment of the allocation; defaults to `__STDCPP_DEFAULT_NEW_ALIGNMENT__`.
+ * \ingroup container
+ *
+ * \details
+ *
+ * Allocations of at least one page (one huge page if the policy selects huge pages) are mapped from the operating
+ * system according to `policy_v` and rounded up to whole pages. Smaller allocations, and all allocations on systems
+ * that do not support mapping memory, are served like those of bio::ranges::aligned_allocator. This is useful for
+ * indexes of a reference genome that are accessed randomly from many threads:
+ *
+ * \include test/snippet/ranges/container/page_allocator.cpp
+ *
+ * The allocator can be used with any container that accepts an allocator; bio::ranges::bitcompressed_vector and
+ * std::vector rebind it to their element type and bio::ranges::concatenated_sequences uses it via its
+ * underlying containers.
+ *
+ * This allocator is provided separately from bio::ranges::aligned_allocator, because it includes the operating
+ * system's headers for mapping memory.
+ *
+ * \see https://en.cppreference.com/w/cpp/named_req/Allocator
+ */
+template <typename value_t, memory_policy policy_v, size_t alignment_v = __STDCPP_DEFAULT_NEW_ALIGNMENT__>
+class page_allocator
+{
+public:
+    //!\brief How memory is obtained from the operating system.
+    static constexpr memory_policy policy    = policy_v;
+    //!\brief The memory-alignment of the allocation.
+    static constexpr size_t        alignment = alignment_v;
+
+    //!\brief The value type of the allocation.
+    using value_type      = value_t;
+    //!\brief The pointer type of the allocation.
+    using pointer         = value_type *;
+    //!\brief The difference type of the allocation.
+    using difference_type = typename std::pointer_traits<pointer>::difference_type;
+    //!\brief The size type of the allocation.
+    using size_type       = std::make_unsigned_t<difference_type>;
+
+    //!\brief Are any two allocators of the same page_allocator type always compare equal?
+    using is_always_equal = std::true_type;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    page_allocator() noexcept                                   = default; //!< Defaulted.
+    page_allocator(page_allocator const &) noexcept             = default; //!< Defaulted.
+    page_allocator(page_allocator &&) noexcept                  = default; //!< Defaulted.
+    page_allocator & operator=(page_allocator const &) noexcept = default; //!< Defaulted.
+    page_allocator & operator=(page_allocator &&) noexcept      = default; //!< Defaulted.
+    ~page_allocator() noexcept                                  = default; //!< Defaulted.
+
+    //!\brief Copy constructor with different value type and alignment.
+    template <class other_value_type, size_t other_alignment>
+    constexpr page_allocator(page_allocator<other_value_type, policy_v, other_alignment> const &) noexcept
+    {}
+    //!\}
+
+    /*!\brief Allocates sufficiently large memory to hold `n` many elements of `value_type`.
+     * \param[in] n The number of elements for which to allocate the memory.
+     * \returns The pointer to the first block of allocated memory.
+     * \throws std::bad_alloc If the allocation fails.
+     *
+     * \details
+     *
+     * If at least one page is requested, the memory is mapped from the operating system, otherwise
+     * bio::ranges::aligned_allocator::allocate() is called.
+     *
+     * ### Thread safety
+     *
+     * Thread-safe.
+     *
+     * ### Exception
+     *
+     * Strong exception guarantee.
+     */
+    [[nodiscard]] pointer allocate(size_type const n) const
+    {
+        constexpr size_type max_size = std::numeric_limits<size_type>::max() / sizeof(value_type);
+        if (n > max_size)
+            throw std::bad_alloc{};
+
+        size_t const bytes_to_allocate = n * sizeof(value_type);
+        if (detail::uses_page_memory<policy>(bytes_to_allocate))
+            return static_cast<pointer>(detail::map_pages<policy>(bytes_to_allocate, alignment));
+        else
+            return aligned_allocator<value_type, alignment>{}.allocate(n);
+    }
+
+    /*!\brief Deallocates the storage referenced by the pointer p, which must be a pointer obtained by an earlier call
+     * to bio::ranges::page_allocator::allocate.
+     * \param[in] p The pointer to the memory to be deallocated.
+     * \param[in] n The number of elements to be deallocated; must be equal to the argument of the call to
+     *              bio::ranges::page_allocator::allocate that originally produced `p`.
+     *
+     * ### Thread safety
+     *
+     * Thread-safe.
+     *
+     * ### Exception
+     *
+     * Nothrow guarantee.
+     */
+    void deallocate(pointer const p, size_type const n) const noexcept
+    {
+        size_t const bytes_to_deallocate = n * sizeof(value_type);
+        if (detail::uses_page_memory<policy>(bytes_to_deallocate))
+            detail::unmap_pages<policy>(p, bytes_to_deallocate);
+        else
+            aligned_allocator<value_type, alignment>{}.deallocate(p, n);
+    }
+
+    /*!\brief The page_allocator member template class page_allocator::rebind provides a way to obtain an
+     *        allocator for a different type.
+     * \tparam new_value_type The other value type.
+     *
+     * \details
+     *
+     * If the alignment of the new type exceeds the alignment of the current allocator, the larger alignment will
+     * be used. The policy is retained.
+     */
+    template <typename new_value_type>
+    struct rebind
+    {
+        //!\brief The alignment for the rebound allocator.
+        static constexpr size_t other_alignment = std::max(alignof(new_value_type), alignment);
+        //!\brief The type of the allocator for a different value type.
+        using other                             = page_allocator<new_value_type, policy_v, other_alignment>;
+    };
+
+    /*!\name Comparison operators
+     * \{
+     */
+    //!\brief Returns true if the policy and the memory-alignment match.
+    template <class value_type2, memory_policy policy2, size_t alignment2>
+    constexpr bool operator==(page_allocator<value_type2, policy2, alignment2> const &) noexcept
+    {
+        return policy == policy2 && alignment == alignment2;
+    }
+    //!\}
+};
+
+} // namespace bio::ranges
@@ -0,0 +1,376 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::record_batch.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/detail/container_slice.hpp>
+#include <bio/ranges/detail/random_access_iterator.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief The element type of bio::ranges::record_batch: views on the id, sequence and qualities of one record.
+ * \ingroup container
+ * \details
+ *
+ * This is an aggregate, so it can be used with structured bindings.
+ */
+template <typename id_t, typename seq_t, typename qual_t>
+struct record_view
+{
+    //!\brief The id.
+    id_t   id;
+    //!\brief The sequence.
+    seq_t  seq;
+    //!\brief The qualities; has the same size as the sequence.
+    qual_t qual;
+
+    //!\brief Converts to a record_view over other views, e.g. from mutable to immutable.
+    template <typename id2_t, typename seq2_t, typename qual2_t>
+        requires(!std::same_as<record_view, record_view<id2_t, seq2_t, qual2_t>> && std::convertible_to<id_t, id2_t> &&
+                 std::convertible_to<seq_t, seq2_t> && std::convertible_to<qual_t, qual2_t>)
+    operator record_view<id2_t, seq2_t, qual2_t>() const
+    {
+        return {id, seq, qual};
+    }
+
+    //!\brief Compares the contents.
+    friend bool operator==(record_view const & lhs, record_view const & rhs)
+    {
+        return std::ranges::equal(lhs.id, rhs.id) && std::ranges::equal(lhs.seq, rhs.seq) &&
+               std::ranges::equal(lhs.qual, rhs.qual);
+    }
+};
+
+/*!\brief A batch of sequencing records stored as struct of arrays.
+ * \tparam seq_container_t  Type of the container that stores all sequences concatenated.
+ * \tparam qual_container_t Type of the container that stores all qualities concatenated.
+ * \tparam id_container_t   Type of an id; the ids are stored in a bio::ranges::concatenated_sequences over it.
+ * \implements std::ranges::random_access_range
+ * \ingroup container
+ *
+ * \details
+ *
+ * Storing reads as `std::vector<record>` with a string, a sequence and a quality vector per record requires three
+ * allocations per record. This container stores the ids, the sequences and the qualities of all records in three
+ * concatenated columns instead. Sequences and qualities have the same lengths, so they share one set of delimiters.
+ *
+ * Elements are bio::ranges::record_view proxies that contain views on the id, sequence and qualities. The letters
+ * of sequences and qualities can be modified through them, but not the lengths; ids are read-only.
+ *
+ * clear() keeps all memory, so a batch can be recycled: once it has been filled with the largest batch, refilling
+ * it does not allocate.
+ *
+ * The columns are also available individually via ids(), seqs() and quals() (ranges of sequences) and via
+ * raw_data() (the concatenated storage, e.g. for SIMD kernels).
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/record_batch.cpp
+ *
+ * ### Thread safety
+ *
+ * This container provides no thread-safety beyond the promise given also by the STL that all
+ * calls to `const` member function are safe from multiple threads (as long as no thread calls
+ * a non-`const` member function at the same time).
+ */
+template <typename seq_container_t  = std::vector<alphabet::dna5>,
+          typename qual_container_t = std::vector<alphabet::phred42>,
+          typename id_container_t   = std::string>
+    requires(detail::reservible_container<seq_container_t> && detail::reservible_container<qual_container_t>)
+class record_batch
+{
+private:
+    //!\brief The type of the id column.
+    using ids_t = concatenated_sequences<id_container_t>;
+
+    //!\brief The ids.
+    ids_t               id_data;
+    //!\brief The concatenated sequences.
+    seq_container_t     seq_data;
+    //!\brief The concatenated qualities.
+    qual_container_t    qual_data;
+    //!\brief Where the sequences and qualities begin; begins with 0, has size of size() + 1.
+    std::vector<size_t> delimiters{0};
+
+public:
+    /*!\name Member types
+     * \{
+     */
+    //!\brief A bio::ranges::record_view over the columns.
+    using value_type = record_view<std::ranges::range_reference_t<ids_t const>,
+                                   decltype(detail::container_slice(std::declval<seq_container_t &>(), 0, 1)),
+                                   decltype(detail::container_slice(std::declval<qual_container_t &>(), 0, 1))>;
+    //!\brief Same as value_type.
+    using reference  = value_type;
+    //!\brief A bio::ranges::record_view over the columns (immutable).
+    using const_reference =
+      record_view<std::ranges::range_reference_t<ids_t const>,
+                  decltype(detail::container_slice(std::declval<seq_container_t const &>(), 0, 1)),
+                  decltype(detail::container_slice(std::declval<qual_container_t const &>(), 0, 1))>;
+    //!\brief The iterator type of this container (a random access iterator).
+    using iterator        = detail::random_access_iterator<record_batch>;
+    //!\brief The const iterator type of this container (a random access iterator).
+    using const_iterator  = detail::random_access_iterator<record_batch const>;
+    //!\brief A signed integer type (usually std::ptrdiff_t).
+    using difference_type = std::ptrdiff_t;
+    //!\brief An unsigned integer type (usually std::size_t).
+    using size_type       = size_t;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    record_batch()                                     = default; //!< Defaulted.
+    record_batch(record_batch const &)                 = default; //!< Defaulted.
+    record_batch(record_batch &&) noexcept             = default; //!< Defaulted.
+    record_batch & operator=(record_batch const &)     = default; //!< Defaulted.
+    record_batch & operator=(record_batch &&) noexcept = default; //!< Defaulted.
+    ~record_batch()                                    = default; //!< Defaulted.
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first element of the container.
+    iterator begin() noexcept { return iterator{*this}; }
+
+    //!\copydoc begin()
+    const_iterator begin() const noexcept { return const_iterator{*this}; }
+
+    //!\copydoc begin()
+    const_iterator cbegin() const noexcept { return const_iterator{*this}; }
+
+    //!\brief Returns an iterator to the element following the last element of the container.
+    iterator end() noexcept { return iterator{*this, size()}; }
+
+    //!\copydoc end()
+    const_iterator end() const noexcept { return const_iterator{*this, size()}; }
+
+    //!\copydoc end()
+    const_iterator cend() const noexcept { return const_iterator{*this, size()}; }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    /*!\brief Return the i-th record.
+     * \param i The record to retrieve.
+     * \throws std::out_of_range If you access an element behind the last.
+     */
+    reference at(size_type const i)
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in record_batch."};
+        return (*this)[i];
+    }
+
+    //!\copydoc at()
+    const_reference at(size_type const i) const
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in record_batch."};
+        return (*this)[i];
+    }
+
+    /*!\brief Return the i-th record.
+     * \param i The record to retrieve.
+     *
+     * Accessing an element behind the last causes undefined behaviour. In debug mode an assertion checks the size of
+     * the container.
+     */
+    reference operator[](size_type const i)
+    {
+        assert(i < size());
+        return {std::as_const(id_data)[i],
+                detail::container_slice(seq_data, delimiters[i], delimiters[i + 1]),
+                detail::container_slice(qual_data, delimiters[i], delimiters[i + 1])};
+    }
+
+    //!\copydoc operator[]()
+    const_reference operator[](size_type const i) const
+    {
+        assert(i < size());
+        return {id_data[i],
+                detail::container_slice(seq_data, delimiters[i], delimiters[i + 1]),
+                detail::container_slice(qual_data, delimiters[i], delimiters[i + 1])};
+    }
+
+    //!\brief The ids of all records (a bio::ranges::concatenated_sequences).
+    ids_t const & ids() const noexcept { return id_data; }
+
+    //!\brief The sequences of all records as a random access range of views.
+    auto seqs() noexcept { return column(seq_data); }
+
+    //!\copydoc seqs()
+    auto seqs() const noexcept { return column(seq_data); }
+
+    //!\brief The qualities of all records as a random access range of views.
+    auto quals() noexcept { return column(qual_data); }
+
+    //!\copydoc quals()
+    auto quals() const noexcept { return column(qual_data); }
+
+    /*!\brief Provides direct, unsafe access to underlying data structures.
+     * \returns A tuple of the ids, the concatenated sequences, the concatenated qualities and the delimiters of
+     *          sequences and qualities.
+     *
+     * \details
+     *
+     * The exact representation of the data is implementation defined. Do not rely on it for API stability.
+     */
+    std::tuple<ids_t &, seq_container_t &, qual_container_t &, std::vector<size_t> &> raw_data() noexcept
+    {
+        return {id_data, seq_data, qual_data, delimiters};
+    }
+
+    //!\copydoc raw_data()
+    std::tuple<ids_t const &, seq_container_t const &, qual_container_t const &, std::vector<size_t> const &>
+    raw_data() const noexcept
+    {
+        return {id_data, seq_data, qual_data, delimiters};
+    }
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    //!\brief Checks whether the container is empty.
+    bool empty() const noexcept { return size() == 0; }
+
+    //!\brief The number of records.
+    size_type size() const noexcept { return delimiters.size() - 1; }
+
+    //!\brief The total number of letters in all sequences.
+    size_type concat_size() const noexcept { return delimiters.back(); }
+
+    /*!\brief Reserve memory for the given number of records and letters.
+     * \param records    The number of records.
+     * \param seq_size   The total number of letters in all sequences (and qualities).
+     * \param ids_size   The total number of characters in all ids.
+     */
+    void reserve(size_type const records, size_type const seq_size, size_type const ids_size)
+    {
+        id_data.reserve(records);
+        id_data.concat_reserve(ids_size);
+        seq_data.reserve(seq_size);
+        qual_data.reserve(seq_size);
+        delimiters.reserve(records + 1);
+    }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    /*!\brief Removes all records; keeps the memory.
+     *
+     * ### Complexity
+     *
+     * Constant (for trivially destructible alphabets).
+     */
+    void clear() noexcept
+    {
+        id_data.clear();
+        seq_data.clear();
+        qual_data.clear();
+        delimiters.resize(1);
+    }
+
+    /*!\brief Appends a record.
+     * \param[in] id   The id.
+     * \param[in] seq  The sequence.
+     * \param[in] qual The qualities; must have the same size as `seq`.
+     * \throws std::invalid_argument If `seq` and `qual` differ in size.
+     *
+     * \details
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee (the records are unchanged if an exception is thrown; the capacity may differ).
+     */
+    template <std::ranges::forward_range id_t, std::ranges::forward_range seq_t, std::ranges::forward_range qual_t>
+    void push_back(id_t && id, seq_t && seq, qual_t && qual)
+    {
+        size_t const seq_size = std::ranges::distance(seq);
+        if (seq_size != static_cast<size_t>(std::ranges::distance(qual)))
+            throw std::invalid_argument{"Sequence and qualities of a record in record_batch must have the same size."};
+
+        size_t const old_size = size();
+        try
+        {
+            if constexpr (std::is_array_v<std::remove_cvref_t<id_t>>) // string literal
+                id_data.push_back(std::string_view{id});
+            else
+                id_data.push_back(std::forward<id_t>(id));
+            seq_data.insert(seq_data.end(), std::ranges::begin(seq), std::ranges::end(seq));
+            qual_data.insert(qual_data.end(), std::ranges::begin(qual), std::ranges::end(qual));
+            delimiters.push_back(delimiters.back() + seq_size);
+        }
+        catch (...)
+        {
+            if (id_data.size() > old_size)
+                id_data.pop_back();
+            seq_data.resize(delimiters.back());
+            qual_data.resize(delimiters.back());
+            throw;
+        }
+    }
+
+    //!\brief Removes the last record.
+    void pop_back()
+    {
+        assert(size() > 0);
+        id_data.pop_back();
+        delimiters.pop_back();
+        seq_data.resize(delimiters.back());
+        qual_data.resize(delimiters.back());
+    }
+
+    //!\brief Swap contents with another instance.
+    void swap(record_batch & rhs) noexcept
+    {
+        std::ranges::swap(id_data, rhs.id_data);
+        std::ranges::swap(seq_data, rhs.seq_data);
+        std::ranges::swap(qual_data, rhs.qual_data);
+        std::ranges::swap(delimiters, rhs.delimiters);
+    }
+    //!\}
+
+    //!\brief Compares the contents.
+    friend bool operator==(record_batch const & lhs, record_batch const & rhs) = default;
+
+private:
+    //!\brief A view on one column: the records' slices of `data`.
+    template <typename data_t>
+    auto column(data_t & data) const noexcept
+    {
+        return std::views::iota(size_t{0}, size()) |
+               std::views::transform([&data, this](size_t const i)
+                                     { return detail::container_slice(data, delimiters[i], delimiters[i + 1]); });
+    }
+};
+
+} // namespace bio::ranges
@@ -0,0 +1,511 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::rle_vector.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/views/rle.hpp>
+#include <bio/ranges/views/zip.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief A run-length encoded sequence.
+ * \tparam alphabet_type The alphabet of the sequence; must satisfy bio::alphabet::writable_semialphabet and
+ *                       std::regular.
+ * \implements bio::cerealisable
+ * \ingroup container
+ *
+ * \details
+ *
+ * The sequence is stored as a list of runs, i.e. a letter (in a bio::ranges::bitcompressed_vector) and the number of
+ * its consecutive occurrences (32bit). This is much smaller than the plain sequence if it contains long runs, e.g.
+ * `N`-stretches and masked regions in references or homopolymers in long reads. Runs longer than 2^32-1 are split.
+ *
+ * For random access, the container stores the sequence position of every `sample_interval`-th run. Accessing
+ * a letter takes O(log(r) + sample_interval) for `r` runs. Iterating takes O(1) per letter; the iterator
+ * remembers the run it is in.
+ *
+ * When constructing from a contiguous range over single-byte letters (e.g. a std::vector<bio::alphabet::dna5>),
+ * the beginnings of runs are detected eight letters at a time (see bio::views::rle).
+ *
+ * The container can only be appended to; the letters cannot be changed.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/rle_vector.cpp
+ *
+ * ### Thread safety
+ *
+ * This container provides no thread-safety beyond the promise given also by the STL that all
+ * calls to `const` member function are safe from multiple threads (as long as no thread calls
+ * a non-`const` member function at the same time).
+ */
+template <alphabet::writable_semialphabet alphabet_type>
+    requires std::regular<alphabet_type>
+class rle_vector
+{
+public:
+    //!\brief The number of runs between two sampled positions.
+    static constexpr size_t sample_interval = 64;
+
+    //!\brief The maximum length of a single run.
+    static constexpr size_t max_run_length = std::numeric_limits<uint32_t>::max();
+
+private:
+    //!\brief The letter of every run.
+    bitcompressed_vector<alphabet_type> letters;
+    //!\brief The length of every run.
+    std::vector<uint32_t>               lengths;
+    //!\brief The sequence position of every `sample_interval`-th run.
+    std::vector<size_t>                 samples;
+    //!\brief The length of the sequence.
+    size_t                              n = 0;
+
+    //!\brief Returns the run that contains position `pos` and the position where it begins.
+    std::pair<size_t, size_t> locate(size_t const pos) const noexcept
+    {
+        assert(pos < n);
+        size_t const sample = std::ranges::upper_bound(samples, pos) - samples.begin() - 1;
+        size_t       run    = sample * sample_interval;
+        size_t       begin  = samples[sample];
+        while (begin + lengths[run] <= pos)
+            begin += lengths[run++];
+        return {run, begin};
+    }
+
+    /*!\brief The iterator type; it stores the current run and its letter.
+     * \implements std::random_access_iterator
+     */
+    class iterator_type
+    {
+    private:
+        //!\brief The container.
+        rle_vector const * host = nullptr;
+        //!\brief The position in the sequence.
+        size_t             pos  = 0;
+        //!\brief The run that contains #pos (run_count() at the end).
+        size_t             run  = 0;
+        //!\brief The position where #run begins.
+        size_t             run_begin = 0;
+        //!\brief The position where #run ends.
+        size_t             run_end   = 0;
+        //!\brief The letter of #run.
+        alphabet_type      letter{};
+
+        //!\brief Load #run_end and #letter of #run.
+        constexpr void load_run() noexcept
+        {
+            if (run < host->lengths.size())
+            {
+                run_end = run_begin + host->lengths[run];
+                letter  = host->letters[run];
+            }
+            else
+            {
+                run_end = run_begin;
+            }
+        }
+
+        //!\brief Update the run after #pos has been changed arbitrarily.
+        constexpr void relocate() noexcept
+        {
+            if (pos >= run_begin && pos < run_end)
+                return;
+
+            if (pos >= host->n)
+            {
+                run       = host->lengths.size();
+                run_begin = host->n;
+            }
+            else
+            {
+                std::tie(run, run_begin) = host->locate(pos);
+            }
+            load_run();
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        using difference_type   = ptrdiff_t;                       //!< Signed integer.
+        using value_type        = alphabet_type;                   //!< The alphabet type.
+        using reference         = alphabet_type;                   //!< Elements are generated.
+        using pointer           = void;                            //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;         //!< Reference is not a reference type.
+        using iterator_concept  = std::random_access_iterator_tag; //!< Random access.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr iterator_type()                                  = default; //!< Defaulted.
+        constexpr iterator_type(iterator_type const &)             = default; //!< Defaulted.
+        constexpr iterator_type(iterator_type &&)                  = default; //!< Defaulted.
+        constexpr iterator_type & operator=(iterator_type const &) = default; //!< Defaulted.
+        constexpr iterator_type & operator=(iterator_type &&)      = default; //!< Defaulted.
+        ~iterator_type()                                           = default; //!< Defaulted.
+
+        //!\brief Construct from the container and a position.
+        constexpr iterator_type(rle_vector const & h, size_t const p) noexcept : host{&h}, pos{p} { relocate(); }
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The current letter.
+        constexpr reference operator*() const noexcept { return letter; }
+
+        //!\brief The letter `d` positions further.
+        constexpr reference operator[](difference_type const d) const noexcept { return *(*this + d); }
+
+        //!\brief Pre-increment; moves to the next run if necessary.
+        constexpr iterator_type & operator++() noexcept
+        {
+            if (++pos == run_end)
+            {
+                run_begin = run_end;
+                ++run;
+                load_run();
+            }
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        constexpr iterator_type operator++(int) noexcept
+        {
+            iterator_type tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        //!\brief Pre-decrement; moves to the previous run if necessary.
+        constexpr iterator_type & operator--() noexcept
+        {
+            if (pos-- == run_begin)
+            {
+                --run;
+                run_end   = run_begin;
+                run_begin = run_end - host->lengths[run];
+                letter    = host->letters[run];
+            }
+            return *this;
+        }
+
+        //!\brief Post-decrement.
+        constexpr iterator_type operator--(int) noexcept
+        {
+            iterator_type tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        //!\brief Move by `d` positions; searches the run unless it stays the same.
+        constexpr iterator_type & operator+=(difference_type const d) noexcept
+        {
+            pos += d;
+            relocate();
+            return *this;
+        }
+
+        //!\brief Move by `-d` positions.
+        constexpr iterator_type & operator-=(difference_type const d) noexcept { return *this += -d; }
+
+        //!\brief Returns an iterator moved by `d` positions.
+        constexpr friend iterator_type operator+(iterator_type it, difference_type const d) noexcept
+        {
+            return it += d;
+        }
+
+        //!\copydoc operator+(iterator_type, difference_type const)
+        constexpr friend iterator_type operator+(difference_type const d, iterator_type it) noexcept
+        {
+            return it += d;
+        }
+
+        //!\brief Returns an iterator moved by `-d` positions.
+        constexpr friend iterator_type operator-(iterator_type it, difference_type const d) noexcept
+        {
+            return it -= d;
+        }
+
+        //!\brief The distance between two iterators.
+        constexpr friend difference_type operator-(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the positions.
+        constexpr friend bool operator==(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return lhs.pos == rhs.pos;
+        }
+
+        //!\brief Compare the positions.
+        constexpr friend auto operator<=>(iterator_type const & lhs, iterator_type const & rhs) noexcept
+        {
+            return lhs.pos <=> rhs.pos;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief The alphabet type.
+    using value_type      = alphabet_type;
+    //!\brief Letters are generated.
+    using reference       = alphabet_type;
+    //!\brief Letters are generated.
+    using const_reference = alphabet_type;
+    //!\brief The iterator type.
+    using iterator        = iterator_type;
+    //!\brief The iterator type.
+    using const_iterator  = iterator_type;
+    //!\brief A signed integer type.
+    using difference_type = ptrdiff_t;
+    //!\brief An unsigned integer type.
+    using size_type       = size_t;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    rle_vector()                                   = default; //!< Defaulted.
+    rle_vector(rle_vector const &)                 = default; //!< Defaulted.
+    rle_vector(rle_vector &&) noexcept             = default; //!< Defaulted.
+    rle_vector & operator=(rle_vector const &)     = default; //!< Defaulted.
+    rle_vector & operator=(rle_vector &&) noexcept = default; //!< Defaulted.
+    ~rle_vector()                                  = default; //!< Defaulted.
+
+    /*!\brief Construct from a range of letters.
+     * \param[in] rng The letters; must satisfy std::ranges::input_range and its reference type must be convertible
+     *                to `alphabet_type`.
+     */
+    template <std::ranges::input_range rng_t>
+        requires(!std::same_as<std::remove_cvref_t<rng_t>, rle_vector> &&
+                 std::convertible_to<std::ranges::range_reference_t<rng_t>, alphabet_type>)
+    explicit rle_vector(rng_t && rng)
+    {
+        append_range(std::forward<rng_t>(rng));
+    }
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first letter.
+    iterator begin() const noexcept { return iterator{*this, 0}; }
+    //!\copydoc begin()
+    iterator cbegin() const noexcept { return begin(); }
+
+    //!\brief Returns an iterator behind the last letter.
+    iterator end() const noexcept { return iterator{*this, n}; }
+    //!\copydoc end()
+    iterator cend() const noexcept { return end(); }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    //!\brief Returns the letter at position `i`.
+    alphabet_type operator[](size_type const i) const noexcept { return letters[locate(i).first]; }
+
+    //!\brief Returns the letter at position `i`.
+    //!\throws std::out_of_range If `i >= size()`.
+    alphabet_type at(size_type const i) const
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in rle_vector."};
+        return (*this)[i];
+    }
+
+    //!\brief Returns the first letter.
+    alphabet_type front() const noexcept
+    {
+        assert(!empty());
+        return letters[0];
+    }
+
+    //!\brief Returns the last letter.
+    alphabet_type back() const noexcept
+    {
+        assert(!empty());
+        return letters[letters.size() - 1];
+    }
+    //!\}
+
+    /*!\name Runs
+     * \{
+     */
+    //!\brief The number of runs.
+    size_type run_count() const noexcept { return lengths.size(); }
+
+    //!\brief The letter of the i-th run.
+    alphabet_type run_letter(size_type const i) const noexcept { return letters[i]; }
+
+    //!\brief The length of the i-th run.
+    size_type run_length(size_type const i) const noexcept { return lengths[i]; }
+
+    //!\brief The index of the run that contains position `pos`.
+    size_type run_of(size_type const pos) const noexcept { return locate(pos).first; }
+
+    /*!\brief The runs as a range of (letter, length) pairs.
+     *
+     * \details
+     *
+     * The result can be expanded with bio::views::unrle.
+     */
+    auto runs() const noexcept { return views::zip(letters, lengths); }
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    //!\brief The number of letters.
+    size_type size() const noexcept { return n; }
+
+    //!\brief Whether the container is empty.
+    bool empty() const noexcept { return n == 0; }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    //!\brief Append a letter.
+    void push_back(alphabet_type const letter) { append_run(letter, 1); }
+
+    //!\brief Append a run of `count` times `letter`; merges with the last run if the letter is the same.
+    void append_run(alphabet_type const letter, size_type count)
+    {
+        if (count == 0)
+            return;
+
+        if (!lengths.empty() && alphabet::to_rank(letters[letters.size() - 1]) == alphabet::to_rank(letter))
+        {
+            size_type const extend = std::min<size_type>(count, max_run_length - lengths.back());
+            lengths.back() += static_cast<uint32_t>(extend);
+            n += extend;
+            count -= extend;
+        }
+
+        while (count > 0)
+        {
+            size_type const len = std::min(count, max_run_length);
+            append_distinct_run(letter, len);
+            count -= len;
+        }
+    }
+
+    /*!\brief Append a range of letters.
+     * \param[in] rng The letters; must satisfy std::ranges::input_range and its reference type must be convertible
+     *                to `alphabet_type`.
+     */
+    template <std::ranges::input_range rng_t>
+        requires std::convertible_to<std::ranges::range_reference_t<rng_t>, alphabet_type>
+    void append_range(rng_t && rng)
+    {
+        if constexpr (detail::scannable_for_runs<rng_t>)
+        {
+            auto const                   data = std::ranges::data(rng);
+            size_type const              size = std::ranges::size(rng);
+            detail::run_boundary_scanner scanner{data, size};
+            for (size_type pos = 0; pos < size;)
+            {
+                size_type const run_end = scanner.next();
+                if (pos == 0 || run_end - pos > max_run_length) // may have to be merged or split
+                    append_run(data[pos], run_end - pos);
+                else
+                    append_distinct_run(data[pos], run_end - pos);
+                pos = run_end;
+            }
+        }
+        else if constexpr (std::ranges::forward_range<rng_t> &&
+                           alphabet::semialphabet<std::ranges::range_reference_t<rng_t>>)
+        {
+            auto       it  = std::ranges::begin(rng);
+            auto const end = std::ranges::end(rng);
+            while (it != end)
+            {
+                auto const run_end = detail::run_end(it, end);
+                append_run(*it, static_cast<size_type>(std::ranges::distance(it, run_end)));
+                it = run_end;
+            }
+        }
+        else
+        {
+            for (alphabet_type const l : rng)
+                push_back(l);
+        }
+    }
+
+    //!\brief Removes all letters.
+    void clear() noexcept
+    {
+        letters.clear();
+        lengths.clear();
+        samples.clear();
+        n = 0;
+    }
+    //!\}
+
+    //!\brief Compares the runs.
+    bool operator==(rle_vector const & rhs) const noexcept
+    {
+        return n == rhs.n && lengths == rhs.lengths && letters == rhs.letters;
+    }
+
+    /*!\cond DEV
+     * \brief Serialisation support function.
+     * \tparam archive_t Type of `archive`; must satisfy bio::typename.
+     * \param archive The archive being serialised from/to.
+     *
+     * \attention These functions are never called directly, see \ref howto_use_cereal for more details.
+     */
+    template <typename archive_t>
+    void serialize(archive_t & archive)
+    {
+        archive(letters, lengths, samples, n);
+    }
+    //!\endcond
+
+private:
+    //!\brief Append a run whose letter differs from the last run's and whose length is at most #max_run_length.
+    void append_distinct_run(alphabet_type const letter, size_type const count)
+    {
+        if (lengths.size() % sample_interval == 0)
+            samples.push_back(n);
+        letters.push_back(letter);
+        lengths.push_back(static_cast<uint32_t>(count));
+        n += count;
+    }
+};
+
+} // namespace bio::ranges
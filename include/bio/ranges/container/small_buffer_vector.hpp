@@ -0,0 +1,1093 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::small_buffer_vector.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <bio/meta/concept/core_language.hpp>
+#include <bio/ranges/views/repeat_n.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief A vector that stores up to `inline_capacity` elements inside the object and only allocates beyond that.
+ * \implements bio::ranges::detail::reservible_container
+ * \ingroup container
+ * \tparam value_type_      The value type stored in the vector.
+ * \tparam inline_capacity_ The number of elements that can be stored without allocation.
+ * \tparam allocator_type_  The allocator used for storage beyond `inline_capacity_`.
+ *
+ * \details
+ *
+ * This container behaves like std::vector, but it has a buffer for `inline_capacity_` elements as a data member.
+ * As long as the size does not exceed this number, no memory is allocated. When the size grows beyond it, the
+ * elements are moved to the heap ("spilled") and the container behaves exactly like std::vector from then on.
+ *
+ * This is useful for per-record data that is usually short but can be long, like tags, CIGAR strings or read
+ * names: in contrast to bio::ranges::small_vector the size is not limited, and in contrast to std::vector most
+ * records never allocate.
+ *
+ * Elements that are trivially copyable are copied and relocated with `std::memcpy`/`std::memmove`.
+ *
+ * Since the inline buffer is part of the object, moving a container that has not spilled moves the elements
+ * one-by-one and invalidates iterators (unlike std::vector). Moving a container that has spilled transfers ownership
+ * of the heap storage in constant time.
+ *
+ * The allocator is only used to obtain heap storage; elements are constructed in-place via std::construct_at.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/small_buffer_vector.cpp
+ */
+template <typename value_type_, size_t inline_capacity_, typename allocator_type_ = std::allocator<value_type_>>
+class small_buffer_vector
+{
+private:
+    //!\brief The allocator traits.
+    using alloc_traits = std::allocator_traits<allocator_type_>;
+
+    //!\brief Whether elements can be copied and relocated bitwise.
+    static constexpr bool is_trivial = std::is_trivially_copyable_v<value_type_>;
+
+    //!\brief Whether move-construction can throw.
+    static constexpr bool is_noexcept_move = std::is_nothrow_move_constructible_v<value_type_>;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    using value_type      = value_type_;                           //!< The value_type type.
+    using allocator_type  = allocator_type_;                       //!< The allocator type.
+    using reference       = value_type &;                          //!< The reference type.
+    using const_reference = value_type const &;                    //!< The const_reference type.
+    using pointer         = value_type *;                          //!< The pointer type.
+    using const_pointer   = value_type const *;                    //!< The const_pointer type.
+    using iterator        = value_type *;                          //!< The iterator type.
+    using const_iterator  = value_type const *;                    //!< The const_iterator type.
+    using difference_type = ptrdiff_t;                             //!< The difference_type type.
+    using size_type       = size_t;                                //!< The size_type type.
+    //!\}
+
+    //!\brief The number of elements that can be stored without allocating.
+    static constexpr size_type inline_capacity = inline_capacity_;
+
+    static_assert(inline_capacity_ > 0, "The inline capacity of small_buffer_vector must be at least 1.");
+    static_assert(std::same_as<typename alloc_traits::value_type, value_type>,
+                  "The allocator's value_type must be the container's value_type.");
+
+private:
+    //!\brief The allocator.
+    [[no_unique_address]] allocator_type alloc{};
+    //!\brief The inline storage (elements are constructed in it on demand).
+    alignas(value_type) std::byte buffer[sizeof(value_type) * inline_capacity_];
+    //!\brief Points to the first element (either to #buffer or to heap storage).
+    value_type * data_ = reinterpret_cast<value_type *>(buffer);
+    //!\brief The number of elements.
+    size_type    sz    = 0;
+    //!\brief The number of elements that fit into the current storage.
+    size_type    cap   = inline_capacity_;
+
+    //!\brief Pointer to the inline storage.
+    value_type * inline_data() noexcept { return reinterpret_cast<value_type *>(buffer); }
+
+    //!\brief Destroy the elements in `[first, first + n)`.
+    static void destroy_n(value_type * const first, size_type const n) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+            std::destroy_n(first, n);
+    }
+
+    //!\brief Move-construct `n` elements from `src` into uninitialised `dst` and destroy the sources.
+    static void relocate(value_type * const src, size_type const n, value_type * const dst) noexcept(is_trivial ||
+                                                                                                   is_noexcept_move)
+    {
+        if constexpr (is_trivial)
+        {
+            if (n > 0)
+                std::memcpy(static_cast<void *>(dst), static_cast<void const *>(src), n * sizeof(value_type));
+        }
+        else
+        {
+            if constexpr (is_noexcept_move)
+                std::uninitialized_move_n(src, n, dst);
+            else
+                std::uninitialized_copy_n(src, n, dst);
+            destroy_n(src, n);
+        }
+    }
+
+    //!\brief Copy-construct the elements of `[first, last)` into uninitialised `dst`; returns the end.
+    template <std::forward_iterator it_t, std::sentinel_for<it_t> sen_t>
+    static value_type * construct_from(it_t first, sen_t const last, value_type * const dst)
+    {
+        if constexpr (is_trivial && std::contiguous_iterator<it_t> &&
+                      std::same_as<std::iter_value_t<it_t>, value_type>)
+        {
+            size_type const n = std::ranges::distance(first, last);
+            if (n > 0)
+                std::memcpy(static_cast<void *>(dst), static_cast<void const *>(std::to_address(first)),
+                            n * sizeof(value_type));
+            return dst + n;
+        }
+        else
+        {
+            value_type * out = dst;
+            try
+            {
+                for (; first != last; ++first, ++out)
+                    std::construct_at(out, *first);
+            }
+            catch (...)
+            {
+                destroy_n(dst, out - dst);
+                throw;
+            }
+            return out;
+        }
+    }
+
+    //!\brief Return the storage to the allocator if it is on the heap (elements must already be destroyed).
+    void release_storage() noexcept
+    {
+        if (!is_inline())
+            alloc_traits::deallocate(alloc, data_, cap);
+        data_ = inline_data();
+        cap   = inline_capacity_;
+    }
+
+    //!\brief The capacity to use when at least `needed` elements must fit.
+    size_type grown_capacity(size_type const needed) const
+    {
+        if (needed > max_size())
+            throw std::length_error{"Trying to grow small_buffer_vector beyond max_size()."};
+        return std::max(needed, std::min(cap * 2, max_size()));
+    }
+
+    //!\brief Move the elements into new heap storage of `new_cap` elements.
+    void reallocate(size_type const new_cap)
+    {
+        assert(new_cap >= sz);
+        value_type * const new_data = alloc_traits::allocate(alloc, new_cap);
+        if constexpr (is_trivial || is_noexcept_move)
+        {
+            relocate(data_, sz, new_data);
+        }
+        else
+        {
+            try
+            {
+                relocate(data_, sz, new_data);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(alloc, new_data, new_cap);
+                throw;
+            }
+        }
+        release_storage();
+        data_ = new_data;
+        cap   = new_cap;
+    }
+
+    //!\brief Take over the contents of `rhs`; `*this` must be empty and have no heap storage.
+    void steal(small_buffer_vector & rhs) noexcept(is_trivial || is_noexcept_move)
+    {
+        assert(sz == 0 && is_inline());
+        if (rhs.is_inline())
+        {
+            relocate(rhs.data_, rhs.sz, data_);
+        }
+        else
+        {
+            data_     = rhs.data_;
+            cap       = rhs.cap;
+            rhs.data_ = rhs.inline_data();
+            rhs.cap   = inline_capacity_;
+        }
+        sz     = rhs.sz;
+        rhs.sz = 0;
+    }
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    //!\brief Default constructor.
+    small_buffer_vector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) {}
+
+    //!\brief Construct with an allocator.
+    explicit small_buffer_vector(allocator_type const & alloc_) noexcept : alloc{alloc_} {}
+
+    /*!\brief Copy constructor.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `rhs`.
+     */
+    small_buffer_vector(small_buffer_vector const & rhs) :
+      alloc{alloc_traits::select_on_container_copy_construction(rhs.alloc)}
+    {
+        assign(rhs.begin(), rhs.end());
+    }
+
+    /*!\brief Move constructor.
+     *
+     * ### Complexity
+     *
+     * Constant if `rhs` has spilled to the heap; linear in the size of `rhs` otherwise.
+     */
+    small_buffer_vector(small_buffer_vector && rhs) noexcept(is_trivial || is_noexcept_move) :
+      alloc{std::move(rhs.alloc)}
+    {
+        steal(rhs);
+    }
+
+    /*!\brief Copy assignment.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `rhs`.
+     */
+    small_buffer_vector & operator=(small_buffer_vector const & rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            if (alloc != rhs.alloc)
+            {
+                clear();
+                release_storage();
+            }
+            alloc = rhs.alloc;
+        }
+
+        assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    /*!\brief Move assignment.
+     *
+     * ### Complexity
+     *
+     * Constant if `rhs` has spilled to the heap (and the allocators are compatible); linear in the size of `rhs`
+     * otherwise.
+     */
+    small_buffer_vector & operator=(small_buffer_vector && rhs) noexcept((is_trivial || is_noexcept_move) &&
+                                                                        (alloc_traits::is_always_equal::value ||
+                                                                         alloc_traits::propagate_on_container_move_assignment::value))
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release_storage();
+            alloc = std::move(rhs.alloc);
+            steal(rhs);
+        }
+        else if (alloc_traits::is_always_equal::value || alloc == rhs.alloc)
+        {
+            release_storage();
+            steal(rhs);
+        }
+        else // storage cannot be exchanged, move element-wise
+        {
+            reserve(rhs.size());
+            std::uninitialized_move_n(rhs.data_, rhs.sz, data_);
+            sz = rhs.sz;
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    //!\brief Destructor.
+    ~small_buffer_vector() noexcept
+    {
+        clear();
+        release_storage();
+    }
+
+    /*!\brief Construct from two iterators.
+     * \tparam begin_it_type Must model std::forward_iterator and `value_type` must be constructible from
+     *                       the reference type of begin_it_type.
+     * \tparam   end_it_type Must satisfy std::sentinel_for.
+     * \param[in]   begin_it Begin of range to construct/assign from.
+     * \param[in]     end_it End of range to construct/assign from.
+     * \param[in]     alloc_ The allocator.
+     *
+     * ### Complexity
+     *
+     * Linear in the distance between `begin_it` and `end_it`.
+     */
+    template <std::forward_iterator begin_it_type, typename end_it_type>
+        requires(std::sentinel_for<end_it_type, begin_it_type> &&
+                 std::constructible_from<value_type, std::iter_reference_t<begin_it_type>>)
+    small_buffer_vector(begin_it_type begin_it, end_it_type end_it, allocator_type const & alloc_ = allocator_type{}) :
+      alloc{alloc_}
+    {
+        assign(begin_it, end_it);
+    }
+
+    /*!\brief Construct from a different range.
+     * \tparam other_range_t The type of range to be inserted; must satisfy std::ranges::input_range and `value_type`
+     *                       must be constructible from std::ranges::range_reference_t<other_range_t>.
+     * \param[in]      range The sequences to construct/assign from.
+     * \param[in]     alloc_ The allocator.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `range`.
+     */
+    template <meta::different_from<small_buffer_vector> other_range_t>
+        requires(std::ranges::input_range<other_range_t> &&
+                 std::constructible_from<value_type, std::ranges::range_reference_t<other_range_t>>)
+    explicit small_buffer_vector(other_range_t && range, allocator_type const & alloc_ = allocator_type{}) :
+      alloc{alloc_}
+    {
+        assign(std::forward<other_range_t>(range));
+    }
+
+    /*!\brief Construct with `n` times `value`.
+     * \param[in] n      Number of elements.
+     * \param[in] value  The initial value to be assigned.
+     * \param[in] alloc_ The allocator.
+     *
+     * ### Complexity
+     *
+     * Linear in `n`.
+     */
+    small_buffer_vector(size_type const        n,
+                        value_type const &     value,
+                        allocator_type const & alloc_ = allocator_type{}) :
+      alloc{alloc_}
+    {
+        assign(n, value);
+    }
+
+    /*!\brief Construct from `std::initializer_list`.
+     * \param[in] ilist  A `std::initializer_list` of value_type.
+     * \param[in] alloc_ The allocator.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `ilist`.
+     */
+    small_buffer_vector(std::initializer_list<value_type> ilist, allocator_type const & alloc_ = allocator_type{}) :
+      alloc{alloc_}
+    {
+        assign(ilist);
+    }
+
+    /*!\brief Assign from `std::initializer_list`.
+     * \param[in] ilist A `std::initializer_list` of value_type.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `ilist`.
+     */
+    small_buffer_vector & operator=(std::initializer_list<value_type> ilist)
+    {
+        assign(ilist);
+        return *this;
+    }
+
+    /*!\brief Assign from `std::initializer_list`.
+     * \param[in] ilist A `std::initializer_list` of value_type.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `ilist`.
+     */
+    void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    /*!\brief Assign with `count` times `value`.
+     * \param[in] count Number of elements.
+     * \param[in] value The initial value to be assigned.
+     *
+     * ### Complexity
+     *
+     * Linear in `count`.
+     */
+    void assign(size_type const count, value_type const & value)
+    {
+        clear();
+        resize(count, value);
+    }
+
+    /*!\brief Assign from a different range.
+     * \tparam other_range_t The type of range to be inserted; must satisfy std::ranges::input_range and `value_type`
+     *                       must be constructible from std::ranges::range_reference_t<other_range_t>.
+     * \param[in]      range The sequences to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `range`.
+     */
+    template <std::ranges::input_range other_range_t>
+        requires std::constructible_from<value_type, std::ranges::range_reference_t<other_range_t>>
+    void assign(other_range_t && range)
+    {
+        if constexpr (std::ranges::forward_range<other_range_t>)
+        {
+            assign(std::ranges::begin(range), std::ranges::end(range));
+        }
+        else
+        {
+            clear();
+            for (auto && v : range)
+                emplace_back(std::forward<decltype(v)>(v));
+        }
+    }
+
+    /*!\brief Assign from pair of iterators.
+     * \tparam begin_it_type Must satisfy std::forward_iterator and the `value_type` must be constructible from
+     *                       the reference type of begin_it_type.
+     * \tparam   end_it_type Must satisfy std::sentinel_for.
+     * \param[in]   begin_it Begin of range to construct/assign from.
+     * \param[in]     end_it End of range to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the distance between `begin_it` and `end_it`.
+     */
+    template <std::forward_iterator begin_it_type, typename end_it_type>
+        requires(std::sentinel_for<end_it_type, begin_it_type> &&
+                 std::constructible_from<value_type, std::iter_reference_t<begin_it_type>>)
+    void assign(begin_it_type begin_it, end_it_type end_it)
+    {
+        clear();
+        size_type const n = std::ranges::distance(begin_it, end_it);
+        if (n > cap)
+            reallocate(grown_capacity(n));
+        construct_from(begin_it, end_it, data_);
+        sz = n;
+    }
+
+    //!\brief Returns a copy of the allocator.
+    allocator_type get_allocator() const noexcept { return alloc; }
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns the begin iterator of the vector.
+    iterator begin() noexcept { return data_; }
+
+    //!\copydoc bio::ranges::small_buffer_vector::begin()
+    const_iterator begin() const noexcept { return data_; }
+
+    //!\copydoc bio::ranges::small_buffer_vector::begin()
+    const_iterator cbegin() const noexcept { return data_; }
+
+    //!\brief Returns iterator past the end of the vector.
+    iterator end() noexcept { return data_ + sz; }
+
+    //!\copydoc bio::ranges::small_buffer_vector::end()
+    const_iterator end() const noexcept { return data_ + sz; }
+
+    //!\copydoc bio::ranges::small_buffer_vector::end()
+    const_iterator cend() const noexcept { return data_ + sz; }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    /*!\brief Return the i-th element.
+     * \param[in] i Index of the element to retrieve.
+     * \throws std::out_of_range If you access an element behind the last.
+     * \returns A reference to the value at position `i`.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * Throws std::out_of_range if `i >= size()`.
+     */
+    reference at(size_type const i)
+    {
+        if (i >= size()) // [[unlikely]]
+        {
+            throw std::out_of_range{"Trying to access element behind the last in small_buffer_vector."};
+        }
+        return (*this)[i];
+    }
+
+    //!\copydoc bio::ranges::small_buffer_vector::at()
+    const_reference at(size_type const i) const
+    {
+        if (i >= size()) // [[unlikely]]
+        {
+            throw std::out_of_range{"Trying to access element behind the last in small_buffer_vector."};
+        }
+        return (*this)[i];
+    }
+
+    /*!\brief Return the i-th element.
+     * \param i The element to retrieve.
+     * \returns A reference to the value at position `i`.
+     *
+     * Accessing an element behind the last causes undefined behaviour. In debug mode an assertion checks the size of
+     * the container.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    reference operator[](size_type const i) noexcept
+    {
+        assert(i < size());
+        return data_[i];
+    }
+
+    //!\copydoc bio::ranges::small_buffer_vector::operator[]()
+    const_reference operator[](size_type const i) const noexcept
+    {
+        assert(i < size());
+        return data_[i];
+    }
+
+    /*!\brief Return the first element. Calling front on an empty container is undefined.
+     * \returns A reference to the value at the first position.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    reference front() noexcept
+    {
+        assert(size() > 0);
+        return (*this)[0];
+    }
+
+    //!\copydoc bio::ranges::small_buffer_vector::front()
+    const_reference front() const noexcept
+    {
+        assert(size() > 0);
+        return (*this)[0];
+    }
+
+    /*!\brief Return the last element. Calling back on an empty container is undefined.
+     * \returns A reference to the value at the last position.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    reference back() noexcept
+    {
+        assert(size() > 0);
+        return (*this)[size() - 1];
+    }
+
+    //!\copydoc bio::ranges::small_buffer_vector::back()
+    const_reference back() const noexcept
+    {
+        assert(size() > 0);
+        return (*this)[size() - 1];
+    }
+
+    //!\brief Direct access to the storage (inline or on the heap).
+    value_type * data() noexcept { return data_; }
+
+    //!\copydoc bio::ranges::small_buffer_vector::data()
+    value_type const * data() const noexcept { return data_; }
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    //!\brief Checks whether the container is empty.
+    bool empty() const noexcept { return sz == 0; }
+
+    //!\brief Returns the number of elements in the container.
+    size_type size() const noexcept { return sz; }
+
+    //!\brief Returns the maximum number of elements the container is able to hold.
+    size_type max_size() const noexcept { return alloc_traits::max_size(alloc); }
+
+    //!\brief Returns the number of elements that can be held without reallocation (at least #inline_capacity).
+    size_type capacity() const noexcept { return cap; }
+
+    //!\brief Whether the elements are stored inline, i.e. no heap storage is used.
+    bool is_inline() const noexcept { return data_ == reinterpret_cast<value_type const *>(buffer); }
+
+    /*!\brief Increase the capacity to at least `new_cap`.
+     * \param[in] new_cap The new capacity.
+     * \throws std::length_error If `new_cap > max_size()`.
+     *
+     * If `new_cap > capacity()`, the elements are moved to new heap storage and all iterators are invalidated.
+     * Otherwise this is a no-op.
+     *
+     * ### Complexity
+     *
+     * At most linear in size().
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee if value_type is trivially copyable or nothrow move-constructible.
+     */
+    void reserve(size_type const new_cap)
+    {
+        if (new_cap > max_size())
+            throw std::length_error{"Trying to reserve more than max_size() in small_buffer_vector."};
+        if (new_cap > cap)
+            reallocate(new_cap);
+    }
+
+    /*!\brief Reduce the capacity to the size (but not below #inline_capacity).
+     *
+     * If the elements fit into the inline storage, they are moved there and the heap storage is released.
+     *
+     * ### Complexity
+     *
+     * At most linear in size().
+     */
+    void shrink_to_fit()
+    {
+        if (is_inline() || sz == cap)
+            return;
+
+        if (sz <= inline_capacity_)
+        {
+            value_type * const old_data = data_;
+            size_type const    old_cap  = cap;
+            relocate(old_data, sz, inline_data());
+            alloc_traits::deallocate(alloc, old_data, old_cap);
+            data_ = inline_data();
+            cap   = inline_capacity_;
+        }
+        else
+        {
+            reallocate(sz);
+        }
+    }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    /*!\brief Removes all elements from the container (the capacity is kept).
+     *
+     * ### Complexity
+     *
+     * Linear in size() (constant for trivially destructible elements).
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    void clear() noexcept
+    {
+        destroy_n(data_, sz);
+        sz = 0;
+    }
+
+    /*!\brief Inserts value before position in the container.
+     * \param   pos Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param value Element value to insert.
+     * \returns     Iterator pointing to the inserted value.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size().
+     */
+    iterator insert(const_iterator pos, value_type const & value) { return insert(pos, 1, value); }
+
+    /*!\brief Inserts count copies of value before position in the container.
+     * \param   pos Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param count Number of copies.
+     * \param value Element value to insert.
+     * \returns     Iterator pointing to the first element inserted, or `pos` if `count==0`.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + `count`.
+     */
+    iterator insert(const_iterator pos, size_type const count, value_type const & value)
+    {
+        value_type const tmp_value = value; // value could be an element of *this
+        auto             tmp       = views::repeat_n(tmp_value, count);
+        return insert(pos, std::ranges::begin(tmp), std::ranges::end(tmp));
+    }
+
+    /*!\brief Inserts elements from range `[begin_it, end_it)` before position in the container.
+     * \tparam begin_it_type Must satisfy std::forward_iterator and the `value_type` must be constructible from
+     *                       the reference type of begin_it_type.
+     * \tparam   end_it_type Must satisfy std::sentinel_for.
+     * \param[in]        pos Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param[in]   begin_it Begin of range to construct/assign from.
+     * \param[in]     end_it End of range to construct/assign from.
+     * \returns              Iterator pointing to the first element inserted, or `pos` if `begin_it==end_it`.
+     *
+     * The behaviour is undefined if begin_it and end_it are iterators into `*this`.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + the distance between `begin_it` and `end_it`.
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee if inserting at the end or if the storage is reallocated; basic exception guarantee
+     * otherwise.
+     */
+    template <std::forward_iterator begin_it_type, typename end_it_type>
+        requires(std::sentinel_for<end_it_type, begin_it_type> &&
+                 std::constructible_from<value_type, std::iter_reference_t<begin_it_type>>)
+    iterator insert(const_iterator pos, begin_it_type begin_it, end_it_type end_it)
+    {
+        size_type const pos_as_num = pos - cbegin();
+        size_type const length     = std::ranges::distance(begin_it, end_it);
+        assert(pos_as_num <= sz);
+
+        if (length == 0)
+            return begin() + pos_as_num;
+
+        if (sz + length > cap) // construct the new elements directly in their final place in new storage
+        {
+            size_type const    new_cap  = grown_capacity(sz + length);
+            value_type * const new_data = alloc_traits::allocate(alloc, new_cap);
+            size_type          built    = 0; // 1: the new elements, 2: and the elements before pos
+            try
+            {
+                construct_from(begin_it, end_it, new_data + pos_as_num);
+                built = 1;
+                if constexpr (is_trivial || is_noexcept_move)
+                {
+                    relocate(data_, pos_as_num, new_data);
+                    relocate(data_ + pos_as_num, sz - pos_as_num, new_data + pos_as_num + length);
+                }
+                else // copy everything before destroying the old elements, so that a throwing copy loses nothing
+                {
+                    std::uninitialized_copy_n(data_, pos_as_num, new_data);
+                    built = 2;
+                    std::uninitialized_copy_n(data_ + pos_as_num, sz - pos_as_num, new_data + pos_as_num + length);
+                    destroy_n(data_, sz);
+                }
+            }
+            catch (...)
+            {
+                if (built > 0)
+                    destroy_n(new_data + pos_as_num, length);
+                if (built > 1)
+                    destroy_n(new_data, pos_as_num);
+                alloc_traits::deallocate(alloc, new_data, new_cap);
+                throw;
+            }
+            release_storage();
+            data_ = new_data;
+            cap   = new_cap;
+        }
+        else if constexpr (is_trivial)
+        {
+            std::memmove(static_cast<void *>(data_ + pos_as_num + length),
+                         static_cast<void const *>(data_ + pos_as_num),
+                         (sz - pos_as_num) * sizeof(value_type));
+            construct_from(begin_it, end_it, data_ + pos_as_num);
+        }
+        else // append and rotate into place
+        {
+            construct_from(begin_it, end_it, data_ + sz);
+            std::rotate(data_ + pos_as_num, data_ + sz, data_ + sz + length);
+        }
+
+        sz += length;
+        return begin() + pos_as_num;
+    }
+
+    /*!\brief Inserts elements from initializer list before position in the container.
+     * \param   pos Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param ilist Initializer list with values to insert.
+     * \returns     Iterator pointing to the first element inserted, or `pos` if `ilist` is empty.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + the size of `ilist`.
+     */
+    iterator insert(const_iterator pos, std::initializer_list<value_type> const & ilist)
+    {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    /*!\brief Removes specified elements from the container.
+     * \param begin_it Begin of range to erase.
+     * \param   end_it Behind the end of range to erase.
+     * \returns        Iterator following the last element removed.
+     *
+     * Invalidates iterators and references at or after the point of the erase, including the end() iterator.
+     *
+     * ### Complexity
+     *
+     * Linear in size().
+     */
+    iterator erase(const_iterator begin_it, const_iterator end_it) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+    {
+        size_type const b = begin_it - cbegin();
+        size_type const e = end_it - cbegin();
+        if (b >= e) // [[unlikely]]
+            return begin() + e;
+
+        if constexpr (is_trivial)
+            std::memmove(static_cast<void *>(data_ + b),
+                         static_cast<void const *>(data_ + e),
+                         (sz - e) * sizeof(value_type));
+        else
+            std::move(data_ + e, data_ + sz, data_ + b);
+
+        destroy_n(data_ + sz - (e - b), e - b);
+        sz -= e - b;
+        return begin() + b;
+    }
+
+    /*!\brief Removes the element at `pos`.
+     * \param   pos Remove the element at pos.
+     * \returns     Iterator following the last element removed.
+     *
+     * ### Complexity
+     *
+     * Linear in size().
+     */
+    iterator erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    /*!\brief Constructs an element in-place at the end of the container.
+     * \param args The arguments to forward to the constructor.
+     * \returns A reference to the new element.
+     *
+     * If the new size() is greater than capacity(), all iterators and references are invalidated.
+     *
+     * ### Complexity
+     *
+     * Amortised constant.
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee.
+     */
+    template <typename... args_t>
+        requires std::constructible_from<value_type, args_t...>
+    reference emplace_back(args_t &&... args)
+    {
+        if (sz == cap) // [[unlikely]]
+        {
+            // construct first, because args could refer to an element of *this
+            value_type tmp(std::forward<args_t>(args)...);
+            reallocate(grown_capacity(sz + 1));
+            std::construct_at(data_ + sz, std::move(tmp));
+        }
+        else
+        {
+            std::construct_at(data_ + sz, std::forward<args_t>(args)...);
+        }
+        return data_[sz++];
+    }
+
+    /*!\brief Appends the given element value to the end of the container.
+     * \param value The value to append.
+     *
+     * If the new size() is greater than capacity(), all iterators and references are invalidated.
+     *
+     * ### Complexity
+     *
+     * Amortised constant.
+     *
+     * ### Exceptions
+     *
+     * Strong exception guarantee.
+     */
+    void push_back(value_type const & value) { emplace_back(value); }
+
+    //!\copydoc bio::ranges::small_buffer_vector::push_back()
+    void push_back(value_type && value) { emplace_back(std::move(value)); }
+
+    /*!\brief Removes the last element of the container.
+     *
+     * Calling pop_back() on an empty container is undefined. In debug mode an assertion will be thrown.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    void pop_back() noexcept
+    {
+        assert(sz > 0);
+        --sz;
+        destroy_n(data_ + sz, 1);
+    }
+
+    /*!\brief Resizes the container to contain count elements.
+     * \param[in] count The new size.
+     *
+     * New elements are value-initialised.
+     *
+     * ### Complexity
+     *
+     * Linear in the difference between size() and `count`.
+     */
+    void resize(size_type const count)
+    {
+        if (count <= sz)
+            return (void)erase(cbegin() + count, cend());
+
+        if (count > cap)
+            reallocate(grown_capacity(count));
+        std::uninitialized_value_construct(data_ + sz, data_ + count);
+        sz = count;
+    }
+
+    /*!\copybrief bio::ranges::small_buffer_vector::resize
+     * \param[in] value Append copies of value when resizing.
+     * \copydetails bio::ranges::small_buffer_vector::resize
+     */
+    void resize(size_type const count, value_type const & value)
+    {
+        if (count <= sz)
+            return (void)erase(cbegin() + count, cend());
+
+        insert(cend(), count - sz, value);
+    }
+
+    /*!\brief Swap contents with another instance.
+     * \param rhs The other instance to swap with.
+     *
+     * ### Complexity
+     *
+     * Constant if both containers have spilled to the heap; linear in the size of both containers otherwise.
+     */
+    void swap(small_buffer_vector & rhs) noexcept(is_trivial || is_noexcept_move)
+    {
+        if (this == &rhs)
+            return;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(alloc, rhs.alloc);
+        }
+        else
+        {
+            assert(alloc == rhs.alloc);
+        }
+
+        if (!is_inline() && !rhs.is_inline())
+        {
+            std::swap(data_, rhs.data_);
+            std::swap(sz, rhs.sz);
+            std::swap(cap, rhs.cap);
+            return;
+        }
+
+        // at least one of them is inline: go through a temporary with the same allocator
+        small_buffer_vector tmp{alloc};
+        tmp.steal(rhs);
+        rhs.steal(*this);
+        steal(tmp);
+    }
+
+    //!\overload
+    void swap(small_buffer_vector && rhs) noexcept(is_trivial || is_noexcept_move) { swap(rhs); }
+    //!\}
+
+    /*!\brief Swap contents with another instance.
+     * \param lhs The first instance.
+     * \param rhs The other instance to swap with.
+     *
+     * ### Complexity
+     *
+     * Constant if both containers have spilled to the heap; linear in the size of both containers otherwise.
+     */
+    friend void swap(small_buffer_vector & lhs, small_buffer_vector & rhs) noexcept(is_trivial || is_noexcept_move)
+    {
+        lhs.swap(rhs);
+    }
+
+    //!\overload
+    friend void swap(small_buffer_vector && lhs, small_buffer_vector && rhs) noexcept(is_trivial || is_noexcept_move)
+    {
+        lhs.swap(rhs);
+    }
+
+    //!\name Comparison operators
+    //!\{
+
+    //!\brief Performs element-wise comparison.
+    friend bool operator==(small_buffer_vector const & lhs, small_buffer_vector const & rhs) noexcept
+        requires std::equality_comparable<value_type>
+    {
+        return std::ranges::equal(lhs, rhs);
+    }
+
+    //!\brief Performs element-wise comparison.
+    friend bool operator<(small_buffer_vector const & lhs, small_buffer_vector const & rhs) noexcept
+        requires std::totally_ordered<value_type>
+    {
+        return std::ranges::lexicographical_compare(lhs, rhs);
+    }
+
+    //!\brief Performs element-wise comparison.
+    friend bool operator>(small_buffer_vector const & lhs, small_buffer_vector const & rhs) noexcept
+        requires std::totally_ordered<value_type>
+    {
+        return rhs < lhs;
+    }
+
+    //!\brief Performs element-wise comparison.
+    friend bool operator<=(small_buffer_vector const & lhs, small_buffer_vector const & rhs) noexcept
+        requires std::totally_ordered<value_type>
+    {
+        return !(rhs < lhs);
+    }
+
+    //!\brief Performs element-wise comparison.
+    friend bool operator>=(small_buffer_vector const & lhs, small_buffer_vector const & rhs) noexcept
+        requires std::totally_ordered<value_type>
+    {
+        return !(lhs < rhs);
+    }
+    //!\}
+};
+
+} // namespace bio::ranges
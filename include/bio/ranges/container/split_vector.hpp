@@ -0,0 +1,722 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::split_vector.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <bio/alphabet/composite/tuple_base.hpp>
+#include <bio/alphabet/proxy_base.hpp>
+#include <bio/meta/concept/core_language.hpp>
+#include <bio/meta/type_list/traits.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/detail/random_access_iterator.hpp>
+
+namespace bio::ranges::detail
+{
+
+//!\brief A std::tuple with one column container per component of a composite alphabet.
+template <typename alphabet_type,
+          template <typename>
+          typename column_template,
+          typename = std::make_index_sequence<std::tuple_size_v<alphabet_type>>>
+struct split_vector_columns;
+
+//!\cond
+template <typename alphabet_type, template <typename> typename column_template, size_t... is>
+struct split_vector_columns<alphabet_type, column_template, std::index_sequence<is...>>
+{
+    using type = std::tuple<column_template<std::tuple_element_t<is, alphabet_type>>...>;
+};
+//!\endcond
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief A container over a composite alphabet that stores every component in its own column.
+ * \tparam alphabet_type   The composite alphabet, e.g. bio::alphabet::qualified; must be derived from
+ *                         bio::alphabet::tuple_base.
+ * \tparam column_template The container template for the columns; bio::ranges::bitcompressed_vector by default.
+ * \implements bio::ranges::detail::reservible_container
+ * \ingroup container
+ *
+ * \details
+ *
+ * A `std::vector<qualified<dna4, phred42>>` stores the combined rank of base and quality; bit-compressing it needs
+ * `log2(4 * 42)` bits per letter and every sequence-only scan has to decode the combined rank. This container
+ * stores the components separately, e.g. the bases in a `bitcompressed_vector<dna4>` (2 bits per letter) and the
+ * qualities in a `bitcompressed_vector<phred42>` (6 bits per letter).
+ *
+ * Element access returns proxies that behave like the composite alphabet (reading and assigning the composite
+ * reads and writes all columns). The columns can be accessed directly with column(), which returns a
+ * std::ranges::ref_view, so that elements can be changed (unless the container is `const`), but not the size.
+ * Choose `std::vector` as `column_template` if kernels need contiguous columns (e.g. for SIMD).
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/container/split_vector.cpp
+ *
+ * ### Thread safety
+ *
+ * This container provides no thread-safety beyond the promise given also by the STL that all
+ * calls to `const` member function are safe from multiple threads (as long as no thread calls
+ * a non-`const` member function at the same time).
+ */
+template <alphabet::detail::alphabet_tuple_like alphabet_type,
+          template <typename> typename column_template = bitcompressed_vector>
+    requires std::regular<alphabet_type>
+class split_vector
+{
+private:
+    //!\brief The type of the columns (a std::tuple).
+    using columns_t = typename detail::split_vector_columns<alphabet_type, column_template>::type;
+
+    //!\brief The number of components.
+    static constexpr size_t component_count = std::tuple_size_v<alphabet_type>;
+
+    //!\brief Index sequence over the components.
+    using component_indexes = std::make_index_sequence<component_count>;
+
+    //!\brief The columns.
+    columns_t columns;
+
+    //!\brief Read the element at position `i` from the columns.
+    template <size_t... is>
+    static alphabet_type get_element(columns_t const & cols, size_t const i, std::index_sequence<is...>) noexcept
+    {
+        return alphabet_type{static_cast<std::tuple_element_t<is, alphabet_type>>(std::get<is>(cols)[i])...};
+    }
+
+    //!\brief Write the element at position `i` to the columns.
+    template <size_t... is>
+    static void
+    set_element(columns_t & cols, size_t const i, alphabet_type const v, std::index_sequence<is...>) noexcept
+    {
+        ((std::get<is>(cols)[i] = get<is>(v)), ...);
+    }
+
+    //!\brief Proxy data type returned by bio::ranges::split_vector as reference to element.
+    class reference_proxy_type : public alphabet::proxy_base<reference_proxy_type, alphabet_type>
+    {
+    private:
+        //!\brief The base type.
+        using base_t = alphabet::proxy_base<reference_proxy_type, alphabet_type>;
+
+        //!\brief Pointer to the host's columns.
+        columns_t * columns_ptr;
+        //!\brief Index of the current element.
+        size_t      index;
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Deleted, because using this proxy without a parent would be undefined behaviour.
+        reference_proxy_type()                                                = delete;
+        constexpr reference_proxy_type(reference_proxy_type const &) noexcept = default; //!< Defaulted.
+        constexpr reference_proxy_type(reference_proxy_type &&) noexcept      = default; //!< Defaulted.
+        ~reference_proxy_type() noexcept                                      = default; //!< Defaulted.
+
+        // Import from base:
+        using base_t::operator=;
+
+        //!\brief Assignment does not change `this`, instead it updates the referenced value.
+        // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+        constexpr reference_proxy_type & operator=(reference_proxy_type const & rhs)
+        {
+            return assign_rank(rhs.to_rank());
+        }
+
+        /*!\brief Assignment does not change `this`, instead it updates the referenced value (also works on `const`
+         *        objects).
+         */
+        // NOLINTNEXTLINE(bugprone-unhandled-self-assignment)
+        constexpr reference_proxy_type const & operator=(reference_proxy_type const & rhs) const
+        {
+            return assign_rank(rhs.to_rank());
+        }
+
+        //!\brief The main constructor to create this object.
+        reference_proxy_type(columns_t * const columns_ptr_, size_t const index_) noexcept :
+          columns_ptr{columns_ptr_}, index{index_}
+        {}
+        //!\}
+
+        //!\brief Retrieve the rank of the composite.
+        constexpr alphabet::rank_t<alphabet_type> to_rank() const noexcept
+        {
+            return alphabet::to_rank(get_element(*columns_ptr, index, component_indexes{}));
+        }
+
+        //!\brief Update all columns.
+        constexpr reference_proxy_type & assign_rank(alphabet::rank_t<alphabet_type> const r) noexcept
+        {
+            set_element(*columns_ptr, index, alphabet::assign_rank_to(r, alphabet_type{}), component_indexes{});
+            return *this;
+        }
+
+        //!\brief Update all columns (also works on `const` objects).
+        constexpr reference_proxy_type const & assign_rank(alphabet::rank_t<alphabet_type> const r) const noexcept
+        {
+            set_element(*columns_ptr, index, alphabet::assign_rank_to(r, alphabet_type{}), component_indexes{});
+            return *this;
+        }
+    };
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief Equals the alphabet_type.
+    using value_type      = alphabet_type;
+    //!\brief A proxy type that reads and writes all columns.
+    using reference       = reference_proxy_type;
+    //!\brief Equals the alphabet_type / value_type.
+    using const_reference = alphabet_type;
+    //!\brief The iterator type of this container (a random access iterator).
+    using iterator        = detail::random_access_iterator<split_vector>;
+    //!\brief The const_iterator type of this container (a random access iterator).
+    using const_iterator  = detail::random_access_iterator<split_vector const>;
+    //!\brief A signed integer type (usually std::ptrdiff_t)
+    using difference_type = std::ptrdiff_t;
+    //!\brief An unsigned integer type (usually std::size_t)
+    using size_type       = size_t;
+    //!\brief The type of the column of component `i`.
+    template <size_t i>
+    using column_type     = std::tuple_element_t<i, columns_t>;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    split_vector()                                         = default; //!< Defaulted.
+    split_vector(split_vector const &)                     = default; //!< Defaulted.
+    split_vector(split_vector &&) noexcept                 = default; //!< Defaulted.
+    split_vector & operator=(split_vector const &)         = default; //!< Defaulted.
+    split_vector & operator=(split_vector &&) noexcept     = default; //!< Defaulted.
+    ~split_vector() noexcept                               = default; //!< Defaulted.
+
+    /*!\brief Construct from a different range.
+     * \tparam other_range_t Type of the other range; must model std::ranges::input_range and have a reference type
+     *                       that is convertible to value_type.
+     * \param[in] range The sequences to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `range`.
+     */
+    template <meta::different_from<split_vector> other_range_t>
+        requires(std::ranges::input_range<other_range_t> &&
+                 std::convertible_to<std::ranges::range_reference_t<other_range_t>, value_type>)
+    explicit split_vector(other_range_t && range)
+    {
+        assign(std::forward<other_range_t>(range));
+    }
+
+    /*!\brief Construct from `count` copies of `value`.
+     * \param[in] count Number of elements.
+     * \param[in] value The initial value to be assigned.
+     *
+     * ### Complexity
+     *
+     * In \f$O(count)\f$.
+     */
+    split_vector(size_type const count, value_type const value) { resize(count, value); }
+
+    /*!\brief Construct from pair of iterators.
+     * \tparam begin_iterator_type Must model std::forward_iterator and have a reference type convertible to
+     *                             value_type.
+     * \tparam end_iterator_type   Must model std::sentinel_for.
+     * \param[in] begin_it Begin of range to construct/assign from.
+     * \param[in] end_it   End of range to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the distance between `begin_it` and `end_it`.
+     */
+    template <std::forward_iterator begin_iterator_type, typename end_iterator_type>
+        requires(std::sentinel_for<end_iterator_type, begin_iterator_type> &&
+                 std::convertible_to<std::iter_reference_t<begin_iterator_type>, value_type>)
+    split_vector(begin_iterator_type begin_it, end_iterator_type end_it)
+    {
+        assign(begin_it, end_it);
+    }
+
+    /*!\brief Construct from std::initializer_list.
+     * \param[in] ilist An std::initializer_list of value_type.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `ilist`.
+     */
+    split_vector(std::initializer_list<value_type> ilist) { assign(ilist); }
+
+    /*!\brief Assign from std::initializer_list.
+     * \param[in] ilist An std::initializer_list of value_type.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `ilist`.
+     */
+    split_vector & operator=(std::initializer_list<value_type> ilist)
+    {
+        assign(ilist);
+        return *this;
+    }
+
+    /*!\brief Assign from a different range.
+     * \tparam other_range_t Type of the other range; must model std::ranges::input_range and have a reference type
+     *                       that is convertible to value_type.
+     * \param[in] range The sequences to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of `range`.
+     */
+    template <std::ranges::input_range other_range_t>
+        requires std::convertible_to<std::ranges::range_reference_t<other_range_t>, value_type>
+    void assign(other_range_t && range)
+    {
+        clear();
+        if constexpr (std::ranges::sized_range<other_range_t>)
+            reserve(std::ranges::size(range));
+
+        for (auto && v : range)
+            push_back(v);
+    }
+
+    //!\copydoc assign(other_range_t && range)
+    void assign(std::initializer_list<value_type> ilist) { assign(std::views::all(ilist)); }
+
+    /*!\brief Assign with `count` times `value`.
+     * \param[in] count Number of elements.
+     * \param[in] value The initial value to be assigned.
+     *
+     * ### Complexity
+     *
+     * In \f$O(count)\f$.
+     */
+    void assign(size_type const count, value_type const value)
+    {
+        clear();
+        resize(count, value);
+    }
+
+    /*!\brief Assign from pair of iterators.
+     * \tparam begin_iterator_type Must model std::forward_iterator and have a reference type convertible to
+     *                             value_type.
+     * \tparam end_iterator_type   Must model std::sentinel_for.
+     * \param[in] begin_it Begin of range to construct/assign from.
+     * \param[in] end_it   End of range to construct/assign from.
+     *
+     * ### Complexity
+     *
+     * Linear in the distance between `begin_it` and `end_it`.
+     */
+    template <std::forward_iterator begin_iterator_type, typename end_iterator_type>
+        requires(std::sentinel_for<end_iterator_type, begin_iterator_type> &&
+                 std::convertible_to<std::iter_reference_t<begin_iterator_type>, value_type>)
+    void assign(begin_iterator_type begin_it, end_iterator_type end_it)
+    {
+        assign(std::ranges::subrange<begin_iterator_type, end_iterator_type>{begin_it, end_it});
+    }
+
+    /*!\brief Assign all columns at once.
+     * \tparam column_rng_ts Types of the ranges; the reference type of the i-th range must be convertible to the
+     *                       i-th component type.
+     * \param[in] column_rngs One range per component; all must have the same size.
+     * \throws std::invalid_argument If the ranges do not have the same size.
+     *
+     * \details
+     *
+     * This avoids the conversion to and from the composite alphabet, e.g. when sequence and qualities are read
+     * separately.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of the ranges.
+     */
+    template <std::ranges::sized_range... column_rng_ts>
+        requires(sizeof...(column_rng_ts) == component_count)
+    void assign_columns(column_rng_ts &&... column_rngs)
+    {
+        size_t const sizes[] = {std::ranges::size(column_rngs)...};
+        if (!std::ranges::all_of(sizes, [&](size_t const s) { return s == sizes[0]; }))
+            throw std::invalid_argument{"All columns of a split_vector need to have the same size."};
+
+        assign_columns_impl(component_indexes{}, std::forward<column_rng_ts>(column_rngs)...);
+    }
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first element of the container.
+    iterator begin() noexcept { return iterator{*this}; }
+
+    //!\copydoc begin()
+    const_iterator begin() const noexcept { return const_iterator{*this}; }
+
+    //!\copydoc begin()
+    const_iterator cbegin() const noexcept { return const_iterator{*this}; }
+
+    //!\brief Returns an iterator to the element following the last element of the container.
+    iterator end() noexcept { return iterator{*this, size()}; }
+
+    //!\copydoc end()
+    const_iterator end() const noexcept { return const_iterator{*this, size()}; }
+
+    //!\copydoc end()
+    const_iterator cend() const noexcept { return const_iterator{*this, size()}; }
+    //!\}
+
+    /*!\name Element access
+     * \{
+     */
+    /*!\brief Return the i-th element.
+     * \param[in] i Index of the element to retrieve.
+     * \throws std::out_of_range If you access an element behind the last.
+     * \returns Either a writable proxy to the element or a copy (if called in const context).
+     *
+     * ### Complexity
+     *
+     * Constant.
+     */
+    reference at(size_type const i)
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in split_vector."};
+        return (*this)[i];
+    }
+
+    //!\copydoc at()
+    const_reference at(size_type const i) const
+    {
+        if (i >= size())
+            throw std::out_of_range{"Trying to access element behind the last in split_vector."};
+        return (*this)[i];
+    }
+
+    /*!\brief Return the i-th element.
+     * \param[in] i Index of the element to retrieve.
+     * \returns Either a writable proxy to the element or a copy (if called in const context).
+     *
+     * Accessing an element behind the last causes undefined behaviour. In debug mode an assertion checks the size of
+     * the container.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     */
+    reference operator[](size_type const i) noexcept
+    {
+        assert(i < size());
+        return {&columns, i};
+    }
+
+    //!\copydoc operator[]()
+    const_reference operator[](size_type const i) const noexcept
+    {
+        assert(i < size());
+        return get_element(columns, i, component_indexes{});
+    }
+
+    //!\brief Return the first element.
+    reference front() noexcept { return (*this)[0]; }
+
+    //!\copydoc front()
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    //!\brief Return the last element.
+    reference back() noexcept { return (*this)[size() - 1]; }
+
+    //!\copydoc back()
+    const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+    /*!\brief The column of the i-th component.
+     * \tparam i The index of the component, e.g. 0 for the sequence and 1 for the qualities of
+     *           bio::alphabet::qualified.
+     * \returns A std::ranges::ref_view of the column (elements are writable if `*this` is not `const`, but the size
+     *          cannot be changed).
+     */
+    template <size_t i>
+        requires(i < component_count)
+    std::ranges::ref_view<column_type<i>> column() noexcept
+    {
+        return std::get<i>(columns);
+    }
+
+    //!\copydoc column()
+    template <size_t i>
+        requires(i < component_count)
+    std::ranges::ref_view<column_type<i> const> column() const noexcept
+    {
+        return std::get<i>(columns);
+    }
+
+    /*!\brief The column of the component with the given type.
+     * \tparam type The type of the component; must be unique in the composite.
+     * \returns See column().
+     */
+    template <typename type>
+        requires(meta::list_traits::count<type, typename alphabet_type::biocpp_required_types> == 1)
+    decltype(auto) column() noexcept
+    {
+        return column<meta::list_traits::find<type, typename alphabet_type::biocpp_required_types>>();
+    }
+
+    //!\copydoc column()
+    template <typename type>
+        requires(meta::list_traits::count<type, typename alphabet_type::biocpp_required_types> == 1)
+    decltype(auto) column() const noexcept
+    {
+        return column<meta::list_traits::find<type, typename alphabet_type::biocpp_required_types>>();
+    }
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    //!\brief Checks whether the container is empty.
+    bool empty() const noexcept { return size() == 0; }
+
+    //!\brief Returns the number of elements in the container.
+    size_type size() const noexcept { return std::ranges::size(std::get<0>(columns)); }
+
+    //!\brief Returns the maximum number of elements the container is able to hold.
+    size_type max_size() const noexcept
+    {
+        return std::apply([](auto const &... cols) { return std::min({size_type(cols.max_size())...}); }, columns);
+    }
+
+    //!\brief Returns the number of elements that the container is able to hold without reallocating.
+    size_type capacity() const noexcept
+    {
+        return std::apply([](auto const &... cols) { return std::min({cols.capacity()...}); }, columns);
+    }
+
+    /*!\brief Increase the capacity of all columns to a value that's greater or equal to new_cap.
+     * \param[in] new_cap The new capacity.
+     * \throws std::length_error If new_cap > max_size() of a column.
+     * \throws std::bad_alloc If the allocator fails.
+     */
+    void reserve(size_type const new_cap)
+    {
+        std::apply([&](auto &... cols) { (cols.reserve(new_cap), ...); }, columns);
+    }
+
+    //!\brief Requests the removal of unused capacity.
+    void shrink_to_fit()
+    {
+        std::apply([](auto &... cols) { (cols.shrink_to_fit(), ...); }, columns);
+    }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    //!\brief Removes all elements from the container.
+    void clear() noexcept
+    {
+        std::apply([](auto &... cols) { (cols.clear(), ...); }, columns);
+    }
+
+    /*!\brief Inserts value before position in the container.
+     * \param[in] pos   Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param[in] value Element value to insert.
+     * \returns Iterator pointing to the inserted value.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size().
+     */
+    iterator insert(const_iterator pos, value_type const value) { return insert(pos, 1, value); }
+
+    /*!\brief Inserts count copies of value before position in the container.
+     * \param[in] pos   Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param[in] count Number of copies.
+     * \param[in] value Element value to insert.
+     * \returns Iterator pointing to the first element inserted, or `pos` if `count==0`.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + count.
+     */
+    iterator insert(const_iterator pos, size_type const count, value_type const value)
+    {
+        difference_type const offset = pos - cbegin();
+        insert_impl(offset, count, value, component_indexes{});
+        return begin() + offset;
+    }
+
+    /*!\brief Inserts elements from range `[begin_it, end_it)` before position in the container.
+     * \tparam begin_iterator_type Must model std::forward_iterator and have a reference type convertible to
+     *                             value_type.
+     * \tparam end_iterator_type   Must model std::sentinel_for.
+     * \param[in] pos      Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param[in] begin_it Begin of range to insert.
+     * \param[in] end_it   Behind the end of range to insert.
+     * \returns Iterator pointing to the first element inserted, or `pos` if `begin_it==end_it`.
+     *
+     * \details
+     *
+     * The behaviour is undefined if `begin_it` and `end_it` are iterators into `*this`.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + the distance between `begin_it` and `end_it`.
+     */
+    template <std::forward_iterator begin_iterator_type, typename end_iterator_type>
+        requires(std::sentinel_for<end_iterator_type, begin_iterator_type> &&
+                 std::convertible_to<std::iter_reference_t<begin_iterator_type>, value_type>)
+    iterator insert(const_iterator pos, begin_iterator_type begin_it, end_iterator_type end_it)
+    {
+        difference_type const offset = pos - cbegin();
+        split_vector const    tmp{begin_it, end_it}; // split into columns first
+        insert_range_impl(offset, tmp, component_indexes{});
+        return begin() + offset;
+    }
+
+    /*!\brief Inserts elements from initializer list before position in the container.
+     * \param[in] pos   Iterator before which the content will be inserted. `pos` may be the end() iterator.
+     * \param[in] ilist Initializer list with values to insert.
+     * \returns Iterator pointing to the first element inserted, or `pos` if `ilist` is empty.
+     *
+     * ### Complexity
+     *
+     * Worst-case linear in size() + the size of `ilist`.
+     */
+    iterator insert(const_iterator pos, std::initializer_list<value_type> const & ilist)
+    {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    /*!\brief Removes specified elements from the container.
+     * \param[in] begin_it Begin of range to erase.
+     * \param[in] end_it   Behind the end of range to erase.
+     * \returns Iterator following the last element removed.
+     *
+     * ### Complexity
+     *
+     * Linear in size().
+     */
+    iterator erase(const_iterator begin_it, const_iterator end_it)
+    {
+        difference_type const b = begin_it - cbegin();
+        difference_type const e = end_it - cbegin();
+        std::apply([&](auto &... cols) { (cols.erase(cols.cbegin() + b, cols.cbegin() + e), ...); }, columns);
+        return begin() + b;
+    }
+
+    //!\copydoc erase(const_iterator, const_iterator)
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /*!\brief Appends the given element value to the end of the container.
+     * \param[in] value The value to append.
+     *
+     * ### Complexity
+     *
+     * Amortised constant.
+     */
+    void push_back(value_type const value) { push_back_impl(value, component_indexes{}); }
+
+    //!\brief Removes the last element of the container.
+    void pop_back()
+    {
+        assert(size() > 0);
+        std::apply([](auto &... cols) { (cols.pop_back(), ...); }, columns);
+    }
+
+    /*!\brief Resizes the container to contain count elements.
+     * \param[in] count The new size.
+     * \param[in] value Elements that are appended are initialised with this value.
+     *
+     * ### Complexity
+     *
+     * Linear in the difference between size() and count.
+     */
+    void resize(size_type const count, value_type const value = value_type{})
+    {
+        resize_impl(count, value, component_indexes{});
+    }
+
+    //!\brief Swap contents with another instance.
+    void swap(split_vector & rhs) noexcept { std::swap(columns, rhs.columns); }
+
+    //!\brief Swap contents of two instances.
+    friend void swap(split_vector & lhs, split_vector & rhs) noexcept { lhs.swap(rhs); }
+    //!\}
+
+    //!\brief Compares the columns.
+    friend bool operator==(split_vector const & lhs, split_vector const & rhs) noexcept = default;
+
+private:
+    //!\brief Implementation of assign_columns().
+    template <size_t... is, typename... column_rng_ts>
+    void assign_columns_impl(std::index_sequence<is...>, column_rng_ts &&... column_rngs)
+    {
+        clear();
+        reserve(std::ranges::size(std::get<0>(std::forward_as_tuple(column_rngs...))));
+
+        auto append = [](auto & col, auto && rng)
+        {
+            for (auto && v : rng)
+                col.push_back(v);
+        };
+        (append(std::get<is>(columns), column_rngs), ...);
+    }
+
+    //!\brief Implementation of insert().
+    template <size_t... is>
+    void insert_impl(difference_type const offset,
+                     size_type const       count,
+                     value_type const      value,
+                     std::index_sequence<is...>)
+    {
+        ((std::get<is>(columns).insert(std::get<is>(columns).cbegin() + offset, count, get<is>(value))), ...);
+    }
+
+    //!\brief Implementation of insert() with a range.
+    template <size_t... is>
+    void insert_range_impl(difference_type const offset, split_vector const & tmp, std::index_sequence<is...>)
+    {
+        ((std::get<is>(columns).insert(std::get<is>(columns).cbegin() + offset,
+                                       std::get<is>(tmp.columns).begin(),
+                                       std::get<is>(tmp.columns).end())),
+         ...);
+    }
+
+    //!\brief Implementation of push_back().
+    template <size_t... is>
+    void push_back_impl(value_type const value, std::index_sequence<is...>)
+    {
+        ((std::get<is>(columns).push_back(get<is>(value))), ...);
+    }
+
+    //!\brief Implementation of resize().
+    template <size_t... is>
+    void resize_impl(size_type const count, value_type const value, std::index_sequence<is...>)
+    {
+        ((std::get<is>(columns).resize(count, get<is>(value))), ...);
+    }
+};
+
+} // namespace bio::ranges
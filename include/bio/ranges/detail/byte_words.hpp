@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides helpers that process letters stored as bytes eight at a time.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief Whether two letters of `alph_t` are equal iff their only byte is equal.
+ * \ingroup range
+ *
+ * \details
+ *
+ * True for all alphabets that store their rank in a single byte (most alphabets of this library) and for `char`.
+ */
+template <typename alph_t>
+concept bytewise_comparable_letter =
+  sizeof(alph_t) == 1 && std::is_trivially_copyable_v<alph_t> && std::has_unique_object_representations_v<alph_t>;
+
+//!\brief Load eight bytes.
+//!\ingroup range
+inline uint64_t load_word(void const * const p) noexcept
+{
+    uint64_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+//!\brief A word with every byte set to `b`.
+//!\ingroup range
+constexpr uint64_t repeat_byte(unsigned char const b) noexcept
+{
+    return uint64_t{b} * 0x0101'0101'0101'0101ull;
+}
+
+/*!\brief The highest bit of every byte of `x` that is not zero; all other bits are zero.
+ * \ingroup range
+ */
+constexpr uint64_t nonzero_byte_high_bits(uint64_t const x) noexcept
+{
+    constexpr uint64_t low7 = 0x7f7f'7f7f'7f7f'7f7full;
+    constexpr uint64_t high = 0x8080'8080'8080'8080ull;
+    return (((x & low7) + low7) | x) & high; // adding to the lower seven bits carries into the highest bit
+}
+
+/*!\brief Bit i is set iff byte i of `x` is not zero (in the order of the bytes in memory on little endian platforms).
+ * \ingroup range
+ */
+constexpr uint64_t nonzero_bytes(uint64_t const x) noexcept
+{
+    return (nonzero_byte_high_bits(x) >> 7) * 0x0102'0408'1020'4080ull >> 56;
+}
+
+//!\brief The number of bytes of `x` that are not zero.
+//!\ingroup range
+constexpr size_t nonzero_byte_count(uint64_t const x) noexcept
+{
+    return (nonzero_byte_high_bits(x) >> 7) * 0x0101'0101'0101'0101ull >> 56; // the sum of the bytes
+}
+
+} // namespace bio::ranges::detail
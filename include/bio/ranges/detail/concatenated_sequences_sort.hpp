@@ -0,0 +1,257 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the sorting algorithms used by bio::ranges::concatenated_sequences.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief Reads ranks from the concatenation of bio::ranges::concatenated_sequences.
+ * \ingroup range
+ * \tparam values_t Type of the underlying container.
+ * \details
+ *
+ * Provides access to single ranks and to "chunks" of multiple ranks packed into one word (the rank of the k-th
+ * letter is stored in the bits `[k * bits, (k + 1) * bits)`). If the underlying container offers a `packed_ranks()`
+ * member (like bio::ranges::bitcompressed_vector), chunks are read directly from the packed storage.
+ */
+template <typename values_t>
+struct rank_reader
+{
+    //!\brief The alphabet type.
+    using alph_t = std::ranges::range_value_t<values_t>;
+
+    //!\brief Whether values_t provides packed access.
+    static constexpr bool is_packed = requires(values_t const & v) {
+        { v.packed_ranks(size_t{}, size_t{}) } -> std::same_as<uint64_t>;
+    };
+
+    //!\brief The number of bits per rank in a chunk.
+    static constexpr size_t bits = []()
+    {
+        if constexpr (is_packed)
+            return values_t::bits_per_letter;
+        else
+            return std::max<size_t>(1, std::bit_width(alphabet::size<alph_t> - 1u));
+    }();
+
+    //!\brief The maximum number of ranks in a chunk.
+    static constexpr size_t chunk_size = []()
+    {
+        if constexpr (is_packed)
+            return values_t::letters_per_word;
+        else
+            return 64 / bits;
+    }();
+
+    //!\brief A bitmask with the lowest #bits set.
+    static constexpr uint64_t mask = bits == 64 ? ~0ull : (1ull << bits) - 1ull;
+
+    //!\brief The underlying container.
+    values_t const & values;
+
+    //!\brief The rank at position i.
+    uint64_t rank(size_t const i) const noexcept { return alphabet::to_rank(values[i]); }
+
+    //!\brief The ranks of `count` letters beginning at position i, packed into one word.
+    uint64_t chunk(size_t const i, size_t const count) const noexcept
+    {
+        if constexpr (is_packed)
+        {
+            return values.packed_ranks(i, count);
+        }
+        else
+        {
+            uint64_t ret = 0;
+            for (size_t k = 0; k < count; ++k)
+                ret |= rank(i + k) << (k * bits);
+            return ret;
+        }
+    }
+
+    /*!\brief Lexicographically compare two subranges of the values.
+     * \param a_pos Begin of the first subrange.
+     * \param a_len Length of the first subrange.
+     * \param b_pos Begin of the second subrange.
+     * \param b_len Length of the second subrange.
+     */
+    std::weak_ordering compare(size_t const a_pos, size_t const a_len, size_t const b_pos, size_t const b_len)
+      const noexcept
+    {
+        size_t const len = std::min(a_len, b_len);
+        for (size_t k = 0; k < len; k += chunk_size)
+        {
+            size_t const   count = std::min(chunk_size, len - k);
+            uint64_t const a     = chunk(a_pos + k, count);
+            uint64_t const b     = chunk(b_pos + k, count);
+            if (a != b)
+            {
+                // the first differing letter is the one with the lowest differing bit
+                size_t const shift = std::countr_zero(a ^ b) / bits * bits;
+                return ((a >> shift) & mask) <=> ((b >> shift) & mask);
+            }
+        }
+        return a_len <=> b_len;
+    }
+};
+
+/*!\brief Sort the indexes of sequences lexicographically with an MSD radix sort over the ranks.
+ * \ingroup range
+ * \tparam values_t     Type of the underlying container of bio::ranges::concatenated_sequences.
+ * \tparam delimiters_t Type of the delimiter container of bio::ranges::concatenated_sequences.
+ * \tparam index_t      Type of the indexes.
+ * \param[in]     values     The concatenated sequences.
+ * \param[in]     delimiters The delimiters.
+ * \param[in,out] indexes    The sequence indexes to sort.
+ * \param[in]     pool       The thread pool to use; `nullptr` sorts in the calling thread.
+ * \details
+ *
+ * Buckets are split by the rank at the current depth; sequences that end at the current depth go to an extra
+ * first bucket. Small buckets and alphabets with more than 256 letters are handled by comparison sort. Common prefixes
+ * of whole buckets are skipped chunk-wise (this makes use of packed storage, see bio::ranges::detail::rank_reader).
+ *
+ * Uses one extra buffer of the same size as `indexes`. If a pool is given, the top-level buckets
+ * are created sequentially and then run as tasks of the pool.
+ */
+template <typename values_t, typename delimiters_t, typename index_t>
+void sort_lexicographically(values_t const &       values,
+                            delimiters_t const &   delimiters,
+                            std::vector<index_t> & indexes,
+                            thread_pool * const    pool)
+{
+    using reader_t = rank_reader<values_t>;
+    reader_t const reader{values};
+
+    constexpr size_t sigma            = alphabet::size<typename reader_t::alph_t>;
+    constexpr bool   use_radix        = sigma <= 256;
+    constexpr size_t small_bucket_max = 32;
+
+    struct task
+    {
+        size_t lo;
+        size_t hi;
+        size_t depth;
+    };
+
+    std::vector<index_t> buffer(use_radix ? indexes.size() : 0);
+
+    auto len = [&](index_t const i) -> size_t { return delimiters[i + 1] - delimiters[i]; };
+
+    auto comparison_sort = [&](task const & t)
+    {
+        std::sort(indexes.begin() + t.lo,
+                  indexes.begin() + t.hi,
+                  [&](index_t const a, index_t const b)
+                  {
+                      return reader.compare(delimiters[a] + t.depth,
+                                            len(a) - t.depth,
+                                            delimiters[b] + t.depth,
+                                            len(b) - t.depth) < 0;
+                  });
+    };
+
+    // splits a task into buckets; buckets that need further processing are passed to push
+    auto split = [&](task t, [[maybe_unused]] auto && push)
+    {
+        if (t.hi - t.lo < 2)
+            return;
+
+        if constexpr (!use_radix)
+        {
+            comparison_sort(t);
+        }
+        else
+        {
+            if (t.hi - t.lo <= small_bucket_max)
+                return comparison_sort(t);
+
+            // skip common prefix chunk-wise
+            for (;;)
+            {
+                index_t const first = indexes[t.lo];
+                if (len(first) < t.depth + reader_t::chunk_size)
+                    break;
+
+                uint64_t const c    = reader.chunk(delimiters[first] + t.depth, reader_t::chunk_size);
+                bool const     same = std::all_of(indexes.begin() + t.lo + 1,
+                                              indexes.begin() + t.hi,
+                                              [&](index_t const i)
+                                              {
+                                                  return len(i) >= t.depth + reader_t::chunk_size &&
+                                                         reader.chunk(delimiters[i] + t.depth, reader_t::chunk_size) == c;
+                                              });
+                if (!same)
+                    break;
+                t.depth += reader_t::chunk_size;
+            }
+
+            // bucket 0 is for sequences that end at this depth
+            auto key = [&](index_t const i) -> size_t
+            { return len(i) > t.depth ? reader.rank(delimiters[i] + t.depth) + 1 : 0; };
+
+            std::array<size_t, sigma + 3> bounds{};
+            for (size_t i = t.lo; i < t.hi; ++i)
+                ++bounds[key(indexes[i]) + 2];
+            bounds[1] = t.lo;
+            for (size_t b = 2; b < bounds.size(); ++b)
+                bounds[b] += bounds[b - 1];
+
+            for (size_t i = t.lo; i < t.hi; ++i)
+                buffer[bounds[key(indexes[i]) + 1]++] = indexes[i];
+            std::copy(buffer.begin() + t.lo, buffer.begin() + t.hi, indexes.begin() + t.lo);
+
+            // now bounds[b + 1] is the end of bucket b
+            for (size_t b = 1; b <= sigma; ++b)
+                if (bounds[b + 1] - bounds[b] > 1)
+                    push(task{bounds[b], bounds[b + 1], t.depth + 1});
+        }
+    };
+
+    auto process = [&](task const & initial)
+    {
+        std::vector<task> stack{initial};
+        while (!stack.empty())
+        {
+            task t = stack.back();
+            stack.pop_back();
+            split(t, [&](task const & n) { stack.push_back(n); });
+        }
+    };
+
+    if (pool == nullptr || pool->size() == 0)
+        return process(task{0, indexes.size(), 0});
+
+    // create enough independent tasks sequentially
+    std::vector<task> tasks{task{0, indexes.size(), 0}};
+    while (!tasks.empty() && tasks.size() < (pool->size() + 1) * 4)
+    {
+        std::vector<task> next;
+        for (task const & t : tasks)
+            split(t, [&](task const & n) { next.push_back(n); });
+        tasks = std::move(next);
+    }
+
+    // process them in parallel
+    pool->run(tasks.size(), [&](size_t const j) { process(tasks[j]); });
+}
+
+} // namespace bio::ranges::detail
@@ -0,0 +1,44 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::detail::container_slice.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <bio/ranges/views/slice.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief Create the view on `[b, e)` of a container.
+ * \ingroup range
+ * \tparam container_t Type of the container; possibly const-qualified.
+ * \param container The container.
+ * \param b         The position of the first element.
+ * \param e         The position behind the last element.
+ *
+ * \details
+ *
+ * Containers that provide their own `slice()` member (like bio::ranges::bitcompressed_vector) return a view with
+ * additional capabilities; for all other containers, this is `container | views::slice(b, e)`.
+ */
+template <typename container_t>
+constexpr auto container_slice(container_t & container, size_t const b, size_t const e)
+{
+    if constexpr (requires { container.slice(b, e); })
+        return container.slice(b, e);
+    else
+        return container | views::slice(b, e);
+}
+
+} // namespace bio::ranges::detail
@@ -0,0 +1,222 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::memory_policy and the page-level allocation functions behind it.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__) && __has_include(<sys/mman.h>) && __has_include(<sys/syscall.h>) && __has_include(<unistd.h>)
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    define BIOCPP_HAS_PAGE_MEMORY 1
+#else
+#    define BIOCPP_HAS_PAGE_MEMORY 0
+#endif
+
+namespace bio::ranges
+{
+
+/*!\brief How the pages of an allocation are backed (see bio::ranges::memory_policy).
+ * \ingroup container
+ */
+enum class page_kind : uint8_t
+{
+    standard,         //!< Regular allocation via `operator new`.
+    transparent_huge, //!< Anonymous mapping aligned to huge pages and advised with `madvise(MADV_HUGEPAGE)`.
+    hugetlb           //!< Explicit huge pages (`MAP_HUGETLB`); uses bio::ranges::page_kind::transparent_huge if
+                      //!< no huge pages are reserved on the system or if the alignment exceeds the huge page size.
+};
+
+/*!\brief How the pages of an allocation are distributed over NUMA nodes (see bio::ranges::memory_policy).
+ * \ingroup container
+ */
+enum class numa_kind : uint8_t
+{
+    none,       //!< Use the policy of the calling thread (usually: first touch).
+    interleave, //!< Interleave pages over bio::ranges::memory_policy::numa_nodes.
+    bind        //!< Only place pages on bio::ranges::memory_policy::numa_nodes.
+};
+
+/*!\brief Describes how memory is obtained from the operating system; used by bio::ranges::page_allocator.
+ * \ingroup container
+ *
+ * \details
+ *
+ * The default policy allocates via `operator new`. Other policies map memory directly from the operating system;
+ * this is only done for allocations of at least one (huge) page, smaller allocations always use `operator new`.
+ *
+ * Huge pages reduce TLB misses for random access into large containers. NUMA policies make sure that memory
+ * shared by threads on all sockets is spread evenly (bio::ranges::numa_kind::interleave) or that memory is
+ * local to a socket (bio::ranges::numa_kind::bind).
+ *
+ * All non-default settings are hints: on systems that do not support them (non-Linux, no NUMA, restricted
+ * system calls) the memory is still allocated, but with the default behaviour.
+ */
+struct memory_policy
+{
+    //!\brief The kind of pages.
+    page_kind pages      = page_kind::standard;
+    //!\brief The NUMA placement.
+    numa_kind numa       = numa_kind::none;
+    //!\brief Bitmask of NUMA nodes (bit `i` is node `i`); `0` means all nodes that the process may use.
+    uint64_t  numa_nodes = 0;
+
+    //!\brief Defaulted.
+    friend constexpr bool operator==(memory_policy const &, memory_policy const &) noexcept = default;
+};
+
+} // namespace bio::ranges
+
+namespace bio::ranges::detail
+{
+
+//!\brief The size of huge pages assumed for alignment and for the minimum allocation size.
+inline constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+//!\brief Whether an allocation of `bytes` bytes is served by map_pages() instead of `operator new`.
+template <memory_policy policy>
+inline bool uses_page_memory(size_t const bytes) noexcept
+{
+    if constexpr (!BIOCPP_HAS_PAGE_MEMORY || policy == memory_policy{})
+    {
+        return false;
+    }
+    else if constexpr (policy.pages == page_kind::standard)
+    {
+#if BIOCPP_HAS_PAGE_MEMORY
+        static size_t const page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return bytes >= page_size;
+#else
+        return false;
+#endif
+    }
+    else
+    {
+        return bytes >= huge_page_size;
+    }
+}
+
+#if BIOCPP_HAS_PAGE_MEMORY
+
+//!\brief The bytes that are actually mapped for an allocation of `bytes` bytes.
+template <memory_policy policy>
+inline size_t mapped_size(size_t const bytes) noexcept
+{
+    size_t const granularity = policy.pages == page_kind::standard ? static_cast<size_t>(::sysconf(_SC_PAGESIZE))
+                                                                    : huge_page_size;
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+//!\brief Apply the NUMA part of the policy to a mapping (failures are ignored).
+template <memory_policy policy>
+inline void apply_numa_policy(void * const ptr, size_t const bytes) noexcept
+{
+#    if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    if constexpr (policy.numa != numa_kind::none)
+    {
+        constexpr long mpol_bind           = 2; // values from <linux/mempolicy.h>
+        constexpr long mpol_interleave     = 3;
+        constexpr long mpol_f_mems_allowed = 1 << 2;
+        unsigned long  nodes               = policy.numa_nodes;
+
+        if (nodes == 0 && ::syscall(SYS_get_mempolicy, nullptr, &nodes, 64ul, nullptr, mpol_f_mems_allowed) != 0)
+            return;
+
+        ::syscall(SYS_mbind,
+                  ptr,
+                  bytes,
+                  policy.numa == numa_kind::bind ? mpol_bind : mpol_interleave,
+                  &nodes,
+                  65ul, // the kernel reads maxnode - 1 bits
+                  0ul);
+    }
+#    else
+    (void)ptr;
+    (void)bytes;
+#    endif
+}
+
+/*!\brief Map `bytes` bytes (rounded up to the page size) aligned to `alignment` according to the policy.
+ * \throws std::bad_alloc If the mapping fails.
+ */
+template <memory_policy policy>
+inline void * map_pages(size_t const bytes, size_t const alignment)
+{
+    size_t const size = mapped_size<policy>(bytes);
+    void *       ptr  = MAP_FAILED;
+
+#    ifdef MAP_HUGETLB
+    // explicit huge pages are only aligned to their size; larger alignments are served by the trimmed mapping below
+    if constexpr (policy.pages == page_kind::hugetlb)
+        if (alignment <= huge_page_size)
+            ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#    endif
+
+    if (ptr == MAP_FAILED)
+    {
+        // over-allocate so that the mapping can be trimmed to the required alignment
+        size_t const align = policy.pages == page_kind::standard ? alignment : std::max(alignment, huge_page_size);
+        size_t const page  = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t const extra = align > page ? align : 0;
+
+        void * const raw = ::mmap(nullptr, size + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc{};
+
+        uintptr_t const begin   = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t const aligned = (begin + align - 1) / align * align;
+        if (aligned > begin)
+            ::munmap(raw, aligned - begin);
+        if (size_t const tail = begin + size + extra - (aligned + size); tail > 0)
+            ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+        ptr = reinterpret_cast<void *>(aligned);
+
+#    ifdef MADV_HUGEPAGE
+        if constexpr (policy.pages != page_kind::standard)
+            ::madvise(ptr, size, MADV_HUGEPAGE);
+#    endif
+    }
+
+    // the policy must be set before the pages are touched
+    apply_numa_policy<policy>(ptr, size);
+    return ptr;
+}
+
+//!\brief Unmap memory obtained from map_pages().
+template <memory_policy policy>
+inline void unmap_pages(void * const ptr, size_t const bytes) noexcept
+{
+    ::munmap(ptr, mapped_size<policy>(bytes));
+}
+
+#else // !BIOCPP_HAS_PAGE_MEMORY
+
+//!\cond
+template <memory_policy policy>
+inline void * map_pages(size_t, size_t)
+{
+    throw std::bad_alloc{};
+}
+
+template <memory_policy policy>
+inline void unmap_pages(void *, size_t) noexcept
+{}
+//!\endcond
+
+#endif
+
+} // namespace bio::ranges::detail
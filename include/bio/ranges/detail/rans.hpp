@@ -0,0 +1,572 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an order-1 rANS entropy coder for small alphabets.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace bio::ranges::detail
+{
+
+/*!\name Variable-length integers
+ * \{
+ */
+//!\brief Append `v` with 7 bits per byte; the highest bit of a byte signals that more bytes follow.
+inline void write_varint(std::vector<uint8_t> & out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+//!\brief Read a number written by bio::ranges::detail::write_varint() and advance `ptr`.
+//!\throws std::runtime_error If the data ends prematurely.
+inline uint64_t read_varint(uint8_t const *& ptr, uint8_t const * const end)
+{
+    uint64_t ret = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (ptr == end)
+            break;
+        uint8_t const byte = *ptr++;
+        ret |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return ret;
+    }
+    throw std::runtime_error{"Corrupted data: could not read variable-length integer."};
+}
+//!\}
+
+/*!\brief An order-1 rANS entropy coder for symbols of alphabets with up to 256 letters.
+ * \ingroup range
+ *
+ * \details
+ *
+ * The symbols are split into records. Every symbol is coded in the context of its predecessor in the same record
+ * (the first symbol of a record has its own context). For every context, the symbol frequencies of the data are
+ * stored along with the coded data (quantised to 10 bits), i.e. the model adapts to each block of data.
+ *
+ * The coder is range asymmetric numeral systems (rANS) with a 32-bit state and 16-bit renormalisation, after
+ * Fabian Giesen's public domain `rans_byte.h` and `rans_word_sse41.h`. The records are distributed over four lanes
+ * of roughly equal size (consecutive records per lane), and every lane has its own state and byte stream. Since each
+ * symbol depends on the previously decoded symbol of its lane, the lanes are decoded interleaved to hide the latency
+ * of the table lookups. Every #checkpoint_interval records, the coder state and stream position of the lane are
+ * stored, so that a single record is decoded from the preceding checkpoint of its lane (at most #checkpoint_interval
+ * records) and not from the beginning of the lane.
+ *
+ * Encoded format: the frequency table of each context (varint number of symbols, then symbol and varint frequency
+ * per symbol), the checkpoints of all lanes (state as four little-endian bytes and varint position in the lane's
+ * stream), the varint sizes of the lanes' streams, followed by the streams. Every stream begins with the final coder
+ * state and ends with two bytes of padding.
+ */
+struct rans_order1
+{
+    //!\brief Frequencies are quantised to `2^scale_bits`.
+    static constexpr uint32_t scale_bits = 10;
+    //!\brief The sum of the quantised frequencies of a context.
+    static constexpr uint32_t prob_scale = 1u << scale_bits;
+    //!\brief The lower bound of the normalised state.
+    static constexpr uint32_t rans_l     = 1u << 15;
+    //!\brief The number of lanes.
+    static constexpr size_t   n_lanes    = 4;
+    //!\brief The number of records between two checkpoints of a lane.
+    static constexpr size_t   checkpoint_interval = 8;
+
+    //!\brief The first record of each lane and the number of records at the end.
+    using lane_bounds_t = std::array<size_t, n_lanes + 1>;
+
+    //!\brief Distribute the records over the lanes so that every lane has roughly the same number of symbols.
+    static lane_bounds_t lane_bounds(std::span<size_t const> const lengths) noexcept
+    {
+        size_t const total = std::accumulate(lengths.begin(), lengths.end(), size_t{0});
+
+        lane_bounds_t ret{};
+        size_t        sum = 0;
+        size_t        r   = 0;
+        for (size_t lane = 1; lane < n_lanes; ++lane)
+        {
+            while (r < lengths.size() && sum < total * lane / n_lanes)
+                sum += lengths[r++];
+            ret[lane] = r;
+        }
+        ret[n_lanes] = lengths.size();
+        return ret;
+    }
+
+    //!\brief Quantise the counts of one context to sum up to bio::ranges::detail::rans_order1::prob_scale.
+    static void normalise(std::span<uint32_t const> const counts, std::span<uint16_t> const freqs)
+    {
+        uint64_t const total = std::accumulate(counts.begin(), counts.end(), uint64_t{0});
+        std::ranges::fill(freqs, 0);
+        if (total == 0)
+            return;
+
+        int64_t sum     = 0;
+        size_t  largest = 0;
+        for (size_t s = 0; s < counts.size(); ++s)
+        {
+            if (counts[s] == 0)
+                continue;
+            freqs[s] = static_cast<uint16_t>(std::max<uint64_t>(uint64_t{counts[s]} * prob_scale / total, 1));
+            sum += freqs[s];
+            if (counts[s] > counts[largest])
+                largest = s;
+        }
+
+        // give the rounding error to the most frequent symbol; if that is not possible, take from all symbols
+        int64_t const diff = static_cast<int64_t>(prob_scale) - sum;
+        if (freqs[largest] + diff >= 1)
+        {
+            freqs[largest] = static_cast<uint16_t>(freqs[largest] + diff);
+            return;
+        }
+        for (size_t s = 0; sum > prob_scale; s = (s + 1) % freqs.size())
+        {
+            if (freqs[s] > 1)
+            {
+                --freqs[s];
+                --sum;
+            }
+        }
+    }
+
+    /*!\brief Encode symbols and append them to `out`.
+     * \param[in]  symbols The symbols of all records (concatenated); each must be smaller than `sigma`.
+     * \param[in]  lengths The length of each record.
+     * \param[in]  sigma   The alphabet size; at most 256.
+     * \param[out] out     The encoded data is appended to this.
+     */
+    static void encode(std::span<uint8_t const> const symbols,
+                       std::span<size_t const> const  lengths,
+                       size_t const                   sigma,
+                       std::vector<uint8_t> &         out)
+    {
+        size_t const          contexts = sigma + 1;
+        std::vector<uint32_t> counts(contexts * sigma);
+        std::vector<uint16_t> freqs(contexts * sigma);
+        std::vector<uint16_t> starts(contexts * sigma);
+
+        // count
+        size_t pos = 0;
+        for (size_t const len : lengths)
+        {
+            size_t ctx = 0;
+            for (size_t i = 0; i < len; ++i, ++pos)
+            {
+                ++counts[ctx * sigma + symbols[pos]];
+                ctx = symbols[pos] + 1;
+            }
+        }
+
+        // quantise and write tables
+        for (size_t ctx = 0; ctx < contexts; ++ctx)
+        {
+            std::span<uint16_t> const f{freqs.data() + ctx * sigma, sigma};
+            normalise(std::span{counts.data() + ctx * sigma, sigma}, f);
+
+            write_varint(out, std::ranges::count_if(f, [](uint16_t const v) { return v != 0; }));
+            uint16_t start = 0;
+            for (size_t s = 0; s < sigma; ++s)
+            {
+                starts[ctx * sigma + s] = start;
+                if (f[s] != 0)
+                {
+                    out.push_back(static_cast<uint8_t>(s));
+                    write_varint(out, f[s]);
+                    start = static_cast<uint16_t>(start + f[s]);
+                }
+            }
+        }
+
+        // encode every lane backwards (the decoder reads forwards)
+        lane_bounds_t const                         bounds = lane_bounds(lengths);
+        std::array<std::vector<uint8_t>, n_lanes> streams;
+        std::array<std::vector<uint8_t>, n_lanes> checkpoints;
+
+        size_t lane_end = symbols.size();
+        for (size_t lane = n_lanes; lane-- > 0;)
+        {
+            std::vector<uint8_t> & rev = streams[lane];
+            uint32_t               x   = rans_l;
+
+            // the state and the number of bytes written at each checkpoint (in the order of encoding)
+            std::vector<std::pair<uint32_t, size_t>> lane_checkpoints;
+
+            pos = lane_end;
+            for (size_t r = bounds[lane + 1]; r-- > bounds[lane];)
+            {
+                size_t const record_begin = pos - lengths[r];
+                for (; pos > record_begin; --pos)
+                {
+                    size_t const   i     = pos - 1;
+                    size_t const   ctx   = (i == record_begin) ? 0 : symbols[i - 1] + 1;
+                    uint32_t const freq  = freqs[ctx * sigma + symbols[i]];
+                    uint32_t const start = starts[ctx * sigma + symbols[i]];
+
+                    // renormalise: at most one 16-bit word per symbol
+                    if (x >= ((rans_l >> scale_bits) << 16) * freq)
+                    {
+                        rev.push_back(static_cast<uint8_t>(x & 0xFF));
+                        rev.push_back(static_cast<uint8_t>((x >> 8) & 0xFF));
+                        x >>= 16;
+                    }
+                    x = ((x / freq) << scale_bits) + (x % freq) + start;
+                }
+
+                if (r > bounds[lane] && (r - bounds[lane]) % checkpoint_interval == 0)
+                    lane_checkpoints.emplace_back(x, rev.size());
+            }
+            lane_end = pos;
+
+            // the decoder reads the bytes written after a checkpoint first; they follow the 4 bytes of the state
+            for (auto const & [cx, written] : lane_checkpoints | std::views::reverse)
+            {
+                for (int k = 0; k < 4; ++k)
+                    checkpoints[lane].push_back(static_cast<uint8_t>(cx >> (8 * k)));
+                write_varint(checkpoints[lane], 4 + rev.size() - written);
+            }
+
+            for (int k = 0; k < 4; ++k)
+            {
+                rev.push_back(static_cast<uint8_t>(x & 0xFF));
+                x >>= 8;
+            }
+            std::ranges::reverse(rev);
+            rev.insert(rev.end(), 2, 0); // padding, see step()
+        }
+
+        for (std::vector<uint8_t> const & lane_checkpoints : checkpoints)
+            out.insert(out.end(), lane_checkpoints.begin(), lane_checkpoints.end());
+        for (std::vector<uint8_t> const & stream : streams)
+            write_varint(out, stream.size());
+        for (std::vector<uint8_t> const & stream : streams)
+            out.insert(out.end(), stream.begin(), stream.end());
+    }
+
+private:
+    //!\brief Pointers to the decoding tables (so that they are not reloaded after every write of a symbol).
+    struct table_pointers
+    {
+        uint32_t const * slots;        //!< See bio::ranges::detail::rans_order1::decoder.
+        uint32_t const * ctx_to_slots; //!< See bio::ranges::detail::rans_order1::decoder.
+    };
+
+    //!\brief The decoding state of one lane.
+    struct lane_state
+    {
+        uint32_t        x;         //!< The coder state.
+        uint8_t const * ptr;       //!< The current position in the lane's stream.
+        uint8_t const * last;      //!< The last position at which a 16-bit word may be read (before the padding).
+        uint8_t *       out;       //!< The output.
+        size_t          ctx;       //!< The current context.
+        size_t          remaining; //!< The number of symbols left in the current record.
+        size_t          record;    //!< The current record.
+        size_t          end;       //!< The record at which to stop.
+    };
+
+    //!\brief Advance to the next non-empty record; returns false if there is none.
+    static bool next_record(lane_state & l, std::span<size_t const> const lengths) noexcept
+    {
+        while (l.record < l.end && lengths[l.record] == 0)
+            ++l.record;
+        if (l.record == l.end)
+            return false;
+
+        l.ctx       = 0;
+        l.remaining = lengths[l.record++];
+        return true;
+    }
+
+    //!\brief Decode one symbol of a lane.
+    static void step(lane_state & l, table_pointers const t) noexcept
+    {
+        uint32_t const entry = t.slots[t.ctx_to_slots[l.ctx] + (l.x & (prob_scale - 1))];
+        uint32_t const s     = entry & 0xFF;
+        uint32_t const x_hi  = l.x >> scale_bits;
+        uint32_t const x     = ((entry >> 8) & 0xFFF) * x_hi + x_hi + (entry >> 20); // freq * x_hi + slot - start
+
+        // renormalise without branching (at most one 16-bit word per symbol)
+        bool const     renorm = (x < rans_l) & (l.ptr < l.last);
+        uint32_t const word   = (uint32_t{l.ptr[0]} << 8) | l.ptr[1];
+        l.ptr += 2 * renorm;
+        l.x = (x << (16 * renorm)) | (word & (0u - renorm)); // renorm ? (x << 16) | word : x
+
+        *l.out++ = static_cast<uint8_t>(s);
+        l.ctx    = s + 1;
+    }
+
+public:
+    /*!\brief Decodes data written by bio::ranges::detail::rans_order1::encode().
+     * \details
+     *
+     * The constructor reads the frequency tables and builds the decoding tables once, so that the data can be decoded
+     * (as a whole or record by record) any number of times afterwards. Every context that occurs has a table with one
+     * entry per slot (i.e. #prob_scale entries). An entry contains the symbol (bits 0-7), its frequency minus one
+     * (bits 8-19) and the offset of the slot from the symbol's first slot (bits 20-31), so that decoding a symbol
+     * needs a single lookup.
+     *
+     * The decoder refers to the encoded data, which must outlive it.
+     */
+    class decoder
+    {
+    private:
+        //!\brief The coder state and stream position of a lane at the beginning of a record.
+        struct checkpoint
+        {
+            uint32_t x;      //!< The coder state.
+            size_t   offset; //!< The position in the lane's stream.
+        };
+
+        //!\brief The slot tables of all contexts that occur.
+        std::vector<uint32_t>                    slots;
+        //!\brief The offset of every context's table in #slots.
+        std::vector<uint32_t>                    ctx_to_slots;
+        //!\brief The lengths of all records.
+        std::vector<size_t>                      lengths;
+        //!\brief The first record of every lane.
+        lane_bounds_t                            bounds;
+        //!\brief The checkpoints of all lanes.
+        std::vector<checkpoint>                  checkpoints;
+        //!\brief The first checkpoint of every lane in #checkpoints (and the number of checkpoints at the end).
+        std::array<size_t, n_lanes + 1>          lane_checkpoints;
+        //!\brief The beginning of every lane's stream (and the end of the last).
+        std::array<uint8_t const *, n_lanes + 1> streams;
+
+        //!\brief Read the tables; `ptr` is moved behind them.
+        void read_tables(uint8_t const *& ptr, uint8_t const * const end, size_t const sigma)
+        {
+            size_t const contexts = sigma + 1;
+            ctx_to_slots.assign(contexts, 0);
+            slots.reserve(contexts * prob_scale); // avoid reallocation; pages of unused contexts are never touched
+
+            for (size_t ctx = 0; ctx < contexts; ++ctx)
+            {
+                uint64_t const used = read_varint(ptr, end);
+                if (used == 0)
+                    continue;
+                if (used > sigma)
+                    throw std::runtime_error{"Corrupted data: invalid rANS frequency table."};
+
+                ctx_to_slots[ctx] = static_cast<uint32_t>(slots.size());
+                slots.resize(slots.size() + prob_scale);
+                uint32_t * const ctx_slots = slots.data() + ctx_to_slots[ctx];
+
+                uint32_t start = 0;
+                for (size_t j = 0; j < used; ++j)
+                {
+                    if (ptr == end)
+                        throw std::runtime_error{"Corrupted data: invalid rANS frequency table."};
+                    uint8_t const  s    = *ptr++;
+                    uint64_t const freq = read_varint(ptr, end);
+                    if (s >= sigma || freq == 0 || start + freq > prob_scale)
+                        throw std::runtime_error{"Corrupted data: invalid rANS frequency table."};
+
+                    for (uint32_t i = 0; i < freq; ++i)
+                        ctx_slots[start + i] = s | static_cast<uint32_t>(freq - 1) << 8 | i << 20;
+                    start += static_cast<uint32_t>(freq);
+                }
+                if (start != prob_scale)
+                    throw std::runtime_error{"Corrupted data: invalid rANS frequency table."};
+            }
+        }
+
+        //!\brief Read the checkpoints; `ptr` is moved behind them.
+        void read_checkpoints(uint8_t const *& ptr, uint8_t const * const end)
+        {
+            lane_checkpoints[0] = 0;
+            for (size_t lane = 0; lane < n_lanes; ++lane)
+            {
+                size_t const records       = bounds[lane + 1] - bounds[lane];
+                size_t const count         = records == 0 ? 0 : (records - 1) / checkpoint_interval;
+                lane_checkpoints[lane + 1] = lane_checkpoints[lane] + count;
+            }
+
+            checkpoints.resize(lane_checkpoints[n_lanes]);
+            for (checkpoint & c : checkpoints)
+            {
+                if (end - ptr < 4)
+                    throw std::runtime_error{"Corrupted data: invalid rANS checkpoint."};
+                c.x = uint32_t{ptr[0]} | (uint32_t{ptr[1]} << 8) | (uint32_t{ptr[2]} << 16) | (uint32_t{ptr[3]} << 24);
+                ptr += 4;
+                c.offset = read_varint(ptr, end);
+            }
+        }
+
+        //!\brief Read the sizes of the lanes' streams and store the beginning of each stream (and the end).
+        void read_streams(uint8_t const * ptr, uint8_t const * const end)
+        {
+            std::array<uint64_t, n_lanes> sizes;
+            for (uint64_t & size : sizes)
+                size = read_varint(ptr, end);
+
+            streams[0] = ptr;
+            for (size_t lane = 0; lane < n_lanes; ++lane)
+            {
+                if (sizes[lane] < 6 || static_cast<uint64_t>(end - streams[lane]) < sizes[lane])
+                    throw std::runtime_error{"Corrupted data: rANS stream is too short."};
+                streams[lane + 1] = streams[lane] + sizes[lane];
+
+                for (size_t c = lane_checkpoints[lane]; c < lane_checkpoints[lane + 1]; ++c)
+                    if (checkpoints[c].offset < 4 || checkpoints[c].offset > sizes[lane] - 2)
+                        throw std::runtime_error{"Corrupted data: invalid rANS checkpoint."};
+            }
+        }
+
+        /*!\brief Initialise the state of a lane at record `first`; returns false if the lane has no symbols before
+         *        record `last`.
+         * \details
+         *
+         * `first` is the first record of the lane or a record with a checkpoint.
+         */
+        bool init_lane(lane_state & l, size_t const lane, size_t const first, size_t const last, uint8_t * const out)
+          const noexcept
+        {
+            uint8_t const * const stream = streams[lane];
+            if (first == bounds[lane])
+            {
+                l.x = (uint32_t{stream[0]} << 24) | (uint32_t{stream[1]} << 16) | (uint32_t{stream[2]} << 8) |
+                      stream[3];
+                l.ptr = stream + 4;
+            }
+            else
+            {
+                size_t const       c  = lane_checkpoints[lane] + (first - bounds[lane]) / checkpoint_interval - 1;
+                checkpoint const & cp = checkpoints[c];
+                l.x                   = cp.x;
+                l.ptr                 = stream + cp.offset;
+            }
+            l.last   = streams[lane + 1] - 2;
+            l.out    = out;
+            l.ctx    = 0;
+            l.record = first;
+            l.end    = last;
+            return next_record(l, lengths);
+        }
+
+    public:
+        /*!\brief Read the tables of encoded data.
+         * \param[in] ptr     Beginning of the encoded data.
+         * \param[in] end     End of the encoded data.
+         * \param[in] lengths The lengths of all encoded records.
+         * \param[in] sigma   The alphabet size.
+         * \throws std::runtime_error If the data is corrupted.
+         */
+        decoder(uint8_t const * ptr, uint8_t const * const end, std::vector<size_t> lengths, size_t const sigma) :
+          lengths{std::move(lengths)}, bounds{lane_bounds(this->lengths)}
+        {
+            read_tables(ptr, end, sigma);
+            read_checkpoints(ptr, end);
+            read_streams(ptr, end);
+        }
+
+        /*!\brief Decode all symbols.
+         * \param[out] out The symbols; must have room for the sum of the lengths.
+         */
+        void decode(uint8_t * out) const noexcept
+        {
+            table_pointers const t{slots.data(), ctx_to_slots.data()};
+
+            std::array<lane_state, n_lanes> lanes;
+            std::array<bool, n_lanes>       active;
+            for (size_t lane = 0; lane < n_lanes; ++lane)
+            {
+                active[lane] = init_lane(lanes[lane], lane, bounds[lane], bounds[lane + 1], out);
+                out += std::accumulate(lengths.begin() + bounds[lane], lengths.begin() + bounds[lane + 1], size_t{0});
+            }
+
+            // decode all lanes interleaved, as long as all have symbols
+            while (std::ranges::all_of(active, std::identity{}))
+            {
+                size_t const n = std::ranges::min(lanes, {}, &lane_state::remaining).remaining;
+
+                // local copies, so that the states are kept in registers
+                auto [l0, l1, l2, l3] = lanes;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    step(l0, t);
+                    step(l1, t);
+                    step(l2, t);
+                    step(l3, t);
+                }
+                lanes = {l0, l1, l2, l3};
+
+                for (size_t lane = 0; lane < n_lanes; ++lane)
+                    if ((lanes[lane].remaining -= n) == 0)
+                        active[lane] = next_record(lanes[lane], lengths);
+            }
+
+            // decode the remaining lanes one by one
+            for (size_t lane = 0; lane < n_lanes; ++lane)
+            {
+                for (; active[lane]; active[lane] = next_record(lanes[lane], lengths))
+                    for (; lanes[lane].remaining > 0; --lanes[lane].remaining)
+                        step(lanes[lane], t);
+            }
+        }
+
+        /*!\brief Decode a single record.
+         * \param[in]  record The number of the record.
+         * \param[out] buffer Resized and used to decode the record and the preceding records since the last
+         *                    checkpoint of its lane.
+         * \returns The symbols of the record (a subrange of `buffer`).
+         */
+        std::span<uint8_t const> decode_record(size_t const record, std::vector<uint8_t> & buffer) const
+        {
+            assert(record < lengths.size());
+            table_pointers const t{slots.data(), ctx_to_slots.data()};
+
+            size_t const lane  = std::ranges::upper_bound(bounds, record) - bounds.begin() - 1;
+            size_t const first = record - (record - bounds[lane]) % checkpoint_interval;
+            buffer.resize(std::accumulate(lengths.begin() + first, lengths.begin() + record + 1, size_t{0}));
+
+            lane_state l;
+            for (bool active = init_lane(l, lane, first, record + 1, buffer.data()); active;
+                 active      = next_record(l, lengths))
+                for (; l.remaining > 0; --l.remaining)
+                    step(l, t);
+
+            return std::span{buffer}.last(lengths[record]);
+        }
+    };
+
+    /*!\brief Decode all symbols.
+     * \param[in]  ptr     Beginning of the encoded data.
+     * \param[in]  end     End of the encoded data.
+     * \param[in]  lengths The lengths of all encoded records.
+     * \param[in]  sigma   The alphabet size.
+     * \param[out] out     The symbols; must have room for the sum of `lengths`.
+     * \throws std::runtime_error If the data is corrupted.
+     */
+    static void decode(uint8_t const * const         ptr,
+                       uint8_t const * const         end,
+                       std::span<size_t const> const lengths,
+                       size_t const                  sigma,
+                       uint8_t * const               out)
+    {
+        decoder{ptr, end, std::vector<size_t>(lengths.begin(), lengths.end()), sigma}.decode(out);
+    }
+};
+
+} // namespace bio::ranges::detail
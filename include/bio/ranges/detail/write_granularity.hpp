@@ -0,0 +1,40 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::detail::write_granularity.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <ranges>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief The number of elements of a container that may not be written to concurrently.
+ * \ingroup range
+ * \details
+ *
+ * Containers that pack multiple elements into one word (e.g. bio::ranges::bitcompressed_vector or
+ * `std::vector<bool>`) must be split into chunks at multiples of this number when written from multiple threads.
+ */
+template <typename container_t>
+constexpr size_t write_granularity()
+{
+    if constexpr (requires { container_t::letters_per_word; })
+        return container_t::letters_per_word; // e.g. bio::ranges::bitcompressed_vector
+    else if constexpr (std::same_as<std::ranges::range_value_t<container_t>, bool>)
+        return 64; // std::vector<bool>
+    else
+        return 1;
+}
+
+} // namespace bio::ranges::detail
@@ -0,0 +1,280 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::edit_distance and bio::ranges::edit_distances.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief A pattern prepared for Myers' bit-parallel edit distance algorithm.
+ * \tparam alph_t The alphabet of the pattern.
+ * \ingroup range
+ *
+ * \details
+ *
+ * The pattern is split into blocks of 64 letters. For every rank of the alphabet and every block, a bit mask of the
+ * positions with this rank is computed once ("Peq"); the texts are then processed one letter (column of the DP
+ * matrix) at a time, with one step of the algorithm per block in the band.
+ *
+ * The implementation follows the block-based formulation of Myers (1999) with Hyyrö's handling of horizontal
+ * input deltas. The band is derived from the maximum distance `k`: a cell `(i, j)` can only be on an alignment
+ * with at most `k` differences if `|i - j| + |(m - i) - (n - j)| <= k`, so only the blocks that intersect this
+ * diagonal band are computed. Cells outside the band are over-estimated, which never affects the result if it is at
+ * most `k`.
+ */
+template <alphabet::semialphabet alph_t>
+class myers_pattern
+{
+private:
+    //!\brief The number of bits in a word.
+    static constexpr size_t word_size = 64;
+    //!\brief The size of the alphabet.
+    static constexpr size_t sigma     = alphabet::size<alph_t>;
+
+    //!\brief The pattern length.
+    size_t                m      = 0;
+    //!\brief The number of blocks.
+    size_t                blocks = 0;
+    //!\brief The bit masks; `peq[rank * blocks + b]` has bit `i` set iff letter `b * 64 + i` has this rank.
+    std::vector<uint64_t> peq;
+
+    //!\brief The state of one block: vertical deltas and the score in the last row.
+    struct block_state
+    {
+        uint64_t pv;    //!< Positive vertical deltas.
+        uint64_t mv;    //!< Negative vertical deltas.
+        size_t   score; //!< The value of the last row of the block.
+    };
+
+    //!\brief The state of all blocks (reused between texts).
+    std::vector<block_state> state;
+
+    //!\brief One step for one block; returns the horizontal delta at row `out_bit`.
+    static int advance_block(block_state & s, uint64_t eq, int const hin, size_t const out_bit) noexcept
+    {
+        uint64_t const pv = s.pv;
+        uint64_t const mv = s.mv;
+        uint64_t const xv = eq | mv;
+        if (hin < 0)
+            eq |= 1;
+        uint64_t const xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t       ph = mv | ~(xh | pv);
+        uint64_t       mh = pv & xh;
+
+        int const hout = static_cast<int>((ph >> out_bit) & 1) - static_cast<int>((mh >> out_bit) & 1);
+
+        ph <<= 1;
+        mh <<= 1;
+        if (hin < 0)
+            mh |= 1;
+        else if (hin > 0)
+            ph |= 1;
+        s.pv = mh | ~(xv | ph);
+        s.mv = ph & xv;
+        s.score += hout;
+        return hout;
+    }
+
+    //!\brief The number of rows of block `b`.
+    size_t rows_in(size_t const b) const noexcept { return std::min(word_size, m - b * word_size); }
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    myers_pattern()                                  = default; //!< Defaulted.
+    myers_pattern(myers_pattern const &)             = default; //!< Defaulted.
+    myers_pattern(myers_pattern &&)                  = default; //!< Defaulted.
+    myers_pattern & operator=(myers_pattern const &) = default; //!< Defaulted.
+    myers_pattern & operator=(myers_pattern &&)      = default; //!< Defaulted.
+    ~myers_pattern()                                 = default; //!< Defaulted.
+
+    //!\brief Compute the bit masks of the pattern.
+    template <std::ranges::forward_range pattern_t>
+    explicit myers_pattern(pattern_t && pattern) :
+      m{static_cast<size_t>(std::ranges::distance(pattern))},
+      blocks{(m + word_size - 1) / word_size},
+      peq(sigma * blocks, 0),
+      state(blocks)
+    {
+        size_t i = 0;
+        for (auto && l : pattern)
+        {
+            peq[alphabet::to_rank(l) * blocks + i / word_size] |= uint64_t{1} << (i % word_size);
+            ++i;
+        }
+    }
+    //!\}
+
+    //!\brief The length of the pattern.
+    size_t size() const noexcept { return m; }
+
+    /*!\brief The edit distance between the pattern and `text`.
+     * \param[in] text         The text; a std::ranges::input_range over `alph_t`.
+     * \param[in] n            The size of the text.
+     * \param[in] max_distance The maximum distance of interest.
+     * \returns The distance, or `max_distance + 1` if it is larger.
+     */
+    template <typename text_t>
+    size_t distance(text_t && text, size_t const n, size_t const max_distance)
+    {
+        size_t const diff = m > n ? m - n : n - m;
+        if (diff > max_distance)
+            return max_distance + 1;
+        if (m == 0 || n == 0)
+            return diff;
+
+        // the distance is never larger than max(m, n)
+        size_t const k = std::min(max_distance, std::max(m, n));
+
+        // rows i of column j that are in the band: i - j in [lo_diag, hi_diag]
+        ptrdiff_t const delta   = static_cast<ptrdiff_t>(m) - static_cast<ptrdiff_t>(n);
+        ptrdiff_t const slack   = static_cast<ptrdiff_t>(k - diff) / 2;
+        ptrdiff_t const lo_diag = std::min<ptrdiff_t>(0, delta) - slack;
+        ptrdiff_t const hi_diag = std::max<ptrdiff_t>(0, delta) + slack;
+
+        auto block_of_row = [](ptrdiff_t const row) { return static_cast<size_t>(row - 1) / word_size; };
+        auto first_row    = [&](size_t const j)
+        { return std::max<ptrdiff_t>(1, static_cast<ptrdiff_t>(j) + lo_diag); };
+        auto last_row     = [&](size_t const j)
+        { return std::min<ptrdiff_t>(static_cast<ptrdiff_t>(m), static_cast<ptrdiff_t>(j) + hi_diag); };
+
+        // column 0: D[i][0] = i
+        size_t last_block = block_of_row(last_row(1));
+        for (size_t b = 0; b <= last_block; ++b)
+            state[b] = block_state{~uint64_t{0}, 0, b * word_size + rows_in(b)};
+
+        if (blocks == 1) // the whole pattern fits into one word
+        {
+            block_state            s       = state[0];
+            size_t const           out_bit = m - 1;
+            uint64_t const * const eqs     = peq.data();
+            for (auto && l : text)
+                advance_block(s, eqs[alphabet::to_rank(l)], 1, out_bit);
+            return s.score > max_distance ? max_distance + 1 : s.score;
+        }
+
+        size_t j = 1;
+        for (auto && l : text)
+        {
+            size_t const     first_block = block_of_row(first_row(j));
+            size_t const     new_last    = block_of_row(last_row(j));
+            uint64_t const * eq          = peq.data() + alphabet::to_rank(l) * blocks;
+
+            if (new_last > last_block) // the band reaches a new block; assume vertical deltas of +1 (over-estimate)
+            {
+                state[new_last] = block_state{~uint64_t{0}, 0, state[last_block].score + rows_in(new_last)};
+                last_block      = new_last;
+            }
+
+            int hin = 1; // the top row (or the over-estimated row above the band) increases by one per column
+            for (size_t b = first_block; b < last_block; ++b)
+                hin = advance_block(state[b], eq[b], hin, word_size - 1);
+            advance_block(state[last_block], eq[last_block], hin, rows_in(last_block) - 1);
+            ++j;
+        }
+
+        size_t const score = state[blocks - 1].score;
+        return score > max_distance ? max_distance + 1 : score;
+    }
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Compute the edit (Levenshtein) distance between two sequences.
+ * \ingroup range
+ * \param[in] pattern      The first sequence; letters of a bio::alphabet::semialphabet.
+ * \param[in] text         The second sequence; of the same alphabet.
+ * \param[in] max_distance The maximum distance of interest (band limit).
+ * \returns The number of substitutions, insertions and deletions needed to transform one sequence into the other,
+ *          or `max_distance + 1` if this is larger than `max_distance`.
+ *
+ * \details
+ *
+ * This uses Myers' bit-parallel algorithm: the DP matrix is computed one column (letter of `text`) at a time,
+ * with 64 cells per word. Patterns longer than 64 letters are split into blocks of 64. Letters are compared by
+ * rank, so any bio::alphabet::semialphabet works.
+ *
+ * If `max_distance` is given, only the blocks that intersect a diagonal band of width `max_distance` are computed,
+ * and pairs whose lengths differ by more than `max_distance` are rejected immediately. Choosing a small threshold is
+ * therefore much faster for long sequences.
+ *
+ * To compare one pattern with many texts, use bio::ranges::edit_distances, which prepares the pattern only once.
+ *
+ * ### Complexity
+ *
+ * `O(n * ⌈min(m, max_distance) / 64⌉)` for a pattern of length `m` and a text of length `n`.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/edit_distance.cpp
+ */
+template <std::ranges::forward_range pattern_t, std::ranges::input_range text_t>
+    requires(alphabet::semialphabet<std::ranges::range_value_t<pattern_t>> &&
+             std::same_as<std::ranges::range_value_t<pattern_t>, std::ranges::range_value_t<text_t>> &&
+             std::ranges::sized_range<text_t>)
+size_t edit_distance(pattern_t && pattern,
+                     text_t &&    text,
+                     size_t const max_distance = std::numeric_limits<size_t>::max())
+{
+    detail::myers_pattern<std::ranges::range_value_t<pattern_t>> prepared{pattern};
+    return prepared.distance(text, std::ranges::size(text), max_distance);
+}
+
+/*!\brief Compute the edit (Levenshtein) distances between one pattern and many texts.
+ * \ingroup range
+ * \param[in] pattern      The pattern; letters of a bio::alphabet::semialphabet.
+ * \param[in] texts        A range of sized ranges of the same alphabet, e.g. bio::ranges::concatenated_sequences.
+ * \param[in] max_distance The maximum distance of interest (band limit).
+ * \returns A std::vector with one distance per text; distances larger than `max_distance` are `max_distance + 1`.
+ *
+ * \details
+ *
+ * This computes the same as calling bio::ranges::edit_distance for every text, but the bit masks of the pattern
+ * and the working memory are created only once.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/edit_distance.cpp
+ */
+template <std::ranges::forward_range pattern_t, std::ranges::input_range texts_t>
+    requires(alphabet::semialphabet<std::ranges::range_value_t<pattern_t>> &&
+             std::ranges::sized_range<std::ranges::range_reference_t<texts_t>> &&
+             std::same_as<std::ranges::range_value_t<pattern_t>,
+                          std::ranges::range_value_t<std::ranges::range_reference_t<texts_t>>>)
+std::vector<size_t> edit_distances(pattern_t && pattern,
+                                   texts_t &&   texts,
+                                   size_t const max_distance = std::numeric_limits<size_t>::max())
+{
+    detail::myers_pattern<std::ranges::range_value_t<pattern_t>> prepared{pattern};
+
+    std::vector<size_t> ret;
+    if constexpr (std::ranges::sized_range<texts_t>)
+        ret.reserve(std::ranges::size(texts));
+    for (auto && text : texts)
+        ret.push_back(prepared.distance(text, std::ranges::size(text), max_distance));
+    return ret;
+}
+
+} // namespace bio::ranges
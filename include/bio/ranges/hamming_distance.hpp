@@ -0,0 +1,347 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::hamming_distance and bio::ranges::hamming_distances.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/detail/byte_words.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief A range that provides the ranks of multiple letters in one word, like bio::ranges::bitcompressed_vector.
+ * \ingroup range
+ */
+template <typename rng_t>
+concept packed_rank_range = std::ranges::sized_range<rng_t> && requires(rng_t const & r) {
+    {
+        r.packed_ranks(size_t{}, size_t{})
+    } -> std::same_as<uint64_t>;
+    {
+        std::remove_cvref_t<rng_t>::bits_per_letter
+    } -> std::convertible_to<size_t>;
+};
+
+/*!\brief A contiguous range of letters that store their rank in a single byte (e.g. std::vector<dna4>).
+ * \ingroup range
+ */
+template <typename rng_t>
+concept byte_rank_range = std::ranges::contiguous_range<rng_t> && std::ranges::sized_range<rng_t> &&
+                          bytewise_comparable_letter<std::ranges::range_value_t<rng_t>>;
+
+//!\brief A word with the lowest bit of every letter set.
+template <size_t bits_per_letter>
+inline constexpr uint64_t lowest_letter_bits = []()
+{
+    uint64_t ret = 0;
+    for (size_t i = 0; i + bits_per_letter <= 64; i += bits_per_letter)
+        ret |= uint64_t{1} << i;
+    return ret;
+}();
+
+/*!\brief The number of set bits.
+ * \details
+ *
+ * Without a popcount instruction in the target architecture (e.g. `-march=x86-64`), std::popcount is a library call;
+ * the bit-parallel fallback is inlined and much faster.
+ */
+inline size_t popcount64(uint64_t x) noexcept
+{
+#if defined(__POPCNT__) || defined(__ARM_NEON)
+    return std::popcount(x);
+#else
+    x = x - ((x >> 1) & 0x5555'5555'5555'5555ull);
+    x = (x & 0x3333'3333'3333'3333ull) + ((x >> 2) & 0x3333'3333'3333'3333ull);
+    x = (x + (x >> 4)) & 0x0f0f'0f0f'0f0f'0f0full;
+    return (x * 0x0101'0101'0101'0101ull) >> 56;
+#endif
+}
+
+//!\brief The number of letters (of `bits_per_letter` bits each) that are not zero in `x`.
+template <size_t bits_per_letter>
+inline size_t nonzero_letters(uint64_t x) noexcept
+{
+    // fold every letter onto its lowest bit; shifts smaller than the letter size never cross a letter boundary
+    uint64_t folded = x;
+    for (size_t s = 1; s < bits_per_letter; ++s)
+        folded |= x >> s;
+    return popcount64(folded & lowest_letter_bits<bits_per_letter>);
+}
+
+//!\brief The result of a comparison that exceeds the threshold.
+inline size_t clamp_distance(size_t const distance, size_t const max_distance) noexcept
+{
+    return distance > max_distance ? max_distance + 1 : distance;
+}
+
+/*!\brief The number of differing bytes in `[l, l + size)` and `[r, r + size)`, stopping early above `max_distance`.
+ * \details
+ *
+ * Blocks of 64 bytes are compared in a loop without early exit, which the compiler vectorises; the threshold is
+ * checked after every block. The remaining bytes are compared eight at a time.
+ */
+inline size_t byte_mismatches(unsigned char const * const l,
+                              unsigned char const * const r,
+                              size_t const                size,
+                              size_t const                max_distance) noexcept
+{
+    size_t d = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        uint8_t block = 0;
+        for (size_t j = 0; j < 64; ++j)
+            block += l[i + j] != r[i + j];
+        d += block;
+        if (d > max_distance)
+            return d;
+    }
+    for (; i + 8 <= size; i += 8)
+        d += nonzero_byte_count(load_word(l + i) ^ load_word(r + i));
+    if (i < size) // the remaining bytes are zero in both words
+    {
+        uint64_t lw = 0, rw = 0;
+        std::memcpy(&lw, l + i, size - i);
+        std::memcpy(&rw, r + i, size - i);
+        d += nonzero_byte_count(lw ^ rw);
+    }
+    return d;
+}
+
+/*!\brief The query of bio::ranges::hamming_distances, prepared for a kind of target range.
+ * \tparam target_t The type of the targets.
+ * \ingroup range
+ *
+ * \details
+ *
+ * The query is converted once into the layout of the targets (words of packed ranks, bytes or plain ranks).
+ */
+template <typename target_t>
+class hamming_query
+{
+private:
+    //!\brief The kind of preparation.
+    static constexpr int kind = packed_rank_range<target_t> ? 0 : byte_rank_range<target_t> ? 1 : 2;
+
+    //!\brief The number of letters per word.
+    static constexpr size_t letters_per_word = []()
+    {
+        if constexpr (kind == 0)
+            return 64 / std::remove_cvref_t<target_t>::bits_per_letter;
+        else
+            return 1;
+    }();
+
+    //!\brief The query as words of packed ranks or as ranks (one per word).
+    std::vector<uint64_t>      words;
+    //!\brief The query as bytes.
+    std::vector<unsigned char> bytes;
+    //!\brief The number of letters.
+    size_t                     size = 0;
+
+public:
+    //!\brief Prepare the query.
+    template <typename query_t>
+    explicit hamming_query(query_t const & query) : size{static_cast<size_t>(std::ranges::size(query))}
+    {
+        if constexpr (kind != 1)
+            words.resize((size + letters_per_word - 1) / letters_per_word);
+        if constexpr (kind == 0)
+        {
+            constexpr size_t bits = std::remove_cvref_t<target_t>::bits_per_letter;
+            size_t           i    = 0;
+            for (auto const l : query)
+            {
+                words[i / letters_per_word] |= uint64_t{alphabet::to_rank(l)} << (i % letters_per_word * bits);
+                ++i;
+            }
+        }
+        else if constexpr (kind == 1) // the same bytes as in the targets
+        {
+            bytes.resize(size);
+            std::ranges::transform(query,
+                                   bytes.begin(),
+                                   [](auto const l)
+                                   { return std::bit_cast<unsigned char>(std::ranges::range_value_t<query_t>(l)); });
+        }
+        else
+        {
+            std::ranges::transform(query, words.begin(), [](auto const l) { return alphabet::to_rank(l); });
+        }
+    }
+
+    //!\brief Compare with a target.
+    size_t distance(target_t const & target, size_t const max_distance) const
+    {
+        if (static_cast<size_t>(std::ranges::size(target)) != size)
+            throw std::invalid_argument{"Hamming distances can only be computed between ranges of the same size."};
+
+        size_t d = 0;
+        if constexpr (kind == 0)
+        {
+            constexpr size_t bits = std::remove_cvref_t<target_t>::bits_per_letter;
+            for (size_t k = 0, i = 0; k < words.size(); ++k, i += letters_per_word)
+            {
+                d += nonzero_letters<bits>(words[k] ^
+                                           target.packed_ranks(i, std::min(letters_per_word, size - i)));
+                if (d > max_distance)
+                    break;
+            }
+        }
+        else if constexpr (kind == 1)
+        {
+            d = byte_mismatches(bytes.data(),
+                                reinterpret_cast<unsigned char const *>(std::ranges::data(target)),
+                                size,
+                                max_distance);
+        }
+        else
+        {
+            auto it = std::ranges::begin(target);
+            for (size_t i = 0; i < size && d <= max_distance; ++i, ++it)
+                d += words[i] != alphabet::to_rank(*it);
+        }
+        return clamp_distance(d, max_distance);
+    }
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Count the positions at which two ranges of letters differ.
+ * \ingroup range
+ * \param[in] lhs          The first range.
+ * \param[in] rhs          The second range; must have the same size.
+ * \param[in] max_distance Stop as soon as the distance exceeds this value.
+ * \returns The Hamming distance, or `max_distance + 1` if it is larger than `max_distance`.
+ * \throws std::invalid_argument If the ranges have different sizes.
+ *
+ * \details
+ *
+ * Letters are compared with `==`. Depending on the types of the ranges, multiple letters are compared at once:
+ *
+ *   * If both ranges are bio::ranges::bitcompressed_vector or bio::ranges::bitcompressed_slice (e.g. elements of
+ *     bio::ranges::concatenated_sequences) of the same alphabet, a word of packed ranks (32 letters of
+ *     bio::alphabet::dna4) is compared with one XOR and one popcount.
+ *   * If both ranges are contiguous ranges of the same single-byte alphabet (e.g. std::vector<bio::alphabet::dna5>),
+ *     blocks of 64 letters are compared in a loop that the compiler vectorises, and the rest eight letters at a time
+ *     with one XOR and a few bit operations.
+ *
+ * The threshold is checked after every word or block, so pairs that are far apart are rejected early.
+ *
+ * To compare one sequence with many others (e.g. a read with all barcodes), use bio::ranges::hamming_distances.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/hamming_distance.cpp
+ */
+template <std::ranges::random_access_range lhs_t, std::ranges::random_access_range rhs_t>
+    requires(std::ranges::sized_range<lhs_t> && std::ranges::sized_range<rhs_t> &&
+             alphabet::semialphabet<std::ranges::range_value_t<lhs_t>> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<lhs_t>,
+                                           std::ranges::range_reference_t<rhs_t>>)
+size_t hamming_distance(lhs_t && lhs,
+                        rhs_t && rhs,
+                        size_t const max_distance = std::numeric_limits<size_t>::max())
+{
+    size_t const size = std::ranges::size(lhs);
+    if (size != static_cast<size_t>(std::ranges::size(rhs)))
+        throw std::invalid_argument{"Hamming distances can only be computed between ranges of the same size."};
+
+    constexpr bool same_alphabet = std::same_as<std::ranges::range_value_t<lhs_t>, std::ranges::range_value_t<rhs_t>>;
+
+    size_t d = 0;
+    if constexpr (same_alphabet && detail::packed_rank_range<lhs_t> && detail::packed_rank_range<rhs_t>)
+    {
+        constexpr size_t bits = std::remove_cvref_t<lhs_t>::bits_per_letter;
+        constexpr size_t lpw  = 64 / bits;
+        for (size_t i = 0; i < size; i += lpw)
+        {
+            size_t const count = std::min(lpw, size - i);
+            d += detail::nonzero_letters<bits>(lhs.packed_ranks(i, count) ^ rhs.packed_ranks(i, count));
+            if (d > max_distance)
+                break;
+        }
+    }
+    else if constexpr (same_alphabet && detail::byte_rank_range<lhs_t> && detail::byte_rank_range<rhs_t>)
+    {
+        d = detail::byte_mismatches(reinterpret_cast<unsigned char const *>(std::ranges::data(lhs)),
+                                    reinterpret_cast<unsigned char const *>(std::ranges::data(rhs)),
+                                    size,
+                                    max_distance);
+    }
+    else
+    {
+        auto l = std::ranges::begin(lhs);
+        auto r = std::ranges::begin(rhs);
+        for (size_t i = 0; i < size && d <= max_distance; ++i, ++l, ++r)
+            d += !(*l == *r);
+    }
+
+    return detail::clamp_distance(d, max_distance);
+}
+
+/*!\brief Compute the Hamming distances between one range and many others.
+ * \ingroup range
+ * \param[in] query        The range that is compared to all targets.
+ * \param[in] targets      A range of ranges (e.g. bio::ranges::concatenated_sequences); all must have the size of
+ *                         `query`.
+ * \param[in] max_distance Stop comparing with a target as soon as the distance exceeds this value.
+ * \returns A std::vector with one distance per target; distances larger than `max_distance` are `max_distance + 1`.
+ * \throws std::invalid_argument If a target has a different size than the query.
+ *
+ * \details
+ *
+ * This computes the same as calling bio::ranges::hamming_distance for every target, but the query is converted only
+ * once into the layout of the targets, e.g. into words of packed ranks for bio::ranges::bitcompressed_slice targets.
+ * For short queries like barcodes this is a single word that stays in a register while the targets are streamed.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/hamming_distance.cpp
+ */
+template <std::ranges::forward_range query_t, std::ranges::input_range targets_t>
+    requires(std::ranges::sized_range<query_t> &&
+             std::ranges::random_access_range<std::ranges::range_reference_t<targets_t>> &&
+             std::same_as<std::ranges::range_value_t<query_t>,
+                          std::ranges::range_value_t<std::ranges::range_reference_t<targets_t>>> &&
+             alphabet::semialphabet<std::ranges::range_value_t<query_t>>)
+std::vector<size_t> hamming_distances(query_t &&   query,
+                                      targets_t && targets,
+                                      size_t const max_distance = std::numeric_limits<size_t>::max())
+{
+    using target_t = std::remove_cvref_t<std::ranges::range_reference_t<targets_t>>;
+
+    detail::hamming_query<target_t> const prepared{query};
+
+    std::vector<size_t> ret;
+    if constexpr (std::ranges::sized_range<targets_t>)
+        ret.reserve(std::ranges::size(targets));
+    for (auto && target : targets)
+        ret.push_back(prepared.distance(target, max_distance));
+    return ret;
+}
+
+} // namespace bio::ranges
@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
 #include <ranges>
+#include <type_traits>
 
 #include <bio/alphabet/hash.hpp>
 #include <bio/ranges/concept.hpp>
@@ -40,13 +44,38 @@ struct hash<urng_t>
         requires bio::alphabet::semialphabet<std::ranges::range_reference_t<urng2_t>>
     size_t operator()(urng2_t && range) const noexcept
     {
-        using alphabet_t = std::ranges::range_reference_t<urng_t>;
-        size_t           result{0};
-        hash<alphabet_t> h{};
-        for (alphabet_t character : range)
+        using alphabet_t = std::remove_cvref_t<std::ranges::range_reference_t<urng_t>>;
+        size_t result{0};
+
+        // packed ranges (e.g. bio::ranges::bitcompressed_slice): read one word at a time
+        if constexpr (ranges::sized_range<urng2_t> && requires {
+                          { range.packed_ranks(size_t{}, size_t{}) } -> std::same_as<uint64_t>;
+                          std::remove_cvref_t<urng2_t>::bits_per_letter;
+                          std::remove_cvref_t<urng2_t>::letters_per_word;
+                      })
+        {
+            constexpr size_t   bits  = std::remove_cvref_t<urng2_t>::bits_per_letter;
+            constexpr size_t   lpw   = std::remove_cvref_t<urng2_t>::letters_per_word;
+            constexpr size_t   sigma = bio::alphabet::size<alphabet_t>;
+            constexpr uint64_t mask  = (1ull << bits) - 1ull;
+
+            size_t const n = ranges::size(range);
+            for (size_t i = 0; i < n; i += lpw)
+            {
+                size_t const count = std::min(lpw, n - i);
+                uint64_t     word  = range.packed_ranks(i, count);
+                for (size_t k = 0; k < count; ++k, word >>= bits)
+                    result = result * sigma + (word & mask);
+            }
+        }
+        else
         {
-            result *= bio::alphabet::size<alphabet_t>;
-            result += h(character);
+            hash<alphabet_t> h{};
+            for (alphabet_t character : range)
+            {
+                result *= bio::alphabet::size<alphabet_t>;
+                result += h(character);
+            }
         }
         return result;
     }
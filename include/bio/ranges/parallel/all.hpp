@@ -0,0 +1,24 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Meta-header for the \link parallel parallel submodule \endlink.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <bio/ranges/parallel/bounded_queue.hpp>
+#include <bio/ranges/parallel/for_each.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+/*!\defgroup parallel Parallel
+ * \brief The parallel submodule contains a thread pool, a concurrent queue and parallel algorithms over ranges.
+ * \ingroup range
+ * \sa range/parallel/all.hpp
+ */
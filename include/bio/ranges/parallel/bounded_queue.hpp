@@ -0,0 +1,329 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::bounded_queue.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace bio::ranges
+{
+
+/*!\brief The result of an operation on bio::ranges::bounded_queue.
+ * \ingroup parallel
+ */
+enum class queue_op_status : uint8_t
+{
+    success, //!< The element was pushed or popped.
+    full,    //!< The queue was full (only returned by bio::ranges::bounded_queue::try_push).
+    empty,   //!< The queue was empty (only returned by bio::ranges::bounded_queue::try_pop).
+    closed   //!< The queue is closed (push) or closed and empty (pop).
+};
+
+/*!\brief A bounded multi-producer/multi-consumer queue.
+ * \ingroup parallel
+ * \tparam value_t The element type; must be nothrow move-constructible and nothrow move-assignable.
+ *
+ * \details
+ *
+ * This is a lock-free ring buffer (after Dmitry Vyukov's bounded MPMC queue): every slot has a sequence number
+ * that tells producers and consumers whether the slot is free or filled, so pushing and popping only requires
+ * one compare-and-swap on the respective position. Elements are moved in and out; a batch of sequences (e.g. a
+ * bio::ranges::concatenated_sequences) is never copied.
+ *
+ * The non-blocking functions try_push() and try_pop() never wait. The blocking functions push() and pop() spin
+ * briefly and then sleep until the queue changes.
+ *
+ * After close() has been called, pushing fails with bio::ranges::queue_op_status::closed. Elements that are
+ * already in the queue can still be popped; pop() returns bio::ranges::queue_op_status::closed once the queue is
+ * empty. Pushes that compete with close() either succeed (and their elements are popped) or fail.
+ *
+ * ### Thread safety
+ *
+ * All member functions except the destructor may be called concurrently.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/parallel/bounded_queue.cpp
+ */
+template <typename value_t>
+    requires(std::is_nothrow_move_constructible_v<value_t> && std::is_nothrow_move_assignable_v<value_t>)
+class bounded_queue
+{
+public:
+    //!\brief The element type.
+    using value_type = value_t;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bounded_queue(bounded_queue const &)             = delete; //!< Deleted.
+    bounded_queue(bounded_queue &&)                  = delete; //!< Deleted.
+    bounded_queue & operator=(bounded_queue const &) = delete; //!< Deleted.
+    bounded_queue & operator=(bounded_queue &&)      = delete; //!< Deleted.
+
+    /*!\brief Construct with the given capacity.
+     * \param[in] capacity The maximum number of elements; rounded up to a power of two (and at least 2).
+     */
+    explicit bounded_queue(size_t const capacity) :
+      mask{std::bit_ceil(std::max<size_t>(capacity, 2)) - 1}, cells{std::make_unique<cell[]>(mask + 1)}
+    {
+        for (size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    //!\brief Destroys all elements that are still in the queue.
+    ~bounded_queue()
+    {
+        size_t const end = enqueue_pos.load(std::memory_order_relaxed) & ~closed_bit;
+        for (size_t pos = dequeue_pos.load(std::memory_order_relaxed); pos < end; ++pos)
+            std::destroy_at(cells[pos & mask].ptr());
+    }
+    //!\}
+
+    /*!\name Push
+     * \{
+     */
+    /*!\brief Push an element if the queue is not full.
+     * \param[in] value The element; it is only moved from on success.
+     * \returns bio::ranges::queue_op_status::success, bio::ranges::queue_op_status::full or
+     *          bio::ranges::queue_op_status::closed.
+     */
+    queue_op_status try_push(value_type && value) noexcept
+    {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        cell * c   = nullptr;
+
+        while (true)
+        {
+            if (pos & closed_bit)
+                return queue_op_status::closed;
+
+            c                  = &cells[pos & mask];
+            size_t const seq   = c->sequence.load(std::memory_order_acquire);
+            intptr_t const dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (dif == 0)
+            {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                return queue_op_status::full;
+            }
+            else
+            {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::construct_at(c->ptr(), std::move(value));
+        c->sequence.store(pos + 1, std::memory_order_release);
+        notify(push_events, consumers_waiting);
+        return queue_op_status::success;
+    }
+
+    //!\copydoc try_push(value_type &&)
+    queue_op_status try_push(value_type const & value)
+        requires std::copy_constructible<value_type>
+    {
+        return try_push(value_type{value});
+    }
+
+    /*!\brief Push an element, wait while the queue is full.
+     * \param[in] value The element; it is only moved from on success.
+     * \returns bio::ranges::queue_op_status::success or bio::ranges::queue_op_status::closed.
+     */
+    queue_op_status push(value_type && value) noexcept
+    {
+        return wait_for(pop_events, producers_waiting, [&]() { return try_push(std::move(value)); });
+    }
+
+    //!\copydoc push(value_type &&)
+    queue_op_status push(value_type const & value)
+        requires std::copy_constructible<value_type>
+    {
+        return push(value_type{value});
+    }
+    //!\}
+
+    /*!\name Pop
+     * \{
+     */
+    /*!\brief Pop an element if the queue is not empty.
+     * \param[out] value Is assigned the element on success.
+     * \returns bio::ranges::queue_op_status::success, bio::ranges::queue_op_status::empty or
+     *          bio::ranges::queue_op_status::closed (if the queue is closed and empty).
+     */
+    queue_op_status try_pop(value_type & value) noexcept
+    {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        cell * c   = nullptr;
+
+        while (true)
+        {
+            c                  = &cells[pos & mask];
+            size_t const seq   = c->sequence.load(std::memory_order_acquire);
+            intptr_t const dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+            if (dif == 0)
+            {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+            {
+                // empty; or a producer has claimed the slot but not yet filled it
+                size_t const enq = enqueue_pos.load(std::memory_order_acquire);
+                return (enq == (pos | closed_bit)) ? queue_op_status::closed : queue_op_status::empty;
+            }
+            else
+            {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value_type * const p = c->ptr();
+        value                = std::move(*p);
+        std::destroy_at(p);
+        c->sequence.store(pos + mask + 1, std::memory_order_release);
+        notify(pop_events, producers_waiting);
+        return queue_op_status::success;
+    }
+
+    /*!\brief Pop an element, wait while the queue is empty.
+     * \param[out] value Is assigned the element on success.
+     * \returns bio::ranges::queue_op_status::success or bio::ranges::queue_op_status::closed (if the queue is closed
+     *          and empty).
+     */
+    queue_op_status pop(value_type & value) noexcept
+    {
+        return wait_for(push_events, consumers_waiting, [&]() { return try_pop(value); });
+    }
+    //!\}
+
+    /*!\name State
+     * \{
+     */
+    //!\brief Close the queue: further pushes fail and pop() returns once the queue is empty.
+    void close() noexcept
+    {
+        enqueue_pos.fetch_or(closed_bit, std::memory_order_acq_rel);
+        for (std::atomic<uint32_t> * events : {&push_events, &pop_events})
+        {
+            events->fetch_add(1, std::memory_order_release);
+            events->notify_all();
+        }
+    }
+
+    //!\brief Whether close() has been called.
+    bool is_closed() const noexcept { return enqueue_pos.load(std::memory_order_acquire) & closed_bit; }
+
+    //!\brief The maximum number of elements.
+    size_t capacity() const noexcept { return mask + 1; }
+
+    //!\brief The number of elements; only a snapshot if other threads are modifying the queue.
+    size_t size() const noexcept
+    {
+        size_t const deq = dequeue_pos.load(std::memory_order_acquire);
+        size_t const enq = enqueue_pos.load(std::memory_order_acquire) & ~closed_bit;
+        return enq > deq ? enq - deq : 0;
+    }
+
+    //!\brief Whether the queue is empty; only a snapshot if other threads are modifying the queue.
+    bool empty() const noexcept { return size() == 0; }
+    //!\}
+
+private:
+    //!\brief A slot of the ring buffer.
+    struct cell
+    {
+        //!\brief Equal to the position if the slot is free, to the position + 1 if it is filled.
+        std::atomic<size_t> sequence;
+        //!\brief Storage for the element.
+        alignas(value_type) std::byte storage[sizeof(value_type)];
+
+        //!\brief Pointer to the element.
+        value_type * ptr() noexcept { return std::launder(reinterpret_cast<value_type *>(storage)); }
+    };
+
+    //!\brief Set in the enqueue position when the queue is closed.
+    static constexpr size_t closed_bit = size_t{1} << (sizeof(size_t) * 8 - 1);
+    //!\brief Avoids false sharing between the positions.
+    static constexpr size_t cache_line = 64;
+    //!\brief The number of unsuccessful attempts before a thread goes to sleep.
+    static constexpr size_t spin_count = 64;
+
+    //!\brief Wake up waiting threads (only if there are any).
+    static void notify(std::atomic<uint32_t> & events, std::atomic<uint32_t> const & waiting) noexcept
+    {
+        // pairs with the increment of `waiting` in wait_for(): either the waiting thread sees our change or we see it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) > 0)
+        {
+            events.fetch_add(1, std::memory_order_release);
+            events.notify_all();
+        }
+    }
+
+    //!\brief Repeat `op` until it succeeds or returns closed; spin first, then sleep until `events` changes.
+    template <typename op_t>
+    static queue_op_status wait_for(std::atomic<uint32_t> & events, std::atomic<uint32_t> & waiting, op_t && op)
+    {
+        for (size_t i = 0; i < spin_count; ++i)
+        {
+            if (queue_op_status const s = op(); s == queue_op_status::success || s == queue_op_status::closed)
+                return s;
+            std::this_thread::yield();
+        }
+
+        waiting.fetch_add(1, std::memory_order_seq_cst);
+        queue_op_status s = queue_op_status::closed;
+        while (true)
+        {
+            uint32_t const old = events.load(std::memory_order_acquire);
+            if (s = op(); s == queue_op_status::success || s == queue_op_status::closed)
+                break;
+            events.wait(old, std::memory_order_acquire);
+        }
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+        return s;
+    }
+
+    //!\brief Capacity - 1.
+    size_t                  mask;
+    //!\brief The ring buffer.
+    std::unique_ptr<cell[]> cells;
+
+    //!\brief The next position to push to; the highest bit is set when the queue is closed.
+    alignas(cache_line) std::atomic<size_t> enqueue_pos{0};
+    //!\brief The next position to pop from.
+    alignas(cache_line) std::atomic<size_t> dequeue_pos{0};
+    //!\brief Incremented after pushes if consumers are waiting.
+    alignas(cache_line) std::atomic<uint32_t> push_events{0};
+    //!\brief The number of consumers waiting in pop().
+    std::atomic<uint32_t>                     consumers_waiting{0};
+    //!\brief Incremented after pops if producers are waiting.
+    alignas(cache_line) std::atomic<uint32_t> pop_events{0};
+    //!\brief The number of producers waiting in push().
+    std::atomic<uint32_t>                     producers_waiting{0};
+};
+
+} // namespace bio::ranges
@@ -0,0 +1,208 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::parallel_for_each and bio::ranges::parallel_transform.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <bio/ranges/detail/write_granularity.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+namespace bio::ranges::detail
+{
+
+//!\brief How many tasks are created per thread (more tasks give better load balancing, fewer less overhead).
+inline constexpr size_t tasks_per_thread = 4;
+
+/*!\brief Split `[0, size(rng))` into chunks of roughly equal work and call `fun(b, e)` for every chunk in the pool.
+ * \details
+ *
+ * The work of an element is the size of the element (if it is a sized range) plus one. Chunk boundaries are
+ * multiples of `granularity`.
+ */
+template <std::ranges::random_access_range rng_t, typename fun_t>
+void parallel_weighted_chunks(thread_pool & pool, rng_t && rng, size_t const granularity, fun_t && fun)
+{
+    size_t const count  = std::ranges::size(rng);
+    size_t const chunks = std::min(count, (pool.size() + 1) * tasks_per_thread);
+
+    if (chunks <= 1 || pool.size() == 0)
+        return fun(size_t{0}, count);
+
+    std::vector<size_t> bounds(chunks + 1, count);
+    bounds[0] = 0;
+
+    if constexpr (std::ranges::sized_range<std::ranges::range_reference_t<rng_t>>)
+    {
+        // elements of skewed length (e.g. read batches): balance by letters, not by elements
+        std::vector<size_t> prefix(count + 1);
+        for (size_t i = 0; i < count; ++i)
+            prefix[i + 1] = prefix[i] + std::ranges::size(rng[i]) + 1;
+
+        for (size_t c = 1; c < chunks; ++c)
+        {
+            size_t const target = prefix.back() / chunks * c;
+            bounds[c] = std::ranges::lower_bound(prefix, target) - std::ranges::begin(prefix);
+        }
+    }
+    else
+    {
+        for (size_t c = 1; c < chunks; ++c)
+            bounds[c] = count / chunks * c + std::min(c, count % chunks);
+    }
+
+    for (size_t c = 1; c < chunks; ++c)
+        bounds[c] = std::max(bounds[c - 1], std::min(count, bounds[c] / granularity * granularity));
+
+    pool.run(chunks,
+             [&](size_t const c)
+             {
+                 if (bounds[c] < bounds[c + 1])
+                     fun(bounds[c], bounds[c + 1]);
+             });
+}
+
+/*!\brief Calls `fun(b, e)` on chunks of a random access range that contains the elements (or iterators to them).
+ * \details
+ *
+ * Random access ranges are used directly. For other forward ranges, a vector of iterators is created first.
+ * Single-pass ranges are processed in the calling thread. `fun` receives a random access range and a chunk of it.
+ */
+template <std::ranges::input_range rng_t, typename fun_t>
+void parallel_dispatch(thread_pool & pool, rng_t && rng, size_t const granularity, fun_t && fun)
+{
+    if constexpr (std::ranges::random_access_range<rng_t> && std::ranges::sized_range<rng_t>)
+    {
+        parallel_weighted_chunks(pool, rng, granularity, [&](size_t const b, size_t const e) { fun(rng, b, e); });
+    }
+    else if constexpr (std::ranges::forward_range<rng_t>)
+    {
+        std::vector<std::ranges::iterator_t<rng_t>> its;
+        for (auto it = std::ranges::begin(rng); it != std::ranges::end(rng); ++it)
+            its.push_back(it);
+
+        auto elements = its | std::views::transform([](auto const & it) -> decltype(auto) { return *it; });
+        parallel_weighted_chunks(pool,
+                                 elements,
+                                 granularity,
+                                 [&](size_t const b, size_t const e) { fun(elements, b, e); });
+    }
+    else
+    {
+        std::vector<std::ranges::range_value_t<rng_t>> elements;
+        for (auto && elem : rng)
+            elements.push_back(std::forward<decltype(elem)>(elem));
+        fun(elements, size_t{0}, elements.size());
+    }
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Invoke a function on every element of a range, in parallel.
+ * \ingroup parallel
+ * \param[in] pool The thread pool.
+ * \param[in] rng  The range; must model std::ranges::input_range.
+ * \param[in] fun  The function; must be invocable with the reference type of the range and is invoked concurrently.
+ * \throws Rethrows the first exception thrown by `fun`.
+ *
+ * \details
+ *
+ * The range is split into about four chunks per thread. If the elements are themselves sized ranges (e.g. the
+ * sequences in a bio::ranges::concatenated_sequences), chunks contain roughly the same number of letters, so that
+ * skewed length distributions do not lead to idle threads. Threads that finish early steal the remaining chunks.
+ *
+ * Random access ranges (including most views) are split directly. For other forward ranges the iterators are
+ * collected first (in linear time). Single-pass input ranges are consumed and then processed in the calling thread.
+ *
+ * The order in which elements are visited is undefined.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/parallel/for_each.cpp
+ */
+template <std::ranges::input_range rng_t, typename fun_t>
+    requires std::invocable<fun_t &, std::ranges::range_reference_t<rng_t>>
+void parallel_for_each(thread_pool & pool, rng_t && rng, fun_t fun)
+{
+    detail::parallel_dispatch(pool,
+                              rng,
+                              1,
+                              [&](auto && elements, size_t const b, size_t const e)
+                              {
+                                  for (size_t i = b; i < e; ++i)
+                                      std::invoke(fun, elements[i]);
+                              });
+}
+
+/*!\brief Apply a function to every element of a range and write the results to an output range, in parallel.
+ * \ingroup parallel
+ * \param[in]  pool The thread pool.
+ * \param[in]  in   The input range; must model std::ranges::input_range.
+ * \param[out] out  The output range; must model std::ranges::random_access_range and have at least as many elements
+ *                  as `in`.
+ * \param[in]  fun  The function; must be invocable with the reference type of `in` and is invoked concurrently.
+ * \throws std::invalid_argument If `out` is a sized range with fewer elements than `in`.
+ * \throws Rethrows the first exception thrown by `fun`.
+ *
+ * \details
+ *
+ * `out[i]` is assigned `fun(in[i])`. Work is split like in bio::ranges::parallel_for_each(). If `out` is a container
+ * that packs multiple elements into one word (e.g. bio::ranges::bitcompressed_vector), chunks never share a word.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/parallel/for_each.cpp
+ */
+template <std::ranges::input_range in_t, std::ranges::random_access_range out_t, typename fun_t>
+    requires std::invocable<fun_t &, std::ranges::range_reference_t<in_t>> &&
+             std::indirectly_writable<std::ranges::iterator_t<out_t>,
+                                      std::invoke_result_t<fun_t &, std::ranges::range_reference_t<in_t>>>
+void parallel_transform(thread_pool & pool, in_t && in, out_t && out, fun_t fun)
+{
+    auto check_size = [&](size_t const in_size)
+    {
+        if constexpr (std::ranges::sized_range<out_t>)
+        {
+            if (in_size > static_cast<size_t>(std::ranges::size(out)))
+                throw std::invalid_argument{"The output range of parallel_transform is smaller than the input range."};
+        }
+    };
+
+    // single-pass ranges are only counted after they have been consumed (and are then processed in one chunk)
+    if constexpr (std::ranges::forward_range<in_t>)
+        check_size(static_cast<size_t>(std::ranges::distance(in)));
+
+    auto const out_it = std::ranges::begin(out);
+    detail::parallel_dispatch(pool,
+                              in,
+                              detail::write_granularity<std::remove_cvref_t<out_t>>(),
+                              [&](auto && elements, size_t const b, size_t const e)
+                              {
+                                  if constexpr (!std::ranges::forward_range<in_t>)
+                                      check_size(std::ranges::size(elements));
+
+                                  for (size_t i = b; i < e; ++i)
+                                      out_it[i] = std::invoke(fun, elements[i]);
+                              });
+}
+
+} // namespace bio::ranges
@@ -0,0 +1,278 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::thread_pool.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bio::ranges
+{
+
+/*!\brief A work-stealing thread pool.
+ * \ingroup parallel
+ *
+ * \details
+ *
+ * Every worker thread has its own task queue. Tasks submitted by a worker (e.g. nested parallelism) are put into
+ * that worker's queue, other tasks are distributed round-robin. Workers take tasks from the back of their own
+ * queue and, when it is empty, steal from the front of the other queues. Each queue is protected by its own mutex,
+ * so workers only contend when stealing.
+ *
+ * The thread that calls run() also executes tasks until all of its tasks are done; when no task is queued, it
+ * sleeps until its last task finishes. A pool with zero threads is valid: run() then executes everything in the
+ * calling thread.
+ *
+ * The destructor executes all tasks that are still queued and then joins the threads.
+ *
+ * ### Thread safety
+ *
+ * All member functions may be called concurrently, including from within tasks.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/parallel/thread_pool.cpp
+ */
+class thread_pool
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    thread_pool(thread_pool const &)             = delete; //!< Deleted.
+    thread_pool(thread_pool &&)                  = delete; //!< Deleted.
+    thread_pool & operator=(thread_pool const &) = delete; //!< Deleted.
+    thread_pool & operator=(thread_pool &&)      = delete; //!< Deleted.
+
+    /*!\brief Start the given number of worker threads.
+     * \param[in] threads The number of threads; defaults to std::thread::hardware_concurrency().
+     */
+    explicit thread_pool(size_t const threads = std::thread::hardware_concurrency()) : queues(threads)
+    {
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this, i]() { work(i); });
+    }
+
+    //!\brief Executes all queued tasks and joins the threads.
+    ~thread_pool()
+    {
+        {
+            std::lock_guard lock{sleep_mutex};
+            stop = true;
+        }
+        sleep_cv.notify_all();
+        workers.clear(); // joins
+    }
+    //!\}
+
+    //!\brief The number of worker threads.
+    size_t size() const noexcept { return workers.size(); }
+
+    /*!\brief Queue a task.
+     * \param[in] task The callable; it must not throw, otherwise std::terminate() is called.
+     */
+    template <std::invocable fun_t>
+    void submit(fun_t && task)
+    {
+        if (queues.empty())
+        {
+            task();
+            return;
+        }
+
+        size_t const q = current_pool == this ? current_queue
+                                               : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // count the task before it can be taken, so that the counter never underflows
+        {
+            std::lock_guard lock{sleep_mutex};
+            ++queued;
+        }
+        try
+        {
+            std::lock_guard lock{queues[q].mutex};
+            queues[q].tasks.emplace_back(std::forward<fun_t>(task));
+        }
+        catch (...)
+        {
+            --queued;
+            throw;
+        }
+        sleep_cv.notify_one();
+    }
+
+    /*!\brief Execute one queued task in the calling thread.
+     * \returns `true` if a task was executed, `false` if no task was queued.
+     */
+    bool run_one()
+    {
+        if (std::function<void()> task = take(current_pool == this ? current_queue : 0); task)
+        {
+            execute(task);
+            return true;
+        }
+        return false;
+    }
+
+    /*!\brief Invoke `fun(i)` for all `i` in `[0, count)` as separate tasks and wait for them.
+     * \param[in] count The number of tasks.
+     * \param[in] fun   The callable; is invoked concurrently.
+     * \throws Rethrows the first exception thrown by `fun`; all tasks are finished when this happens.
+     *
+     * \details
+     *
+     * The calling thread executes tasks while waiting, so this may be called from within tasks.
+     */
+    template <std::invocable<size_t> fun_t>
+    void run(size_t const count, fun_t && fun)
+    {
+        std::atomic<size_t> pending{count};
+        std::exception_ptr  error;
+        std::mutex          error_mutex;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            submit(
+              [&, i]() noexcept
+              {
+                  try
+                  {
+                      fun(i);
+                  }
+                  catch (...)
+                  {
+                      std::lock_guard lock{error_mutex};
+                      if (!error)
+                          error = std::current_exception();
+                  }
+                  if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                  {
+                      { // the waiting thread checks pending while holding the mutex
+                          std::lock_guard lock{sleep_mutex};
+                      }
+                      sleep_cv.notify_all();
+                  }
+              });
+        }
+
+        while (pending.load(std::memory_order_acquire) > 0)
+        {
+            if (run_one())
+                continue;
+
+            // sleep until the last task is done or there is a new task to help with
+            std::unique_lock lock{sleep_mutex};
+            sleep_cv.wait(lock,
+                          [&]()
+                          {
+                              return pending.load(std::memory_order_acquire) == 0 ||
+                                     queued.load(std::memory_order_relaxed) > 0;
+                          });
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    //!\brief A task queue.
+    struct queue
+    {
+        //!\brief Protects tasks.
+        std::mutex                        mutex;
+        //!\brief The owner takes from the back, thieves from the front.
+        std::deque<std::function<void()>> tasks;
+    };
+
+    //!\brief Invoke a task; exceptions terminate.
+    static void execute(std::function<void()> & task) noexcept { task(); }
+
+    //!\brief Take a task from queue `own` or steal one from another queue.
+    std::function<void()> take(size_t const own)
+    {
+        std::function<void()> task;
+        for (size_t k = 0; k < queues.size() && !task; ++k)
+        {
+            queue &         q = queues[(own + k) % queues.size()];
+            std::lock_guard lock{q.mutex};
+            if (q.tasks.empty())
+                continue;
+
+            if (k == 0)
+            {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+        }
+
+        if (task)
+            queued.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    //!\brief The loop of worker `i`.
+    void work(size_t const i)
+    {
+        current_pool  = this;
+        current_queue = i;
+
+        while (true)
+        {
+            if (std::function<void()> task = take(i); task)
+            {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex};
+            sleep_cv.wait(lock, [this]() { return stop || queued.load(std::memory_order_relaxed) > 0; });
+            if (stop && queued.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+
+    //!\brief One queue per worker.
+    std::vector<queue>        queues;
+    //!\brief The number of queued tasks (over all queues).
+    std::atomic<size_t>       queued{0};
+    //!\brief Round-robin counter for tasks submitted from outside the pool.
+    std::atomic<size_t>       next_queue{0};
+    //!\brief Protects the condition below.
+    std::mutex                sleep_mutex;
+    //!\brief Wakes up workers (on new tasks) and threads in run() (on new tasks and when their last task is done).
+    std::condition_variable   sleep_cv;
+    //!\brief Set by the destructor.
+    bool                      stop = false;
+    //!\brief The threads; must be the last member so that they are joined first.
+    std::vector<std::jthread> workers;
+
+    //!\brief The pool that the current thread belongs to (if any).
+    static inline thread_local thread_pool const * current_pool  = nullptr;
+    //!\brief The queue of the current thread (if it belongs to a pool).
+    static inline thread_local size_t              current_queue = 0;
+};
+
+} // namespace bio::ranges
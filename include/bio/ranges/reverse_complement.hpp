@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::reverse_complement.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+
+#include <bio/alphabet/nucleotide/concept.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief Return the reverse complement of a bit-compressed nucleotide range.
+ * \tparam rng_t Type of the range; must be a bio::ranges::bitcompressed_vector or a bio::ranges::bitcompressed_slice
+ *               over a bio::alphabet::nucleotide.
+ * \param[in] range The input range.
+ * \returns A bio::ranges::bitcompressed_vector with the reverse complement.
+ * \ingroup range
+ *
+ * \details
+ *
+ * This computes the same as `range | std::views::reverse | bio::views::complement`, but operates on packed words:
+ * each output word is assembled from at most two input words, the order of the letters within the word is reversed
+ * and all letters are complemented at once. For alphabets where the complement of rank `r` is `size - 1 - r` (like
+ * bio::alphabet::dna4), complementing is a single XOR, and for 2-bit and 4-bit alphabets the letters are reversed
+ * by swapping bit groups instead of one letter at a time.
+ *
+ * ### Complexity
+ *
+ * Linear in the size of the input (but the number of operations per letter is much smaller than for the views).
+ *
+ * ### Exceptions
+ *
+ * Throws if the allocation fails.
+ */
+template <typename rng_t>
+    requires(std::ranges::sized_range<rng_t> && alphabet::nucleotide<std::ranges::range_value_t<rng_t>> &&
+             requires(rng_t const & r) {
+                 { r.packed_ranks(size_t{}, size_t{}) } -> std::same_as<uint64_t>;
+             })
+bitcompressed_vector<std::ranges::range_value_t<rng_t>> reverse_complement(rng_t const & range)
+{
+    using alph_t     = std::ranges::range_value_t<rng_t>;
+    using vector_t   = bitcompressed_vector<alph_t>;
+    using size_type  = typename vector_t::size_type;
+    constexpr size_t bits  = vector_t::bits_per_letter;
+    constexpr size_t lpw   = vector_t::letters_per_word;
+    constexpr size_t sigma = alphabet::size<alph_t>;
+    constexpr uint64_t mask = (1ull << bits) - 1ull;
+
+    // complement rank of every rank
+    static constexpr std::array<uint64_t, sigma> complement_table = []()
+    {
+        std::array<uint64_t, sigma> ret{};
+        for (size_t r = 0; r < sigma; ++r)
+            ret[r] = alphabet::to_rank(alphabet::complement(alphabet::assign_rank_to(r, alph_t{})));
+        return ret;
+    }();
+
+    // whether complementing is an XOR with the mask (requires all bit patterns to be valid ranks)
+    static constexpr bool complement_is_xor = []()
+    {
+        if (sigma != (1ull << bits))
+            return false;
+        for (size_t r = 0; r < sigma; ++r)
+            if (complement_table[r] != (sigma - 1 - r))
+                return false;
+        return true;
+    }();
+
+    // reverse the order of `count` letters in `word` and complement them
+    auto reverse_word = [](uint64_t word, size_type const count) -> uint64_t
+    {
+        if constexpr (complement_is_xor && (bits == 2 || bits == 4))
+        {
+            if constexpr (bits == 2)
+                word = ((word >> 2) & 0x3333333333333333ull) | ((word & 0x3333333333333333ull) << 2);
+            word = ((word >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((word & 0x0F0F0F0F0F0F0F0Full) << 4);
+            word = ((word >> 8) & 0x00FF00FF00FF00FFull) | ((word & 0x00FF00FF00FF00FFull) << 8);
+            word = ((word >> 16) & 0x0000FFFF0000FFFFull) | ((word & 0x0000FFFF0000FFFFull) << 16);
+            word = (word >> 32) | (word << 32);
+            return ~word >> (64 - count * bits);
+        }
+        else
+        {
+            uint64_t ret = 0;
+            for (size_type k = 0; k < count; ++k, word >>= bits)
+            {
+                uint64_t const r = word & mask;
+                ret = (ret << bits) | (complement_is_xor ? r ^ mask : complement_table[r]);
+            }
+            return ret;
+        }
+    };
+
+    size_type const n = std::ranges::size(range);
+    vector_t        ret;
+    ret.reserve(n);
+    for (size_type i = 0; i < n; i += lpw)
+    {
+        size_type const count = std::min<size_type>(lpw, n - i);
+        ret.append_packed(reverse_word(range.packed_ranks(n - i - count, count), count), count);
+    }
+    return ret;
+}
+
+} // namespace bio::ranges
@@ -0,0 +1,599 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::suffix_array.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/parallel/for_each.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+namespace bio::ranges::detail
+{
+
+//!\brief Marks unused entries of the suffix array during construction.
+template <std::unsigned_integral index_t>
+inline constexpr index_t sais_empty = std::numeric_limits<index_t>::max();
+
+//!\brief Inputs smaller than this are always processed in the calling thread.
+inline constexpr size_t sais_parallel_threshold = size_t{1} << 16;
+
+//!\brief The number of entries per task in the parallel scans.
+inline constexpr size_t sais_block_size = size_t{1} << 14;
+
+/*!\brief The input of the suffix array construction: sequences that are separated by virtual sentinels.
+ * \tparam values_t     The type of the concatenated letters; must model std::ranges::random_access_range.
+ * \tparam delimiters_t The type of the begin/end positions of the sequences; a sorted random access range.
+ * \details
+ *
+ * Nothing is copied. Every sequence is followed by a unique sentinel that is smaller than all letters; the sentinel
+ * of the i-th sequence is smaller than the sentinel of the j-th sequence iff `i < j`. The sentinels are not part of
+ * the text, they are represented by the delimiters.
+ */
+template <std::ranges::random_access_range values_t, std::ranges::random_access_range delimiters_t>
+class sais_input_text
+{
+public:
+    //!\brief Construct from the letters and the begin/end positions of the sequences.
+    sais_input_text(values_t const & values, delimiters_t const & delimiters) :
+      it{std::ranges::begin(values)},
+      n{static_cast<size_t>(std::ranges::size(values))},
+      delimiters{delimiters}
+    {}
+
+    //!\brief The number of letters.
+    size_t size() const noexcept { return n; }
+
+    //!\brief The size of the alphabet.
+    static constexpr size_t sigma() noexcept { return alphabet::size<std::ranges::range_value_t<values_t>>; }
+
+    //!\brief The rank of letter `i`.
+    size_t operator[](size_t const i) const noexcept { return alphabet::to_rank(it[i]); }
+
+    //!\brief The first letter of the first sequence that begins at or after `i` (or the size, if there is none).
+    size_t next_start(size_t const i) const
+    {
+        auto const d = std::ranges::lower_bound(delimiters, i);
+        return d == std::ranges::end(delimiters) ? n : std::min<size_t>(*d, n);
+    }
+
+    //!\brief Call `fun(i)` for the first letter `i` of every sequence that begins in `[b, e)`, in ascending order.
+    template <typename fun_t>
+    void for_each_start(size_t const b, size_t const e, fun_t && fun) const
+    {
+        size_t last = n;
+        for (auto d = std::ranges::lower_bound(delimiters, b); d != std::ranges::end(delimiters); ++d)
+        {
+            size_t const s = *d;
+            if (s >= std::min(e, n))
+                break;
+            if (s != last) // empty sequences
+                fun(s);
+            last = s;
+        }
+    }
+
+    //!\brief Call `fun(i)` for the last letter `i` of every non-empty sequence, in the order of the sequences.
+    template <typename fun_t>
+    void for_each_last(fun_t && fun) const
+    {
+        for_each_start(1, n, [&](size_t const s) { fun(s - 1); });
+        fun(n - 1);
+    }
+
+private:
+    //!\brief Iterator to the letters.
+    std::ranges::iterator_t<values_t const> it;
+    //!\brief The number of letters.
+    size_t                                  n;
+    //!\brief The begin/end positions of the sequences.
+    delimiters_t const &                    delimiters;
+};
+
+//!\brief The reduced text of a recursion level: one sequence of names, followed by a sentinel.
+template <std::unsigned_integral index_t>
+struct sais_reduced_text
+{
+    //!\brief The names.
+    index_t const * data;
+    //!\brief The number of names.
+    size_t          n;
+    //!\brief The number of different names.
+    size_t          alphabet_size;
+
+    //!\brief The number of letters.
+    size_t size() const noexcept { return n; }
+
+    //!\brief The size of the alphabet.
+    size_t sigma() const noexcept { return alphabet_size; }
+
+    //!\brief Letter `i`.
+    size_t operator[](size_t const i) const noexcept { return data[i]; }
+
+    //!\brief The first letter of the first sequence that begins at or after `i` (or the size, if there is none).
+    size_t next_start(size_t const i) const noexcept { return i == 0 ? 0 : n; }
+
+    //!\brief Call `fun(0)` if `0` is in `[b, e)`.
+    template <typename fun_t>
+    void for_each_start(size_t const b, size_t const e, fun_t && fun) const
+    {
+        if (b == 0 && e > 0)
+            fun(size_t{0});
+    }
+
+    //!\brief Call `fun(n - 1)`.
+    template <typename fun_t>
+    void for_each_last(fun_t && fun) const
+    {
+        fun(n - 1);
+    }
+};
+
+//!\brief Call `fun(b, e)` on chunks of `[0, n)` whose bounds are multiples of 64; in parallel if `pool` is given.
+template <typename fun_t>
+void sais_chunks(thread_pool * const pool, size_t const n, fun_t && fun)
+{
+    if (pool == nullptr || n < sais_parallel_threshold)
+        fun(size_t{0}, n);
+    else
+        parallel_weighted_chunks(*pool, std::views::iota(size_t{0}, n), 64, fun);
+}
+
+/*!\brief The types of the suffixes and the first letters of the sequences, two bits per letter.
+ * \details
+ *
+ * Both bits of a letter are stored in the same word, so that the scans need only one memory access for them.
+ * Threads may write concurrently if they write different 64-bit words.
+ */
+class sais_types
+{
+public:
+    //!\brief Default construction.
+    sais_types() = default;
+
+    //!\brief Whether suffix `i` is S-type.
+    bool is_s(size_t const i) const noexcept { return (words[i / 32] >> (i % 32 * 2)) & 1u; }
+
+    //!\brief Whether letter `i` is the first letter of a sequence.
+    bool is_start(size_t const i) const noexcept { return (words[i / 32] >> (i % 32 * 2 + 1)) & 1u; }
+
+    //!\brief Whether suffix `i` is a leftmost S-type suffix (LMS), i.e. S-type and preceded by an L-type suffix.
+    bool is_lms(size_t const i) const noexcept { return !is_start(i) && is_s(i) && !is_s(i - 1); }
+
+    //!\brief Compute the types of all suffixes of `text`.
+    template <typename text_t>
+    void assign(text_t const & text, thread_pool * const pool)
+    {
+        size_t const n = text.size();
+        words.assign((n + 31) / 32, 0);
+
+        sais_chunks(pool,
+                    n,
+                    [&](size_t const b, size_t const e)
+                    {
+                        text.for_each_start(b,
+                                            e,
+                                            [&](size_t const i)
+                                            {
+                                                words[i / 32] |= uint64_t{2} << (i % 32 * 2);
+                                            });
+
+                        // the first suffix of the next chunk
+                        bool   s_type     = false;
+                        bool   next_start = true;
+                        size_t next       = 0;
+                        if (e < n)
+                        {
+                            size_t const end = text.next_start(e + 1); // of the sequence
+                            next_start       = text.next_start(e) == e;
+
+                            size_t j = e;
+                            while (j + 1 < end && text[j + 1] == text[j])
+                                ++j;
+                            s_type = j + 1 < end && text[j] < text[j + 1];
+                            next   = text[e];
+                        }
+
+                        for (size_t i = e; i-- > b;)
+                        {
+                            size_t const c = text[i];
+                            // a letter that is followed by a sentinel is L-type
+                            s_type         = !next_start && ((c < next) | ((c == next) & s_type));
+                            words[i / 32] |= uint64_t{s_type} << (i % 32 * 2);
+                            next       = c;
+                            next_start = is_start(i);
+                        }
+                    });
+    }
+
+    //!\brief Release the memory.
+    void clear() noexcept
+    {
+        words.clear();
+        words.shrink_to_fit();
+    }
+
+private:
+    //!\brief The bits.
+    std::vector<uint64_t> words;
+};
+
+//!\brief Count the occurrences of every letter.
+template <std::unsigned_integral index_t, typename text_t>
+void sais_count(text_t const & text, index_t * const counts, thread_pool * const pool)
+{
+    size_t const sigma = text.sigma();
+    std::fill(counts, counts + sigma, index_t{0});
+
+    if (sigma > 256) // the reduced texts of deeper levels are counted sequentially
+    {
+        for (size_t i = 0; i < text.size(); ++i)
+            ++counts[text[i]];
+        return;
+    }
+
+    std::mutex mutex;
+    sais_chunks(pool,
+                text.size(),
+                [&](size_t const b, size_t const e)
+                {
+                    std::array<size_t, 256> local{};
+                    for (size_t i = b; i < e; ++i)
+                        ++local[text[i]];
+
+                    std::lock_guard lock{mutex};
+                    for (size_t c = 0; c < sigma; ++c)
+                        counts[c] += local[c];
+                });
+}
+
+//!\brief Compute the begin (or end) positions of the buckets.
+template <std::unsigned_integral index_t>
+void sais_buckets(index_t const * const counts, index_t * const buckets, size_t const sigma, bool const ends)
+{
+    index_t sum = 0;
+    for (size_t c = 0; c < sigma; ++c)
+    {
+        sum += counts[c];
+        buckets[c] = ends ? sum : sum - counts[c];
+    }
+}
+
+/*!\brief Induce L-type suffixes from left to right (or S-type suffixes from right to left).
+ * \details
+ *
+ * For every entry `j` of the suffix array, `j - 1` is put at the head (tail) of its bucket if it is an L-type
+ * (S-type) suffix. With a thread pool, the lookups of `j - 1` in the text and the types, which are the expensive
+ * (random) memory accesses, are done in parallel for blocks of entries; the entries are then placed in the calling
+ * thread. Entries that have been written to the block after the lookup are detected and handled sequentially.
+ */
+template <bool s_scan, std::unsigned_integral index_t, typename text_t>
+void sais_induce(text_t const &     text,
+                 index_t * const    sa,
+                 sais_types const & types,
+                 index_t * const    buckets,
+                 thread_pool * const pool)
+{
+    constexpr index_t empty = sais_empty<index_t>;
+    size_t const      n     = text.size();
+
+    auto predecessor = [&](index_t const j) noexcept -> index_t
+    {
+        if (j == empty || types.is_start(j) || types.is_s(j - 1) != s_scan)
+            return empty;
+        return j - 1;
+    };
+
+    auto place = [&](index_t const k, size_t const c) noexcept
+    {
+        if constexpr (s_scan)
+            sa[--buckets[c]] = k;
+        else
+            sa[buckets[c]++] = k;
+    };
+
+    auto position = [n](size_t const step) noexcept { return s_scan ? n - 1 - step : step; };
+
+    if (pool == nullptr || pool->size() == 0 || n < sais_parallel_threshold)
+    {
+        for (size_t step = 0; step < n; ++step)
+            if (index_t const k = predecessor(sa[position(step)]); k != empty)
+                place(k, text[k]);
+        return;
+    }
+
+    size_t const         tasks = pool->size() + 1;
+    size_t const         block = tasks * sais_block_size;
+    std::vector<index_t> seen(block);
+    std::vector<index_t> found(block);
+    std::vector<index_t> letters(block);
+
+    for (size_t first = 0; first < n; first += block)
+    {
+        size_t const count = std::min(block, n - first);
+
+        pool->run(tasks,
+                  [&](size_t const t)
+                  {
+                      for (size_t s = t * sais_block_size; s < std::min(count, (t + 1) * sais_block_size); ++s)
+                      {
+                          seen[s]  = sa[position(first + s)];
+                          found[s] = predecessor(seen[s]);
+                          if (found[s] != empty)
+                              letters[s] = text[found[s]];
+                      }
+                  });
+
+        for (size_t s = 0; s < count; ++s)
+        {
+            index_t const j = sa[position(first + s)];
+            if (j == seen[s])
+            {
+                if (found[s] != empty)
+                    place(found[s], letters[s]);
+            }
+            else if (index_t const k = predecessor(j); k != empty)
+            {
+                place(k, text[k]);
+            }
+        }
+    }
+}
+
+/*!\brief The SA-IS algorithm by Nong, Zhang and Chan (2009).
+ * \param[in]  text The text; one of the text types above.
+ * \param[out] sa   The suffix array; must have `text.size()` entries.
+ * \param[in]  free Memory that may be used for the buckets (if it is large enough).
+ * \param[in]  pool The thread pool or `nullptr`.
+ * \details
+ *
+ * The reduced text of the recursion is stored in the second half of `sa` and its suffix array in the first half,
+ * so besides the suffix array, only the types (two bits per letter) and the buckets are allocated on every level.
+ *
+ * Sequences are separated by unique sentinels (see bio::ranges::detail::sais_input_text). The sentinels are
+ * handled implicitly: the last letter of every sequence is an L-type suffix that is induced first (in the order of
+ * the sentinels), no suffix is induced from the first letter of a sequence, and an LMS substring that reaches a
+ * sentinel is unique.
+ */
+template <std::unsigned_integral index_t, typename text_t>
+void sais(text_t const & text, index_t * const sa, std::span<index_t> const free, thread_pool * const pool)
+{
+    constexpr index_t empty = sais_empty<index_t>;
+    size_t const      n     = text.size();
+    size_t const      sigma = text.sigma();
+
+    std::vector<index_t> bucket_storage;
+    index_t *            counts = free.data();
+    if (free.size() < 2 * sigma)
+    {
+        bucket_storage.resize(2 * sigma);
+        counts = bucket_storage.data();
+    }
+    index_t * const buckets = counts + sigma;
+
+    sais_types types;
+    types.assign(text, pool);
+    sais_count(text, counts, pool);
+
+    auto is_lms  = [&](size_t const i) noexcept { return types.is_lms(i); };
+    auto is_last = [&](size_t const i) noexcept { return i + 1 == n || types.is_start(i + 1); };
+
+    auto induce = [&]()
+    {
+        sais_buckets(counts, buckets, sigma, false);
+        text.for_each_last([&](size_t const i) { sa[buckets[text[i]]++] = i; });
+        sais_induce<false>(text, sa, types, buckets, pool);
+
+        sais_buckets(counts, buckets, sigma, true);
+        sais_induce<true>(text, sa, types, buckets, pool);
+    };
+
+    // 1. sort the LMS substrings
+    std::fill(sa, sa + n, empty);
+    sais_buckets(counts, buckets, sigma, true);
+    for (size_t i = 1; i < n; ++i)
+        if (is_lms(i))
+            sa[--buckets[text[i]]] = i;
+    induce();
+
+    // 2. name the LMS substrings; the names of LMS suffix p are stored at n1 + p / 2 (LMS are not adjacent)
+    size_t n1 = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (is_lms(sa[i]))
+            sa[n1++] = sa[i];
+
+    auto equal = [&](size_t const p, size_t const q)
+    {
+        for (size_t d = 0;; ++d)
+        {
+            if (text[p + d] != text[q + d] || types.is_s(p + d) != types.is_s(q + d))
+                return false;
+            if (d > 0 && is_lms(p + d))
+                return true;
+            if (is_last(p + d) || is_last(q + d)) // sentinels are unique
+                return false;
+        }
+    };
+
+    std::fill(sa + n1, sa + n, empty);
+    size_t names = 0;
+    for (size_t i = 0; i < n1; ++i)
+    {
+        if (i == 0 || !equal(sa[i - 1], sa[i]))
+            ++names;
+        sa[n1 + sa[i] / 2] = names - 1;
+    }
+
+    for (size_t i = n, j = n; i-- > n1;)
+        if (sa[i] != empty)
+            sa[--j] = sa[i];
+
+    // 3. sort the LMS suffixes: recurse if the names are not unique
+    index_t * const reduced = sa + n - n1;
+    if (names < n1)
+    {
+        types.clear(); // recomputing them afterwards is cheap and lowers the peak memory
+        sais(sais_reduced_text<index_t>{reduced, n1, names}, sa, std::span{sa + n1, n - 2 * n1}, pool);
+        types.assign(text, pool);
+    }
+    else
+    {
+        for (size_t i = 0; i < n1; ++i)
+            sa[reduced[i]] = i;
+    }
+
+    for (size_t i = 1, j = 0; i < n; ++i)
+        if (is_lms(i))
+            reduced[j++] = i;
+
+    sais_chunks(pool,
+                n1,
+                [&](size_t const b, size_t const e)
+                {
+                    for (size_t i = b; i < e; ++i)
+                        sa[i] = reduced[sa[i]];
+                });
+
+    // 4. induce all suffixes from the sorted LMS suffixes
+    std::fill(sa + n1, sa + n, empty);
+    sais_buckets(counts, buckets, sigma, true);
+    for (size_t i = n1; i-- > 0;)
+    {
+        index_t const j        = sa[i];
+        sa[i]                  = empty;
+        sa[--buckets[text[j]]] = j;
+    }
+    induce();
+}
+
+//!\brief A type that provides raw_data() like bio::ranges::concatenated_sequences.
+template <typename t>
+concept sais_concatenation = requires(t const & c) {
+    c.raw_data();
+    requires alphabet::semialphabet<
+      std::ranges::range_value_t<std::remove_cvref_t<decltype(std::declval<t const &>().raw_data().first)>>>;
+};
+
+//!\brief A single sequence.
+template <typename t>
+concept sais_sequence = std::ranges::random_access_range<t> && std::ranges::sized_range<t> &&
+                        alphabet::semialphabet<std::ranges::range_value_t<t>>;
+
+//!\brief Build the suffix array of the concatenation or sequence.
+template <std::unsigned_integral index_t, typename rng_t>
+std::vector<index_t> suffix_array_impl(rng_t const & rng, thread_pool * const pool)
+{
+    auto build = [pool](auto const & values, auto const & delimiters)
+    {
+        size_t const n = std::ranges::size(values);
+        if (n >= std::numeric_limits<index_t>::max())
+            throw std::length_error{"The input of suffix_array is too large for the index type."};
+
+        std::vector<index_t> sa(n);
+        if (n > 0)
+        {
+            sais_input_text<std::remove_cvref_t<decltype(values)>, std::remove_cvref_t<decltype(delimiters)>> const
+              text{values, delimiters};
+            sais(text, sa.data(), std::span<index_t>{}, pool);
+        }
+        return sa;
+    };
+
+    if constexpr (sais_concatenation<rng_t>)
+    {
+        auto const & [values, delimiters] = rng.raw_data();
+        return build(values | std::views::take(delimiters.back()), delimiters);
+    }
+    else
+    {
+        return build(rng, std::array<size_t, 2>{0, static_cast<size_t>(std::ranges::size(rng))});
+    }
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Construct the suffix array of a sequence or of all sequences in a bio::ranges::concatenated_sequences.
+ * \ingroup range
+ * \tparam index_t The type of the entries; must model std::unsigned_integral, e.g. `uint32_t` or `uint64_t`.
+ * \param[in] rng A bio::ranges::concatenated_sequences of bio::alphabet::semialphabet letters, or a single sequence
+ *                (a std::ranges::random_access_range and std::ranges::sized_range of such letters).
+ * \returns A std::vector with the begin positions of all suffixes in lexicographical order.
+ * \throws std::length_error If there are `std::numeric_limits<index_t>::max()` letters or more.
+ *
+ * \details
+ *
+ * The positions refer to the concatenation of the sequences (`rng.concat()`), i.e. to the underlying container.
+ * The sequence of a position `p` is the one whose range in `rng.raw_data().second` (the "data delimiters") contains
+ * `p`; it can be found with std::ranges::upper_bound.
+ *
+ * A suffix ends at the end of its sequence: every sequence is followed by a unique sentinel that is smaller than
+ * all letters. Therefore a suffix that is a prefix of another suffix is ordered first, and equal suffixes of
+ * different sequences are ordered by their position. Letters are compared by rank. Empty sequences
+ * contribute no suffixes.
+ *
+ * This uses the SA-IS algorithm (induced sorting). Besides the result (`n * sizeof(index_t)` bytes for `n` letters),
+ * only about `n / 4` bytes are allocated; the letters are not copied. Use `uint32_t` for inputs with less than
+ * 2^32 - 1 letters to halve the memory.
+ *
+ * ### Complexity
+ *
+ * Linear in the number of letters.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/suffix_array.cpp
+ */
+template <std::unsigned_integral index_t = uint64_t, typename rng_t>
+    requires(detail::sais_concatenation<std::remove_cvref_t<rng_t>> || detail::sais_sequence<rng_t>)
+std::vector<index_t> suffix_array(rng_t && rng)
+{
+    return detail::suffix_array_impl<index_t>(rng, nullptr);
+}
+
+/*!\brief Construct the suffix array of a sequence or of all sequences in a bio::ranges::concatenated_sequences,
+ *        in parallel.
+ * \ingroup range
+ * \tparam index_t The type of the entries; must model std::unsigned_integral, e.g. `uint32_t` or `uint64_t`.
+ * \param[in] pool The thread pool.
+ * \param[in] rng  A bio::ranges::concatenated_sequences or a single sequence, see above.
+ * \returns The same as bio::ranges::suffix_array(rng_t &&).
+ * \throws std::length_error If there are `std::numeric_limits<index_t>::max()` letters or more.
+ *
+ * \details
+ *
+ * The suffix types and the letter counts are computed in parallel. The induced sorting scans are inherently
+ * sequential, but for blocks of entries, the lookups of the preceding letters (the random memory accesses) are
+ * done in parallel, and only the writes to the buckets are done in the calling thread. This needs a buffer of
+ * about `3 * 2^14 * sizeof(index_t)` bytes per thread.
+ */
+template <std::unsigned_integral index_t = uint64_t, typename rng_t>
+    requires(detail::sais_concatenation<std::remove_cvref_t<rng_t>> || detail::sais_sequence<rng_t>)
+std::vector<index_t> suffix_array(thread_pool & pool, rng_t && rng)
+{
+    return detail::suffix_array_impl<index_t>(rng, &pool);
+}
+
+} // namespace bio::ranges
@@ -14,13 +14,80 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <bio/ranges/detail/write_granularity.hpp>
 #include <bio/ranges/views/detail.hpp>
 
+namespace bio::ranges
+{
+
+class thread_pool;
+
+/*!\brief Execution policy for bio::ranges::to that fills the container with the tasks of a thread pool.
+ * \ingroup range
+ * \see bio::ranges::par
+ * \details
+ *
+ * This header only declares bio::ranges::thread_pool; include bio/ranges/parallel/thread_pool.hpp to create one.
+ */
+struct parallel_policy
+{
+    //!\brief The pool; must outlive the conversion.
+    thread_pool * pool = nullptr;
+};
+
+/*!\brief Returns the execution policy for bio::ranges::to that uses the given pool.
+ * \ingroup range
+ */
+inline parallel_policy par(thread_pool & pool) noexcept
+{
+    return parallel_policy{&pool};
+}
+
+} // namespace bio::ranges
+
 namespace bio::ranges::detail
 {
 
+/*!\brief Call `fun(b, e)` for consecutive chunks of `[begin, end)` as tasks of a thread pool.
+ * \param pool        The pool (bio::ranges::thread_pool); the calling thread takes part.
+ * \param begin       Begin of the interval.
+ * \param end         End of the interval.
+ * \param granularity Chunk boundaries (except `begin` and `end`) are multiples of this.
+ * \param min_chunk   The minimum size of a chunk (in elements).
+ * \param fun         The function to call.
+ * \throws Rethrows the first exception thrown by `fun` after all chunks are done.
+ */
+template <typename pool_t, typename fun_t>
+void parallel_chunks(pool_t &     pool,
+                     size_t const begin,
+                     size_t const end,
+                     size_t const granularity,
+                     size_t const min_chunk,
+                     fun_t &&     fun)
+{
+    size_t const size    = end - begin;
+    size_t const threads = std::max<size_t>(1, std::min(pool.size() + 1, size / std::max<size_t>(min_chunk, 1)));
+
+    if (threads == 1)
+        return fun(begin, end);
+
+    size_t const chunk = ((size + threads - 1) / threads + granularity - 1) / granularity * granularity;
+
+    // boundaries are aligned absolutely, so that chunks never share a word of packed storage; if `begin` is not
+    // aligned, this shortens the chunks and there is one more chunk than threads
+    std::vector<size_t> bounds{begin};
+    while (bounds.back() < end)
+        bounds.push_back(std::min(end, (bounds.back() + chunk) / granularity * granularity));
+
+    pool.run(bounds.size() - 1, [&](size_t const t) { fun(bounds[t], bounds[t + 1]); });
+}
+
 //!\brief Functor that creates the given container from a range.
 //!\ingroup views
 template <typename container_t>
@@ -31,23 +98,212 @@ private:
      *
      * \tparam rng_t       type of the range
      * \tparam container_t type of the target container
+     *
+     * \details
+     *
+     * Contiguous ranges of trivially copyable elements are copied with std::memcpy into contiguous containers,
+     * other sized ranges are inserted with a single call to `insert(end, first, last)`. Only if neither is possible,
+     * the elements are appended one by one. Ranges that provide a function `to_bulk_append(container, rng)`, found
+     * by argument-dependent lookup (e.g. a bio::views::zip of the components of a composite alphabet), are appended
+     * by that function. It is declared together with the range type, so the choice does not depend on the headers
+     * that are included.
      */
-    auto impl(std::ranges::range auto && rng, container_t & container) const
+    template <std::ranges::range rng_t>
+    auto impl(rng_t && rng, container_t & container) const
     {
-        std::ranges::copy(rng, std::back_inserter(container));
+        using value_t = std::ranges::range_value_t<container_t>;
+
+        if constexpr (requires { to_bulk_append(container, std::as_const(rng)); })
+        {
+            to_bulk_append(container, std::as_const(rng));
+        }
+        else if constexpr (std::ranges::contiguous_range<rng_t> && std::ranges::sized_range<rng_t> &&
+                      std::ranges::contiguous_range<container_t> &&
+                      std::same_as<std::ranges::range_value_t<rng_t>, value_t> &&
+                      std::is_trivially_copyable_v<value_t> &&
+                      requires { container.resize(std::size_t{}); })
+        {
+            std::size_t const old_size = std::ranges::size(container);
+            std::size_t const count    = std::ranges::size(rng);
+            container.resize(old_size + count);
+            if (count > 0)
+                std::memcpy(std::ranges::data(container) + old_size, std::ranges::data(rng), count * sizeof(value_t));
+        }
+        else if constexpr (std::ranges::sized_range<rng_t> && std::ranges::forward_range<rng_t> &&
+                           std::ranges::common_range<rng_t> &&
+                           requires {
+                               container.insert(std::ranges::end(container),
+                                                std::ranges::begin(rng),
+                                                std::ranges::end(rng));
+                           })
+        {
+            container.insert(std::ranges::end(container), std::ranges::begin(rng), std::ranges::end(rng));
+        }
+        else
+        {
+            std::ranges::copy(rng, std::back_inserter(container));
+        }
     }
 
     /*!\brief Overload for nested ranges.
      *
      * \tparam rng_t       type of the range
      * \tparam container_t type of the target container
+     *
+     * \details
+     *
+     * If the target stores all elements in one concatenated container (like bio::ranges::concatenated_sequences),
+     * the inner ranges are appended directly and the concatenated storage is reserved upfront (if the inner sizes
+     * can be determined cheaply). Otherwise, every inner range is converted separately.
      */
-    auto impl(std::ranges::range auto && rng, container_t & container) const
+    template <std::ranges::range rng_t>
+    auto impl(rng_t && rng, container_t & container) const
         requires std::ranges::range<std::decay_t<decltype(*rng.begin())>>
     {
-        auto adapter   = to_fn<typename container_t::value_type>{};
-        auto inner_rng = rng | std::views::transform(adapter);
-        std::ranges::copy(inner_rng, std::back_inserter(container));
+        using inner_t = std::ranges::range_reference_t<rng_t>;
+
+        if constexpr (requires(inner_t inner) {
+                          container.concat_reserve(std::size_t{});
+                          container.push_back(inner);
+                      })
+        {
+            // the inner ranges must not be computed on-the-fly, because they are accessed twice
+            if constexpr (std::ranges::forward_range<rng_t> && std::ranges::sized_range<inner_t> &&
+                          (std::is_reference_v<inner_t> || std::ranges::view<std::remove_cvref_t<inner_t>>))
+            {
+                std::size_t concat_size = container.concat_size();
+                for (auto && inner : rng)
+                    concat_size += std::ranges::size(inner);
+                container.concat_reserve(concat_size);
+            }
+
+            for (auto && inner : rng)
+                container.push_back(inner);
+        }
+        else
+        {
+            auto adapter   = to_fn<typename container_t::value_type>{};
+            auto inner_rng = rng | std::views::transform(adapter);
+            std::ranges::copy(inner_rng, std::back_inserter(container));
+        }
+    }
+
+    /*!\brief Fill a container from multiple threads.
+     *
+     * \details
+     *
+     * Supported for sized random access ranges:
+     *
+     *   * flat: the container is resized and the chunks are assigned in parallel.
+     *   * nested into concatenated storage (bio::ranges::concatenated_sequences): the inner sizes are computed in
+     *     parallel, the delimiters are computed as prefix sum and then the letters are copied in chunks of equal size.
+     *   * nested into other random access containers: the inner containers are created in parallel.
+     *
+     * Everything else is converted sequentially.
+     */
+    template <typename rng_t, typename pool_t>
+    void parallel_impl(rng_t && rng, container_t & container, pool_t & pool) const
+    {
+        constexpr bool input_ok = std::ranges::random_access_range<rng_t> && std::ranges::sized_range<rng_t>;
+        constexpr size_t min_chunk = 1ull << 14; // elements per task
+        using inner_t              = std::ranges::range_reference_t<rng_t>;
+
+        if constexpr (!input_ok)
+        {
+            impl(std::forward<rng_t>(rng), container);
+        }
+        else if constexpr (requires {
+                               container.raw_data();
+                               container.concat_size();
+                           } && std::ranges::random_access_range<inner_t> && std::ranges::sized_range<inner_t>)
+        {
+            auto && [values, delimiters] = container.raw_data();
+            using values_t               = std::remove_cvref_t<decltype(values)>;
+
+            size_t const count      = std::ranges::size(rng);
+            size_t const old_count  = delimiters.size() - 1;
+            size_t const old_concat = delimiters.back();
+            auto const   in         = std::ranges::begin(rng);
+
+            // inner sizes, then prefix sum
+            delimiters.resize(old_count + 1 + count);
+            parallel_chunks(pool,
+                            0,
+                            count,
+                            1,
+                            min_chunk,
+                            [&](size_t const b, size_t const e)
+                            {
+                                for (size_t i = b; i < e; ++i)
+                                    delimiters[old_count + 1 + i] = std::ranges::size(in[i]);
+                            });
+            for (size_t i = old_count + 1; i < delimiters.size(); ++i)
+                delimiters[i] += delimiters[i - 1];
+
+            // the letters are split evenly among the tasks, independent of sequence boundaries
+            values.resize(delimiters.back());
+            parallel_chunks(pool,
+                            old_concat,
+                            delimiters.back(),
+                            write_granularity<values_t>(),
+                            min_chunk,
+                            [&](size_t pos, size_t const e)
+                            {
+                                auto   first = std::ranges::begin(delimiters) + old_count;
+                                size_t i     = std::ranges::upper_bound(first, std::ranges::end(delimiters), pos) -
+                                           first - 1;
+                                for (; pos < e; ++i)
+                                {
+                                    size_t const seq_begin = delimiters[old_count + i];
+                                    size_t const seq_end   = std::min<size_t>(delimiters[old_count + i + 1], e);
+                                    auto &&      inner     = in[i];
+                                    auto         it        = std::ranges::begin(inner) + (pos - seq_begin);
+                                    for (; pos < seq_end; ++pos, ++it)
+                                        values[pos] = *it;
+                                }
+                            });
+        }
+        else if constexpr (std::ranges::random_access_range<container_t> &&
+                           requires { container.resize(std::size_t{}); })
+        {
+            size_t const count    = std::ranges::size(rng);
+            size_t const old_size = std::ranges::size(container);
+            auto const   in       = std::ranges::begin(rng);
+            container.resize(old_size + count);
+
+            auto const out = std::ranges::begin(container);
+            if constexpr (std::ranges::range<std::remove_cvref_t<inner_t>>) // nested
+            {
+                auto adapter = to_fn<std::ranges::range_value_t<container_t>>{};
+                parallel_chunks(pool,
+                                0,
+                                count,
+                                1,
+                                1,
+                                [&](size_t const b, size_t const e)
+                                {
+                                    for (size_t i = b; i < e; ++i)
+                                        out[old_size + i] = adapter(in[i]);
+                                });
+            }
+            else
+            {
+                parallel_chunks(pool,
+                                old_size,
+                                old_size + count,
+                                write_granularity<container_t>(),
+                                min_chunk,
+                                [&](size_t const b, size_t const e)
+                                {
+                                    for (size_t i = b; i < e; ++i)
+                                        out[i] = in[i - old_size];
+                                });
+            }
+        }
+        else
+        {
+            impl(std::forward<rng_t>(rng), container);
+        }
     }
 
 public:
@@ -71,6 +327,24 @@ public:
         impl(std::forward<rng_t>(rng), r);
         return r;
     }
+
+    /*!\brief Converts a range into a container using the threads of a bio::ranges::thread_pool.
+     * \tparam rng_t    The type of the range being processed.
+     * \tparam policy_t bio::ranges::parallel_policy (a template parameter, so that bio::ranges::thread_pool only
+     *                  needs to be complete where this is instantiated).
+     * \tparam args_t   The types of the arguments for the constructor.
+     * \param  rng      The range being processed.
+     * \param  policy   The execution policy.
+     * \param  args     Arguments to pass to the constructor of the container.
+     */
+    template <std::ranges::range rng_t, std::same_as<parallel_policy> policy_t, typename... args_t>
+    auto operator()(rng_t && rng, policy_t const policy, args_t &&... args) const
+    {
+        auto r = container_t(std::forward<args_t>(args)...);
+
+        parallel_impl(std::forward<rng_t>(rng), r, *policy.pool);
+        return r;
+    }
 };
 
 /**
@@ -108,6 +382,10 @@ namespace bio::ranges
  * Both syntaxes support the explicit specification of the target container or
  * a specification with an deduced value type.
  *
+ * If a bio::ranges::parallel_policy (created with bio::ranges::par() from a bio::ranges::thread_pool) is passed as
+ * first argument, sized random access ranges are converted by the threads of the pool. This requires that the
+ * range's elements can be read concurrently, e.g. a transformation function must not modify shared state.
+ *
  * \include snippet/ranges/to.cpp
  */
 template <typename container_t, typename... args_t>
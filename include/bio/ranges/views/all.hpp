@@ -14,14 +14,18 @@
 #pragma once
 
 #include <bio/ranges/to.hpp>
+#include <bio/ranges/views/bin_quality.hpp>
 #include <bio/ranges/views/char_to.hpp>
 #include <bio/ranges/views/complement.hpp>
 #include <bio/ranges/views/convert.hpp>
 #include <bio/ranges/views/deep.hpp>
+#include <bio/ranges/views/find_all.hpp>
 #include <bio/ranges/views/interleave.hpp>
 #include <bio/ranges/views/pairwise_combine.hpp>
+#include <bio/ranges/views/pairwise_combine_tiled.hpp>
 #include <bio/ranges/views/persist.hpp>
 #include <bio/ranges/views/rank_to.hpp>
+#include <bio/ranges/views/rle.hpp>
 #include <bio/ranges/views/single_pass_input.hpp>
 #include <bio/ranges/views/take_exactly.hpp>
 #include <bio/ranges/views/to_char.hpp>
@@ -0,0 +1,418 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::views::bin_quality, bio::views::pblock_quality and bio::views::rblock_quality.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+
+#include <bio/ranges/bin_quality.hpp>
+#include <bio/ranges/views/deep.hpp>
+#include <bio/ranges/views/detail.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief The type returned by bio::views::pblock_quality and bio::views::rblock_quality.
+ * \tparam urng_t   The type of the underlying range, must model std::ranges::forward_range and std::ranges::view.
+ * \tparam policy_t bio::ranges::detail::pblock_policy or bio::ranges::detail::rblock_policy.
+ * \implements std::ranges::view
+ * \implements std::ranges::forward_range
+ * \ingroup views
+ */
+template <std::ranges::view urng_t, typename policy_t>
+    requires std::ranges::forward_range<urng_t>
+class view_block_quality : public std::ranges::view_interface<view_block_quality<urng_t, policy_t>>
+{
+private:
+    //!\brief The underlying range.
+    urng_t   urange;
+    //!\brief The block definition.
+    policy_t policy;
+
+    /*!\brief The iterator type; it stores the end of the current block and its representative score.
+     * \tparam const_range Whether this is the iterator of the const range.
+     */
+    template <bool const_range>
+    class basic_iterator
+    {
+    private:
+        //!\brief The underlying range type (possibly const).
+        using base_t     = std::conditional_t<const_range, urng_t const, urng_t>;
+        //!\brief The underlying iterator type.
+        using base_it_t  = std::ranges::iterator_t<base_t>;
+        //!\brief The underlying sentinel type.
+        using base_sen_t = std::ranges::sentinel_t<base_t>;
+
+        //!\brief The current position.
+        base_it_t  current{};
+        //!\brief The end of the current block.
+        base_it_t  block_end{};
+        //!\brief The end of the underlying range.
+        base_sen_t urange_end{};
+        //!\brief The block definition.
+        policy_t   policy{};
+        //!\brief The score of the current block.
+        int8_t     rep = 0;
+
+        //!\brief Befriend the other iterator type for the converting constructor.
+        template <bool>
+        friend class basic_iterator;
+
+        //!\brief Find the next block.
+        constexpr void next_block()
+        {
+            if (current != urange_end)
+                std::tie(block_end, rep) = next_quality_block(current, urange_end, policy);
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        using difference_type   = std::ranges::range_difference_t<base_t>; //!< From the underlying range.
+        using value_type        = std::ranges::range_value_t<base_t>;      //!< From the underlying range.
+        using reference         = value_type;                              //!< Elements are generated.
+        using pointer           = void;                                    //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;                 //!< Reference is not a reference type.
+        using iterator_concept  = std::forward_iterator_tag;               //!< Always forward.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr basic_iterator()                                   = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator const &)             = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator &&)                  = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator &&)      = default; //!< Defaulted.
+        ~basic_iterator()                                            = default; //!< Defaulted.
+
+        //!\brief Construct from the underlying range.
+        constexpr basic_iterator(base_t & urng, policy_t const & p) :
+          current{std::ranges::begin(urng)}, urange_end{std::ranges::end(urng)}, policy{p}
+        {
+            next_block();
+        }
+
+        //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+        constexpr basic_iterator(basic_iterator<!const_range> it)
+            requires const_range
+          :
+          current{std::move(it.current)},
+          block_end{std::move(it.block_end)},
+          urange_end{std::move(it.urange_end)},
+          policy{it.policy},
+          rep{it.rep}
+        {}
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The current element with the score of the block.
+        constexpr reference operator*() const
+        {
+            value_type ret = *current;
+            alphabet::assign_phred_to(rep, ret);
+            return ret;
+        }
+
+        //!\brief Pre-increment; finds the next block if necessary.
+        constexpr basic_iterator & operator++()
+        {
+            if (++current == block_end)
+                next_block();
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        constexpr basic_iterator operator++(int)
+        {
+            basic_iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the positions.
+        constexpr friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+        {
+            return lhs.current == rhs.current;
+        }
+
+        //!\brief Whether the end has been reached.
+        constexpr friend bool operator==(basic_iterator const & lhs, std::default_sentinel_t const &)
+        {
+            return lhs.current == lhs.urange_end;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    view_block_quality()                                           = default; //!< Defaulted.
+    view_block_quality(view_block_quality const & rhs)             = default; //!< Defaulted.
+    view_block_quality(view_block_quality && rhs)                  = default; //!< Defaulted.
+    view_block_quality & operator=(view_block_quality const & rhs) = default; //!< Defaulted.
+    view_block_quality & operator=(view_block_quality && rhs)      = default; //!< Defaulted.
+    ~view_block_quality()                                          = default; //!< Defaulted.
+
+    //!\brief Construct from another view and the block definition.
+    constexpr view_block_quality(urng_t _urange, policy_t const _policy) :
+      urange{std::move(_urange)}, policy{_policy}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first element.
+    constexpr basic_iterator<false> begin() { return {urange, policy}; }
+
+    //!\copydoc begin()
+    constexpr basic_iterator<true> begin() const
+        requires const_iterable_range<urng_t>
+    {
+        return {urange, policy};
+    }
+
+    //!\brief Returns a sentinel.
+    constexpr std::default_sentinel_t end() const noexcept { return {}; }
+    //!\}
+
+    //!\brief Returns the size of the underlying range.
+    constexpr auto size()
+        requires std::ranges::sized_range<urng_t>
+    {
+        return std::ranges::size(urange);
+    }
+
+    //!\copydoc size()
+    constexpr auto size() const
+        requires std::ranges::sized_range<urng_t const>
+    {
+        return std::ranges::size(urange);
+    }
+};
+
+//!\brief Template argument deduction guide.
+template <std::ranges::viewable_range urng_t, typename policy_t>
+view_block_quality(urng_t &&, policy_t) -> view_block_quality<std::views::all_t<urng_t>, policy_t>;
+
+//!\brief The underlying type of bio::views::bin_quality.
+struct bin_quality_fn
+{
+    //!\brief Store the argument and return a range adaptor closure object.
+    constexpr auto operator()(quality_bins const & bins) const { return adaptor_from_functor{*this, bins}; }
+
+    //!\brief Bin the elements of `urange`.
+    template <std::ranges::viewable_range urng_t>
+    constexpr auto operator()(urng_t && urange, quality_bins const & bins) const
+    {
+        static_assert(alphabet::writable_quality<std::ranges::range_value_t<urng_t>>,
+                      "views::bin_quality can only operate on ranges over bio::alphabet::writable_quality.");
+
+        return std::views::transform(std::forward<urng_t>(urange),
+                                     [bins](auto in)
+                                     {
+                                         alphabet::assign_phred_to(bins(alphabet::to_phred(in)), in);
+                                         return in;
+                                     });
+    }
+};
+
+//!\brief The underlying type of bio::views::pblock_quality.
+struct pblock_quality_fn
+{
+    //!\brief Store the argument and return a range adaptor closure object.
+    constexpr auto operator()(int const max_error) const
+    {
+        if (max_error < 0)
+            throw std::invalid_argument{"The maximum error of views::pblock_quality must not be negative."};
+        return adaptor_from_functor{*this, max_error};
+    }
+
+    //!\brief Apply the P-block scheme to `urange`.
+    template <std::ranges::viewable_range urng_t>
+    constexpr auto operator()(urng_t && urange, int const max_error) const
+    {
+        static_assert(std::ranges::forward_range<urng_t>, "views::pblock_quality requires a forward range.");
+        static_assert(alphabet::writable_quality<std::ranges::range_value_t<urng_t>>,
+                      "views::pblock_quality can only operate on ranges over bio::alphabet::writable_quality.");
+
+        if (max_error < 0)
+            throw std::invalid_argument{"The maximum error of views::pblock_quality must not be negative."};
+        return view_block_quality{std::forward<urng_t>(urange), pblock_policy{max_error}};
+    }
+};
+
+//!\brief The underlying type of bio::views::rblock_quality.
+struct rblock_quality_fn
+{
+    //!\brief Store the argument and return a range adaptor closure object.
+    constexpr auto operator()(double const max_ratio) const
+    {
+        if (!(max_ratio >= 1))
+            throw std::invalid_argument{"The maximum ratio of views::rblock_quality must be at least 1."};
+        return adaptor_from_functor{*this, max_ratio};
+    }
+
+    //!\brief Apply the R-block scheme to `urange`.
+    template <std::ranges::viewable_range urng_t>
+    constexpr auto operator()(urng_t && urange, double const max_ratio) const
+    {
+        static_assert(std::ranges::forward_range<urng_t>, "views::rblock_quality requires a forward range.");
+        static_assert(alphabet::writable_quality<std::ranges::range_value_t<urng_t>>,
+                      "views::rblock_quality can only operate on ranges over bio::alphabet::writable_quality.");
+
+        if (!(max_ratio >= 1))
+            throw std::invalid_argument{"The maximum ratio of views::rblock_quality must be at least 1."};
+        return view_block_quality{std::forward<urng_t>(urange), rblock_policy{max_ratio * max_ratio}};
+    }
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges::views
+{
+
+/*!\name Alphabet related views
+ * \{
+ */
+
+/*!\brief               A view that bins the quality scores of a range.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] bins      The binning; see bio::ranges::quality_bins.
+ * \returns             A range of binned elements. See below for the properties of the returned range.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/bin_quality.hpp}
+ *
+ * Every phred score `p` is replaced by `bins(p)`; other components of composites (e.g. bio::alphabet::dna4q) remain
+ * unchanged. To modify a range in-place, bio::ranges::bin_quality() is faster.
+ *
+ * ### View properties
+ *
+ * This view is a **deep view** Given a range-of-range as input (as opposed to just a range), it will apply
+ * the transformation on the innermost range (instead of the outermost range).
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)       |
+ * |----------------------------------|:-------------------------------------:|:------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                          |
+ * | std::ranges::forward_range       |                                       | *preserved*                          |
+ * | std::ranges::bidirectional_range |                                       | *preserved*                          |
+ * | std::ranges::random_access_range |                                       | *preserved*                          |
+ * | std::ranges::contiguous_range    |                                       | *lost*                               |
+ * |                                  |                                       |                                      |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                         |
+ * | std::ranges::view                |                                       | *guaranteed*                         |
+ * | std::ranges::sized_range         |                                       | *preserved*                          |
+ * | std::ranges::common_range        |                                       | *preserved*                          |
+ * | std::ranges::output_range        |                                       | *lost*                               |
+ * | bio::ranges::const_iterable_range |                                       | *preserved*                          |
+ * |                                  |                                       |                                      |
+ * | std::ranges::range_reference_t   | bio::alphabet::writable_quality     | std::ranges::range_value_t<urng_t>   |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/bin_quality_views.cpp
+ * \hideinitializer
+ */
+inline constexpr auto bin_quality = deep{detail::bin_quality_fn{}};
+
+/*!\brief               A view that applies the P-block scheme (maximum absolute error) to quality scores.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] max_error The maximum absolute difference between an original and a new score.
+ * \returns             A range of modified elements. See below for the properties of the returned range.
+ * \throws std::invalid_argument If `max_error` is negative.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/bin_quality.hpp}
+ *
+ * The lazy version of bio::ranges::pblock_quality(); see there for the definition of the blocks. The end of a block
+ * is determined when the iterator enters it, so every element is read twice.
+ *
+ * ### View properties
+ *
+ * This view is a **deep view** Given a range-of-range as input (as opposed to just a range), it will apply
+ * the transformation on the innermost range (instead of the outermost range).
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)       |
+ * |----------------------------------|:-------------------------------------:|:------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                          |
+ * | std::ranges::forward_range       | *required*                            | *guaranteed*                         |
+ * | std::ranges::bidirectional_range |                                       | *lost*                               |
+ * | std::ranges::random_access_range |                                       | *lost*                               |
+ * | std::ranges::contiguous_range    |                                       | *lost*                               |
+ * |                                  |                                       |                                      |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                         |
+ * | std::ranges::view                |                                       | *guaranteed*                         |
+ * | std::ranges::sized_range         |                                       | *preserved*                          |
+ * | std::ranges::common_range        |                                       | *lost*                               |
+ * | std::ranges::output_range        |                                       | *lost*                               |
+ * | bio::ranges::const_iterable_range |                                       | *preserved*                          |
+ * |                                  |                                       |                                      |
+ * | std::ranges::range_reference_t   | bio::alphabet::writable_quality     | std::ranges::range_value_t<urng_t>   |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/bin_quality_views.cpp
+ * \hideinitializer
+ */
+inline constexpr auto pblock_quality = deep{detail::pblock_quality_fn{}};
+
+/*!\brief               A view that applies the R-block scheme (maximum relative error) to quality scores.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed. [parameter is omitted in pipe notation]
+ * \param[in] max_ratio The maximum ratio between an original and a new score (or vice versa); at least 1.
+ * \returns             A range of modified elements. See below for the properties of the returned range.
+ * \throws std::invalid_argument If `max_ratio` is smaller than 1.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/bin_quality.hpp}
+ *
+ * The lazy version of bio::ranges::rblock_quality(); see there for the definition of the blocks. The view properties
+ * are the same as for bio::views::pblock_quality.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/bin_quality_views.cpp
+ * \hideinitializer
+ */
+inline constexpr auto rblock_quality = deep{detail::rblock_quality_fn{}};
+
+//!\}
+
+} // namespace bio::ranges::views
@@ -0,0 +1,561 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::views::find_all.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/views/detail.hpp>
+
+namespace bio::ranges
+{
+
+/*!\brief The kind of errors allowed by bio::views::find_all.
+ * \ingroup views
+ */
+enum class search_errors : uint8_t
+{
+    mismatches, //!< Substitutions only (Hamming distance).
+    edits       //!< Substitutions, insertions and deletions (edit distance).
+};
+
+} // namespace bio::ranges
+
+namespace bio::ranges::detail
+{
+
+/*!\brief The bit masks of a pattern for bit-parallel search (Shift-And, BNDM and Wu–Manber).
+ * \tparam alph_t The alphabet of the pattern.
+ * \ingroup views
+ *
+ * \details
+ *
+ * For every rank of the alphabet, bit `i` of `masks[rank]` is set iff the letter at position `i` of the pattern has
+ * this rank; `reverse_masks` is the same for the reversed pattern (used by BNDM). Patterns are limited to 64 letters.
+ */
+template <alphabet::semialphabet alph_t>
+class bitap_pattern
+{
+public:
+    //!\brief The bit masks (indexed by rank).
+    std::vector<uint64_t> masks;
+    //!\brief The bit masks of the reversed pattern (indexed by rank).
+    std::vector<uint64_t> reverse_masks;
+    //!\brief The size of the pattern.
+    size_t                size       = 0;
+    //!\brief The maximum number of errors (at most #size).
+    size_t                max_errors = 0;
+    //!\brief The kind of errors.
+    search_errors         errors     = search_errors::mismatches;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bitap_pattern()                                  = default; //!< Defaulted.
+    bitap_pattern(bitap_pattern const &)             = default; //!< Defaulted.
+    bitap_pattern(bitap_pattern &&)                  = default; //!< Defaulted.
+    bitap_pattern & operator=(bitap_pattern const &) = default; //!< Defaulted.
+    bitap_pattern & operator=(bitap_pattern &&)      = default; //!< Defaulted.
+    ~bitap_pattern()                                 = default; //!< Defaulted.
+
+    /*!\brief Compute the bit masks of `pattern`.
+     * \throws std::invalid_argument If the pattern is empty or longer than 64 letters.
+     */
+    template <std::ranges::forward_range pattern_t>
+    bitap_pattern(pattern_t && pattern, size_t const max_errors_, search_errors const errors_) :
+      masks(alphabet::size<alph_t>, 0), reverse_masks(alphabet::size<alph_t>, 0), errors{errors_}
+    {
+        size = static_cast<size_t>(std::ranges::distance(pattern));
+        if (size == 0 || size > 64)
+            throw std::invalid_argument{"The pattern of views::find_all must have between 1 and 64 letters."};
+
+        // more errors than letters behave like as many errors as letters
+        max_errors = std::min(max_errors_, size);
+
+        size_t i = 0;
+        for (auto && l : pattern)
+        {
+            masks[alphabet::to_rank(l)] |= uint64_t{1} << i;
+            reverse_masks[alphabet::to_rank(l)] |= uint64_t{1} << (size - 1 - i);
+            ++i;
+        }
+    }
+    //!\}
+
+    //!\brief The bit that marks an occurrence of the complete pattern.
+    uint64_t top() const noexcept { return uint64_t{1} << (size - 1); }
+
+    /*!\brief Whether BNDM is expected to be faster than Shift-And for exact search.
+     *
+     * \details
+     *
+     * BNDM skips more of the text for long patterns over large alphabets; for short DNA patterns, reading every
+     * letter is faster. The threshold was measured on random DNA (BNDM wins from about 20 letters).
+     */
+    bool prefer_skipping() const noexcept { return size * std::bit_width(alphabet::size<alph_t> - 1) > 40; }
+};
+
+/*!\brief The type returned by bio::views::find_all.
+ * \tparam urng_t The type of the underlying range, must model std::ranges::forward_range and std::ranges::view.
+ * \tparam alph_t The alphabet of the pattern.
+ * \implements std::ranges::view
+ * \implements std::ranges::forward_range
+ * \ingroup views
+ */
+template <std::ranges::view urng_t, alphabet::semialphabet alph_t>
+    requires std::ranges::forward_range<urng_t>
+class view_find_all : public std::ranges::view_interface<view_find_all<urng_t, alph_t>>
+{
+private:
+    //!\brief The underlying range.
+    urng_t                urange;
+    //!\brief The bit masks of the pattern.
+    bitap_pattern<alph_t> pattern;
+
+    /*!\brief The iterator type; it stores the state of the search after the current occurrence.
+     * \tparam const_range Whether this is the iterator of the const range.
+     *
+     * \details
+     *
+     * Exact search for long patterns on sized random access ranges uses BNDM; in this case #current stays at the
+     * beginning of the underlying range and #pos is the beginning of the next window. Otherwise, the text is read
+     * letter by letter with Shift-And (exact and mismatches) or Wu and Manber's extension (edits) and #pos is the
+     * number of letters read so far.
+     */
+    template <bool const_range>
+    class basic_iterator
+    {
+    private:
+        //!\brief The underlying range type (possibly const).
+        using base_t     = std::conditional_t<const_range, urng_t const, urng_t>;
+        //!\brief The underlying iterator type.
+        using base_it_t  = std::ranges::iterator_t<base_t>;
+        //!\brief The underlying sentinel type.
+        using base_sen_t = std::ranges::sentinel_t<base_t>;
+
+        //!\brief Whether BNDM can be used for exact search.
+        static constexpr bool skipping = std::ranges::random_access_range<base_t> && std::ranges::sized_range<base_t>;
+
+        //!\brief The pattern.
+        bitap_pattern<alph_t> const * pattern = nullptr;
+        //!\brief The current position in the underlying range (or its beginning, see above).
+        base_it_t                     current{};
+        //!\brief The end of the underlying range.
+        base_sen_t                    urange_end{};
+        //!\brief The number of letters read (or the next window, see above).
+        size_t                        pos    = 0;
+        //!\brief The size of the underlying range (BNDM only).
+        size_t                        n      = 0;
+        //!\brief The end of the current occurrence.
+        size_t                        match  = 0;
+        //!\brief Whether there are no more occurrences.
+        bool                          at_end = false;
+        //!\brief The search state: one bit vector per number of errors.
+        std::vector<uint64_t>         state;
+
+        //!\brief Befriend the other iterator type for the converting constructor.
+        template <bool>
+        friend class basic_iterator;
+
+        //!\brief Whether the BNDM is used.
+        bool uses_bndm() const noexcept { return skipping && pattern->max_errors == 0 && pattern->prefer_skipping(); }
+
+        //!\brief Find the next occurrence with BNDM.
+        void next_bndm()
+            requires skipping
+        {
+            size_t const           m     = pattern->size;
+            uint64_t const         top   = pattern->top();
+            uint64_t const         valid = (top << 1) - 1; // wraps around to all bits for m == 64
+            uint64_t const * const masks = pattern->reverse_masks.data();
+
+            while (pos + m <= n)
+            {
+                size_t   j     = m;
+                size_t   last  = m;
+                bool     found = false;
+                uint64_t d     = valid;
+                while (d != 0 && j > 0)
+                {
+                    --j;
+                    d &= masks[alphabet::to_rank(current[pos + j])];
+                    if (d & top)
+                    {
+                        if (j > 0)
+                            last = j; // the window suffix is a prefix of the pattern
+                        else
+                            found = true;
+                    }
+                    d = (d << 1) & valid;
+                }
+
+                size_t const window = pos;
+                pos += last;
+                if (found)
+                {
+                    match = window + m;
+                    return;
+                }
+            }
+            at_end = true;
+        }
+
+        //!\brief Find the next occurrence with Shift-And.
+        void next_exact()
+        {
+            uint64_t const         top   = pattern->top();
+            uint64_t const * const masks = pattern->masks.data();
+            uint64_t               d     = state[0];
+
+            while (current != urange_end)
+            {
+                d = ((d << 1) | 1) & masks[alphabet::to_rank(*current)];
+                ++current;
+                ++pos;
+                if (d & top)
+                {
+                    state[0] = d;
+                    match    = pos;
+                    return;
+                }
+            }
+            at_end = true;
+        }
+
+        /*!\brief Find the next occurrence with up to `k` errors.
+         * \tparam edits   Whether insertions and deletions are allowed.
+         * \tparam fixed_k The number of errors if known at compile time, else 0.
+         *
+         * \details
+         *
+         * The bit vectors are kept in a local array while reading the text so that the compiler does not need to
+         * assume that they alias the masks; for few errors, the loop over them is unrolled.
+         */
+        template <bool edits, size_t fixed_k = 0>
+        void next_approximate()
+        {
+            uint64_t const         top   = pattern->top();
+            uint64_t const * const masks = pattern->masks.data();
+            size_t const           k     = fixed_k == 0 ? pattern->max_errors : fixed_k;
+
+            uint64_t r[65];
+            std::ranges::copy(state, r);
+            at_end = true;
+
+            while (current != urange_end)
+            {
+                uint64_t const b    = masks[alphabet::to_rank(*current)];
+                uint64_t       prev = r[0]; // the old value of r[d - 1]
+                r[0]                = ((r[0] << 1) | 1) & b;
+                for (size_t d = 1; d <= k; ++d)
+                {
+                    uint64_t const old = r[d];
+                    uint64_t       now = (((old << 1) | 1) & b) | (prev << 1) | 1; // match or substitution
+                    if constexpr (edits)
+                        now |= prev | (r[d - 1] << 1); // insertion or deletion
+                    r[d] = now;
+                    prev = old;
+                }
+                ++current;
+                ++pos;
+                if (r[k] & top)
+                {
+                    match  = pos;
+                    at_end = false;
+                    break;
+                }
+            }
+            std::ranges::copy_n(r, k + 1, state.begin());
+        }
+
+        //!\brief Find the next occurrence.
+        void next()
+        {
+            if constexpr (skipping)
+            {
+                if (uses_bndm())
+                    return next_bndm();
+            }
+
+            auto approximate = [this]<bool edits>()
+            {
+                switch (pattern->max_errors)
+                {
+                    case 1:
+                        return next_approximate<edits, 1>();
+                    case 2:
+                        return next_approximate<edits, 2>();
+                    case 3:
+                        return next_approximate<edits, 3>();
+                    default:
+                        return next_approximate<edits>();
+                }
+            };
+
+            if (pattern->max_errors == 0)
+                next_exact();
+            else if (pattern->errors == search_errors::edits)
+                approximate.template operator()<true>();
+            else
+                approximate.template operator()<false>();
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        using value_type        = size_t;                                  //!< The end of an occurrence.
+        using difference_type   = std::ranges::range_difference_t<base_t>; //!< From the underlying range.
+        using reference         = value_type;                              //!< Elements are generated.
+        using pointer           = void;                                    //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;                 //!< Reference is not a reference type.
+        using iterator_concept  = std::forward_iterator_tag;               //!< Always forward.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        basic_iterator()                                   = default; //!< Defaulted.
+        basic_iterator(basic_iterator const &)             = default; //!< Defaulted.
+        basic_iterator(basic_iterator &&)                  = default; //!< Defaulted.
+        basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+        basic_iterator & operator=(basic_iterator &&)      = default; //!< Defaulted.
+        ~basic_iterator()                                  = default; //!< Defaulted.
+
+        //!\brief Construct from the underlying range and the pattern; finds the first occurrence.
+        basic_iterator(base_t & urng, bitap_pattern<alph_t> const & pat) :
+          pattern{&pat}, current{std::ranges::begin(urng)}, urange_end{std::ranges::end(urng)}
+        {
+            if constexpr (skipping)
+                n = std::ranges::size(urng);
+
+            if (!uses_bndm())
+            {
+                // with edits, a prefix of d letters can always be deleted with d errors
+                state.resize(pattern->max_errors + 1, 0);
+                if (pattern->errors == search_errors::edits)
+                    for (size_t d = 1; d < state.size(); ++d)
+                        state[d] = d >= 64 ? ~uint64_t{0} : (uint64_t{1} << d) - 1;
+            }
+            next();
+        }
+
+        //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+        basic_iterator(basic_iterator<!const_range> it)
+            requires const_range
+          :
+          pattern{it.pattern},
+          current{std::move(it.current)},
+          urange_end{std::move(it.urange_end)},
+          pos{it.pos},
+          n{it.n},
+          match{it.match},
+          at_end{it.at_end},
+          state{std::move(it.state)}
+        {}
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The end position of the current occurrence.
+        reference operator*() const noexcept { return match; }
+
+        //!\brief Pre-increment; finds the next occurrence.
+        basic_iterator & operator++()
+        {
+            next();
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        basic_iterator operator++(int)
+        {
+            basic_iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the occurrences.
+        friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs) noexcept
+        {
+            return lhs.at_end == rhs.at_end && (lhs.at_end || lhs.match == rhs.match);
+        }
+
+        //!\brief Whether there are no more occurrences.
+        friend bool operator==(basic_iterator const & lhs, std::default_sentinel_t const &) noexcept
+        {
+            return lhs.at_end;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    view_find_all()                                      = default; //!< Defaulted.
+    view_find_all(view_find_all const & rhs)             = default; //!< Defaulted.
+    view_find_all(view_find_all && rhs)                  = default; //!< Defaulted.
+    view_find_all & operator=(view_find_all const & rhs) = default; //!< Defaulted.
+    view_find_all & operator=(view_find_all && rhs)      = default; //!< Defaulted.
+    ~view_find_all()                                     = default; //!< Defaulted.
+
+    //!\brief Construct from another view and the pattern.
+    view_find_all(urng_t _urange, bitap_pattern<alph_t> _pattern) :
+      urange{std::move(_urange)}, pattern{std::move(_pattern)}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first occurrence.
+    basic_iterator<false> begin() { return {urange, pattern}; }
+
+    //!\copydoc begin()
+    basic_iterator<true> begin() const
+        requires const_iterable_range<urng_t>
+    {
+        return {urange, pattern};
+    }
+
+    //!\brief Returns a sentinel.
+    std::default_sentinel_t end() const noexcept { return {}; }
+    //!\}
+};
+
+//!\brief Template argument deduction guide.
+template <std::ranges::viewable_range urng_t, typename alph_t>
+view_find_all(urng_t &&, bitap_pattern<alph_t>) -> view_find_all<std::views::all_t<urng_t>, alph_t>;
+
+//!\brief The underlying type of bio::views::find_all.
+struct find_all_fn
+{
+    //!\brief Compute the bit masks of the pattern and return a range adaptor closure object.
+    template <std::ranges::forward_range pattern_t>
+    auto operator()(pattern_t &&        pattern,
+                    size_t const        max_errors = 0,
+                    search_errors const errors     = search_errors::mismatches) const
+    {
+        static_assert(alphabet::semialphabet<std::ranges::range_reference_t<pattern_t>>,
+                      "The pattern of views::find_all must be a range over bio::alphabet::semialphabet.");
+
+        using alph_t = std::ranges::range_value_t<pattern_t>;
+        return adaptor_from_functor{*this, bitap_pattern<alph_t>{pattern, max_errors, errors}};
+    }
+
+    //!\brief Search `pattern` in `urange`.
+    template <std::ranges::viewable_range urng_t, std::ranges::forward_range pattern_t>
+    auto operator()(urng_t &&           urange,
+                    pattern_t &&        pattern,
+                    size_t const        max_errors = 0,
+                    search_errors const errors     = search_errors::mismatches) const
+    {
+        return (*this)(std::forward<urng_t>(urange),
+                       bitap_pattern<std::ranges::range_value_t<pattern_t>>{pattern, max_errors, errors});
+    }
+
+    //!\brief Search the prepared pattern in `urange`.
+    template <std::ranges::viewable_range urng_t, typename alph_t>
+    auto operator()(urng_t && urange, bitap_pattern<alph_t> pattern) const
+    {
+        static_assert(std::ranges::forward_range<urng_t>, "views::find_all requires a forward range.");
+        static_assert(std::same_as<std::ranges::range_value_t<urng_t>, alph_t>,
+                      "The text and the pattern of views::find_all must have the same alphabet.");
+
+        return view_find_all{std::forward<urng_t>(urange), std::move(pattern)};
+    }
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges::views
+{
+
+/*!\name General purpose views
+ * \{
+ */
+
+/*!\brief               A view of the occurrences of a pattern, found with bit-parallel algorithms.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed (the text). [parameter is omitted in pipe notation]
+ * \param[in] pattern   The pattern; a std::ranges::forward_range of 1 to 64 letters of the text's alphabet.
+ * \param[in] max_errors The maximum number of errors (0 by default).
+ * \param[in] errors    Whether errors are bio::ranges::search_errors::mismatches (default) or
+ *                      bio::ranges::search_errors::edits.
+ * \returns             The end positions of the occurrences. See below for the properties of the returned range.
+ * \throws std::invalid_argument If the pattern is empty or longer than 64 letters.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/find_all.hpp}
+ *
+ * Every element is the position one past the end of an occurrence, in increasing order. For exact search and search
+ * with mismatches, the occurrence begins at `position - std::ranges::size(pattern)`. With edits, the same
+ * occurrence can end at neighbouring positions (e.g. with one more or one less letter); all of them are reported.
+ *
+ * Letters are compared by rank. The bit masks of the pattern are computed once, when the adaptor is created;
+ * the occurrences are found lazily, when the iterator is incremented:
+ *
+ *   * Exact search on sized random access ranges uses BNDM (backward nondeterministic DAWG matching), which skips
+ *     parts of the text, if the pattern is long enough for this to pay off (e.g. more than 20 DNA letters).
+ *   * Other exact search uses Shift-And, reading every letter once.
+ *   * Search with errors uses the extension of Shift-And by Wu and Manber with one bit vector per number of errors.
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)        |
+ * |----------------------------------|:-------------------------------------:|:-------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                           |
+ * | std::ranges::forward_range       | *required*                            | *guaranteed*                          |
+ * | std::ranges::bidirectional_range |                                       | *lost*                                |
+ * | std::ranges::random_access_range |                                       | *lost*                                |
+ * | std::ranges::contiguous_range    |                                       | *lost*                                |
+ * |                                  |                                       |                                       |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                          |
+ * | std::ranges::view                |                                       | *guaranteed*                          |
+ * | std::ranges::sized_range         |                                       | *lost*                                |
+ * | std::ranges::common_range        |                                       | *lost*                                |
+ * | std::ranges::output_range        |                                       | *lost*                                |
+ * | bio::ranges::const_iterable_range |                                      | *preserved*                           |
+ * |                                  |                                       |                                       |
+ * | std::ranges::range_reference_t   | bio::alphabet::semialphabet           | `size_t`                              |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/find_all.cpp
+ * \hideinitializer
+ */
+inline constexpr auto find_all = detail::find_all_fn{};
+
+//!\}
+
+} // namespace bio::ranges::views
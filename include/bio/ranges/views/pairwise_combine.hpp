@@ -13,14 +13,111 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <ranges>
+#include <utility>
 
 #include <bio/meta/tuple.hpp>
 #include <bio/meta/type_traits/transformation_trait_or.hpp>
 #include <bio/ranges/concept.hpp>
 #include <bio/ranges/views/detail.hpp>
 
+namespace bio::ranges
+{
+
+/*!\name Pair indexes
+ * \brief Convert between pairs (i, j) and their linear index in bio::ranges::views::pairwise_combine.
+ * \{
+ */
+
+/*!\brief Returns the linear index of the pair (i, j) among the pairs of `n` elements.
+ * \ingroup views
+ * \param[in] n The number of elements in the underlying range.
+ * \param[in] i The position of the first element; must be smaller than `j`.
+ * \param[in] j The position of the second element; must be smaller than `n`.
+ *
+ * \details
+ *
+ * The pairs are numbered in the order in which bio::ranges::views::pairwise_combine generates them:
+ * (0, 1), (0, 2), ..., (0, n - 1), (1, 2), ..., (n - 2, n - 1).
+ *
+ * ### Complexity
+ *
+ * Constant.
+ */
+constexpr size_t pairwise_combine_index(size_t const n, size_t const i, size_t const j) noexcept
+{
+    return i * (2 * n - i - 1) / 2 + j - i - 1;
+}
+
+/*!\brief Returns the pair (i, j) with the given linear index among the pairs of `n` elements.
+ * \ingroup views
+ * \param[in] n     The number of elements in the underlying range; must be smaller than 2^31.
+ * \param[in] index The linear index; must not be greater than `n * (n - 1) / 2`.
+ * \returns The positions of both elements; `index == n * (n - 1) / 2` returns `(n - 1, n)`.
+ *
+ * \details
+ *
+ * This is the inverse of bio::ranges::pairwise_combine_index(). The row `i` is found via the triangular root of the
+ * index (see https://stackoverflow.com/questions/27086195/linear-index-upper-triangular-matrix); since the floating
+ * point estimate may be off by one for large `n`, it is corrected with exact integer arithmetic.
+ *
+ * ### Complexity
+ *
+ * Constant.
+ */
+inline std::pair<size_t, size_t> pairwise_combine_pair(size_t const n, size_t const index) noexcept
+{
+    if (n < 2)
+        return {0, n};
+
+    // the first index of row i
+    auto row_begin = [n](size_t const i) { return i * (2 * n - i - 1) / 2; };
+
+    double const b   = 2.0 * static_cast<double>(n) - 1.0;
+    double const est = (b - std::sqrt(std::max(b * b - 8.0 * static_cast<double>(index), 0.0))) / 2.0;
+    size_t       i   = est > 0 ? std::min(static_cast<size_t>(est), n - 1) : 0;
+
+    while (i > 0 && row_begin(i) > index)
+        --i;
+    while (i + 1 < n && row_begin(i + 1) <= index)
+        ++i;
+
+    return {i, index - row_begin(i) + i + 1};
+}
+
+/*!\brief Returns the linear indexes [first, last) of one of `count` equally sized chunks of the pairs of `n` elements.
+ * \ingroup views
+ * \param[in] n     The number of elements in the underlying range.
+ * \param[in] chunk The number of the chunk; must be smaller than `count`.
+ * \param[in] count The total number of chunks; must be greater than 0.
+ *
+ * \details
+ *
+ * The chunk sizes differ by at most one. This splits the (triangular) pair space evenly, so that every chunk can
+ * be processed by a different thread, e.g. via `v | bio::views::slice(first, last)` which is constant time for
+ * random access ranges. The chunks can also be used with bio::ranges::views::pairwise_combine_tiled which has the
+ * same number of pairs.
+ *
+ * ### Complexity
+ *
+ * Constant.
+ */
+constexpr std::pair<size_t, size_t> pairwise_combine_chunk(size_t const n,
+                                                           size_t const chunk,
+                                                           size_t const count) noexcept
+{
+    size_t const total = n < 2 ? 0 : n * (n - 1) / 2;
+    size_t const size  = total / count;
+    size_t const rest  = total % count;
+    size_t const first = chunk * size + std::min(chunk, rest);
+    return {first, first + size + (chunk < rest)};
+}
+//!\}
+
+} // namespace bio::ranges
+
 namespace bio::ranges::detail
 {
 /*!\brief Generates all pairwise combinations of the elements in the underlying range.
@@ -480,17 +577,13 @@ private:
      * diagonal index of this matrix can be computed using triangular roots
      * (see https://stackoverflow.com/questions/27086195/linear-index-upper-triangular-matrix).
      * Given these properties, one can compute the matrix index (i, j) from the linearised matrix index and vice
-     * versa.
+     * versa (see bio::ranges::pairwise_combine_index() and bio::ranges::pairwise_combine_pair()).
      */
     constexpr size_t to_index() const
       noexcept(noexcept(std::declval<underlying_iterator_type &>() - std::declval<underlying_iterator_type &>()))
         requires std::random_access_iterator<underlying_iterator_type>
     {
-        size_t src_size = end_it - begin_it;
-        size_t index_i  = first_it - begin_it;
-        size_t index_j  = second_it - begin_it;
-        return (src_size * (src_size - 1) / 2) - (src_size - index_i) * ((src_size - index_i) - 1) / 2 + index_j -
-               index_i - 1;
+        return pairwise_combine_index(end_it - begin_it, first_it - begin_it, second_it - begin_it);
     }
 
     /*!\brief Sets the iterator to the given index.
@@ -502,13 +595,9 @@ private:
                std::declval<underlying_iterator_type &>()) && noexcept(std::declval<underlying_iterator_type &>() + 1))
         requires std::random_access_iterator<underlying_iterator_type>
     {
-        size_t src_size = end_it - begin_it;
-        size_t index_i =
-          src_size - 2 - static_cast<size_t>(std::sqrt(-8 * index + 4 * src_size * (src_size - 1) - 7) / 2.0 - 0.5);
-        size_t index_j =
-          index + index_i + 1 - src_size * (src_size - 1) / 2 + (src_size - index_i) * ((src_size - index_i) - 1) / 2;
-        first_it  = begin_it + index_i;
-        second_it = begin_it + index_j;
+        auto [index_i, index_j] = pairwise_combine_pair(end_it - begin_it, index);
+        first_it                = begin_it + index_i;
+        second_it               = begin_it + index_j;
     }
 
     //!\brief The iterator pointing to the first element of the pairwise combination.
@@ -0,0 +1,601 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::views::pairwise_combine_tiled.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+#include <bio/meta/tuple.hpp>
+#include <bio/meta/type_traits/transformation_trait_or.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/views/detail.hpp>
+#include <bio/ranges/views/pairwise_combine.hpp>
+
+namespace bio::ranges::detail
+{
+
+// ============================================================================
+//  pairwise_tiling
+// ============================================================================
+
+/*!\brief The order of pairs in bio::ranges::views::pairwise_combine_tiled.
+ * \ingroup views
+ *
+ * \details
+ *
+ * The positions `0, ..., n - 1` are divided into `t` tiles of `tile_size` positions (the last tile may be smaller).
+ * The pairs are enumerated tile-row by tile-row; within row `I` first the pairs of the diagonal tile (I, I), then
+ * the tiles (I, J) for J > I. Within a tile, pairs are enumerated row by row.
+ */
+struct pairwise_tiling
+{
+    //!\brief The number of elements.
+    size_t n         = 0;
+    //!\brief The number of elements per tile.
+    size_t tile_size = 1;
+
+    //!\brief The number of tiles.
+    constexpr size_t tiles() const noexcept { return (n + tile_size - 1) / tile_size; }
+
+    //!\brief One past the last position of tile `t`.
+    constexpr size_t tile_end(size_t const t) const noexcept { return std::min(n, (t + 1) * tile_size); }
+
+    //!\brief The number of pairs.
+    constexpr size_t size() const noexcept { return n < 2 ? 0 : n * (n - 1) / 2; }
+
+    //!\brief The index of the first pair in tile-row `I`; `I` must be smaller than tiles().
+    constexpr size_t row_begin(size_t const I) const noexcept
+    {
+        // all rows before I consist of full tiles: one triangle and the rectangle with all positions behind the tile
+        return I * tile_size * (tile_size - 1) / 2 + tile_size * (I * n - tile_size * I * (I + 1) / 2);
+    }
+
+    //!\brief The linear index of the pair (i, j), i < j.
+    constexpr size_t index(size_t const i, size_t const j) const noexcept
+    {
+        size_t const I  = i / tile_size;
+        size_t const J  = j / tile_size;
+        size_t const bI = I * tile_size;
+        size_t const sI = tile_end(I) - bI;
+
+        if (I == J)
+            return row_begin(I) + pairwise_combine_index(sI, i - bI, j - bI);
+
+        size_t const bJ = J * tile_size;
+        return row_begin(I) + sI * (sI - 1) / 2 + (J - I - 1) * sI * tile_size + (i - bI) * (tile_end(J) - bJ) +
+               (j - bJ);
+    }
+
+    //!\brief The pair (i, j) with the given linear index; `index` must be smaller than size().
+    inline std::pair<size_t, size_t> pair(size_t const index) const noexcept
+    {
+        // row_begin(I) = b * I - a * I^2 with a = tile_size^2 / 2 and b = n * tile_size - tile_size / 2
+        size_t const t   = tiles();
+        double const bs  = static_cast<double>(tile_size);
+        double const b   = static_cast<double>(n) * bs - bs / 2.0;
+        double const d   = std::max(b * b - 2.0 * bs * bs * static_cast<double>(index), 0.0);
+        double const est = (b - std::sqrt(d)) / (bs * bs);
+        size_t       I   = est > 0 ? std::min(static_cast<size_t>(est), t - 1) : 0;
+
+        // the floating point estimate may be off by one
+        while (I > 0 && row_begin(I) > index)
+            --I;
+        while (I + 1 < t && row_begin(I + 1) <= index)
+            ++I;
+
+        size_t       offset = index - row_begin(I);
+        size_t const bI     = I * tile_size;
+        size_t const sI     = tile_end(I) - bI;
+
+        if (size_t const diagonal = sI * (sI - 1) / 2; offset < diagonal)
+        {
+            auto [i, j] = pairwise_combine_pair(sI, offset);
+            return {bI + i, bI + j};
+        }
+        else
+        {
+            offset -= diagonal;
+        }
+
+        // all tiles before the last one are full
+        size_t const per_tile = sI * tile_size;
+        size_t const J        = std::min(I + 1 + offset / per_tile, t - 1);
+        offset -= (J - I - 1) * per_tile;
+
+        size_t const bJ = J * tile_size;
+        size_t const sJ = tile_end(J) - bJ;
+        return {bI + offset / sJ, bJ + offset % sJ};
+    }
+};
+
+// ============================================================================
+//  pairwise_combine_tiled_view
+// ============================================================================
+
+/*!\brief Generates all pairwise combinations of the elements in the underlying range, tile by tile.
+ * \ingroup views
+ * \tparam underlying_range_type The type of the underlying range; must model std::ranges::view,
+ *                               std::ranges::random_access_range, std::ranges::sized_range and
+ *                               std::ranges::common_range.
+ * \sa bio::ranges::views::pairwise_combine_tiled
+ */
+template <std::ranges::view underlying_range_type>
+    requires(std::ranges::random_access_range<underlying_range_type> &&
+             std::ranges::sized_range<underlying_range_type> && std::ranges::common_range<underlying_range_type>)
+class pairwise_combine_tiled_view :
+  public std::ranges::view_interface<pairwise_combine_tiled_view<underlying_range_type>>
+{
+private:
+    //!\brief The forward declared iterator type.
+    template <typename range_type2>
+    class basic_iterator;
+
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief The iterator type.
+    using iterator = basic_iterator<underlying_range_type>;
+    //!\brief The const iterator type. Evaluates to void if the underlying range is not const iterable.
+    using const_iterator =
+      meta::transformation_trait_or_t<std::type_identity<basic_iterator<underlying_range_type const>>, void>;
+    //!\}
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    pairwise_combine_tiled_view()                                                    = default; //!< Defaulted.
+    pairwise_combine_tiled_view(pairwise_combine_tiled_view const &)                 = default; //!< Defaulted.
+    pairwise_combine_tiled_view(pairwise_combine_tiled_view &&) noexcept             = default; //!< Defaulted.
+    pairwise_combine_tiled_view & operator=(pairwise_combine_tiled_view const &)     = default; //!< Defaulted.
+    pairwise_combine_tiled_view & operator=(pairwise_combine_tiled_view &&) noexcept = default; //!< Defaulted.
+    ~pairwise_combine_tiled_view()                                                   = default; //!< Defaulted.
+
+    /*!\brief Constructs from a view and the tile size.
+     * \param[in] range     The underlying range to be wrapped.
+     * \param[in] tile_size The number of elements per tile.
+     * \throws std::invalid_argument If `tile_size` is 0.
+     */
+    constexpr pairwise_combine_tiled_view(underlying_range_type range, size_t const tile_size) :
+      u_range{std::move(range)}, tiling{std::ranges::size(u_range), tile_size}
+    {
+        if (tile_size == 0)
+            throw std::invalid_argument{"The tile_size argument to bio::views::pairwise_combine_tiled must be > 0."};
+    }
+
+    /*!\brief Constructs from a viewable range and the tile size.
+     * \param[in] range     The underlying range to be wrapped.
+     * \param[in] tile_size The number of elements per tile.
+     * \throws std::invalid_argument If `tile_size` is 0.
+     */
+    template <meta::different_from<pairwise_combine_tiled_view> other_range_t>
+        requires(std::ranges::viewable_range<other_range_t> &&
+                 std::constructible_from<underlying_range_type, std::views::all_t<other_range_t>>)
+    constexpr pairwise_combine_tiled_view(other_range_t && range, size_t const tile_size) :
+      pairwise_combine_tiled_view{std::views::all(std::forward<other_range_t>(range)), tile_size}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first element of the range.
+    constexpr iterator begin() noexcept { return {std::ranges::begin(u_range), tiling, 0}; }
+
+    //!\copydoc begin()
+    constexpr const_iterator begin() const noexcept
+        requires const_iterable_range<underlying_range_type>
+    {
+        return {std::ranges::cbegin(u_range), tiling, 0};
+    }
+
+    //!\brief Returns an iterator to the element following the last element of the range.
+    constexpr iterator end() noexcept { return {std::ranges::begin(u_range), tiling, tiling.size()}; }
+
+    //!\copydoc end()
+    constexpr const_iterator end() const noexcept
+        requires const_iterable_range<underlying_range_type>
+    {
+        return {std::ranges::cbegin(u_range), tiling, tiling.size()};
+    }
+    //!\}
+
+    /*!\name Capacity
+     * \{
+     */
+    //!\brief The number of pairs, `n choose 2`.
+    constexpr size_t size() const noexcept { return tiling.size(); }
+
+    //!\brief The number of elements per tile.
+    constexpr size_t tile_size() const noexcept { return tiling.tile_size; }
+    //!\}
+
+private:
+    //!\brief The underling range.
+    underlying_range_type u_range;
+    //!\brief The tile geometry.
+    pairwise_tiling       tiling;
+};
+
+/*!\name Type deduction guides
+ * \{
+ */
+//!\brief Deduces the correct template type from a non-view lvalue range by wrapping the range in std::views::all.
+template <std::ranges::viewable_range other_range_t>
+pairwise_combine_tiled_view(other_range_t && range, size_t)
+  -> pairwise_combine_tiled_view<std::views::all_t<other_range_t>>;
+//!\}
+
+/*!\brief The iterator type of pairwise_combine_tiled_view.
+ * \tparam range_type The type of the range this iterator is operating on.
+ *
+ * \details
+ *
+ * The iterator stores the linear index of the current pair and the positions (i, j). Incrementing moves to the next
+ * pair in the tile and only recomputes tile boundaries when a tile is finished. Random access converts the linear
+ * index to (i, j) in constant time.
+ */
+template <std::ranges::view underlying_range_type>
+    requires(std::ranges::random_access_range<underlying_range_type> &&
+             std::ranges::sized_range<underlying_range_type> && std::ranges::common_range<underlying_range_type>)
+template <typename range_type>
+class pairwise_combine_tiled_view<underlying_range_type>::basic_iterator
+{
+private:
+    //!\brief Friend declaration for iterator with different range const-ness.
+    template <typename range_type2>
+    friend class basic_iterator;
+
+    //!\brief Alias type for the iterator over the passed range type.
+    using underlying_iterator_type = std::ranges::iterator_t<range_type>;
+    //!\brief Alias for the value type of the underlying iterator type.
+    using underlying_val_t         = std::iter_value_t<underlying_iterator_type>;
+    //!\brief Alias for the reference type of the underlying iterator type.
+    using underlying_ref_t         = std::iter_reference_t<underlying_iterator_type>;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief The difference type.
+    using difference_type   = std::ptrdiff_t;
+    //!\brief The value type.
+    using value_type        = bio::meta::tuple<underlying_val_t, underlying_val_t>;
+    //!\brief The reference type.
+    using reference         = bio::meta::tuple<underlying_ref_t, underlying_ref_t>;
+    //!\brief The pointer type.
+    using pointer           = void;
+    //!\brief The iterator category tag.
+    using iterator_category = detail::iterator_category_tag_t<underlying_iterator_type>;
+    //!\brief The iterator concept tag.
+    using iterator_concept  = std::random_access_iterator_tag;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    basic_iterator()                                       = default; //!< Defaulted.
+    basic_iterator(basic_iterator const &)                 = default; //!< Defaulted.
+    basic_iterator(basic_iterator &&) noexcept             = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator const &)     = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator &&) noexcept = default; //!< Defaulted.
+    ~basic_iterator()                                      = default; //!< Defaulted.
+
+    /*!\brief Constructs the iterator from the begin of the underlying range, the tiling and the linear index.
+     * \param[in] begin_it The iterator pointing to begin of the underlying range.
+     * \param[in] tiling   The tile geometry.
+     * \param[in] index    The linear index of the pair.
+     */
+    constexpr basic_iterator(underlying_iterator_type begin_it, pairwise_tiling const tiling, size_t const index) :
+      begin_it{std::move(begin_it)}, tiling{tiling}
+    {
+        from_index(index);
+    }
+
+    //!\brief Constructs const iterator from non-const iterator.
+    template <typename other_range_type>
+        requires(std::convertible_to<other_range_type, range_type &> &&
+                 std::same_as<std::remove_const_t<other_range_type>, std::remove_const_t<range_type>>)
+    constexpr basic_iterator(basic_iterator<other_range_type> other) noexcept :
+      begin_it{std::move(other.begin_it)},
+      tiling{other.tiling},
+      index{other.index},
+      i{other.i},
+      j{other.j},
+      tile_i{other.tile_i},
+      tile_j{other.tile_j},
+      j_end{other.j_end}
+    {}
+    //!\}
+
+    /*!\name Accessors
+     * \{
+     */
+    //!\brief Accesses the pointed-to element.
+    constexpr reference operator*() const noexcept(noexcept(*std::declval<underlying_iterator_type>()))
+    {
+        return reference{begin_it[i], begin_it[j]};
+    }
+
+    //!\brief Access the element at the given index.
+    constexpr reference operator[](difference_type const offset) const { return *(*this + offset); }
+
+    //!\brief The positions (i, j) of the current pair in the underlying range.
+    constexpr std::pair<size_t, size_t> positions() const noexcept { return {i, j}; }
+    //!\}
+
+    /*!\name Arithmetic operators
+     * \{
+     */
+    //!\brief Pre-increment operator.
+    constexpr basic_iterator & operator++(/*pre-increment*/) noexcept
+    {
+        ++index;
+        if (++j == j_end)
+            next_tile_row();
+        return *this;
+    }
+
+    //!\brief Post-increment operator.
+    constexpr basic_iterator operator++(int /*post-increment*/) noexcept
+    {
+        basic_iterator tmp{*this};
+        ++*this;
+        return tmp;
+    }
+
+    //!\brief Pre-decrement operator.
+    constexpr basic_iterator & operator--(/*pre-decrement*/) noexcept
+    {
+        from_index(index - 1);
+        return *this;
+    }
+
+    //!\brief Post-decrement operator.
+    constexpr basic_iterator operator--(int /*post-decrement*/) noexcept
+    {
+        basic_iterator tmp{*this};
+        --*this;
+        return tmp;
+    }
+
+    //!\brief Advances the iterator by the given offset.
+    constexpr basic_iterator & operator+=(difference_type const offset) noexcept
+    {
+        from_index(index + offset);
+        return *this;
+    }
+
+    //!\brief Advances the iterator by the given offset.
+    constexpr basic_iterator operator+(difference_type const offset) const noexcept
+    {
+        basic_iterator tmp{*this};
+        return (tmp += offset);
+    }
+
+    //!\brief Advances the iterator by the given offset.
+    constexpr friend basic_iterator operator+(difference_type const offset, basic_iterator iter) noexcept
+    {
+        return (iter += offset);
+    }
+
+    //!\brief Decrements the iterator by the given offset.
+    constexpr basic_iterator & operator-=(difference_type const offset) noexcept
+    {
+        from_index(index - offset);
+        return *this;
+    }
+
+    //!\brief Decrements the iterator by the given offset.
+    constexpr basic_iterator operator-(difference_type const offset) const noexcept
+    {
+        basic_iterator tmp{*this};
+        return (tmp -= offset);
+    }
+
+    //!\brief Computes the distance between two iterators.
+    template <typename other_range_type>
+        requires std::same_as<std::remove_const_t<range_type>, std::remove_const_t<other_range_type>>
+    constexpr difference_type operator-(basic_iterator<other_range_type> const & rhs) const noexcept
+    {
+        return static_cast<difference_type>(index - rhs.index);
+    }
+    //!\}
+
+    /*!\name Comparison operators
+     * \{
+     */
+    //!\brief Checks whether `lhs` is equal to `rhs`.
+    constexpr friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs) noexcept
+    {
+        return lhs.index == rhs.index;
+    }
+
+    //!\brief Determines order of `lhs` and `rhs`.
+    constexpr friend auto operator<=>(basic_iterator const & lhs, basic_iterator const & rhs) noexcept
+    {
+        return lhs.index <=> rhs.index;
+    }
+    //!\}
+
+private:
+    //!\brief Called when `j` left its tile: moves to the next row of the tile or to the next tile.
+    constexpr void next_tile_row() noexcept
+    {
+        size_t const t = tiling.tiles();
+        while (j >= j_end)
+        {
+            if (++i < tiling.tile_end(tile_i)) // next row in the same tile
+            {
+                j = tile_i == tile_j ? i + 1 : tile_j * tiling.tile_size;
+            }
+            else if (++tile_j < t) // next tile in the same tile-row
+            {
+                i     = tile_i * tiling.tile_size;
+                j     = tile_j * tiling.tile_size;
+                j_end = tiling.tile_end(tile_j);
+            }
+            else if (++tile_i < t) // next tile-row
+            {
+                tile_j = tile_i;
+                i      = tile_i * tiling.tile_size;
+                j      = i + 1;
+                j_end  = tiling.tile_end(tile_j);
+            }
+            else // end
+            {
+                i = j = j_end = tiling.n;
+                return;
+            }
+        }
+    }
+
+    //!\brief Sets the iterator to the given linear index.
+    constexpr void from_index(size_t const new_index) noexcept
+    {
+        index = new_index;
+        if (index < tiling.size())
+        {
+            std::tie(i, j) = tiling.pair(index);
+            tile_i         = i / tiling.tile_size;
+            tile_j         = j / tiling.tile_size;
+            j_end          = tiling.tile_end(tile_j);
+        }
+        else
+        {
+            i = j = j_end = tiling.n;
+            tile_i = tile_j = tiling.tiles();
+        }
+    }
+
+    //!\brief The begin of the underlying range.
+    underlying_iterator_type begin_it{};
+    //!\brief The tile geometry.
+    pairwise_tiling          tiling{};
+    //!\brief The linear index of the current pair.
+    size_t                   index  = 0;
+    //!\brief The position of the first element.
+    size_t                   i      = 0;
+    //!\brief The position of the second element.
+    size_t                   j      = 0;
+    //!\brief The tile of the first element.
+    size_t                   tile_i = 0;
+    //!\brief The tile of the second element.
+    size_t                   tile_j = 0;
+    //!\brief One past the last position of the tile of the second element.
+    size_t                   j_end  = 0;
+};
+
+// ============================================================================
+//  pairwise_combine_tiled_fn (adaptor definition)
+// ============================================================================
+
+//!\brief View adaptor definition for views::pairwise_combine_tiled.
+struct pairwise_combine_tiled_fn
+{
+    //!\brief Store the argument and return a range adaptor closure object.
+    constexpr auto operator()(size_t const tile_size) const noexcept
+    {
+        return detail::adaptor_from_functor{*this, tile_size};
+    }
+
+    /*!\brief       Call the view's constructor with the underlying view as argument.
+     * \returns     An instance of bio::ranges::detail::pairwise_combine_tiled_view.
+     */
+    template <std::ranges::viewable_range urng_t>
+    constexpr auto operator()(urng_t && urange, size_t const tile_size) const
+    {
+        static_assert(std::ranges::random_access_range<urng_t>,
+                      "The range parameter to views::pairwise_combine_tiled must model "
+                      "std::ranges::random_access_range.");
+        static_assert(std::ranges::sized_range<urng_t>,
+                      "The range parameter to views::pairwise_combine_tiled must model std::ranges::sized_range.");
+        static_assert(std::ranges::common_range<urng_t>,
+                      "The range parameter to views::pairwise_combine_tiled must model std::ranges::common_range.");
+
+        return pairwise_combine_tiled_view{std::forward<urng_t>(urange), tile_size};
+    }
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges::views
+{
+/*!\name General purpose views
+ * \{
+ */
+
+/*!\brief               Like bio::ranges::views::pairwise_combine, but generates the pairs tile by tile.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed.
+ * \param[in] tile_size The number of elements per tile.
+ * \returns             A view over all pairwise combinations of the elements of the underlying range.
+ * \throws std::invalid_argument If `tile_size` is 0.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/pairwise_combine_tiled.hpp}
+ *
+ * This view generates the same `n choose 2` pairs (i, j), i < j as bio::ranges::views::pairwise_combine, but in a
+ * cache-friendly order: the positions are divided into tiles of `tile_size` elements and all pairs between two tiles
+ * are generated before moving on to the next tile. This way, only `2 * tile_size` elements are accessed in a while
+ * instead of the whole range for every `i`. The tile size should be chosen so that two tiles (including the memory
+ * that the elements refer to, e.g. the sequences) fit into the L2 cache.
+ *
+ * For a tile size of `1` (or of at least `n`), the order is the same as that of bio::ranges::views::pairwise_combine.
+ *
+ * The returned view is random access and conversion between the linear index and the pair is constant time. It can be
+ * split into equally sized chunks for multiple threads with bio::ranges::pairwise_combine_chunk().
+ * The iterator has a member `positions()` that returns (i, j).
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)                 |
+ * |----------------------------------|:-------------------------------------:|:----------------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                                    |
+ * | std::ranges::forward_range       | *required*                            | *preserved*                                    |
+ * | std::ranges::bidirectional_range | *required*                            | *preserved*                                    |
+ * | std::ranges::random_access_range | *required*                            | *preserved*                                    |
+ * | std::ranges::contiguous_range    |                                       | *lost*                                         |
+ * |                                  |                                       |                                                |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                                   |
+ * | std::ranges::view                |                                       | *guaranteed*                                   |
+ * | std::ranges::sized_range         | *required*                            | *preserved*                                    |
+ * | std::ranges::common_range        | *required*                            | *guaranteed*                                   |
+ * | std::ranges::output_range        |                                       | *preserved*                                    |
+ * | bio::ranges::const_iterable_range|                                       | *preserved*                                    |
+ * |                                  |                                       |                                                |
+ * | std::ranges::range_reference_t   |                                       | bio::meta::tuple<rng_ref_t, rng_ref_t>         |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Thread safety
+ *
+ * Concurrent access to this view, e.g. while iterating over it, is thread-safe and must not be protected externally.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/pairwise_combine_tiled.cpp
+ *
+ * \hideinitializer
+ */
+inline constexpr auto pairwise_combine_tiled = detail::pairwise_combine_tiled_fn{};
+
+//!\}
+} // namespace bio::ranges::views
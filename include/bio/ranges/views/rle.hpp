@@ -0,0 +1,663 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::views::rle and bio::views::unrle.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+
+#include <bio/alphabet/concept.hpp>
+#include <bio/meta/detail/empty_type.hpp>
+#include <bio/meta/tuple.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/detail/byte_words.hpp>
+#include <bio/ranges/views/deep.hpp>
+#include <bio/ranges/views/detail.hpp>
+
+namespace bio::ranges::detail
+{
+
+/*!\brief Finds the ends of the runs in a contiguous range of bytes, one after the other.
+ * \ingroup views
+ *
+ * \details
+ *
+ * For every block of 64 bytes, the scanner computes a bit mask of the positions where a new run begins, comparing
+ * eight bytes at a time; blocks that only continue the current run are skipped after a cheaper check. The ends of
+ * the runs are then found by counting trailing zeros and clearing the lowest bit of the mask, so finding the end of
+ * a run does not depend on the length of the previous one.
+ */
+class run_boundary_scanner
+{
+private:
+    //!\brief The data.
+    unsigned char const * data  = nullptr;
+    //!\brief The size of the data.
+    size_t                size  = 0;
+    //!\brief The beginning of the current block.
+    size_t                block = 0;
+    //!\brief The run beginnings in the current block that have not been returned, yet.
+    uint64_t              mask  = 0;
+
+    //!\brief Whether the block at `b` consists of 64 copies of the preceding byte.
+    bool continues_run(size_t const b) const noexcept
+    {
+        if (size - b < 64)
+            return false;
+
+        uint64_t const pattern = repeat_byte(data[b - 1]);
+        uint64_t       diff    = 0;
+        for (size_t i = 0; i < 64; i += 8)
+            diff |= load_word(data + b + i) ^ pattern;
+        return diff == 0;
+    }
+
+    //!\brief Bit i is set iff `data[b + i] != data[b + i - 1]` (bit 0 is not set for `b == 0`).
+    uint64_t boundaries(size_t const b) const noexcept
+    {
+        unsigned char const * p = data + b;
+        unsigned char         buf[64];
+        if (size_t const n = size - b; n < 64) // pad by repeating the last byte, i.e. without new runs
+        {
+            std::memcpy(buf, p, n);
+            std::memset(buf + n, p[n - 1], 64 - n);
+            p = buf;
+        }
+
+        uint64_t prev = b == 0 ? p[0] : data[b - 1];
+        uint64_t ret  = 0;
+        for (size_t i = 0; i < 64; i += 8)
+        {
+            uint64_t const w = load_word(p + i);
+            ret |= nonzero_bytes(w ^ ((w << 8) | prev)) << i; // byte k is non-zero iff p[i+k] != p[i+k-1]
+            prev = w >> 56;
+        }
+        return ret;
+    }
+
+public:
+    //!\brief Whether the scanner can be used on this platform (it assumes little endian byte order).
+    static constexpr bool available = std::endian::native == std::endian::little;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    constexpr run_boundary_scanner()                                         = default; //!< Defaulted.
+    constexpr run_boundary_scanner(run_boundary_scanner const &)             = default; //!< Defaulted.
+    constexpr run_boundary_scanner(run_boundary_scanner &&)                  = default; //!< Defaulted.
+    constexpr run_boundary_scanner & operator=(run_boundary_scanner const &) = default; //!< Defaulted.
+    constexpr run_boundary_scanner & operator=(run_boundary_scanner &&)      = default; //!< Defaulted.
+    ~run_boundary_scanner()                                                  = default; //!< Defaulted.
+
+    //!\brief Construct from the data.
+    run_boundary_scanner(void const * const d, size_t const s) noexcept :
+      data{static_cast<unsigned char const *>(d)}, size{s}
+    {
+        if (size > 0)
+            mask = boundaries(0);
+    }
+    //!\}
+
+    //!\brief Returns the end of the next run (the first call returns the end of the first run); `size` at the end.
+    size_t next() noexcept
+    {
+        while (mask == 0)
+        {
+            block += 64;
+            if (block >= size)
+                return size;
+            if (!continues_run(block))
+                mask = boundaries(block);
+        }
+
+        size_t const ret = block + std::countr_zero(mask);
+        mask &= mask - 1;
+        return ret;
+    }
+};
+
+/*!\brief Returns the end of the run that begins at `first`.
+ * \ingroup views
+ */
+template <std::forward_iterator it_t, std::sentinel_for<it_t> sen_t>
+constexpr it_t run_end(it_t const first, sen_t const last)
+{
+    auto const rank = alphabet::to_rank(*first);
+    it_t       it   = std::ranges::next(first);
+    while (it != last && alphabet::to_rank(*it) == rank)
+        ++it;
+    return it;
+}
+
+/*!\brief Whether bio::ranges::detail::run_boundary_scanner can be used on a range.
+ * \ingroup views
+ */
+template <typename rng_t>
+concept scannable_for_runs = run_boundary_scanner::available && std::ranges::contiguous_range<rng_t> &&
+                             std::ranges::sized_range<rng_t> &&
+                             bytewise_comparable_letter<std::ranges::range_value_t<rng_t>>;
+
+/*!\brief The type returned by bio::views::rle.
+ * \tparam urng_t The type of the underlying range, must model std::ranges::forward_range and std::ranges::view.
+ * \implements std::ranges::view
+ * \implements std::ranges::forward_range
+ * \ingroup views
+ */
+template <std::ranges::view urng_t>
+    requires std::ranges::forward_range<urng_t>
+class view_rle : public std::ranges::view_interface<view_rle<urng_t>>
+{
+private:
+    //!\brief The underlying range.
+    urng_t urange;
+
+    /*!\brief The iterator type; it points to the beginning of a run and stores its end.
+     * \tparam const_range Whether this is the iterator of the const range.
+     */
+    template <bool const_range>
+    class basic_iterator
+    {
+    private:
+        //!\brief The underlying range type (possibly const).
+        using base_t     = std::conditional_t<const_range, urng_t const, urng_t>;
+        //!\brief The underlying iterator type.
+        using base_it_t  = std::ranges::iterator_t<base_t>;
+        //!\brief The underlying sentinel type.
+        using base_sen_t = std::ranges::sentinel_t<base_t>;
+
+        //!\brief Whether bio::ranges::detail::run_boundary_scanner is used.
+        static constexpr bool scan = scannable_for_runs<base_t>;
+        //!\brief The scanner type (if used).
+        using scanner_t = std::conditional_t<scan, run_boundary_scanner, meta::detail::empty_type>;
+
+        //!\brief The beginning of the current run.
+        base_it_t                       current{};
+        //!\brief The end of the current run.
+        base_it_t                       current_end{};
+        //!\brief The end of the underlying range.
+        base_sen_t                      urange_end{};
+        //!\brief The beginning of the underlying range (if the scanner is used).
+        [[no_unique_address]] std::conditional_t<scan, base_it_t, meta::detail::empty_type> urange_begin{};
+        //!\brief Finds the ends of runs (if used).
+        [[no_unique_address]] scanner_t scanner{};
+
+        //!\brief Befriend the other iterator type for the converting constructor.
+        template <bool>
+        friend class basic_iterator;
+
+        //!\brief Find the end of the run that begins at #current.
+        constexpr void next_run()
+        {
+            if (current == urange_end)
+                return;
+
+            if constexpr (scan)
+                current_end = urange_begin + scanner.next();
+            else
+                current_end = run_end(current, urange_end);
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        //!\brief The letter and the length of the run.
+        using value_type        = meta::tuple<std::ranges::range_value_t<base_t>, size_t>;
+        using difference_type   = std::ranges::range_difference_t<base_t>; //!< From the underlying range.
+        using reference         = value_type;                              //!< Elements are generated.
+        using pointer           = void;                                    //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;                 //!< Reference is not a reference type.
+        using iterator_concept  = std::forward_iterator_tag;               //!< Always forward.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr basic_iterator()                                   = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator const &)             = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator &&)                  = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator &&)      = default; //!< Defaulted.
+        ~basic_iterator()                                            = default; //!< Defaulted.
+
+        //!\brief Construct from the underlying range.
+        constexpr basic_iterator(base_t & urng) : current{std::ranges::begin(urng)}, urange_end{std::ranges::end(urng)}
+        {
+            if constexpr (scan)
+            {
+                urange_begin = current;
+                scanner      = scanner_t{std::ranges::data(urng), std::ranges::size(urng)};
+            }
+            next_run();
+        }
+
+        //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+        constexpr basic_iterator(basic_iterator<!const_range> it)
+            requires(const_range && scan == basic_iterator<!const_range>::scan)
+          :
+          current{std::move(it.current)},
+          current_end{std::move(it.current_end)},
+          urange_end{std::move(it.urange_end)},
+          urange_begin{std::move(it.urange_begin)},
+          scanner{it.scanner}
+        {}
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The letter and the length of the current run.
+        constexpr reference operator*() const
+        {
+            return {*current, static_cast<size_t>(std::ranges::distance(current, current_end))};
+        }
+
+        //!\brief Pre-increment; finds the end of the next run.
+        constexpr basic_iterator & operator++()
+        {
+            current = current_end;
+            next_run();
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        constexpr basic_iterator operator++(int)
+        {
+            basic_iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the positions.
+        constexpr friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+        {
+            return lhs.current == rhs.current;
+        }
+
+        //!\brief Whether the end has been reached.
+        constexpr friend bool operator==(basic_iterator const & lhs, std::default_sentinel_t const &)
+        {
+            return lhs.current == lhs.urange_end;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    view_rle()                                 = default; //!< Defaulted.
+    view_rle(view_rle const & rhs)             = default; //!< Defaulted.
+    view_rle(view_rle && rhs)                  = default; //!< Defaulted.
+    view_rle & operator=(view_rle const & rhs) = default; //!< Defaulted.
+    view_rle & operator=(view_rle && rhs)      = default; //!< Defaulted.
+    ~view_rle()                                = default; //!< Defaulted.
+
+    //!\brief Construct from another view.
+    constexpr view_rle(urng_t _urange) : urange{std::move(_urange)} {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first run.
+    constexpr basic_iterator<false> begin() { return {urange}; }
+
+    //!\copydoc begin()
+    constexpr basic_iterator<true> begin() const
+        requires const_iterable_range<urng_t>
+    {
+        return {urange};
+    }
+
+    //!\brief Returns a sentinel.
+    constexpr std::default_sentinel_t end() const noexcept { return {}; }
+    //!\}
+};
+
+//!\brief Template argument deduction guide.
+template <std::ranges::viewable_range urng_t>
+view_rle(urng_t &&) -> view_rle<std::views::all_t<urng_t>>;
+
+/*!\brief The type returned by bio::views::unrle.
+ * \tparam urng_t The type of the underlying range of runs, must model std::ranges::forward_range and
+ *                std::ranges::view.
+ * \implements std::ranges::view
+ * \implements std::ranges::forward_range
+ * \ingroup views
+ */
+template <std::ranges::view urng_t>
+    requires std::ranges::forward_range<urng_t>
+class view_unrle : public std::ranges::view_interface<view_unrle<urng_t>>
+{
+private:
+    //!\brief The underlying range.
+    urng_t urange;
+
+    /*!\brief The iterator type; it points to a run and stores the position inside the run.
+     * \tparam const_range Whether this is the iterator of the const range.
+     */
+    template <bool const_range>
+    class basic_iterator
+    {
+    private:
+        //!\brief The underlying range type (possibly const).
+        using base_t     = std::conditional_t<const_range, urng_t const, urng_t>;
+        //!\brief The underlying iterator type.
+        using base_it_t  = std::ranges::iterator_t<base_t>;
+        //!\brief The underlying sentinel type.
+        using base_sen_t = std::ranges::sentinel_t<base_t>;
+
+        //!\brief The current run.
+        base_it_t  current{};
+        //!\brief The end of the underlying range.
+        base_sen_t urange_end{};
+        //!\brief The position inside the current run.
+        size_t     offset = 0;
+
+        //!\brief Befriend the other iterator type for the converting constructor.
+        template <bool>
+        friend class basic_iterator;
+
+        //!\brief Skip runs that have been consumed completely (and empty runs).
+        constexpr void normalise()
+        {
+            while (current != urange_end && offset >= static_cast<size_t>(std::get<1>(*current)))
+            {
+                ++current;
+                offset = 0;
+            }
+        }
+
+    public:
+        /*!\name Associated types
+         * \{
+         */
+        //!\brief The letter type of the runs.
+        using value_type = std::remove_cvref_t<std::tuple_element_t<0, std::ranges::range_value_t<base_t>>>;
+        using difference_type   = std::ranges::range_difference_t<base_t>; //!< From the underlying range.
+        using reference         = value_type;                              //!< Elements are generated.
+        using pointer           = void;                                    //!< Has no pointer.
+        using iterator_category = std::input_iterator_tag;                 //!< Reference is not a reference type.
+        using iterator_concept  = std::forward_iterator_tag;               //!< Always forward.
+        //!\}
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr basic_iterator()                                   = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator const &)             = default; //!< Defaulted.
+        constexpr basic_iterator(basic_iterator &&)                  = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+        constexpr basic_iterator & operator=(basic_iterator &&)      = default; //!< Defaulted.
+        ~basic_iterator()                                            = default; //!< Defaulted.
+
+        //!\brief Construct from the underlying range.
+        constexpr basic_iterator(base_t & urng) : current{std::ranges::begin(urng)}, urange_end{std::ranges::end(urng)}
+        {
+            normalise();
+        }
+
+        //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+        constexpr basic_iterator(basic_iterator<!const_range> it)
+            requires const_range
+          : current{std::move(it.current)}, urange_end{std::move(it.urange_end)}, offset{it.offset}
+        {}
+        //!\}
+
+        /*!\name Access and arithmetic
+         * \{
+         */
+        //!\brief The letter of the current run.
+        constexpr reference operator*() const { return std::get<0>(*current); }
+
+        //!\brief Pre-increment; moves to the next run if necessary.
+        constexpr basic_iterator & operator++()
+        {
+            ++offset;
+            normalise();
+            return *this;
+        }
+
+        //!\brief Post-increment.
+        constexpr basic_iterator operator++(int)
+        {
+            basic_iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+        //!\}
+
+        /*!\name Comparison operators
+         * \{
+         */
+        //!\brief Compare the positions.
+        constexpr friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+        {
+            return lhs.current == rhs.current && lhs.offset == rhs.offset;
+        }
+
+        //!\brief Whether the end has been reached.
+        constexpr friend bool operator==(basic_iterator const & lhs, std::default_sentinel_t const &)
+        {
+            return lhs.current == lhs.urange_end;
+        }
+        //!\}
+    };
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    view_unrle()                                   = default; //!< Defaulted.
+    view_unrle(view_unrle const & rhs)             = default; //!< Defaulted.
+    view_unrle(view_unrle && rhs)                  = default; //!< Defaulted.
+    view_unrle & operator=(view_unrle const & rhs) = default; //!< Defaulted.
+    view_unrle & operator=(view_unrle && rhs)      = default; //!< Defaulted.
+    ~view_unrle()                                  = default; //!< Defaulted.
+
+    //!\brief Construct from another view.
+    constexpr view_unrle(urng_t _urange) : urange{std::move(_urange)} {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    //!\brief Returns an iterator to the first letter.
+    constexpr basic_iterator<false> begin() { return {urange}; }
+
+    //!\copydoc begin()
+    constexpr basic_iterator<true> begin() const
+        requires const_iterable_range<urng_t>
+    {
+        return {urange};
+    }
+
+    //!\brief Returns a sentinel.
+    constexpr std::default_sentinel_t end() const noexcept { return {}; }
+    //!\}
+};
+
+//!\brief Template argument deduction guide.
+template <std::ranges::viewable_range urng_t>
+view_unrle(urng_t &&) -> view_unrle<std::views::all_t<urng_t>>;
+
+//!\brief The underlying type of bio::views::rle.
+class rle_fn : public adaptor_base<rle_fn>
+{
+private:
+    //!\brief Type of the CRTP-base.
+    using base_type = adaptor_base<rle_fn>;
+
+    //!\brief Befriend the base class so it can call impl().
+    friend base_type;
+
+    //!\brief Run-length encode `urange`.
+    template <std::ranges::viewable_range urng_t>
+    static constexpr auto impl(urng_t && urange)
+    {
+        static_assert(std::ranges::forward_range<urng_t>, "views::rle requires a forward range.");
+        static_assert(alphabet::semialphabet<std::ranges::range_reference_t<urng_t>>,
+                      "views::rle can only operate on ranges over bio::alphabet::semialphabet.");
+
+        return view_rle{std::forward<urng_t>(urange)};
+    }
+
+public:
+    using base_type::base_type;
+};
+
+//!\brief The underlying type of bio::views::unrle.
+class unrle_fn : public adaptor_base<unrle_fn>
+{
+private:
+    //!\brief Type of the CRTP-base.
+    using base_type = adaptor_base<unrle_fn>;
+
+    //!\brief Befriend the base class so it can call impl().
+    friend base_type;
+
+    //!\brief Expand the runs in `urange`.
+    template <std::ranges::viewable_range urng_t>
+    static constexpr auto impl(urng_t && urange)
+    {
+        static_assert(std::ranges::forward_range<urng_t>, "views::unrle requires a forward range.");
+        static_assert(std::tuple_size_v<std::ranges::range_value_t<urng_t>> == 2,
+                      "views::unrle requires a range of (letter, count) pairs.");
+        static_assert(std::integral<std::remove_cvref_t<std::tuple_element_t<1, std::ranges::range_value_t<urng_t>>>>,
+                      "views::unrle requires a range of (letter, count) pairs.");
+
+        return view_unrle{std::forward<urng_t>(urange)};
+    }
+
+public:
+    using base_type::base_type;
+};
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges::views
+{
+
+/*!\name General purpose views
+ * \{
+ */
+
+/*!\brief               A view that run-length encodes a range.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed. [parameter is omitted in pipe notation]
+ * \returns             A range of runs. See below for the properties of the returned range.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/rle.hpp}
+ *
+ * Every element is a bio::meta::tuple of the letter and the number of consecutive occurrences of the letter ("run").
+ * Letters are compared by rank. The end of a run is determined when the iterator reaches it.
+ * On contiguous ranges over alphabets whose letters are stored in a single byte (e.g. bio::alphabet::dna4 or
+ * `char`), the beginnings of runs are determined for blocks of 64 letters, comparing eight letters at once
+ * (see bio::ranges::detail::run_boundary_scanner).
+ *
+ * bio::views::unrle performs the inverse operation; bio::ranges::rle_vector stores the runs.
+ *
+ * ### View properties
+ *
+ * This view is a **deep view** Given a range-of-range as input (as opposed to just a range), it will apply
+ * the transformation on the innermost range (instead of the outermost range).
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)        |
+ * |----------------------------------|:-------------------------------------:|:-------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                           |
+ * | std::ranges::forward_range       | *required*                            | *guaranteed*                          |
+ * | std::ranges::bidirectional_range |                                       | *lost*                                |
+ * | std::ranges::random_access_range |                                       | *lost*                                |
+ * | std::ranges::contiguous_range    |                                       | *lost*                                |
+ * |                                  |                                       |                                       |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                          |
+ * | std::ranges::view                |                                       | *guaranteed*                          |
+ * | std::ranges::sized_range         |                                       | *lost*                                |
+ * | std::ranges::common_range        |                                       | *lost*                                |
+ * | std::ranges::output_range        |                                       | *lost*                                |
+ * | bio::ranges::const_iterable_range |                                      | *preserved*                           |
+ * |                                  |                                       |                                       |
+ * | std::ranges::range_reference_t   | bio::alphabet::semialphabet           | bio::meta::tuple<value_type, size_t>  |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/rle.cpp
+ * \hideinitializer
+ */
+inline constexpr auto rle = deep{detail::rle_fn{}};
+
+/*!\brief               A view that expands a range of runs.
+ * \tparam urng_t       The type of the range being processed. See below for requirements. [template parameter is
+ *                      omitted in pipe notation]
+ * \param[in] urange    The range being processed. [parameter is omitted in pipe notation]
+ * \returns             A range of letters. See below for the properties of the returned range.
+ * \ingroup views
+ *
+ * \details
+ *
+ * \header_file{bio/ranges/views/rle.hpp}
+ *
+ * The elements of the underlying range are tuple-like pairs of a letter and a count (e.g. the elements of
+ * bio::views::rle or std::pair<bio::alphabet::dna4, size_t>); every letter is repeated `count` times.
+ * Runs of length 0 are skipped.
+ *
+ * ### View properties
+ *
+ * | Concepts and traits              | `urng_t` (underlying range type)      | `rrng_t` (returned range type)        |
+ * |----------------------------------|:-------------------------------------:|:-------------------------------------:|
+ * | std::ranges::input_range         | *required*                            | *preserved*                           |
+ * | std::ranges::forward_range       | *required*                            | *guaranteed*                          |
+ * | std::ranges::bidirectional_range |                                       | *lost*                                |
+ * | std::ranges::random_access_range |                                       | *lost*                                |
+ * | std::ranges::contiguous_range    |                                       | *lost*                                |
+ * |                                  |                                       |                                       |
+ * | std::ranges::viewable_range      | *required*                            | *guaranteed*                          |
+ * | std::ranges::view                |                                       | *guaranteed*                          |
+ * | std::ranges::sized_range         |                                       | *lost*                                |
+ * | std::ranges::common_range        |                                       | *lost*                                |
+ * | std::ranges::output_range        |                                       | *lost*                                |
+ * | bio::ranges::const_iterable_range |                                      | *preserved*                           |
+ * |                                  |                                       |                                       |
+ * | std::ranges::range_reference_t   | tuple-like (letter, integral)         | the letter type (by value)            |
+ *
+ * See the \link views views submodule documentation \endlink for detailed descriptions of the view properties.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/views/rle.cpp
+ * \hideinitializer
+ */
+inline constexpr auto unrle = detail::unrle_fn{};
+
+//!\}
+
+} // namespace bio::ranges::views
@@ -20,6 +20,7 @@
 #include <bio/meta/tuple.hpp>
 #include <bio/ranges/concept.hpp>
 #include <bio/ranges/views/detail.hpp>
+#include <bio/ranges/zip_components.hpp>
 
 //!\cond
 // Contains helpers for bio::views::zip.
@@ -130,6 +131,30 @@ public:
     = default;
     constexpr explicit zip_view(Views... views) : views_(std::move(views)...) {}
 
+    // not in the standard; found by bio::ranges::to via argument-dependent lookup; appends the zipped components
+    // to a container of the composite with bio::ranges::zip_components()
+    template <typename container_t>
+        requires(std::ranges::random_access_range<Views const> && ...) &&
+                (std::ranges::sized_range<Views const> && ...) &&
+                components_of<std::ranges::range_value_t<container_t>, Views const...> &&
+                std::ranges::random_access_range<container_t> && requires(container_t & c) { c.resize(size_t{}); }
+    friend void to_bulk_append(container_t & container, zip_view const & rng)
+    {
+        size_t const old_size = std::ranges::size(container);
+        size_t const count    = std::ranges::size(rng);
+        container.resize(old_size + count);
+
+        auto const out = std::ranges::begin(container) + old_size;
+        std::apply(
+          [&](auto const &... views)
+          {
+              // views may be longer than the zip
+              zip_components(std::ranges::subrange{out, out + count},
+                             std::ranges::subrange{std::ranges::begin(views), std::ranges::begin(views) + count}...);
+          },
+          rng.views_);
+    }
+
     constexpr auto begin()
         requires(!(simple_view<Views> && ...))
     {
@@ -451,6 +476,10 @@ namespace bio::ranges::views
  *
  * This is an implementation of the C++23 zip_view. It will be replaced with std::views::zip.
  *
+ * Zipping the components of a composite alphabet (e.g. a sequence and its qualities) and converting the result
+ * with bio::ranges::to into a container of the composite (e.g. `std::vector<qualified<dna5, phred42>>`) does not
+ * construct the elements one by one, but uses the bulk kernel bio::ranges::zip_components().
+ *
  * \sa https://en.cppreference.com/w/cpp/ranges/zip_view
  */
 inline constexpr auto zip = detail::zip_fn{};
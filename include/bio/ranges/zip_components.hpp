@@ -0,0 +1,225 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides bio::ranges::zip_components and bio::ranges::unzip_components.
+ * \author Hannes Hauswedell <hannes.hauswedell AT decode.is>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <bio/alphabet/composite/detail.hpp>
+#include <bio/alphabet/concept.hpp>
+
+namespace bio::ranges::detail
+{
+
+//!\brief Whether the value types of `component_rng_ts` are the component types of `composite_t` (in order).
+template <typename composite_t, typename indexes, typename... component_rng_ts>
+inline constexpr bool components_match = false;
+
+//!\cond
+template <typename composite_t, size_t... is, typename... component_rng_ts>
+    requires(sizeof...(is) == sizeof...(component_rng_ts))
+inline constexpr bool components_match<composite_t, std::index_sequence<is...>, component_rng_ts...> =
+  (std::same_as<std::ranges::range_value_t<component_rng_ts>, std::tuple_element_t<is, composite_t>> && ...);
+//!\endcond
+
+/*!\brief Whether the value types of `component_rng_ts` are the component types of `composite_t` (in order).
+ * \ingroup range
+ */
+template <typename composite_t, typename... component_rng_ts>
+concept components_of =
+  alphabet::detail::alphabet_tuple_like<composite_t> &&
+  (std::tuple_size_v<composite_t> == sizeof...(component_rng_ts)) &&
+  components_match<composite_t, std::make_index_sequence<std::tuple_size_v<composite_t>>, component_rng_ts...>;
+
+//!\brief The rank of a composite from the ranks of its components (the first component is the most significant).
+template <typename composite_t, typename... component_ts>
+constexpr alphabet::rank_t<composite_t> compose_rank(component_ts const... components) noexcept
+{
+    // intermediate values never exceed the final rank, so the narrow rank type suffices (and vectorises better)
+    using rank_t = alphabet::rank_t<composite_t>;
+    rank_t rank  = 0;
+    ((rank = static_cast<rank_t>(rank * alphabet::size<component_ts> + alphabet::to_rank(components))), ...);
+    return rank;
+}
+
+/*!\brief Split the rank of a composite into the ranks of its components.
+ * \details
+ *
+ * Divisions by the (constant) alphabet sizes are compiled to multiplications and shifts.
+ */
+template <typename composite_t, size_t... is>
+constexpr void
+decompose_rank(alphabet::rank_t<composite_t> rank, std::index_sequence<is...>, auto &... components) noexcept
+{
+    constexpr size_t count = sizeof...(is);
+    auto             assign_one = [&]<size_t i>(std::integral_constant<size_t, i>, auto & component)
+    {
+        using component_t         = std::tuple_element_t<count - 1 - i, composite_t>;
+        constexpr auto   sigma    = static_cast<alphabet::rank_t<composite_t>>(alphabet::size<component_t>);
+        alphabet::assign_rank_to(static_cast<alphabet::rank_t<component_t>>(rank % sigma), component);
+        rank /= sigma;
+    };
+
+    // least significant component first
+    auto refs = std::tie(components...);
+    (assign_one(std::integral_constant<size_t, is>{}, std::get<count - 1 - is>(refs)), ...);
+}
+
+} // namespace bio::ranges::detail
+
+namespace bio::ranges
+{
+
+/*!\brief Combine ranges of components into a range of a composite alphabet.
+ * \ingroup range
+ * \tparam out_t            Type of the output; a std::ranges::random_access_range over a tuple composite
+ *                          (e.g. bio::alphabet::qualified).
+ * \tparam component_rng_ts Types of the inputs; one std::ranges::random_access_range per component.
+ * \param[out] out           The output range; must have at least as many elements as the inputs.
+ * \param[in]  component_rngs The components, e.g. a sequence and its qualities.
+ * \throws std::invalid_argument If the inputs differ in size or `out` is too small.
+ *
+ * \details
+ *
+ * `out[i]` is assigned the composite of `component_rngs[i]...`. Instead of constructing every composite through
+ * bio::alphabet::tuple_base, the combined rank is computed directly as `rank0 * size1 + rank1` (and so on). If
+ * all ranges are contiguous, this is a simple loop over arrays that the compiler vectorises.
+ *
+ * bio::ranges::to uses this function when it converts a bio::views::zip of the components into a container of
+ * the composite.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/zip_components.cpp
+ */
+template <std::ranges::random_access_range out_t, std::ranges::random_access_range... component_rng_ts>
+    requires(std::ranges::sized_range<component_rng_ts> && ...) &&
+            detail::components_of<std::ranges::range_value_t<out_t>, component_rng_ts...>
+void zip_components(out_t && out, component_rng_ts &&... component_rngs)
+{
+    using composite_t = std::ranges::range_value_t<out_t>;
+
+    size_t const sizes[] = {static_cast<size_t>(std::ranges::size(component_rngs))...};
+    size_t const count   = sizes[0];
+    if (!std::ranges::all_of(sizes, [&](size_t const s) { return s == count; }))
+        throw std::invalid_argument{"All component ranges passed to zip_components need to have the same size."};
+    if constexpr (std::ranges::sized_range<out_t>)
+    {
+        if (static_cast<size_t>(std::ranges::size(out)) < count)
+            throw std::invalid_argument{"The output range of zip_components is too small."};
+    }
+
+    if constexpr (std::ranges::contiguous_range<out_t> && (std::ranges::contiguous_range<component_rng_ts> && ...))
+    {
+        composite_t * const out_ptr = std::ranges::data(out);
+        auto const          in_ptrs = std::tuple{std::ranges::data(component_rngs)...};
+
+        std::apply(
+          [&](auto const *... ins)
+          {
+              for (size_t i = 0; i < count; ++i)
+                  alphabet::assign_rank_to(detail::compose_rank<composite_t>(ins[i]...), out_ptr[i]);
+          },
+          in_ptrs);
+    }
+    else
+    {
+        auto       out_it = std::ranges::begin(out);
+        auto const in_its = std::tuple{std::ranges::begin(component_rngs)...};
+
+        std::apply(
+          [&](auto const &... ins)
+          {
+              for (size_t i = 0; i < count; ++i)
+                  out_it[i] = alphabet::assign_rank_to(detail::compose_rank<composite_t>(ins[i]...), composite_t{});
+          },
+          in_its);
+    }
+}
+
+/*!\brief Split a range of a composite alphabet into ranges of its components.
+ * \ingroup range
+ * \tparam in_t             Type of the input; a std::ranges::random_access_range over a tuple composite
+ *                          (e.g. bio::alphabet::qualified).
+ * \tparam component_rng_ts Types of the outputs; one std::ranges::random_access_range per component.
+ * \param[in]  in             The input range.
+ * \param[out] component_rngs The components, e.g. a sequence and its qualities; must have at least as many elements
+ *                            as `in`.
+ * \throws std::invalid_argument If one of the outputs is too small.
+ *
+ * \details
+ *
+ * This is the inverse of bio::ranges::zip_components(). The component ranks are computed from the combined rank
+ * with divisions by constants (no per-element bio::alphabet::get). If all ranges are contiguous, this is a simple
+ * loop over arrays that the compiler vectorises.
+ *
+ * ### Example
+ *
+ * \include test/snippet/ranges/zip_components.cpp
+ */
+template <std::ranges::random_access_range in_t, std::ranges::random_access_range... component_rng_ts>
+    requires std::ranges::sized_range<in_t> &&
+             detail::components_of<std::ranges::range_value_t<in_t>, component_rng_ts...>
+void unzip_components(in_t && in, component_rng_ts &&... component_rngs)
+{
+    using composite_t    = std::ranges::range_value_t<in_t>;
+    using indexes        = std::make_index_sequence<sizeof...(component_rng_ts)>;
+    size_t const count   = std::ranges::size(in);
+
+    auto check_size = [&]<typename rng_t>(rng_t & rng)
+    {
+        if constexpr (std::ranges::sized_range<rng_t>)
+            if (static_cast<size_t>(std::ranges::size(rng)) < count)
+                throw std::invalid_argument{"An output range of unzip_components is too small."};
+    };
+    (check_size(component_rngs), ...);
+
+    if constexpr (std::ranges::contiguous_range<in_t> && (std::ranges::contiguous_range<component_rng_ts> && ...))
+    {
+        composite_t const * const in_ptr   = std::ranges::data(in);
+        auto const                out_ptrs = std::tuple{std::ranges::data(component_rngs)...};
+
+        std::apply(
+          [&](auto * const... outs)
+          {
+              for (size_t i = 0; i < count; ++i)
+                  detail::decompose_rank<composite_t>(alphabet::to_rank(in_ptr[i]), indexes{}, outs[i]...);
+          },
+          out_ptrs);
+    }
+    else
+    {
+        auto const in_it   = std::ranges::begin(in);
+        auto const out_its = std::tuple{std::ranges::begin(component_rngs)...};
+
+        std::apply(
+          [&](auto const &... outs)
+          {
+              for (size_t i = 0; i < count; ++i)
+              {
+                  std::tuple<std::ranges::range_value_t<component_rng_ts>...> tmp;
+                  std::apply([&](auto &... t)
+                             { detail::decompose_rank<composite_t>(alphabet::to_rank(in_it[i]), indexes{}, t...); },
+                             tmp);
+                  std::apply([&](auto const &... t) { ((outs[i] = t), ...); }, tmp);
+              }
+          },
+          out_its);
+    }
+}
+
+} // namespace bio::ranges
@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/adapter_trimming.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/views/trim_quality.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+using namespace bio::alphabet::literals;
+
+constexpr size_t count  = 10'000;
+constexpr size_t length = 150;
+
+//!\brief Scalar search with early exit per position (the usual hand-written loop).
+size_t naive_position(auto const & read, auto const & adapter, size_t const n)
+{
+    for (size_t p = 0; p + 3 <= n; ++p)
+    {
+        size_t const overlap = std::min(adapter.size(), n - p);
+        size_t const allowed = static_cast<size_t>(std::floor(0.1 * overlap));
+        size_t       errors  = 0;
+        size_t       i       = 0;
+        for (; i < overlap && errors <= allowed; ++i)
+            errors += read[p + i] != adapter[i];
+        if (errors <= allowed)
+            return p;
+    }
+    return n;
+}
+
+//!\brief Quality and adapter trimming of `count` reads of which half contain the adapter.
+template <bool combined>
+void adapter_trimming(benchmark::State & state)
+{
+    auto const adapter = "AGATCGGAAGAGCACACGTCTGAACTCCAGTCA"_dna5;
+
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna5>>    seqs;
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::phred42>> quals;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto seq = bio::test::generate_sequence<bio::alphabet::dna5>(length, 0, i);
+        if (i % 2 == 0)
+        {
+            size_t const start = 50 + i % 100;
+            std::ranges::copy(adapter | std::views::take(length - start), seq.begin() + start);
+        }
+        // a quarter of the reads has a low quality tail
+        std::vector<bio::alphabet::phred42> qual(length, bio::alphabet::phred42{}.assign_phred(35));
+        if (i % 4 == 1)
+            qual[length - 1 - i % 40].assign_phred(1);
+
+        seqs.push_back(seq);
+        quals.push_back(qual);
+    }
+
+    bio::ranges::adapter_trimmer const trimmer{adapter};
+
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        if constexpr (combined)
+        {
+            for (size_t const p : trimmer.trim_positions(seqs, quals, 2))
+                sum += p;
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t const n = std::ranges::distance(quals[i] | bio::views::trim_quality(2));
+                sum += naive_position(seqs[i], adapter, n);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["reads/s"] = benchmark::Counter(count, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(adapter_trimming, false);
+BENCHMARK_TEMPLATE(adapter_trimming, true);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,53 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/quality/phred63.hpp>
+#include <bio/ranges/bin_quality.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+constexpr size_t length = 10'000;
+
+enum class method
+{
+    per_element, //!< to_phred() and assign_phred() per element
+    bulk         //!< bio::ranges::bin_quality
+};
+
+template <method m>
+void bin(benchmark::State & state)
+{
+    auto const                          qual = bio::test::generate_sequence<bio::alphabet::phred63>(length, 0, 0);
+    std::vector<bio::alphabet::phred63> out  = qual;
+    auto const                          bins = bio::ranges::quality_bins::illumina8();
+
+    for (auto _ : state)
+    {
+        if constexpr (m == method::bulk)
+        {
+            bio::ranges::bin_quality(out, bins);
+        }
+        else
+        {
+            for (auto & q : out)
+                q.assign_phred(bins(q.to_phred()));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(bin, method::per_element);
+BENCHMARK_TEMPLATE(bin, method::bulk);
+
+BENCHMARK_MAIN();
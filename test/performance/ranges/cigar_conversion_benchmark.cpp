@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/cigar_conversion.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+using gapped_t = bio::alphabet::gapped<bio::alphabet::dna4>;
+
+constexpr size_t length = 100'000; // a long read
+
+//!\brief An alignment of a long read with an indel every ~50 columns (typical for older nanopore reads).
+std::vector<bio::alphabet::cigar> const cigar = []()
+{
+    std::mt19937                          gen{0};
+    std::uniform_int_distribution<size_t> match_dist{10, 90};
+    std::uniform_int_distribution<size_t> indel_dist{1, 4};
+
+    std::vector<bio::alphabet::cigar> ret;
+    for (size_t ref_len = 0; ref_len < length;)
+    {
+        size_t const m = match_dist(gen);
+        ret.emplace_back(m, bio::alphabet::cigar_op{}.assign_char('M'));
+        ret.emplace_back(indel_dist(gen), bio::alphabet::cigar_op{}.assign_char(gen() % 2 ? 'I' : 'D'));
+        ref_len += m;
+    }
+    return ret;
+}();
+
+bio::ranges::cigar_lengths const lengths = bio::ranges::get_cigar_lengths(cigar);
+
+// ============================================================================
+//  cigar to gapped rows
+// ============================================================================
+
+template <bool bulk>
+void to_gapped(benchmark::State & state)
+{
+    auto const ref   = bio::test::generate_sequence<bio::alphabet::dna4>(lengths.reference, 0, 0);
+    auto const query = bio::test::generate_sequence<bio::alphabet::dna4>(lengths.query, 0, 1);
+
+    std::vector<gapped_t> ref_row, query_row;
+    for (auto _ : state)
+    {
+        if constexpr (bulk)
+        {
+            bio::ranges::cigar_to_gapped(cigar, ref, query, ref_row, query_row);
+        }
+        else
+        {
+            ref_row.clear();
+            query_row.clear();
+            auto r = ref.begin();
+            auto q = query.begin();
+            for (bio::alphabet::cigar const c : cigar)
+            {
+                char const op = get<1>(c).to_char();
+                for (size_t i = 0; i < get<0>(c); ++i)
+                {
+                    ref_row.push_back(op == 'I' ? gapped_t{bio::alphabet::gap{}} : gapped_t{*r++});
+                    query_row.push_back(op == 'D' ? gapped_t{bio::alphabet::gap{}} : gapped_t{*q++});
+                }
+            }
+        }
+        benchmark::DoNotOptimize(ref_row.data());
+        benchmark::DoNotOptimize(query_row.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["columns/s"] = benchmark::Counter(lengths.columns, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(to_gapped, false);
+BENCHMARK_TEMPLATE(to_gapped, true);
+
+// ============================================================================
+//  gapped rows to cigar
+// ============================================================================
+
+template <bool bulk, bool distinguish_mismatches>
+void to_cigar(benchmark::State & state)
+{
+    auto const ref   = bio::test::generate_sequence<bio::alphabet::dna4>(lengths.reference, 0, 0);
+    auto const query = bio::test::generate_sequence<bio::alphabet::dna4>(lengths.query, 0, 1);
+
+    auto [ref_row, query_row] = bio::ranges::cigar_to_gapped(cigar, ref, query);
+    for (size_t i = 0; i < ref_row.size(); ++i) // 98% of the aligned letters match
+        if (ref_row[i] != bio::alphabet::gap{} && query_row[i] != bio::alphabet::gap{} && i % 50 != 0)
+            query_row[i] = ref_row[i];
+
+    std::vector<bio::alphabet::cigar> out;
+    for (auto _ : state)
+    {
+        if constexpr (bulk)
+        {
+            out = bio::ranges::gapped_to_cigar(ref_row, query_row, distinguish_mismatches);
+        }
+        else
+        {
+            out.clear();
+            for (size_t i = 0; i < ref_row.size(); ++i)
+            {
+                bool const ref_gap   = ref_row[i] == bio::alphabet::gap{};
+                bool const query_gap = query_row[i] == bio::alphabet::gap{};
+                char const op        = ref_gap                  ? (query_gap ? 'P' : 'I')
+                                       : query_gap              ? 'D'
+                                       : !distinguish_mismatches ? 'M'
+                                       : ref_row[i] == query_row[i] ? '='
+                                                                    : 'X';
+                bio::alphabet::cigar_op const cop = bio::alphabet::cigar_op{}.assign_char(op);
+                if (!out.empty() && get<1>(out.back()) == cop)
+                    out.back() = bio::alphabet::cigar{get<0>(out.back()) + 1, cop};
+                else
+                    out.emplace_back(1, cop);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["columns/s"] = benchmark::Counter(lengths.columns, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(to_cigar, false, false);
+BENCHMARK_TEMPLATE(to_cigar, true, false);
+BENCHMARK_TEMPLATE(to_cigar, false, true);
+BENCHMARK_TEMPLATE(to_cigar, true, true);
+
+BENCHMARK_MAIN();
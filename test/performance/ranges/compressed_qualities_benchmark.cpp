@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/container/compressed_qualities.hpp>
+
+constexpr size_t n_records = 10'000;
+constexpr size_t length    = 150;
+
+//!\brief Qualities that drift along the read, similar to those of Illumina reads.
+std::vector<std::vector<bio::alphabet::phred42>> generate_qualities()
+{
+    std::mt19937                       gen{42};
+    std::uniform_int_distribution<int> step_dist{-3, 2};
+
+    std::vector<std::vector<bio::alphabet::phred42>> ret(n_records, std::vector<bio::alphabet::phred42>(length));
+    for (auto & record : ret)
+    {
+        int q = 38;
+        for (auto & l : record)
+        {
+            q = std::clamp(q + step_dist(gen), 2, 41);
+            bio::alphabet::assign_phred_to(q, l);
+        }
+    }
+    return ret;
+}
+
+void encode(benchmark::State & state)
+{
+    auto const qualities = generate_qualities();
+    size_t     size      = 0;
+
+    for (auto _ : state)
+    {
+        bio::ranges::compressed_qualities<bio::alphabet::phred42> c{qualities};
+        size = c.compressed_size();
+        benchmark::DoNotOptimize(size);
+    }
+
+    state.counters["ratio"]   = static_cast<double>(n_records * length) / size;
+    state.counters["bytes/s"] = benchmark::Counter(n_records * length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(encode);
+
+void decode(benchmark::State & state)
+{
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{generate_qualities(),
+                                                                      static_cast<size_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        auto d = c.decode();
+        benchmark::DoNotOptimize(d.raw_data().first.data());
+    }
+
+    state.counters["ratio"]   = static_cast<double>(n_records * length) / c.compressed_size();
+    state.counters["bytes/s"] = benchmark::Counter(n_records * length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(decode)->Arg(1 << 14)->Arg(1 << 18);
+
+void random_access(benchmark::State & state)
+{
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{generate_qualities(),
+                                                                      static_cast<size_t>(state.range(0))};
+    std::mt19937                                                    gen{42};
+    std::uniform_int_distribution<size_t>                           dist{0, n_records - 1};
+
+    for (auto _ : state)
+    {
+        auto r = c[dist(gen)];
+        benchmark::DoNotOptimize(r.data());
+    }
+
+    state.counters["records/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(random_access)->Arg(1 << 14)->Arg(1 << 18);
+
+// accesses to the same block reuse its decoding tables
+void random_access_in_block(benchmark::State & state)
+{
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{generate_qualities(),
+                                                                      static_cast<size_t>(state.range(0))};
+
+    // the records of the first block
+    size_t block_records = 1;
+    while (block_records < c.size() && c.block_of(block_records) == 0)
+        ++block_records;
+
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> dist{0, block_records - 1};
+
+    for (auto _ : state)
+    {
+        auto r = c[dist(gen)];
+        benchmark::DoNotOptimize(r.data());
+    }
+
+    state.counters["records/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(random_access_in_block)->Arg(1 << 14)->Arg(1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/arena_resource.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/container/dictionary.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+// ============================================================================
+//  count allocations
+// ============================================================================
+
+// forwards to new/delete (like std::allocator) and counts the allocations
+struct counting_resource : std::pmr::memory_resource
+{
+    size_t allocations = 0;
+
+    void * do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+};
+
+// ============================================================================
+//  one batch of records
+// ============================================================================
+
+constexpr size_t records_per_batch = 1'000;
+
+using seq_t  = bio::ranges::pmr::bitcompressed_vector<bio::alphabet::dna4>;
+using seqs_t = bio::ranges::pmr::concatenated_sequences<seq_t>;
+using dict_t = bio::ranges::pmr::dictionary<std::string, int>;
+
+/* Simulates processing a batch of records: every record has a sequence and some tags. The sequences are
+ * stored in one concatenated_sequences, every record has its own dictionary of tags.
+ * All containers are created with `alloc`.
+ */
+void process_batch(std::vector<std::vector<bio::alphabet::dna4>> const & input,
+                   std::pmr::polymorphic_allocator<> const &             alloc)
+{
+    seqs_t seqs{alloc};
+    for (size_t i = 0; i < records_per_batch; ++i)
+    {
+        seq_t seq{alloc};
+        seq.assign(input[i]);
+        seqs.push_back(seq);
+
+        dict_t tags{alloc};
+        tags.emplace_back("NM", static_cast<int>(i));
+        tags.emplace_back("AS", static_cast<int>(seq.size()));
+        benchmark::DoNotOptimize(tags);
+    }
+    benchmark::DoNotOptimize(seqs);
+}
+
+std::vector<std::vector<bio::alphabet::dna4>> make_input()
+{
+    std::vector<std::vector<bio::alphabet::dna4>> input;
+    for (size_t i = 0; i < records_per_batch; ++i)
+        input.push_back(bio::test::generate_sequence<bio::alphabet::dna4>(150, 50, i));
+    return input;
+}
+
+// ============================================================================
+//  benchmarks
+// ============================================================================
+
+// every container allocates on the heap
+void batch_new_delete(benchmark::State & state)
+{
+    auto const input = make_input();
+
+    counting_resource heap{};
+
+    for (auto _ : state)
+        process_batch(input, std::pmr::polymorphic_allocator<>{&heap});
+
+    state.counters["allocs_per_batch"] = benchmark::Counter(heap.allocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(batch_new_delete);
+
+// all containers of a batch allocate from an arena that is reset after every batch
+void batch_arena(benchmark::State & state)
+{
+    auto const input = make_input();
+
+    counting_resource           heap{};
+    bio::ranges::arena_resource arena{64 * 1024, &heap};
+
+    for (auto _ : state)
+    {
+        process_batch(input, std::pmr::polymorphic_allocator<>{&arena});
+        arena.reset();
+    }
+
+    state.counters["allocs_per_batch"] = benchmark::Counter(heap.allocations, benchmark::Counter::kAvgIterations);
+    state.counters["arena_bytes"]      = arena.bytes_reserved();
+}
+BENCHMARK(batch_arena);
+
+BENCHMARK_MAIN();
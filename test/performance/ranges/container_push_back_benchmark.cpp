@@ -17,6 +17,9 @@
 template <typename t>
 using small_vec = bio::ranges::small_vector<t, 10'000>;
 
+template <typename t>
+using small_buffer_vec = bio::ranges::small_buffer_vector<t, 16>;
+
 // ============================================================================
 //  push_back
 // ============================================================================
@@ -102,6 +105,54 @@ BENCHMARK_TEMPLATE(push_back, small_vec, bio::alphabet::dna15);
 BENCHMARK_TEMPLATE(push_back, small_vec, bio::alphabet::aa27);
 BENCHMARK_TEMPLATE(push_back, small_vec, bio::alphabet::variant<char, bio::alphabet::dna4>);
 
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, char);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, uint8_t);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, uint16_t);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, uint32_t);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, uint64_t);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::gap);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::dna4);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::gapped<bio::alphabet::dna4>);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::dna15);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::aa27);
+BENCHMARK_TEMPLATE(push_back, small_buffer_vec, bio::alphabet::variant<char, bio::alphabet::dna4>);
+
+// ============================================================================
+//  push_back of short sequences (many containers, few elements each)
+// ============================================================================
+
+template <template <typename> typename container_t, typename alphabet_t>
+void push_back_short(benchmark::State & state)
+{
+    size_t const length = state.range(0);
+    alphabet_t   a{};
+
+    for (auto _ : state)
+    {
+        for (size_t j = 0; j < 1'000; ++j)
+        {
+            container_t<alphabet_t> c;
+            for (size_t i = 0; i < length; ++i)
+                c.push_back(a);
+            a = c.back();
+            benchmark::DoNotOptimize(c.data());
+        }
+    }
+
+    state.counters["sizeof"] = sizeof(alphabet_t);
+    state.counters["length"] = length;
+}
+
+template <typename t>
+using small_vec_short = bio::ranges::small_vector<t, 64>;
+
+BENCHMARK_TEMPLATE(push_back_short, std::vector, char)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(push_back_short, small_vec_short, char)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(push_back_short, small_buffer_vec, char)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(push_back_short, std::vector, uint32_t)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(push_back_short, small_vec_short, uint32_t)->Arg(8)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(push_back_short, small_buffer_vec, uint32_t)->Arg(8)->Arg(16)->Arg(64);
+
 // ============================================================================
 //  run
 // ============================================================================
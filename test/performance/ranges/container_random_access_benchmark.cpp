@@ -0,0 +1,65 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/page_allocator.hpp>
+
+// ============================================================================
+//  random access into a large container
+// ============================================================================
+
+using namespace bio::ranges;
+
+template <typename alloc_t>
+void random_access(benchmark::State & state)
+{
+    size_t const size = 1ull << state.range(0);
+
+    bitcompressed_vector<bio::alphabet::dna4, alloc_t> vec{};
+    vec.resize(size);
+    for (size_t i = 0; i < size; i += 997)
+        vec[i] = bio::alphabet::dna4{}.assign_rank(i % 4);
+
+    uint64_t state_ = 42;
+    uint64_t sum    = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < 1'000'000; ++i)
+        {
+            // xorshift
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 7;
+            state_ ^= state_ << 17;
+            sum += vec[state_ & (size - 1)].to_rank();
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+
+    state.counters["accesses"] = benchmark::Counter(1'000'000 * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+template <memory_policy policy>
+using policy_alloc_t = page_allocator<uint64_t, policy, alignof(uint64_t)>;
+
+using huge_alloc_t    = policy_alloc_t<memory_policy{.pages = page_kind::transparent_huge}>;
+using hugetlb_alloc_t = policy_alloc_t<memory_policy{.pages = page_kind::hugetlb}>;
+using numa_alloc_t = policy_alloc_t<memory_policy{.pages = page_kind::transparent_huge, .numa = numa_kind::interleave}>;
+
+// 2^24 letters = 4MiB; 2^32 letters = 1GiB
+BENCHMARK_TEMPLATE(random_access, std::allocator<uint64_t>)->DenseRange(24, 32, 4);
+BENCHMARK_TEMPLATE(random_access, huge_alloc_t)->DenseRange(24, 32, 4);
+BENCHMARK_TEMPLATE(random_access, hugetlb_alloc_t)->DenseRange(24, 32, 4);
+BENCHMARK_TEMPLATE(random_access, numa_alloc_t)->DenseRange(24, 32, 4);
+
+BENCHMARK_MAIN();
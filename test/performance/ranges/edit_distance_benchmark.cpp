@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/edit_distance.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+constexpr size_t count = 1'000;
+
+enum class mode
+{
+    naive,
+    single,
+    batch,
+    banded
+};
+
+//!\brief The textbook DP, one column at a time.
+template <typename lhs_t, typename rhs_t>
+size_t naive_distance(lhs_t const & a, rhs_t const & b, std::vector<size_t> & col)
+{
+    col.resize(a.size() + 1);
+    for (size_t i = 0; i <= a.size(); ++i)
+        col[i] = i;
+    for (size_t j = 1; j <= b.size(); ++j)
+    {
+        size_t diag = col[0];
+        col[0]      = j;
+        for (size_t i = 1; i <= a.size(); ++i)
+        {
+            size_t const up = col[i];
+            col[i]          = std::min({col[i] + 1, col[i - 1] + 1, diag + (a[i - 1] != b[j - 1])});
+            diag            = up;
+        }
+    }
+    return col.back();
+}
+
+//!\brief Compare one read with `count` references of the same length (5% of positions substituted).
+template <mode m>
+void edit(benchmark::State & state)
+{
+    size_t const length = state.range(0);
+    auto const   query  = bio::test::generate_sequence<bio::alphabet::dna4>(length, 0, 0);
+
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> targets;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto       target  = query;
+        auto const changes = bio::test::generate_sequence<bio::alphabet::dna4>(length, 0, i + 1);
+        for (size_t j = i % 20; j < length; j += 20)
+            target[j] = changes[j];
+        targets.push_back(target);
+    }
+
+    std::vector<size_t> col;
+    size_t              sum = 0;
+    for (auto _ : state)
+    {
+        if constexpr (m == mode::naive)
+        {
+            for (auto && t : targets)
+                sum += naive_distance(query, t, col);
+        }
+        else if constexpr (m == mode::single)
+        {
+            for (auto && t : targets)
+                sum += bio::ranges::edit_distance(query, t);
+        }
+        else
+        {
+            size_t const max = m == mode::banded ? length / 10 : length;
+            for (size_t const d : bio::ranges::edit_distances(query, targets, max))
+                sum += d;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["pairs/s"] = benchmark::Counter(count, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(edit, mode::naive)->Arg(50)->Arg(150)->Arg(1000);
+BENCHMARK_TEMPLATE(edit, mode::single)->Arg(50)->Arg(150)->Arg(1000);
+BENCHMARK_TEMPLATE(edit, mode::batch)->Arg(50)->Arg(150)->Arg(1000);
+BENCHMARK_TEMPLATE(edit, mode::banded)->Arg(50)->Arg(150)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/hamming_distance.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+constexpr size_t count = 10'000;
+
+enum class mode
+{
+    naive,
+    single,
+    batch
+};
+
+//!\brief Compare one sequence with `count` others of the same length (e.g. a barcode with a barcode list).
+template <typename container_t, mode m>
+void hamming(benchmark::State & state)
+{
+    size_t const length = state.range(0);
+    auto const   query  = bio::test::generate_sequence<bio::alphabet::dna4>(length, 0, 0);
+
+    bio::ranges::concatenated_sequences<container_t> targets;
+    for (size_t i = 0; i < count; ++i)
+        targets.push_back(bio::test::generate_sequence<bio::alphabet::dna4>(length, 0, i + 1));
+
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        if constexpr (m == mode::naive)
+        {
+            for (auto && t : targets)
+            {
+                size_t d = 0;
+                for (size_t i = 0; i < length; ++i)
+                    d += query[i] != t[i];
+                sum += d;
+            }
+        }
+        else if constexpr (m == mode::single)
+        {
+            for (auto && t : targets)
+                sum += bio::ranges::hamming_distance(query, t);
+        }
+        else
+        {
+            for (size_t const d : bio::ranges::hamming_distances(query, targets))
+                sum += d;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["pairs/s"] = benchmark::Counter(count, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+using bytes_t  = std::vector<bio::alphabet::dna4>;
+using packed_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+
+BENCHMARK_TEMPLATE(hamming, bytes_t, mode::naive)->Arg(16)->Arg(150);
+BENCHMARK_TEMPLATE(hamming, bytes_t, mode::single)->Arg(16)->Arg(150);
+BENCHMARK_TEMPLATE(hamming, bytes_t, mode::batch)->Arg(16)->Arg(150);
+BENCHMARK_TEMPLATE(hamming, packed_t, mode::naive)->Arg(16)->Arg(150);
+BENCHMARK_TEMPLATE(hamming, packed_t, mode::batch)->Arg(16)->Arg(150);
+
+BENCHMARK_MAIN();
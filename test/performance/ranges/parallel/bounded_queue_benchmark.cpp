@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/bounded_queue.hpp>
+
+using batch_t = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+
+// ============================================================================
+//  baseline: std::deque guarded by a mutex
+// ============================================================================
+
+template <typename value_t>
+class mutex_queue
+{
+public:
+    explicit mutex_queue(size_t const capacity) : capacity{capacity} {}
+
+    void push(value_t && value)
+    {
+        std::unique_lock lock{mutex};
+        not_full.wait(lock, [&]() { return queue.size() < capacity; });
+        queue.push_back(std::move(value));
+        lock.unlock();
+        not_empty.notify_one();
+    }
+
+    void pop(value_t & value)
+    {
+        std::unique_lock lock{mutex};
+        not_empty.wait(lock, [&]() { return !queue.empty(); });
+        value = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+    }
+
+private:
+    size_t                  capacity;
+    std::mutex              mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<value_t>     queue;
+};
+
+// ============================================================================
+//  every thread passes batches through the shared queue
+// ============================================================================
+
+// every thread pushes one batch and pops one batch per iteration, so there are never more batches in the queue than
+// threads and push() never blocks indefinitely
+template <typename queue_t>
+void push_pop(benchmark::State & state)
+{
+    static queue_t queue{1024};
+
+    batch_t batch;
+    batch.push_back(std::vector<bio::alphabet::dna4>(150));
+
+    for (auto _ : state)
+    {
+        queue.push(std::move(batch));
+        queue.pop(batch);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(push_pop, mutex_queue<batch_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(push_pop, bio::ranges::bounded_queue<batch_t>)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/rle_vector.hpp>
+#include <bio/ranges/views/rle.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+constexpr size_t length = 1'000'000;
+
+enum class method
+{
+    per_element, //!< compare letters with the first letter of the run, one at a time
+    rle          //!< bio::views::rle
+};
+
+//!\brief Random sequence (short runs) or runs of random length between 1 and 2000 (e.g. masked regions).
+std::vector<bio::alphabet::dna5> generate(bool const long_runs)
+{
+    if (!long_runs)
+        return bio::test::generate_sequence<bio::alphabet::dna5>(length, 0, 0);
+
+    std::mt19937                          gen{0};
+    std::uniform_int_distribution<size_t> len_dist{1, 2000};
+    std::vector<bio::alphabet::dna5>      ret;
+    for (size_t i = 0; ret.size() < length; ++i)
+        ret.insert(ret.end(), len_dist(gen), bio::alphabet::dna5{}.assign_rank(i % 5));
+    ret.resize(length);
+    return ret;
+}
+
+template <method m>
+void count_runs(benchmark::State & state)
+{
+    auto const seq = generate(state.range(0));
+
+    for (auto _ : state)
+    {
+        size_t runs = 0;
+        if constexpr (m == method::rle)
+        {
+            for (auto && [letter, length] : seq | bio::views::rle)
+                runs += length;
+        }
+        else
+        {
+            for (size_t i = 0, j = 0; i < seq.size(); i = j)
+            {
+                for (j = i + 1; j < seq.size() && seq[j] == seq[i]; ++j)
+                {}
+                runs += j - i; // use the length
+            }
+        }
+        benchmark::DoNotOptimize(runs);
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(count_runs, method::per_element)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(count_runs, method::rle)->Arg(0)->Arg(1);
+
+void rle_vector_construct(benchmark::State & state)
+{
+    auto const seq = generate(state.range(0));
+
+    for (auto _ : state)
+    {
+        bio::ranges::rle_vector<bio::alphabet::dna5> r{seq};
+        benchmark::DoNotOptimize(r.run_count());
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(rle_vector_construct)->Arg(0)->Arg(1);
+
+void rle_vector_iterate(benchmark::State & state)
+{
+    bio::ranges::rle_vector<bio::alphabet::dna5> const r{generate(state.range(0))};
+
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        for (bio::alphabet::dna5 const l : r)
+            sum += l.to_rank();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(rle_vector_iterate)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <bio/ranges/suffix_array.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+constexpr size_t letters = 4'000'000;
+
+enum class mode
+{
+    naive,
+    sais32,
+    sais64,
+    parallel
+};
+
+//!\brief Sort the positions by comparing the suffixes.
+template <typename seqs_t>
+std::vector<uint32_t> naive_suffix_array(seqs_t const & seqs)
+{
+    auto const & [values, delimiters] = seqs.raw_data();
+
+    std::vector<uint32_t> ends(values.size());
+    for (size_t i = 0; i + 1 < delimiters.size(); ++i)
+        std::fill(ends.begin() + delimiters[i], ends.begin() + delimiters[i + 1], delimiters[i + 1]);
+
+    std::vector<uint32_t> ret(values.size());
+    std::iota(ret.begin(), ret.end(), 0);
+    std::ranges::sort(ret,
+                      [&](uint32_t const a, uint32_t const b)
+                      {
+                          auto const cmp = std::lexicographical_compare_three_way(values.begin() + a,
+                                                                                  values.begin() + ends[a],
+                                                                                  values.begin() + b,
+                                                                                  values.begin() + ends[b]);
+                          return cmp < 0 || (cmp == 0 && a < b);
+                      });
+    return ret;
+}
+
+//!\brief Sequences of the given length; every tenth is a copy of a previous one (duplicated reads / paralogs).
+template <typename alph_t, mode m>
+void suffix_array(benchmark::State & state)
+{
+    size_t const length = state.range(0);
+
+    bio::ranges::concatenated_sequences<std::vector<alph_t>> seqs;
+    for (size_t i = 0; i < letters / length; ++i)
+    {
+        if (i % 10 == 9)
+            seqs.push_back(seqs[i / 2]);
+        else
+            seqs.push_back(bio::test::generate_sequence<alph_t>(length, 0, i));
+    }
+
+    bio::ranges::thread_pool pool{4};
+    for (auto _ : state)
+    {
+        if constexpr (m == mode::naive)
+            benchmark::DoNotOptimize(naive_suffix_array(seqs));
+        else if constexpr (m == mode::sais32)
+            benchmark::DoNotOptimize(bio::ranges::suffix_array<uint32_t>(seqs));
+        else if constexpr (m == mode::sais64)
+            benchmark::DoNotOptimize(bio::ranges::suffix_array<uint64_t>(seqs));
+        else
+            benchmark::DoNotOptimize(bio::ranges::suffix_array<uint32_t>(pool, seqs));
+    }
+
+    state.counters["letters/s"] =
+      benchmark::Counter(seqs.concat_size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::dna4, mode::naive)->Arg(150)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::dna4, mode::sais32)->Arg(150)->Arg(100'000)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::dna4, mode::sais64)->Arg(150)->Arg(100'000)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::dna4, mode::parallel)->Arg(150)->Arg(100'000)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::aa27, mode::naive)->Arg(300)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::aa27, mode::sais32)->Arg(300)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::aa27, mode::sais64)->Arg(300)->UseRealTime();
+BENCHMARK_TEMPLATE(suffix_array, bio::alphabet::aa27, mode::parallel)->Arg(300)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/views/find_all.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+enum class mode
+{
+    std_search,
+    random_access,
+    forward,
+    mismatches,
+    edits
+};
+
+//!\brief Find all occurrences of a primer/adapter of the given length in 1 Mbp of random DNA.
+template <mode m>
+void find_all(benchmark::State & state)
+{
+    size_t const length  = state.range(0);
+    auto const   text    = bio::test::generate_sequence<bio::alphabet::dna4>(1'000'000, 0, 0);
+    auto const   pattern = bio::test::generate_sequence<bio::alphabet::dna4>(length, 0, 1);
+
+    size_t sum = 0;
+    for (auto _ : state)
+    {
+        if constexpr (m == mode::std_search)
+        {
+            for (auto it = text.begin();; ++it)
+            {
+                it = std::search(it, text.end(), pattern.begin(), pattern.end());
+                if (it == text.end())
+                    break;
+                sum += it - text.begin();
+            }
+        }
+        else if constexpr (m == mode::random_access) // BNDM for long patterns
+        {
+            for (size_t const e : text | bio::ranges::views::find_all(pattern))
+                sum += e;
+        }
+        else if constexpr (m == mode::forward) // Shift-And
+        {
+            for (size_t const e : text | std::views::filter([](auto) { return true; }) |
+                                    bio::ranges::views::find_all(pattern))
+                sum += e;
+        }
+        else
+        {
+            auto const errors =
+              m == mode::mismatches ? bio::ranges::search_errors::mismatches : bio::ranges::search_errors::edits;
+            for (size_t const e : text | bio::ranges::views::find_all(pattern, 2, errors))
+                sum += e;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bp/s"] = benchmark::Counter(text.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(find_all, mode::std_search)->Arg(12)->Arg(20)->Arg(33);
+BENCHMARK_TEMPLATE(find_all, mode::random_access)->Arg(12)->Arg(20)->Arg(33);
+BENCHMARK_TEMPLATE(find_all, mode::forward)->Arg(12)->Arg(20)->Arg(33);
+BENCHMARK_TEMPLATE(find_all, mode::mismatches)->Arg(12)->Arg(20)->Arg(33);
+BENCHMARK_TEMPLATE(find_all, mode::edits)->Arg(12)->Arg(20)->Arg(33);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/views/pairwise_combine.hpp>
+#include <bio/ranges/views/pairwise_combine_tiled.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+// ============================================================================
+//  all-vs-all comparison of short prefixes
+// ============================================================================
+
+// the work per pair is small, so that the runtime is dominated by loading the sequences
+size_t compare(std::vector<bio::alphabet::dna4> const & lhs, std::vector<bio::alphabet::dna4> const & rhs)
+{
+    size_t matches = 0;
+    for (size_t i = 0; i < 64; ++i)
+        matches += lhs[i] == rhs[i];
+    return matches;
+}
+
+std::vector<std::vector<bio::alphabet::dna4>> make_input(size_t const n)
+{
+    std::vector<std::vector<bio::alphabet::dna4>> input;
+    for (size_t i = 0; i < n; ++i)
+        input.push_back(bio::test::generate_sequence<bio::alphabet::dna4>(150, 0, i));
+    return input;
+}
+
+void row_order(benchmark::State & state)
+{
+    auto const input = make_input(state.range(0));
+
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        for (auto [lhs, rhs] : input | bio::views::pairwise_combine)
+            sum += compare(lhs, rhs);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["pairs"] = input.size() * (input.size() - 1) / 2;
+}
+BENCHMARK(row_order)->Arg(1'000)->Arg(20'000);
+
+void tiled(benchmark::State & state)
+{
+    auto const input = make_input(state.range(0));
+
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        for (auto [lhs, rhs] : input | bio::views::pairwise_combine_tiled(state.range(1)))
+            sum += compare(lhs, rhs);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["pairs"] = input.size() * (input.size() - 1) / 2;
+}
+BENCHMARK(tiled)->Args({1'000, 256})->Args({20'000, 256})->Args({20'000, 1024});
+
+BENCHMARK_MAIN();
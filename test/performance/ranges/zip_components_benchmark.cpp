@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/zip_components.hpp>
+
+#include <bio/test/performance/sequence_generator.hpp>
+
+using qualified_t = bio::alphabet::qualified<bio::alphabet::dna5, bio::alphabet::phred42>;
+
+constexpr size_t length = 10'000;
+
+// ============================================================================
+//  combine
+// ============================================================================
+
+template <bool bulk>
+void zip(benchmark::State & state)
+{
+    auto const               seq  = bio::test::generate_sequence<bio::alphabet::dna5>(length, 0, 0);
+    auto const               qual = bio::test::generate_sequence<bio::alphabet::phred42>(length, 0, 1);
+    std::vector<qualified_t> out(length);
+
+    for (auto _ : state)
+    {
+        if constexpr (bulk)
+        {
+            bio::ranges::zip_components(out, seq, qual);
+        }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+                out[i] = qualified_t{seq[i], qual[i]};
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(zip, false);
+BENCHMARK_TEMPLATE(zip, true);
+
+// ============================================================================
+//  split
+// ============================================================================
+
+template <bool bulk>
+void unzip(benchmark::State & state)
+{
+    auto const seq  = bio::test::generate_sequence<bio::alphabet::dna5>(length, 0, 0);
+    auto const qual = bio::test::generate_sequence<bio::alphabet::phred42>(length, 0, 1);
+
+    std::vector<qualified_t> in(length);
+    bio::ranges::zip_components(in, seq, qual);
+    std::vector<bio::alphabet::dna5>    seq_out(length);
+    std::vector<bio::alphabet::phred42> qual_out(length);
+
+    for (auto _ : state)
+    {
+        if constexpr (bulk)
+        {
+            bio::ranges::unzip_components(in, seq_out, qual_out);
+        }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                seq_out[i]  = get<0>(in[i]);
+                qual_out[i] = get<1>(in[i]);
+            }
+        }
+        benchmark::DoNotOptimize(seq_out.data());
+        benchmark::DoNotOptimize(qual_out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["letters/s"] = benchmark::Counter(length, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(unzip, false);
+BENCHMARK_TEMPLATE(unzip, true);
+
+BENCHMARK_MAIN();
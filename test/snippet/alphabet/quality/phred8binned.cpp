@@ -0,0 +1,21 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/phred8binned.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    bio::alphabet::phred8binned q{23};     // binned to 22
+    fmt::print("{}\n", (int)q.to_phred()); // 22
+    fmt::print("{}\n", q.to_char());       // '7'
+
+    // conversion from other quality types bins, too
+    bio::alphabet::phred8binned q2{'H'_phred42}; // phred 39
+    fmt::print("{}\n", q2.to_char());            // 'F' (phred 37)
+
+    // only 3 bits per quality value are needed
+    bio::ranges::bitcompressed_vector<bio::alphabet::phred8binned> v{"II?5+#"_phred8binned};
+    fmt::print("{}\n", v); // IIB70#
+}
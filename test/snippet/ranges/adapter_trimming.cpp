@@ -0,0 +1,31 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/adapter_trimming.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/views/slice.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    // the 5' end of the Illumina TruSeq adapter, up to 10% mismatches, at least 3 letters overlap
+    bio::ranges::adapter_trimmer trimmer{"AGATCGGAAGAGC"_dna5};
+
+    auto   read = "ACGTTGCAACGTAGATCGGTAGAGCTTTT"_dna5;
+    size_t end  = trimmer.adapter_position(read);
+    fmt::print("{}\n", read | bio::views::slice(0, end)); // prints ACGTTGCAACGT
+
+    // a partial adapter at the 3' end
+    fmt::print("{}\n", trimmer.adapter_position("ACGTTGCAACGTAGAT"_dna5)); // prints 12
+
+    // quality trimming (phred < 20) and adapter trimming of many reads in one pass
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna5>>    seqs;
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::phred42>> quals;
+    seqs.push_back(read);
+    quals.push_back("IIIIIIIIIIIIIIIIIIIIIIIIIIIII"_phred42);
+    seqs.push_back("ACGTTGCAACGTACGT"_dna5);
+    quals.push_back("IIIIIIII#IIIIIII"_phred42);
+
+    fmt::print("{}\n", trimmer.trim_positions(seqs, quals, 20)); // prints [12, 8]
+}
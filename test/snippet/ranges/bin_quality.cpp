@@ -0,0 +1,30 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/quality/phred63.hpp>
+#include <bio/ranges/bin_quality.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    std::vector<bio::alphabet::phred63> quals = "IIGH@5.+++$"_phred63;
+
+    // Illumina's 8-level binning
+    std::vector<bio::alphabet::phred63> binned = quals;
+    bio::ranges::bin_quality(binned, bio::ranges::quality_bins::illumina8());
+    fmt::print("{}\n", binned); // IIFFB70000'
+
+    // a user-defined binning: below 20 → 10, 20 and above → 30
+    std::vector<bio::alphabet::phred63> two_bins = quals;
+    bio::ranges::bin_quality(two_bins, bio::ranges::quality_bins{{0, 20}, {10, 30}});
+    fmt::print("{}\n", two_bins); // ??????+++++
+
+    // every score changes by at most 2
+    std::vector<bio::alphabet::phred63> pblock = quals;
+    bio::ranges::pblock_quality(pblock, 2);
+    fmt::print("{}\n", pblock); // HHHH@5,,,,$
+
+    // every score changes by at most 20%
+    std::vector<bio::alphabet::phred63> rblock = quals;
+    bio::ranges::rblock_quality(rblock, 1.2);
+    fmt::print("{}\n", rblock); // DDDDD5,,,,$
+}
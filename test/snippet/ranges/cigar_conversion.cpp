@@ -0,0 +1,27 @@
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/cigar_conversion.hpp>
+
+using namespace bio::alphabet::literals;
+using bio::alphabet::operator""_cigar_op;
+
+int main()
+{
+    std::vector<bio::alphabet::dna4>        reference = "ACGTACGT"_dna4;
+    std::vector<bio::alphabet::dna4>        query     = "ACGAGTT"_dna4;
+    std::vector<bio::alphabet::cigar> const cigar{{4, 'M'_cigar_op}, {2, 'D'_cigar_op}, {2, 'M'_cigar_op},
+                                                  {1, 'I'_cigar_op}};
+
+    auto [reference_row, query_row] = bio::ranges::cigar_to_gapped(cigar, reference, query);
+    fmt::print("{}\n", reference_row); // prints "ACGTACGT-"
+    fmt::print("{}\n", query_row);     // prints "ACGA--GTT"
+
+    fmt::print("{}\n", bio::ranges::gapped_to_cigar(reference_row, query_row)); // prints ["4M", "2D", "2M", "1I"]
+    fmt::print("{}\n", bio::ranges::gapped_to_cigar(reference_row, query_row, true));
+    // prints ["3=", "1X", "2D", "2=", "1I"]
+
+    // the rows can be reused for the next alignment
+    bio::ranges::cigar_to_gapped(cigar, reference, query, reference_row, query_row);
+}
@@ -0,0 +1,27 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/anchor_gaps.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    std::vector<bio::alphabet::dna4> seq = "ACGTACGT"_dna4;
+
+    bio::ranges::anchor_gaps row{seq}; // stores a view of seq
+    row.insert_gap(2, 3);
+    row.insert_gap(9);
+
+    fmt::print("{}\n", row);                       // prints "AC---GTAC-GT"
+    fmt::print("{}\n", row.to_gapped_position(2)); // prints "5"
+    fmt::print("{}\n", row.gap_stretch_count());   // prints "2"
+
+    // convert from and to CIGAR strings
+    using bio::alphabet::operator""_cigar_op;
+    std::vector<bio::alphabet::cigar> const cigar{{4, 'M'_cigar_op}, {2, 'D'_cigar_op}, {2, 'M'_cigar_op}};
+
+    std::vector<bio::alphabet::dna4> query = "ACGAGT"_dna4;
+    auto [ref_row, query_row]              = bio::ranges::cigar_to_anchor_gaps(cigar, seq, query);
+    fmt::print("{}\n", query_row);                                              // prints "ACGA--GT"
+    fmt::print("{}\n", bio::ranges::gapped_to_cigar(ref_row, query_row, true)); // prints ["3=", "1X", "2D", "2="]
+}
@@ -0,0 +1,28 @@
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/arena_resource.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <fmt/format.h>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    bio::ranges::arena_resource arena;
+
+    for (size_t batch = 0; batch < 3; ++batch)
+    {
+        {
+            // all records of the batch allocate from the arena
+            bio::ranges::pmr::concatenated_sequences<bio::ranges::pmr::bitcompressed_vector<bio::alphabet::dna4>> seqs{
+              std::pmr::polymorphic_allocator<>{&arena}};
+
+            seqs.push_back("ACGT"_dna4);
+            seqs.push_back("GAGGA"_dna4);
+            fmt::print("{} {}\n", seqs.size(), arena.bytes_used() > 0); // 2 true
+        }
+
+        // make the memory available to the next batch
+        arena.reset();
+    }
+}
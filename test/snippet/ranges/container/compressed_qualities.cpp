@@ -0,0 +1,21 @@
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/container/compressed_qualities.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    std::vector<std::vector<bio::alphabet::phred42>> qualities{"IIIIHHG!!#"_phred42, "FFFF:F:FFF"_phred42};
+
+    // compressed in blocks of (by default) 2^18 letters
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const compressed{qualities};
+
+    fmt::print("{}\n", compressed.size()); // prints "2"
+    fmt::print("{}\n", compressed[1]);     // decodes and prints "FFFF:F:FFF"
+
+    for (std::vector<bio::alphabet::phred42> const & record : compressed) // decodes every block only once
+        fmt::print("{}\n", record);
+}
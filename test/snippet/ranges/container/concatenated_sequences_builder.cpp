@@ -0,0 +1,29 @@
+#include <thread>
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences_builder.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    // space for at most 100 sequences with a total length of 1000
+    bio::ranges::concatenated_sequences_builder<std::vector<bio::alphabet::dna4>> builder{100, 1000};
+
+    std::thread t1{[&]() { builder.push_back("ACGT"_dna4); }};
+    std::thread t2{[&]()
+                   {
+                       // reserve space for two sequences of total length 9 and fill it
+                       auto segment = builder.reserve(2, 9);
+                       segment.push_back("GAGGA"_dna4);
+                       segment.push_back("TTTT"_dna4);
+                   }};
+    t1.join();
+    t2.join();
+
+    // no letters are copied here:
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> seqs = std::move(builder).finalize();
+    fmt::print("{}\n", seqs.size()); // 3 (order of the elements depends on the threads)
+}
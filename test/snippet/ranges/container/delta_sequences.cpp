@@ -0,0 +1,22 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/delta_sequences.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna4> reference{"ACGTACGTACGTACGT"_dna4};
+    bio::ranges::delta_sequences<bio::alphabet::dna4>      sequences{std::move(reference)};
+
+    sequences.push_back("ACGTACGTTCGTACGT"_dna4);  // one substitution
+    sequences.push_back("ACGTAGTACGTACGTAA"_dna4); // one deletion, one insertion
+    sequences.push_back("CGTACG"_dna4, 1, 7);      // identical to a region of the reference
+
+    fmt::print("{}\n", sequences.edit_count()); // prints "3"
+    fmt::print("{}\n", sequences[1]);           // prints "ACGTAGTACGTACGTAA"
+    fmt::print("{}\n", sequences[1][5]);        // prints "G"
+
+    for (auto && seq : sequences) // every element is a view that decodes while iterating
+        fmt::print("{}\n", seq);
+}
@@ -0,0 +1,24 @@
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/page_allocator.hpp>
+#include <fmt/format.h>
+
+// transparent huge pages, interleaved over all NUMA nodes
+constexpr bio::ranges::memory_policy policy{.pages = bio::ranges::page_kind::transparent_huge,
+                                            .numa  = bio::ranges::numa_kind::interleave};
+
+template <typename t>
+using alloc_t = bio::ranges::page_allocator<t, policy, alignof(t)>;
+
+int main()
+{
+    // allocations of at least one huge page (here 4 MiB each) are mapped from the operating system
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna4, alloc_t<uint64_t>> index{};
+    index.resize(1ull << 24);
+
+    std::vector<uint32_t, alloc_t<uint32_t>> positions(1ull << 20);
+
+    fmt::print("{} {}\n", index.size(), positions.size()); // 16777216 1048576
+}
@@ -0,0 +1,26 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/container/record_batch.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    bio::ranges::record_batch batch;
+
+    for (size_t round = 0; round < 2; ++round)
+    {
+        batch.clear(); // keeps the memory of the previous round
+
+        batch.push_back("read1", "ACGT"_dna5, "II#!"_phred42);
+        batch.push_back("read2", "NAGA"_dna5, "!!!!"_phred42);
+
+        for (auto [id, seq, qual] : batch)
+            fmt::print("{} {} {}\n", std::string_view{id.data(), id.size()}, seq, qual);
+    }
+
+    // a column
+    for (auto seq : batch.seqs())
+        fmt::print("{}\n", seq);
+}
@@ -0,0 +1,19 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/rle_vector.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    bio::ranges::rle_vector<bio::alphabet::dna5> seq{"NNNNNNNNNNACGTTTTNNNNNNNNNN"_dna5};
+    seq.append_run('N'_dna5, 1'000'000); // merged with the last run
+
+    fmt::print("{}\n", seq.size());      // prints "1000027"
+    fmt::print("{}\n", seq.run_count()); // prints "6"
+    fmt::print("{}\n", seq[12]);         // prints "G"
+
+    for (size_t i = 0; i < seq.run_count(); ++i)
+        fmt::print("{}{} ", seq.run_length(i), seq.run_letter(i)); // 10N 1A 1C 1G 4T 1000010N
+    fmt::print("\n");
+}
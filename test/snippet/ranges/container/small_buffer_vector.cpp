@@ -0,0 +1,14 @@
+#include <bio/ranges/container/small_buffer_vector.hpp>
+#include <fmt/format.h>
+
+int main()
+{
+    // stores up to 4 elements without allocating
+    bio::ranges::small_buffer_vector<int, 4> vec{1, 2, 3};
+    fmt::print("{} {}\n", vec.size(), vec.is_inline()); // 3 true
+
+    // the fifth element moves all elements to the heap
+    vec.push_back(4);
+    vec.push_back(5);
+    fmt::print("{} {}\n", vec.size(), vec.is_inline()); // 5 false
+}
@@ -0,0 +1,30 @@
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/container/split_vector.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename t>
+using std_vector = std::vector<t>;
+
+int main()
+{
+    using qualified_t = bio::alphabet::qualified<bio::alphabet::dna4, bio::alphabet::phred42>;
+
+    // bases and qualities are stored in two bitcompressed_vectors (2 bits + 6 bits per letter)
+    bio::ranges::split_vector<qualified_t> vec;
+    vec.assign_columns("ACGT"_dna4, "II#!"_phred42);
+
+    vec[1] = qualified_t{'T'_dna4, '('_phred42}; // writes both columns
+    fmt::print("{}\n", vec.column<0>());        // prints "ATGT"
+    fmt::print("{}\n", vec.column<1>());        // prints "I(#!"
+
+    // with std::vector as columns, the columns are contiguous
+    bio::ranges::split_vector<qualified_t, std_vector> vec2{vec};
+    bio::alphabet::phred42 const * qualities = vec2.column<1>().data();
+    fmt::print("{}\n", *qualities); // prints "I"
+}
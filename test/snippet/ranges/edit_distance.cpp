@@ -0,0 +1,20 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/edit_distance.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    fmt::print("{}\n", bio::ranges::edit_distance("ACGTACGT"_dna4, "ACGACGTT"_dna4));    // prints 2
+    fmt::print("{}\n", bio::ranges::edit_distance("ACGTACGT"_dna4, "TGCATGCA"_dna4, 3)); // prints 4 (> 3)
+
+    // score a read against many references
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> refs;
+    refs.push_back("ACGTTACGT"_dna4);
+    refs.push_back("ACGTACGTACGT"_dna4);
+    refs.push_back("TTGGCCAA"_dna4);
+
+    fmt::print("{}\n", bio::ranges::edit_distances("ACGTACGT"_dna4, refs, 4)); // prints [1, 4, 5]
+}
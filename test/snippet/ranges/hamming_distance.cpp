@@ -0,0 +1,21 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/hamming_distance.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    fmt::print("{}\n", bio::ranges::hamming_distance("ACGTACGT"_dna4, "ACTTACGA"_dna4));    // prints 2
+    fmt::print("{}\n", bio::ranges::hamming_distance("ACGTACGT"_dna4, "TGCATGCA"_dna4, 3)); // prints 4 (> 3)
+
+    // match a read's barcode against all barcodes
+    bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>> barcodes;
+    barcodes.push_back("AACCGGTT"_dna4);
+    barcodes.push_back("ACGTACGT"_dna4);
+    barcodes.push_back("TTGGCCAA"_dna4);
+
+    fmt::print("{}\n", bio::ranges::hamming_distances("ACGTACGA"_dna4, barcodes, 1)); // prints [2, 1, 2]
+}
@@ -0,0 +1,34 @@
+#include <thread>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/bounded_queue.hpp>
+#include <fmt/format.h>
+
+using namespace bio::alphabet::literals;
+
+using batch_t = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+
+int main()
+{
+    bio::ranges::bounded_queue<batch_t> queue{16};
+
+    std::jthread reader{[&]()
+                        {
+                            for (size_t i = 0; i < 3; ++i)
+                            {
+                                batch_t batch;
+                                batch.push_back("ACGT"_dna4);
+                                queue.push(std::move(batch)); // no copy
+                            }
+                            queue.close(); // no more batches
+                        }};
+
+    size_t  count = 0;
+    batch_t batch;
+    while (queue.pop(batch) == bio::ranges::queue_op_status::success)
+        count += batch.size();
+
+    fmt::print("{}\n", count); // 3
+}
@@ -0,0 +1,28 @@
+#include <atomic>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/for_each.hpp>
+#include <fmt/format.h>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> seqs;
+    seqs.push_back("ACGTTTATTAGATTAGA"_dna4);
+    seqs.push_back("GA"_dna4);
+    seqs.push_back("GGGAGAC"_dna4);
+
+    bio::ranges::thread_pool pool{2};
+
+    // the work is split by the number of letters, not the number of sequences
+    std::atomic<size_t> letters = 0;
+    bio::ranges::parallel_for_each(pool, seqs, [&](auto && seq) { letters += seq.size(); });
+    fmt::print("{}\n", letters.load()); // 26
+
+    std::vector<size_t> sizes(seqs.size());
+    bio::ranges::parallel_transform(pool, seqs, sizes, [](auto && seq) { return seq.size(); });
+    fmt::print("{}\n", sizes); // [17, 2, 7]
+}
@@ -0,0 +1,14 @@
+#include <atomic>
+
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <fmt/format.h>
+
+int main()
+{
+    bio::ranges::thread_pool pool{4};
+
+    // run 100 tasks and wait for them; the calling thread helps
+    std::atomic<size_t> sum = 0;
+    pool.run(100, [&](size_t const i) { sum += i; });
+    fmt::print("{}\n", sum.load()); // 4950
+}
@@ -0,0 +1,37 @@
+#include <algorithm>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <bio/ranges/suffix_array.hpp>
+#include <bio/ranges/views/slice.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    // a single sequence
+    fmt::print("{}\n", bio::ranges::suffix_array("ACAACG"_dna4)); // prints [2, 0, 3, 1, 4, 5]
+
+    // suffixes end at the end of their sequence; equal suffixes are ordered by position
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> seqs;
+    seqs.push_back("CAC"_dna4);
+    seqs.push_back("AC"_dna4);
+
+    std::vector<uint32_t> const sa = bio::ranges::suffix_array<uint32_t>(seqs);
+    fmt::print("{}\n", sa); // prints [1, 3, 2, 4, 0]
+
+    // map a position of the concatenation to a sequence and a position in it
+    auto const & delimiters = seqs.raw_data().second;
+    for (uint32_t const p : sa)
+    {
+        size_t const i = std::ranges::upper_bound(delimiters, p) - delimiters.begin() - 1;
+        size_t const j = p - delimiters[i];
+        fmt::print("{}:{} {}\n", i, j, seqs[i] | bio::views::slice(j, seqs[i].size())); // prints 0:1 AC, 1:0 AC, ...
+    }
+
+    // in parallel
+    bio::ranges::thread_pool pool{4};
+    fmt::print("{}\n", bio::ranges::suffix_array(pool, seqs) == bio::ranges::suffix_array(seqs)); // prints true
+}
@@ -3,6 +3,7 @@
 #include <list>
 #include <vector>
 
+#include <bio/ranges/parallel/thread_pool.hpp>
 #include <bio/ranges/to.hpp>
 
 int main()
@@ -36,4 +37,9 @@ int main()
 
     auto vec6 = lst | bio::ranges::to<std::deque>();
     static_assert(std::same_as<decltype(vec6), std::deque<int>>);
+
+    // fill the container with the threads of a pool
+    bio::ranges::thread_pool pool{4};
+    auto vec7 = lst | bio::ranges::to<std::vector>(bio::ranges::par(pool));
+    static_assert(std::same_as<decltype(vec7), std::vector<int>>);
 }
@@ -0,0 +1,15 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/views/bin_quality.hpp>
+#include <bio/ranges/views/to_char.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    std::vector<bio::alphabet::phred42> quals = "IIGH@5.+++$"_phred42;
+
+    fmt::print("{}\n", quals | bio::views::bin_quality(bio::ranges::quality_bins::illumina8())); // IIFFB70000'
+    fmt::print("{}\n", quals | bio::views::pblock_quality(2));                                   // HHHH@5,,,,$
+    fmt::print("{}\n", quals | bio::views::rblock_quality(1.2));                                 // DDDDD5,,,,$
+}
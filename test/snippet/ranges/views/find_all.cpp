@@ -0,0 +1,21 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/views/find_all.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    std::vector<bio::alphabet::dna4> read = "TTACGTACGGATCGGAAGAGCACAC"_dna4;
+
+    // exact search; the elements are the ends of the occurrences
+    fmt::print("{}\n", read | bio::views::find_all("ACG"_dna4)); // [5, 9]
+
+    // an adapter prefix with up to one mismatch
+    auto adapter = "AGATCGGAAG"_dna4;
+    for (size_t end : read | bio::views::find_all(adapter, 1))
+        fmt::print("adapter at {}\n", end - adapter.size()); // adapter at 8
+
+    // up to one substitution, insertion or deletion
+    fmt::print("{}\n", read | bio::views::find_all("GAGAGC"_dna4, 1, bio::ranges::search_errors::edits)); // [21]
+}
@@ -0,0 +1,23 @@
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/ranges/views/pairwise_combine_tiled.hpp>
+#include <bio/ranges/views/slice.hpp>
+
+int main()
+{
+    std::vector vec{'a', 'b', 'c', 'd', 'e'};
+
+    // all pairs of a tile of two elements, before the next tile
+    auto v = vec | bio::views::pairwise_combine_tiled(2);
+    for (auto res : v)
+        fmt::print("{} ", res);
+    fmt::print("\n");
+
+    // split into three chunks of (almost) equal size, e.g. for three threads
+    for (size_t chunk = 0; chunk < 3; ++chunk)
+    {
+        auto [first, last] = bio::ranges::pairwise_combine_chunk(vec.size(), chunk, 3);
+        fmt::print("chunk {}: {}\n", chunk, v | bio::views::slice(first, last));
+    }
+}
@@ -0,0 +1,20 @@
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/views/rle.hpp>
+
+int main()
+{
+    using namespace bio::alphabet::literals;
+
+    std::vector<bio::alphabet::dna5> seq = "NNNNACCGTTTN"_dna5;
+
+    for (auto && [letter, length] : seq | bio::views::rle)
+        fmt::print("{}{} ", length, letter); // 4N 1A 2C 1G 3T 1N
+    fmt::print("\n");
+
+    // homopolymer compression
+    fmt::print("{}\n", seq | bio::views::rle | std::views::elements<0>); // NACGTN
+
+    // and back
+    fmt::print("{}\n", seq | bio::views::rle | bio::views::unrle); // NNNNACCGTTTN
+}
@@ -0,0 +1,33 @@
+#include <vector>
+
+#include <bio/alphabet/fmt.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/to.hpp>
+#include <bio/ranges/views/zip.hpp>
+#include <bio/ranges/zip_components.hpp>
+
+using namespace bio::alphabet::literals;
+
+int main()
+{
+    using qualified_t = bio::alphabet::qualified<bio::alphabet::dna5, bio::alphabet::phred42>;
+
+    std::vector<bio::alphabet::dna5>    seq  = "ACGTN"_dna5;
+    std::vector<bio::alphabet::phred42> qual = "II#!("_phred42;
+
+    // combine
+    std::vector<qualified_t> combined(seq.size());
+    bio::ranges::zip_components(combined, seq, qual);
+
+    // the same, via bio::views::zip
+    auto combined2 = bio::views::zip(seq, qual) | bio::ranges::to<std::vector<qualified_t>>();
+    fmt::print("{}\n", combined == combined2); // prints "true"
+
+    // split again
+    std::vector<bio::alphabet::dna5>    seq2(combined.size());
+    std::vector<bio::alphabet::phred42> qual2(combined.size());
+    bio::ranges::unzip_components(combined, seq2, qual2);
+    fmt::print("{} {}\n", seq2, qual2); // prints "ACGTN II#!("
+}
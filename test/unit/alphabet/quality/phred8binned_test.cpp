@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/phred8binned.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+
+#include "../alphabet_constexpr_test_template.hpp"
+#include "../alphabet_test_template.hpp"
+#include "../semi_alphabet_constexpr_test_template.hpp"
+#include "../semi_alphabet_test_template.hpp"
+
+using namespace bio::alphabet::literals;
+
+INSTANTIATE_TYPED_TEST_SUITE_P(phred8binned, alphabet, bio::alphabet::phred8binned, );
+INSTANTIATE_TYPED_TEST_SUITE_P(phred8binned, semi_alphabet_test, bio::alphabet::phred8binned, );
+INSTANTIATE_TYPED_TEST_SUITE_P(phred8binned, alphabet_constexpr, bio::alphabet::phred8binned, );
+INSTANTIATE_TYPED_TEST_SUITE_P(phred8binned, semi_alphabet_constexpr, bio::alphabet::phred8binned, );
+
+TEST(phred8binned, concept_check)
+{
+    EXPECT_TRUE(bio::alphabet::writable_quality<bio::alphabet::phred8binned>);
+    EXPECT_TRUE(bio::alphabet::writable_quality<bio::alphabet::phred8binned &>);
+    EXPECT_TRUE(bio::alphabet::quality<bio::alphabet::phred8binned const>);
+    EXPECT_FALSE(bio::alphabet::writable_quality<bio::alphabet::phred8binned const>);
+}
+
+TEST(phred8binned, conversion_phred)
+{
+    using p_t = bio::alphabet::phred8binned::phred_type;
+    for (p_t i = std::numeric_limits<p_t>::lowest(); i < std::numeric_limits<p_t>::max(); ++i)
+    {
+        bio::alphabet::phred8binned v{i};
+
+        p_t expected = 40;
+        if (i <= 2)
+            expected = 2;
+        else if (i <= 9)
+            expected = 6;
+        else if (i <= 19)
+            expected = 15;
+        else if (i <= 24)
+            expected = 22;
+        else if (i <= 29)
+            expected = 27;
+        else if (i <= 34)
+            expected = 33;
+        else if (i <= 39)
+            expected = 37;
+
+        EXPECT_EQ(v.to_phred(), expected) << "phred: " << int{i};
+    }
+}
+
+TEST(phred8binned, conversion_char)
+{
+    using c_t = bio::alphabet::phred8binned::char_type;
+    for (c_t i = std::numeric_limits<c_t>::lowest(); i < std::numeric_limits<c_t>::max(); ++i)
+    {
+        bio::alphabet::phred8binned v;
+        v.assign_char(i);
+
+        bio::alphabet::phred8binned const w{static_cast<int8_t>(std::max(i - '!', 0))};
+        EXPECT_EQ(v, w);
+        EXPECT_EQ(v.to_char(), v.to_phred() + '!');
+        EXPECT_EQ(bio::alphabet::char_is_valid_for<bio::alphabet::phred8binned>(i), i >= '!');
+    }
+}
+
+TEST(phred8binned, conversion_rank)
+{
+    for (uint8_t r = 0; r < 8; ++r)
+    {
+        bio::alphabet::phred8binned v;
+        v.assign_rank(r);
+        EXPECT_EQ(v.to_phred(), bio::alphabet::phred8binned::bin_values[r]);
+        // representatives are fixed points of the binning
+        EXPECT_EQ(bio::alphabet::phred8binned{v.to_phred()}, v);
+    }
+}
+
+TEST(phred8binned, conversion_quality)
+{
+    EXPECT_EQ(bio::alphabet::phred8binned{'H'_phred42}, 'F'_phred8binned);
+    EXPECT_EQ(bio::alphabet::phred8binned{'#'_phred42}, '#'_phred8binned);
+    EXPECT_EQ(bio::alphabet::phred42{'<'_phred8binned}, '<'_phred42);
+}
+
+TEST(phred8binned, string_literal)
+{
+    EXPECT_EQ("IIJ!"_phred8binned, "III#"_phred8binned);
+    EXPECT_EQ(bio::alphabet::to_char('5'_phred8binned), '7');
+}
+
+TEST(phred8binned, bitcompressed_vector)
+{
+    bio::ranges::bitcompressed_vector<bio::alphabet::phred8binned> v;
+    for (char c : std::string_view{"#'07<BFI"})
+        v.push_back(bio::alphabet::phred8binned{}.assign_char(c));
+
+    EXPECT_EQ(v.size(), 8u);
+    EXPECT_TRUE(std::ranges::equal(v, "#'07<BFI"_phred8binned));
+}
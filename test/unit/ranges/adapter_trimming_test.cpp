@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/aliases.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/adapter_trimming.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/views/slice.hpp>
+#include <bio/ranges/views/trim_quality.hpp>
+#include <bio/ranges/views/zip.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using bio::alphabet::dna5;
+
+std::vector<dna5> random_sequence(size_t const size, std::mt19937 & gen, size_t const sigma = 4)
+{
+    std::uniform_int_distribution<size_t> rank_dist{0, sigma - 1};
+    std::vector<dna5>                     ret(size);
+    for (auto & l : ret)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+    return ret;
+}
+
+//!\brief The expected adapter position.
+size_t naive_position(std::vector<dna5> const & read,
+                      std::vector<dna5> const & adapter,
+                      double const              rate,
+                      size_t const              min_overlap)
+{
+    for (size_t p = 0; p < read.size(); ++p)
+    {
+        size_t const overlap = std::min(adapter.size(), read.size() - p);
+        if (overlap < std::min(min_overlap, adapter.size()))
+            break;
+        size_t errors = 0;
+        for (size_t i = 0; i < overlap; ++i)
+            errors += adapter[i] != 'N'_dna5 && read[p + i] != adapter[i];
+        if (errors <= static_cast<size_t>(std::floor(rate * overlap)))
+            return p;
+    }
+    return read.size();
+}
+
+TEST(adapter_trimmer, basic)
+{
+    bio::ranges::adapter_trimmer const trimmer{"AGATCGGAAGAGC"_dna5};
+
+    // complete adapter
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTAGATCGGAAGAGCTTTT"_dna5), 8u);
+    // adapter at the end
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTACGTAGATCG"_dna5), 12u);
+    // one mismatch in 13 letters is allowed (rate 0.1), two are not
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTAGATCGGTAGAGCTTTT"_dna5), 8u);
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTAGTTCGGTAGAGCTTTT"_dna5), 25u);
+    // overlaps shorter than three letters are not trimmed
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTACGTCCAG"_dna5), 16u);
+    EXPECT_EQ(trimmer.adapter_position("ACGTACGTACGTCAGA"_dna5), 13u);
+    // no adapter, empty read
+    EXPECT_EQ(trimmer.adapter_position("CCCCCCCCCC"_dna5), 10u);
+    EXPECT_EQ(trimmer.adapter_position(std::vector<dna5>{}), 0u);
+
+    // N in the adapter matches everything
+    bio::ranges::adapter_trimmer const wildcard{"AGNNCGG"_dna5, 0.0};
+    EXPECT_EQ(wildcard.adapter_position("TTTAGTTCGGTT"_dna5), 3u);
+
+    // usable with views::slice
+    auto read = "ACGTACGTAGATCGGAAGAGCTTTT"_dna5;
+    EXPECT_RANGE_EQ(read | bio::views::slice(0, trimmer.adapter_position(read)), "ACGTACGT"_dna5);
+}
+
+TEST(adapter_trimmer, random)
+{
+    std::mt19937 gen{0};
+    for (double const rate : {0.0, 0.1, 0.2})
+    {
+        for (size_t const min_overlap : {1, 3, 8})
+        {
+            for (size_t const adapter_size : {3, 13, 33, 80})
+            {
+                auto const adapter = random_sequence(adapter_size, gen, 5);
+                for (size_t const read_size : {0, 1, 10, 100, 151, 300, 600})
+                {
+                    for (size_t rep = 0; rep < 5; ++rep)
+                    {
+                        // a random read with a (possibly truncated and mutated) adapter
+                        auto         read  = random_sequence(read_size, gen);
+                        size_t const start = read_size == 0 ? 0 : gen() % read_size;
+                        for (size_t i = 0; i < adapter_size && start + i < read_size; ++i)
+                            read[start + i] = gen() % 8 == 0 ? random_sequence(1, gen)[0] : adapter[i];
+
+                        bio::ranges::adapter_trimmer const trimmer{adapter, rate, min_overlap};
+                        EXPECT_EQ(trimmer.adapter_position(read), naive_position(read, adapter, rate, min_overlap))
+                          << rate << ' ' << min_overlap << ' ' << adapter_size << ' ' << read_size;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(adapter_trimmer, packed)
+{
+    bio::ranges::adapter_trimmer const            trimmer{"AGATCGGAAGAGC"_dna5};
+    bio::ranges::bitcompressed_vector<dna5> const read{"ACGTACGTAGATCGGAAGAGCTTTT"_dna5};
+    EXPECT_EQ(trimmer.adapter_position(read), 8u);
+}
+
+TEST(adapter_trimmer, quality)
+{
+    using bio::alphabet::phred42;
+
+    bio::ranges::adapter_trimmer const trimmer{"AGATCGGAAGAGC"_dna5};
+
+    auto const           seq = "ACGTACGTAGATCGGAAGAGCTTTT"_dna5;
+    std::vector<phred42> qual(seq.size(), bio::alphabet::assign_phred_to(30, phred42{}));
+    EXPECT_EQ(trimmer.trim_position(seq, qual, 20), 8u);
+
+    // a low quality letter before the adapter
+    qual[5] = bio::alphabet::assign_phred_to(10, phred42{});
+    EXPECT_EQ(trimmer.trim_position(seq, qual, 20), 5u);
+    EXPECT_EQ(trimmer.trim_position(seq, qual, bio::alphabet::assign_phred_to(20, phred42{})), 5u);
+    EXPECT_EQ(trimmer.trim_position(seq, qual, 5), 8u);
+
+    // the end of the quality-trimmed read is the 3' end: AGAT at 8..11
+    qual[5]  = bio::alphabet::assign_phred_to(30, phred42{});
+    qual[12] = bio::alphabet::assign_phred_to(10, phred42{});
+    EXPECT_EQ(trimmer.trim_position(seq, qual, 20), 8u);
+    auto const seq2 = "ACGTACGTACGTACGTAGATTTT"_dna5;
+    std::vector<phred42> qual2(seq2.size(), bio::alphabet::assign_phred_to(30, phred42{}));
+    EXPECT_EQ(trimmer.trim_position(seq2, qual2, 20), seq2.size());
+    qual2[20] = bio::alphabet::assign_phred_to(2, phred42{});
+    EXPECT_EQ(trimmer.trim_position(seq2, qual2, 20), 16u);
+
+    // the same as trim_quality, then adapter_position
+    auto const trimmed = bio::views::zip(seq2, qual2) | std::views::elements<1> | bio::views::trim_quality(20);
+    EXPECT_EQ(std::ranges::distance(trimmed), 20);
+    EXPECT_EQ(trimmer.adapter_position(seq2 | bio::views::slice(0, 20)), 16u);
+
+    // qualified letters
+    std::vector<bio::alphabet::dna5q> read;
+    for (size_t i = 0; i < seq2.size(); ++i)
+        read.push_back(bio::alphabet::dna5q{seq2[i], qual2[i]});
+    EXPECT_EQ(trimmer.trim_position(read, 20), 16u);
+    EXPECT_EQ(trimmer.adapter_position(read), seq2.size()); // without quality trimming
+}
+
+TEST(adapter_trimmer, batch)
+{
+    using bio::alphabet::phred42;
+
+    std::mt19937                       gen{1};
+    auto const                         adapter = random_sequence(20, gen);
+    bio::ranges::adapter_trimmer const trimmer{adapter};
+
+    bio::ranges::concatenated_sequences<std::vector<dna5>>    seqs;
+    bio::ranges::concatenated_sequences<std::vector<phred42>> quals;
+    std::vector<std::vector<bio::alphabet::dna5q>>            reads;
+    std::vector<size_t>                                       expected;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto seq = random_sequence(150, gen);
+        std::ranges::copy(adapter | std::views::take(50 - i % 50), seq.begin() + 100 + i % 50);
+
+        std::vector<phred42> qual(150);
+        for (auto & q : qual)
+            bio::alphabet::assign_phred_to(gen() % 100 == 0 ? 5 : 35, q);
+
+        size_t quality_end = 0;
+        while (quality_end < 150 && bio::alphabet::to_phred(qual[quality_end]) >= 20)
+            ++quality_end;
+        expected.push_back(naive_position(std::vector<dna5>(seq.begin(), seq.begin() + quality_end), adapter, 0.1, 3));
+
+        std::vector<bio::alphabet::dna5q> read;
+        for (size_t j = 0; j < 150; ++j)
+            read.push_back(bio::alphabet::dna5q{seq[j], qual[j]});
+
+        seqs.push_back(seq);
+        quals.push_back(qual);
+        reads.push_back(read);
+    }
+
+    EXPECT_RANGE_EQ(trimmer.trim_positions(seqs, quals, 20), expected);
+    EXPECT_RANGE_EQ(trimmer.trim_positions(reads, 20), expected);
+
+    quals.pop_back();
+    EXPECT_THROW(trimmer.trim_positions(seqs, quals, 20), std::invalid_argument);
+}
+
+TEST(adapter_trimmer, errors)
+{
+    EXPECT_THROW(bio::ranges::adapter_trimmer{std::vector<dna5>{}}, std::invalid_argument);
+    EXPECT_THROW(bio::ranges::adapter_trimmer{std::vector<dna5>(256)}, std::invalid_argument);
+    EXPECT_THROW((bio::ranges::adapter_trimmer{"ACGT"_dna5, 1.0}), std::invalid_argument);
+    EXPECT_THROW((bio::ranges::adapter_trimmer{"ACGT"_dna5, -0.1}), std::invalid_argument);
+    EXPECT_THROW((bio::ranges::adapter_trimmer{"ACGT"_dna5, 0.1, 0}), std::invalid_argument);
+}
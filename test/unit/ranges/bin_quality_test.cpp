@@ -0,0 +1,179 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <list>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/quality/all.hpp>
+#include <bio/ranges/bin_quality.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+
+using namespace bio::alphabet::literals;
+
+// generate all scores of phred63, repeated a few times (longer than one chunk of the vectorised kernel)
+static std::vector<bio::alphabet::phred63> all_scores()
+{
+    std::vector<bio::alphabet::phred63> ret;
+    for (size_t i = 0; i < 10; ++i)
+        for (int8_t p = 0; p < 63; ++p)
+            ret.emplace_back(p);
+    return ret;
+}
+
+TEST(quality_bins, construction)
+{
+    bio::ranges::quality_bins const identity{};
+    for (int8_t p = 0; p < 100; ++p)
+        EXPECT_EQ(identity(p), p);
+
+    bio::ranges::quality_bins const bins{
+      {0, 10, 30},
+      {5, 20, 40}
+    };
+    EXPECT_EQ(bins(-3), 5);
+    EXPECT_EQ(bins(0), 5);
+    EXPECT_EQ(bins(9), 5);
+    EXPECT_EQ(bins(10), 20);
+    EXPECT_EQ(bins(29), 20);
+    EXPECT_EQ(bins(30), 40);
+    EXPECT_EQ(bins(90), 40);
+
+    EXPECT_THROW((bio::ranges::quality_bins{{}, {}}), std::invalid_argument);
+    EXPECT_THROW((bio::ranges::quality_bins{{0, 10}, {5}}), std::invalid_argument);
+    EXPECT_THROW((bio::ranges::quality_bins{
+                   {0, 10, 10},
+                   {5, 20, 30}
+    }),
+                 std::invalid_argument);
+}
+
+TEST(quality_bins, illumina8)
+{
+    constexpr bio::ranges::quality_bins bins = bio::ranges::quality_bins::illumina8();
+    for (int8_t p = 0; p < 100; ++p)
+        EXPECT_EQ(bins(p), bio::alphabet::phred8binned{p}.to_phred());
+}
+
+TEST(bin_quality, contiguous)
+{
+    for (auto const & bins : {bio::ranges::quality_bins::illumina8(),
+                              bio::ranges::quality_bins{},
+                              bio::ranges::quality_bins{{0, 20}, {10, 30}}})
+    {
+        std::vector<bio::alphabet::phred63> vec = all_scores();
+        bio::ranges::bin_quality(vec, bins);
+
+        std::vector<bio::alphabet::phred63> const orig = all_scores();
+        ASSERT_EQ(vec.size(), orig.size());
+        for (size_t i = 0; i < vec.size(); ++i)
+            EXPECT_EQ(vec[i].to_phred(), bins(orig[i].to_phred()));
+    }
+}
+
+TEST(bin_quality, non_contiguous)
+{
+    bio::ranges::quality_bins const bins = bio::ranges::quality_bins::illumina8();
+    std::vector<bio::alphabet::phred63> const orig = all_scores();
+
+    std::list<bio::alphabet::phred63> list(orig.begin(), orig.end());
+    bio::ranges::bin_quality(list, bins);
+    EXPECT_TRUE(std::ranges::equal(list | std::views::transform(bio::alphabet::to_phred),
+                                   orig | std::views::transform([&](auto q) { return bins(q.to_phred()); })));
+
+    bio::ranges::bitcompressed_vector<bio::alphabet::phred63> bv{orig};
+    bio::ranges::bin_quality(bv, bins);
+    EXPECT_TRUE(std::ranges::equal(bv, list));
+}
+
+TEST(bin_quality, qualified)
+{
+    std::vector<bio::alphabet::dna4q> vec{
+      {'A'_dna4, bio::alphabet::phred42{41}},
+      {'C'_dna4, bio::alphabet::phred42{3} },
+      {'G'_dna4, bio::alphabet::phred42{23}},
+      {'T'_dna4, bio::alphabet::phred42{0} }
+    };
+    std::vector<bio::alphabet::dna4q> const cmp{
+      {'A'_dna4, bio::alphabet::phred42{40}},
+      {'C'_dna4, bio::alphabet::phred42{6} },
+      {'G'_dna4, bio::alphabet::phred42{22}},
+      {'T'_dna4, bio::alphabet::phred42{2} }
+    };
+
+    bio::ranges::bin_quality(vec, bio::ranges::quality_bins::illumina8());
+    EXPECT_EQ(vec, cmp);
+}
+
+TEST(pblock_quality, basic)
+{
+    std::vector<bio::alphabet::phred42> vec{"IIGHA5.+++"_phred42}; // 40 40 38 39 32 20 13 10 10 10
+    bio::ranges::pblock_quality(vec, 2);
+    // blocks: [40 40 38 39] [32] [20] [13 10 10 10]
+    EXPECT_EQ(vec, "HHHHA5,,,,"_phred42);
+
+    std::vector<bio::alphabet::phred42> vec2{"IIGHA5.+++"_phred42};
+    bio::ranges::pblock_quality(vec2, 0);
+    EXPECT_EQ(vec2, "IIGHA5.+++"_phred42);
+
+    bio::ranges::pblock_quality(vec2, 100);
+    EXPECT_EQ(vec2, "::::::::::"_phred42); // midpoint of 10 and 40 is 25
+
+    std::vector<bio::alphabet::phred42> empty;
+    bio::ranges::pblock_quality(empty, 3);
+    EXPECT_TRUE(empty.empty());
+
+    EXPECT_THROW(bio::ranges::pblock_quality(vec, -1), std::invalid_argument);
+}
+
+TEST(pblock_quality, max_error)
+{
+    std::vector<bio::alphabet::phred63> vec = all_scores();
+    std::ranges::reverse(vec.begin() + 100, vec.begin() + 300);
+    std::vector<bio::alphabet::phred63> const orig = vec;
+
+    for (int e : {1, 3, 7})
+    {
+        vec = orig;
+        bio::ranges::pblock_quality(vec, e);
+        for (size_t i = 0; i < vec.size(); ++i)
+            EXPECT_LE(std::abs(vec[i].to_phred() - orig[i].to_phred()), e);
+    }
+}
+
+TEST(rblock_quality, basic)
+{
+    std::vector<bio::alphabet::phred42> vec{"II5+!!$"_phred42}; // 40 40 20 10 0 0 3
+    bio::ranges::rblock_quality(vec, 1.5);
+    // blocks: [40 40 20] [10] [0 0] [3]
+    EXPECT_EQ(vec, "===+!!$"_phred42); // √(20*40) = 28.28
+
+    std::vector<bio::alphabet::phred42> vec2{"II5+!!$"_phred42};
+    bio::ranges::rblock_quality(vec2, 1);
+    EXPECT_EQ(vec2, "II5+!!$"_phred42);
+
+    EXPECT_THROW(bio::ranges::rblock_quality(vec, 0.5), std::invalid_argument);
+}
+
+TEST(rblock_quality, qualified)
+{
+    std::vector<bio::alphabet::dna4q> vec{
+      {'A'_dna4, bio::alphabet::phred42{40}},
+      {'C'_dna4, bio::alphabet::phred42{30}},
+      {'G'_dna4, bio::alphabet::phred42{10}},
+    };
+    std::vector<bio::alphabet::dna4q> const cmp{
+      {'A'_dna4, bio::alphabet::phred42{35}},
+      {'C'_dna4, bio::alphabet::phred42{35}},
+      {'G'_dna4, bio::alphabet::phred42{10}},
+    };
+
+    bio::ranges::rblock_quality(vec, 1.2);
+    EXPECT_EQ(vec, cmp);
+}
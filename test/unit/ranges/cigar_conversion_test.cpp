@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/cigar_conversion.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+using bio::alphabet::operator""_cigar_op;
+
+using gapped_t = bio::alphabet::gapped<bio::alphabet::dna4>;
+
+std::vector<bio::alphabet::dna4> const ref   = "ACGTACGTAC"_dna4;
+std::vector<bio::alphabet::dna4> const query = "ACTTAGGGTAC"_dna4;
+
+// the rows are "ACGT---ACGTAC" and "ACTTAG--GGTAC"; the soft-clipping is not part of the alignment
+std::vector<bio::alphabet::cigar> const cigar{{2, 'S'_cigar_op},
+                                              {4, 'M'_cigar_op},
+                                              {2, 'I'_cigar_op},
+                                              {1, 'P'_cigar_op},
+                                              {1, 'D'_cigar_op},
+                                              {5, 'M'_cigar_op}};
+
+std::vector<bio::alphabet::cigar> const extended{{2, '='_cigar_op},
+                                                 {1, 'X'_cigar_op},
+                                                 {1, '='_cigar_op},
+                                                 {2, 'I'_cigar_op},
+                                                 {1, 'P'_cigar_op},
+                                                 {1, 'D'_cigar_op},
+                                                 {1, 'X'_cigar_op},
+                                                 {4, '='_cigar_op}};
+
+std::vector<gapped_t> make_row(std::string_view const str)
+{
+    std::vector<gapped_t> ret;
+    for (char const c : str)
+        ret.push_back(c == '-' ? gapped_t{bio::alphabet::gap{}} : gapped_t{bio::alphabet::dna4{}.assign_char(c)});
+    return ret;
+}
+
+std::vector<gapped_t> const ref_row   = make_row("ACGT---ACGTAC");
+std::vector<gapped_t> const query_row = make_row("ACTTAG--GGTAC");
+
+TEST(cigar_conversion, get_cigar_lengths)
+{
+    EXPECT_EQ(bio::ranges::get_cigar_lengths(cigar), (bio::ranges::cigar_lengths{10, 11, 13}));
+    EXPECT_EQ(bio::ranges::get_cigar_lengths(extended), (bio::ranges::cigar_lengths{10, 11, 13}));
+    EXPECT_EQ(bio::ranges::get_cigar_lengths(std::vector<bio::alphabet::cigar>{}), bio::ranges::cigar_lengths{});
+}
+
+TEST(cigar_conversion, cigar_to_gapped)
+{
+    auto [r, q] = bio::ranges::cigar_to_gapped(cigar, ref, query);
+    EXPECT_RANGE_EQ(r, ref_row);
+    EXPECT_RANGE_EQ(q, query_row);
+
+    // extended operations and reused rows
+    bio::ranges::cigar_to_gapped(extended, ref, query, r, q);
+    EXPECT_RANGE_EQ(r, ref_row);
+    EXPECT_RANGE_EQ(q, query_row);
+
+    // not contiguous
+    std::deque<bio::alphabet::dna4> const ref_deque{ref.begin(), ref.end()};
+    std::deque<gapped_t>                  r_deque, q_deque;
+    bio::ranges::cigar_to_gapped(cigar, ref_deque, query, r_deque, q_deque);
+    EXPECT_RANGE_EQ(r_deque, ref_row);
+    EXPECT_RANGE_EQ(q_deque, query_row);
+
+    // fixed size
+    std::vector<gapped_t> r_buf(20), q_buf(20);
+    bio::ranges::cigar_to_gapped(cigar, ref, query, std::span{r_buf}, std::span{q_buf});
+    EXPECT_RANGE_EQ(std::span{r_buf}.first(13), ref_row);
+    EXPECT_RANGE_EQ(std::span{q_buf}.first(13), query_row);
+    EXPECT_THROW(bio::ranges::cigar_to_gapped(cigar, ref, query, std::span{r_buf}.first(12), std::span{q_buf}),
+                 std::invalid_argument);
+
+    EXPECT_THROW(bio::ranges::cigar_to_gapped(cigar, ref, "ACGT"_dna4), std::invalid_argument);
+    EXPECT_THROW(bio::ranges::cigar_to_gapped(cigar, "ACGT"_dna4, query), std::invalid_argument);
+}
+
+TEST(cigar_conversion, gapped_to_cigar)
+{
+    std::vector<bio::alphabet::cigar> const expected{cigar.begin() + 1, cigar.end()};
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_row, query_row), expected);
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_row, query_row, true), extended);
+
+    // not contiguous
+    std::deque<gapped_t> const ref_deque{ref_row.begin(), ref_row.end()};
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_deque, query_row), expected);
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_deque, query_row, true), extended);
+
+    EXPECT_TRUE(bio::ranges::gapped_to_cigar(std::vector<gapped_t>{}, std::vector<gapped_t>{}).empty());
+    EXPECT_THROW(bio::ranges::gapped_to_cigar(ref_row, std::span{query_row}.first(12)), std::invalid_argument);
+}
+
+TEST(cigar_conversion, append_cigar)
+{
+    std::vector<bio::alphabet::cigar> c;
+    bio::ranges::detail::append_cigar(c, 0, 'M'_cigar_op);
+    EXPECT_TRUE(c.empty());
+
+    bio::ranges::detail::append_cigar(c, 3, 'M'_cigar_op);
+    bio::ranges::detail::append_cigar(c, (size_t{1} << 29), 'M'_cigar_op);
+    bio::ranges::detail::append_cigar(c, 1, 'I'_cigar_op);
+    size_t const max = (size_t{1} << 28) - 1;
+    EXPECT_RANGE_EQ(c,
+                    (std::vector<bio::alphabet::cigar>{{max, 'M'_cigar_op},
+                                                       {max, 'M'_cigar_op},
+                                                       {(size_t{1} << 29) + 3 - 2 * max, 'M'_cigar_op},
+                                                       {1, 'I'_cigar_op}}));
+}
+
+TEST(cigar_conversion, random)
+{
+    std::mt19937                          gen{11};
+    std::uniform_int_distribution<size_t> rank_dist{0, 3};
+    std::uniform_int_distribution<size_t> len_dist{1, 150};
+    std::uniform_int_distribution<size_t> op_dist{0, 9};
+
+    for (size_t round = 0; round < 30; ++round)
+    {
+        // alternating operations with long and short stretches, so that blocks of 64 columns are crossed
+        std::vector<bio::alphabet::cigar> c;
+        char                              last = 0;
+        while (c.size() < 40)
+        {
+            size_t const o  = op_dist(gen);
+            char const   op = o < 5 ? 'M' : o < 7 ? 'I' : o < 9 ? 'D' : 'P';
+            if (op == last)
+                continue;
+            last = op;
+            c.emplace_back(op_dist(gen) < 5 ? len_dist(gen) : rank_dist(gen) + 1,
+                           bio::alphabet::cigar_op{}.assign_char(op));
+        }
+
+        bio::ranges::cigar_lengths const lengths = bio::ranges::get_cigar_lengths(c);
+        std::vector<bio::alphabet::dna4> r(lengths.reference), q(lengths.query);
+        for (auto & l : r)
+            bio::alphabet::assign_rank_to(rank_dist(gen), l);
+        for (auto & l : q)
+            bio::alphabet::assign_rank_to(rank_dist(gen), l);
+
+        auto const [r_row, q_row] = bio::ranges::cigar_to_gapped(c, r, q);
+        ASSERT_EQ(r_row.size(), lengths.columns);
+        EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(r_row, q_row), c);
+
+        // =/X in the fast path agrees with the generic path
+        std::deque<gapped_t> const r_deque{r_row.begin(), r_row.end()};
+        auto const                 ext = bio::ranges::gapped_to_cigar(r_row, q_row, true);
+        EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(r_deque, q_row, true), ext);
+
+        auto const [r_row2, q_row2] = bio::ranges::cigar_to_gapped(ext, r, q);
+        EXPECT_RANGE_EQ(r_row2, r_row);
+        EXPECT_RANGE_EQ(q_row2, q_row);
+    }
+}
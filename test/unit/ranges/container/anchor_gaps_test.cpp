@@ -0,0 +1,254 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/anchor_gaps.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+#include "../iterator_test_template.hpp"
+
+using namespace bio::alphabet::literals;
+
+using gapped_t = bio::alphabet::gapped<bio::alphabet::dna4>;
+using row_t    = bio::ranges::anchor_gaps<std::vector<bio::alphabet::dna4>>;
+
+//!\brief Builds the gapped row "A-CG--T-" explicitly, for comparison.
+std::vector<gapped_t> const expected_row{'A'_dna4, bio::alphabet::gap{}, 'C'_dna4, 'G'_dna4, bio::alphabet::gap{},
+                                         bio::alphabet::gap{}, 'T'_dna4, bio::alphabet::gap{}};
+
+row_t make_row()
+{
+    row_t row{"ACGT"_dna4};
+    row.insert_gap(1);    // A-CGT
+    row.insert_gap(4, 2); // A-CG--T
+    row.insert_gap(7);    // A-CG--T-
+    return row;
+}
+
+// ----------------------------------------------------------------------------
+// iterator
+// ----------------------------------------------------------------------------
+
+template <>
+struct iterator_fixture<row_t> : public ::testing::Test
+{
+    using iterator_tag = std::random_access_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    row_t                 test_range     = make_row();
+    std::vector<gapped_t> expected_range = expected_row;
+};
+
+using test_type = ::testing::Types<row_t>;
+INSTANTIATE_TYPED_TEST_SUITE_P(anchor_gaps_iterator, iterator_fixture, test_type, );
+
+// ----------------------------------------------------------------------------
+// container
+// ----------------------------------------------------------------------------
+
+TEST(anchor_gaps, concepts)
+{
+    EXPECT_TRUE(std::ranges::random_access_range<row_t const>);
+    EXPECT_TRUE(std::ranges::sized_range<row_t const>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<row_t>, gapped_t>));
+
+    using view_row_t = decltype(bio::ranges::anchor_gaps{std::declval<std::vector<bio::alphabet::dna4> &>()});
+    EXPECT_TRUE(
+      (std::same_as<view_row_t, bio::ranges::anchor_gaps<std::ranges::ref_view<std::vector<bio::alphabet::dna4>>>>));
+}
+
+TEST(anchor_gaps, access)
+{
+    row_t const row = make_row();
+    EXPECT_EQ(row.size(), 8u);
+    EXPECT_EQ(row.gap_count(), 4u);
+    EXPECT_EQ(row.gap_stretch_count(), 3u);
+    EXPECT_EQ(row.gap_stretch(1), (bio::meta::tuple<size_t, size_t>{3, 2}));
+
+    for (size_t i = 0; i < expected_row.size(); ++i)
+        EXPECT_EQ(row[i], expected_row[i]) << i;
+    EXPECT_RANGE_EQ(row, expected_row);
+    EXPECT_EQ(row.front(), 'A'_dna4);
+    EXPECT_EQ(row.back(), bio::alphabet::gap{});
+    EXPECT_THROW(row.at(8), std::out_of_range);
+}
+
+TEST(anchor_gaps, positions)
+{
+    row_t const row = make_row();
+
+    std::vector<size_t> const gapped{0, 2, 3, 6, 8};
+    for (size_t i = 0; i <= 4; ++i)
+        EXPECT_EQ(row.to_gapped_position(i), gapped[i]) << i;
+
+    std::vector<size_t> const ungapped{0, 1, 1, 2, 3, 3, 3, 4, 4};
+    for (size_t i = 0; i <= 8; ++i)
+        EXPECT_EQ(row.to_ungapped_position(i), ungapped[i]) << i;
+}
+
+TEST(anchor_gaps, insert_and_erase)
+{
+    row_t row{"ACGT"_dna4};
+    EXPECT_EQ(row.gap_stretch_count(), 0u);
+    EXPECT_RANGE_EQ(row, "ACGT"_dna4);
+
+    row.insert_gap(0);    // -ACGT
+    row.insert_gap(1);    // --ACGT (extends the stretch)
+    row.insert_gap(0);    // ---ACGT (extends the stretch)
+    row.insert_gap(5, 2); // ---AC--GT
+    row.insert_gap(6);    // ---AC---GT (inside a stretch)
+    EXPECT_EQ(row.gap_stretch_count(), 2u);
+    EXPECT_EQ(row.size(), 10u);
+    EXPECT_EQ(row.to_gapped_position(3), 9u);
+    EXPECT_THROW(row.insert_gap(11), std::out_of_range);
+
+    EXPECT_THROW(row.erase_gap(3), std::invalid_argument);    // a letter
+    EXPECT_THROW(row.erase_gap(1, 3), std::invalid_argument); // crosses a letter
+    row.erase_gap(0, 3);                                      // AC---GT
+    EXPECT_EQ(row.gap_stretch_count(), 1u);
+    row.erase_gap(3);                                         // AC--GT
+    EXPECT_EQ(row.to_ungapped_position(4), 2u);
+    EXPECT_RANGE_EQ(row, (std::vector<gapped_t>{'A'_dna4, 'C'_dna4, bio::alphabet::gap{}, bio::alphabet::gap{},
+                                                'G'_dna4, 'T'_dna4}));
+
+    row_t const other = row;
+    row.clear_gaps();
+    EXPECT_RANGE_EQ(row, "ACGT"_dna4);
+    EXPECT_NE(row, other);
+    EXPECT_EQ(row, row_t{"ACGT"_dna4});
+}
+
+TEST(anchor_gaps, random)
+{
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> rank_dist{0, 3};
+
+    std::vector<bio::alphabet::dna4> seq(500);
+    for (auto & l : seq)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+
+    bio::ranges::anchor_gaps row{seq};
+    std::vector<gapped_t>    expected{seq.begin(), seq.end()};
+    for (size_t i = 0; i < 200; ++i)
+    {
+        size_t const pos   = std::uniform_int_distribution<size_t>{0, expected.size()}(gen);
+        size_t const count = rank_dist(gen) + 1;
+        row.insert_gap(pos, count);
+        expected.insert(expected.begin() + pos, count, bio::alphabet::gap{});
+    }
+
+    ASSERT_EQ(row.size(), expected.size());
+    EXPECT_RANGE_EQ(row, expected);
+    for (size_t i = 0; i < expected.size(); i += 7)
+        EXPECT_EQ(row[i], expected[i]);
+
+    // jumping around with the iterator
+    auto it = row.begin();
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        size_t const pos = std::uniform_int_distribution<size_t>{0, expected.size() - 1}(gen);
+        it += static_cast<ptrdiff_t>(pos) - (it - row.begin());
+        ASSERT_EQ(*it, expected[pos]) << pos;
+        if (pos > 0)
+        {
+            EXPECT_EQ(*std::ranges::prev(it), expected[pos - 1]) << pos;
+        }
+    }
+
+    // the letters are where the coordinate conversion says they are
+    for (size_t i = 0; i < seq.size(); ++i)
+        EXPECT_EQ(expected[row.to_gapped_position(i)], seq[i]);
+}
+
+// ----------------------------------------------------------------------------
+// CIGAR conversion
+// ----------------------------------------------------------------------------
+
+TEST(anchor_gaps, cigar)
+{
+    using bio::alphabet::operator""_cigar_op;
+
+    std::vector<bio::alphabet::dna4> const ref   = "ACGTACGTAC"_dna4;
+    std::vector<bio::alphabet::dna4> const query = "ACTTAGGGTAC"_dna4;
+
+    // soft-clipping is ignored; the rows are "ACGT---ACGTAC" and "ACTTAG--GGTAC"
+    std::vector<bio::alphabet::cigar> const cigar{{2, 'S'_cigar_op},
+                                                  {4, 'M'_cigar_op},
+                                                  {2, 'I'_cigar_op},
+                                                  {1, 'P'_cigar_op},
+                                                  {1, 'D'_cigar_op},
+                                                  {5, 'M'_cigar_op}};
+
+    auto [ref_row, query_row] = bio::ranges::cigar_to_anchor_gaps(cigar, ref, query);
+    static_assert(bio::ranges::detail::gap_stretch_row<decltype(ref_row)>); // gapped_to_cigar() visits stretches
+    EXPECT_EQ(ref_row.size(), 13u);
+    EXPECT_EQ(query_row.size(), 13u);
+    EXPECT_EQ(ref_row.gap_stretch_count(), 1u);
+    EXPECT_EQ(ref_row.gap_stretch(0), (bio::meta::tuple<size_t, size_t>{4, 3}));
+    EXPECT_EQ(query_row.gap_stretch(0), (bio::meta::tuple<size_t, size_t>{6, 2}));
+    EXPECT_EQ(query_row[7], bio::alphabet::gap{});
+    EXPECT_EQ(query_row[8], 'G'_dna4);
+
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_row, query_row),
+                    (std::vector<bio::alphabet::cigar>{cigar.begin() + 1, cigar.end()}));
+
+    std::vector<bio::alphabet::cigar> const extended{{2, '='_cigar_op},
+                                                     {1, 'X'_cigar_op},
+                                                     {1, '='_cigar_op},
+                                                     {2, 'I'_cigar_op},
+                                                     {1, 'P'_cigar_op},
+                                                     {1, 'D'_cigar_op},
+                                                     {1, 'X'_cigar_op},
+                                                     {4, '='_cigar_op}};
+    EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_row, query_row, true), extended);
+
+    // extended CIGAR strings are accepted as input, too
+    auto [ref_row2, query_row2] = bio::ranges::cigar_to_anchor_gaps(extended, ref, query);
+    EXPECT_EQ(ref_row2, ref_row);
+    EXPECT_EQ(query_row2, query_row);
+
+    EXPECT_THROW(bio::ranges::cigar_to_anchor_gaps(cigar, ref, "ACGT"_dna4), std::invalid_argument);
+    query_row.insert_gap(0);
+    EXPECT_THROW(bio::ranges::gapped_to_cigar(ref_row, query_row), std::invalid_argument);
+}
+
+TEST(anchor_gaps, cigar_random)
+{
+    std::mt19937                          gen{7};
+    std::uniform_int_distribution<size_t> rank_dist{0, 3};
+    std::uniform_int_distribution<size_t> op_dist{0, 9};
+
+    for (size_t round = 0; round < 20; ++round)
+    {
+        std::vector<bio::alphabet::cigar> cigar;
+        size_t                            ref_len = 0, query_len = 0;
+        char                              last = 0;
+        for (size_t i = 0; i < 50; ++i)
+        {
+            char const   op    = op_dist(gen) < 6 ? 'M' : op_dist(gen) < 5 ? 'I' : op_dist(gen) < 9 ? 'D' : 'P';
+            size_t const count = rank_dist(gen) + 1;
+            if (op == last)
+                continue; // gapped_to_cigar() merges adjacent operations
+            last = op;
+            cigar.emplace_back(count, bio::alphabet::cigar_op{}.assign_char(op));
+            ref_len += (op == 'M' || op == 'D') ? count : 0;
+            query_len += (op == 'M' || op == 'I') ? count : 0;
+        }
+
+        std::vector<bio::alphabet::dna4> ref(ref_len), query(query_len);
+        auto [ref_row, query_row] = bio::ranges::cigar_to_anchor_gaps(cigar, ref, query);
+        ASSERT_EQ(ref_row.size(), query_row.size());
+        EXPECT_RANGE_EQ(bio::ranges::gapped_to_cigar(ref_row, query_row), cigar);
+    }
+}
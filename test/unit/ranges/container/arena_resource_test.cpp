@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/arena_resource.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/container/concatenated_sequences_sort.hpp>
+#include <bio/ranges/container/dictionary.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+// an upstream resource that counts allocations
+struct counting_resource : std::pmr::memory_resource
+{
+    size_t allocations   = 0;
+    size_t deallocations = 0;
+
+    void * do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, size_t bytes, size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+};
+
+TEST(arena_resource, allocate)
+{
+    counting_resource           upstream;
+    bio::ranges::arena_resource arena{1024, &upstream};
+    EXPECT_EQ(upstream.allocations, 0u); // lazy
+    EXPECT_EQ(arena.upstream_resource(), &upstream);
+
+    for (size_t alignment : {1, 2, 4, 8, 16, 64})
+    {
+        void * p = arena.allocate(3, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+    }
+    EXPECT_EQ(upstream.allocations, 1u);
+    EXPECT_EQ(arena.bytes_used(), 18u);
+
+    // deallocation does not give memory back
+    void * p = arena.allocate(8);
+    arena.deallocate(p, 8);
+    EXPECT_EQ(upstream.deallocations, 0u);
+
+    // allocations larger than the block size
+    void * big = arena.allocate(10'000, 8);
+    std::memset(big, 0, 10'000);
+    EXPECT_EQ(upstream.allocations, 2u);
+    EXPECT_GE(arena.bytes_reserved(), 10'000u + 1024u);
+
+    EXPECT_TRUE(arena.is_equal(arena));
+    bio::ranges::arena_resource other{1024, &upstream};
+    EXPECT_FALSE(arena.is_equal(other));
+}
+
+TEST(arena_resource, reset)
+{
+    counting_resource           upstream;
+    bio::ranges::arena_resource arena{1024, &upstream};
+
+    // single block is rewound
+    void * p1 = arena.allocate(100);
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    EXPECT_EQ(arena.allocate(100), p1);
+    EXPECT_EQ(upstream.allocations, 1u);
+
+    // multiple blocks are coalesced
+    for (size_t i = 0; i < 100; ++i)
+        (void)arena.allocate(100);
+    EXPECT_GT(upstream.allocations, 2u);
+    size_t const reserved = arena.bytes_reserved();
+    arena.reset();
+    EXPECT_EQ(upstream.allocations, upstream.deallocations + 1);
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+
+    // the same batch now fits into one block
+    size_t const allocations = upstream.allocations;
+    for (size_t i = 0; i < 100; ++i)
+        (void)arena.allocate(100);
+    arena.reset();
+    EXPECT_EQ(upstream.allocations, allocations);
+}
+
+TEST(arena_resource, release)
+{
+    counting_resource upstream;
+    {
+        bio::ranges::arena_resource arena{1024, &upstream};
+        for (size_t i = 0; i < 100; ++i)
+            (void)arena.allocate(100);
+        arena.release();
+        EXPECT_EQ(upstream.allocations, upstream.deallocations);
+        EXPECT_EQ(arena.bytes_reserved(), 0u);
+
+        (void)arena.allocate(100);
+        EXPECT_EQ(upstream.allocations, upstream.deallocations + 1);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST(arena_resource, pmr_bitcompressed_vector)
+{
+    counting_resource           upstream;
+    bio::ranges::arena_resource arena{1024, &upstream};
+
+    bio::ranges::pmr::bitcompressed_vector<bio::alphabet::dna4> v{&arena};
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+    v.assign("ACGTACGTACGT"_dna4);
+    v.insert(v.begin() + 2, 4, 'T'_dna4);
+    v.erase(v.begin(), v.begin() + 1);
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+    EXPECT_RANGE_EQ(v, "CTTTTGTACGTACGT"_dna4);
+    EXPECT_EQ(upstream.allocations, 1u);
+}
+
+TEST(arena_resource, pmr_concatenated_sequences)
+{
+    using vec_t = bio::ranges::pmr::bitcompressed_vector<bio::alphabet::dna4>;
+    using std_t = std::vector<std::vector<bio::alphabet::dna4>>;
+
+    counting_resource           upstream;
+    bio::ranges::arena_resource arena{4096, &upstream};
+
+    std_t const in{"GGG"_dna4, "ACGT"_dna4, "AA"_dna4, "T"_dna4};
+
+    bio::ranges::pmr::concatenated_sequences<vec_t> seqs{std::pmr::polymorphic_allocator<>{&arena}};
+    for (auto const & s : in)
+        seqs.push_back(s);
+    for (size_t i = 0; i < in.size(); ++i)
+        EXPECT_RANGE_EQ(seqs[i], in[i]);
+
+    // permutations keep the allocator
+    bio::ranges::sort_sequences(seqs);
+    std_t const sorted{"AA"_dna4, "ACGT"_dna4, "GGG"_dna4, "T"_dna4};
+    for (size_t i = 0; i < sorted.size(); ++i)
+        EXPECT_RANGE_EQ(seqs[i], sorted[i]);
+    auto && [values, delimiters] = seqs.raw_data();
+    EXPECT_EQ(values.get_allocator().resource(), &arena);
+    EXPECT_EQ(delimiters.get_allocator().resource(), &arena);
+    EXPECT_EQ(upstream.allocations, 1u);
+
+    // also works with std::pmr::vector
+    bio::ranges::pmr::concatenated_sequences<std::pmr::vector<char>> strings{std::pmr::polymorphic_allocator<>{&arena}};
+    strings.push_back(std::string{"foo"});
+    strings.push_back(std::string{"bar"});
+    EXPECT_EQ(strings[1][0], 'b');
+    EXPECT_EQ(strings.raw_data().first.get_allocator().resource(), &arena);
+    EXPECT_EQ(upstream.allocations, 1u);
+}
+
+TEST(arena_resource, pmr_dictionary)
+{
+    counting_resource           upstream;
+    bio::ranges::arena_resource arena{4096, &upstream};
+
+    bio::ranges::pmr::dictionary<std::string, int> dict{&arena};
+    dict.push_back({"foo", 1});
+    dict.push_back({"bar", 2});
+    dict.emplace_back("bax", 3);
+    EXPECT_EQ(dict.size(), 3u);
+    EXPECT_EQ(dict["bar"], 2);
+    EXPECT_EQ(dict.get_allocator().resource(), &arena);
+    EXPECT_EQ(upstream.allocations, 1u);
+}
@@ -11,8 +11,11 @@
 #include <bio/alphabet/custom/char.hpp>
 #include <bio/alphabet/gap/gap.hpp>
 #include <bio/alphabet/nucleotide/concept.hpp>
+#include <bio/alphabet/nucleotide/dna15.hpp>
 #include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
 #include <bio/ranges/views/complement.hpp>
+#include <bio/ranges/views/slice.hpp>
 #include <bio/test/expect_range_eq.hpp>
 
 #include "container_test_template.hpp"
@@ -63,6 +66,104 @@ TEST(bitcompressed_vector_test, const_assignability)
     EXPECT_RANGE_EQ(v, "TCGT"_dna4);
 }
 
+TEST(bitcompressed_vector_test, packed_ranks)
+{
+    using vec_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+    constexpr size_t bits = vec_t::bits_per_letter;
+
+    vec_t v;
+    for (size_t i = 0; i < 3 * vec_t::letters_per_word; ++i)
+        v.push_back(bio::alphabet::dna4{}.assign_rank(i % 4));
+
+    EXPECT_EQ(v.packed_ranks(0, 0), 0u);
+    EXPECT_EQ(v.packed_ranks(1, 1), 1u);
+    EXPECT_EQ(v.packed_ranks(1, 3), 1u | (2u << bits) | (3u << 2 * bits));
+
+    // all offsets, including those that span two words
+    for (size_t i = 0; i + vec_t::letters_per_word <= v.size(); ++i)
+    {
+        uint64_t const p = v.packed_ranks(i, vec_t::letters_per_word);
+        for (size_t k = 0; k < vec_t::letters_per_word; ++k)
+            EXPECT_EQ((p >> (k * bits)) & ((1u << bits) - 1u), v[i + k].to_rank());
+    }
+}
+
+TEST(bitcompressed_vector_test, bits_per_letter)
+{
+    EXPECT_EQ(bio::ranges::bitcompressed_vector<bio::alphabet::dna4>::bits_per_letter, 2u);
+    EXPECT_EQ(bio::ranges::bitcompressed_vector<bio::alphabet::dna4>::letters_per_word, 32u);
+    EXPECT_EQ(bio::ranges::bitcompressed_vector<bio::alphabet::dna5>::bits_per_letter, 3u);
+    EXPECT_EQ(bio::ranges::bitcompressed_vector<bio::alphabet::dna15>::bits_per_letter, 4u);
+}
+
+TEST(bitcompressed_vector_test, slice)
+{
+    using vec_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+    constexpr size_t lpw = vec_t::letters_per_word;
+
+    vec_t v;
+    for (size_t i = 0; i < 3 * lpw + 5; ++i)
+        v.push_back(bio::alphabet::dna4{}.assign_rank((i * 7) % 4));
+
+    auto s = v.slice(3, 2 * lpw + 10);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(s)>);
+    EXPECT_TRUE(std::ranges::view<decltype(s)>);
+    EXPECT_TRUE(std::ranges::borrowed_range<decltype(s)>);
+    EXPECT_RANGE_EQ(s, v | bio::views::slice(3, 2 * lpw + 10));
+    EXPECT_EQ(s.packed_ranks(1, 3), v.packed_ranks(4, 3));
+
+    // chunks are aligned to the beginning of the slice
+    auto chunks = s.chunks();
+    ASSERT_EQ(std::ranges::size(chunks), 3u);
+    EXPECT_EQ(chunks[0], v.packed_ranks(3, lpw));
+    EXPECT_EQ(chunks[1], v.packed_ranks(3 + lpw, lpw));
+    EXPECT_EQ(chunks[2], v.packed_ranks(3 + 2 * lpw, 7));
+
+    // writable
+    s[0] = 'T'_dna4;
+    EXPECT_EQ(v[3], 'T'_dna4);
+
+    // const
+    bio::ranges::bitcompressed_slice<vec_t const> cs = s;
+    EXPECT_RANGE_EQ(cs, s);
+    EXPECT_RANGE_EQ(std::as_const(v).slice(0, 0), std::vector<bio::alphabet::dna4>{});
+}
+
+TEST(bitcompressed_vector_test, append_packed)
+{
+    using vec_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+    constexpr size_t lpw = vec_t::letters_per_word;
+
+    vec_t source;
+    for (size_t i = 0; i < 3 * lpw; ++i)
+        source.push_back(bio::alphabet::dna4{}.assign_rank((i * 5 + 1) % 4));
+
+    // append in chunks of all sizes, so that appended words are not aligned
+    for (size_t step = 1; step <= lpw; ++step)
+    {
+        vec_t v;
+        for (size_t i = 0; i < source.size(); i += step)
+        {
+            size_t const count = std::min(step, source.size() - i);
+            v.append_packed(source.packed_ranks(i, count), count);
+        }
+        EXPECT_RANGE_EQ(v, source);
+    }
+
+    // construction from a slice uses the same path
+    vec_t v{source.slice(5, 2 * lpw + 3)};
+    EXPECT_RANGE_EQ(v, source | bio::views::slice(5, 2 * lpw + 3));
+}
+
+TEST(bitcompressed_vector_test, append_self)
+{
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna4> v{"ACGTTGCA"_dna4};
+    for (size_t i = 0; i < 4; ++i) // reallocates in between
+        v.insert(v.cend(), v.cbegin() + 1, v.cend());
+    EXPECT_RANGE_EQ(v | bio::views::slice(0, 15), "ACGTTGCACGTTGCA"_dna4);
+    EXPECT_EQ(v.size(), 8u + 7u + 14u + 28u + 56u);
+}
+
 #include "../../alphabet/alphabet_proxy_test_template.hpp"
 
 using namespace bio::alphabet::literals;
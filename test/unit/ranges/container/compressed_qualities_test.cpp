@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/phred63.hpp>
+#include <bio/ranges/container/compressed_qualities.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using qualities_t = std::vector<std::vector<bio::alphabet::phred42>>;
+
+//!\brief Pseudo-random qualities that drift like those of real reads.
+qualities_t generate_qualities(size_t const n_records, size_t const max_len)
+{
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> len_dist{0, max_len};
+    std::uniform_int_distribution<int>    step_dist{-3, 2};
+
+    qualities_t ret(n_records);
+    for (auto & record : ret)
+    {
+        int q = 38;
+        record.resize(len_dist(gen));
+        for (auto & l : record)
+        {
+            q = std::clamp(q + step_dist(gen), 2, 41);
+            bio::alphabet::assign_phred_to(q, l);
+        }
+    }
+    return ret;
+}
+
+TEST(compressed_qualities, concepts)
+{
+    using t = bio::ranges::compressed_qualities<bio::alphabet::phred42>;
+    EXPECT_TRUE(std::ranges::random_access_range<t const>);
+    EXPECT_TRUE(std::ranges::sized_range<t const>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<t const>, std::vector<bio::alphabet::phred42>>));
+    EXPECT_FALSE((std::ranges::output_range<t, std::vector<bio::alphabet::phred42>>));
+}
+
+TEST(compressed_qualities, empty)
+{
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> c;
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.size(), 0u);
+    EXPECT_EQ(c.block_count(), 0u);
+    EXPECT_EQ(c.begin(), c.end());
+    EXPECT_THROW(c.at(0), std::out_of_range);
+
+    EXPECT_EQ(c, (bio::ranges::compressed_qualities<bio::alphabet::phred42>{qualities_t{}}));
+    EXPECT_THROW((bio::ranges::compressed_qualities<bio::alphabet::phred42>{qualities_t{}, 0}), std::invalid_argument);
+}
+
+TEST(compressed_qualities, access)
+{
+    qualities_t const in{"IIIIHHG!!#"_phred42, ""_phred42, "I"_phred42, "##+++III"_phred42};
+
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{in};
+    ASSERT_EQ(c.size(), 4u);
+    EXPECT_EQ(c.block_count(), 1u);
+    EXPECT_EQ(c.letter_count(), 19u);
+
+    for (size_t i = 0; i < in.size(); ++i)
+        EXPECT_RANGE_EQ(c[i], in[i]);
+
+    EXPECT_RANGE_EQ(c.front(), in.front());
+    EXPECT_RANGE_EQ(c.back(), in.back());
+    EXPECT_RANGE_EQ(c.at(1), ""_phred42);
+    EXPECT_THROW(c.at(4), std::out_of_range);
+
+    EXPECT_RANGE_EQ(c, in);
+    EXPECT_EQ(c.decode(), bio::ranges::concatenated_sequences<std::vector<bio::alphabet::phred42>>{in});
+}
+
+TEST(compressed_qualities, blocks)
+{
+    qualities_t const in = generate_qualities(1000, 150);
+
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{in, 10000};
+    ASSERT_EQ(c.size(), in.size());
+    EXPECT_GT(c.block_count(), 5u);
+    EXPECT_LT(c.compressed_size(), c.letter_count() / 2);
+
+    // random access
+    for (size_t i : {0, 1, 17, 499, 500, 998, 999})
+        EXPECT_RANGE_EQ(c[i], in[i]);
+
+    // every record is in the block reported by block_of()
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        size_t const b = c.block_of(i);
+        EXPECT_LT(b, c.block_count());
+        if (i > 0)
+        {
+            EXPECT_LE(c.block_of(i - 1), b);
+        }
+    }
+
+    // iteration and bulk decoding
+    EXPECT_RANGE_EQ(c, in);
+    EXPECT_EQ(c.decode(), bio::ranges::concatenated_sequences<std::vector<bio::alphabet::phred42>>{in});
+
+    // iterator arithmetic
+    auto it = c.begin() + 600;
+    EXPECT_RANGE_EQ(*it, in[600]);
+    EXPECT_RANGE_EQ(it[-300], in[300]);
+    EXPECT_RANGE_EQ(*--it, in[599]);
+    EXPECT_EQ(c.end() - it, 401);
+}
+
+TEST(compressed_qualities, random_access)
+{
+    // one block with many checkpoints per lane; some records are empty
+    qualities_t in = generate_qualities(1000, 150);
+    for (size_t i = 5; i < in.size(); i += 37)
+        in[i].clear();
+
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> c{in};
+    ASSERT_EQ(c.block_count(), 1u);
+
+    std::vector<size_t> order(in.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::shuffle(order, std::mt19937_64{42});
+    for (size_t const i : order)
+        EXPECT_RANGE_EQ(c[i], in[i]);
+
+    // copies and moves do not share the decoder of the last accessed block
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> copy{c};
+    c = bio::ranges::compressed_qualities<bio::alphabet::phred42>{qualities_t(in.rbegin(), in.rend())};
+    EXPECT_RANGE_EQ(c[0], in.back());
+    EXPECT_RANGE_EQ(copy[0], in.front());
+    EXPECT_EQ(copy, bio::ranges::compressed_qualities<bio::alphabet::phred42>{in});
+}
+
+TEST(compressed_qualities, long_record)
+{
+    // a record longer than the block size forms its own block
+    qualities_t const in = generate_qualities(10, 5000);
+
+    bio::ranges::compressed_qualities<bio::alphabet::phred42> const c{in, 100};
+    EXPECT_RANGE_EQ(c, in);
+}
+
+TEST(compressed_qualities, phred63)
+{
+    std::vector<std::vector<bio::alphabet::phred63>> const in{"!\"#$%&'()*+,-./_^]\\"_phred63, "_____________"_phred63};
+
+    bio::ranges::compressed_qualities<bio::alphabet::phred63> const c{in};
+    EXPECT_RANGE_EQ(c, in);
+}
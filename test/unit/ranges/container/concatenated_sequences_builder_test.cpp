@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences_builder.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using builder_t = bio::ranges::concatenated_sequences_builder<std::vector<bio::alphabet::dna4>>;
+
+TEST(concatenated_sequences_builder, single_thread)
+{
+    builder_t builder{4, 20};
+    builder.push_back("ACGT"_dna4);
+    builder.push_back(""_dna4);
+    builder.push_back("GAGGA"_dna4);
+
+    EXPECT_EQ(builder.size(), 3u);
+    EXPECT_EQ(builder.concat_size(), 9u);
+    EXPECT_EQ(builder.capacity(), 4u);
+    EXPECT_EQ(builder.concat_capacity(), 20u);
+
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> cmp{"ACGT"_dna4, ""_dna4, "GAGGA"_dna4};
+    auto res = std::move(builder).finalize();
+    EXPECT_EQ(res, cmp);
+    EXPECT_EQ(builder.capacity(), 0u);
+    EXPECT_EQ(builder.concat_capacity(), 0u);
+}
+
+TEST(concatenated_sequences_builder, segment)
+{
+    builder_t builder{4, 20};
+
+    auto seg = builder.reserve(2, 7);
+    EXPECT_EQ(seg.remaining_size(), 2u);
+    EXPECT_EQ(seg.remaining_concat_size(), 7u);
+    seg.push_back("ACG"_dna4);
+    seg.push_back("TTTT"_dna4);
+    EXPECT_EQ(seg.remaining_size(), 0u);
+    EXPECT_EQ(seg.remaining_concat_size(), 0u);
+
+    builder.push_back("GA"_dna4);
+
+    auto res = std::move(builder).finalize();
+    ASSERT_EQ(res.size(), 3u);
+    EXPECT_RANGE_EQ(res[0], "ACG"_dna4);
+    EXPECT_RANGE_EQ(res[1], "TTTT"_dna4);
+    EXPECT_RANGE_EQ(res[2], "GA"_dna4);
+}
+
+TEST(concatenated_sequences_builder, capacity_exceeded)
+{
+    builder_t builder{2, 5};
+    builder.push_back("ACG"_dna4);
+    EXPECT_THROW(builder.push_back("ACG"_dna4), std::length_error); // slot reserved, but letters don't fit
+    EXPECT_THROW(builder.push_back("A"_dna4), std::length_error);   // no slots left
+    EXPECT_THROW(builder.reserve(3, 0), std::length_error);
+
+    auto res = std::move(builder).finalize();
+    ASSERT_EQ(res.size(), 1u);
+    EXPECT_RANGE_EQ(res[0], "ACG"_dna4);
+}
+
+TEST(concatenated_sequences_builder, multiple_threads)
+{
+    constexpr size_t n_threads = 4;
+    constexpr size_t n_seqs    = 1000;
+
+    builder_t builder{n_threads * n_seqs, n_threads * n_seqs * 10};
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back(
+          [&builder, t]()
+          {
+              for (size_t i = 0; i < n_seqs; ++i)
+              {
+                  // the length encodes the thread, the letter encodes the position
+                  std::vector<bio::alphabet::dna4> seq(t + 1);
+                  std::ranges::fill(seq, bio::alphabet::dna4{}.assign_rank(i % 4));
+                  if (i % 2)
+                      builder.push_back(seq);
+                  else
+                      builder.reserve(1, seq.size()).push_back(seq);
+              }
+          });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    auto res = std::move(builder).finalize();
+    ASSERT_EQ(res.size(), n_threads * n_seqs);
+
+    // per thread, order must be retained
+    std::vector<size_t> counts(n_threads);
+    for (auto && seq : res)
+    {
+        size_t const t = seq.size() - 1;
+        ASSERT_LT(t, n_threads);
+        EXPECT_TRUE(std::ranges::all_of(seq, [&](auto l) { return l.to_rank() == counts[t] % 4; }));
+        ++counts[t];
+    }
+    EXPECT_TRUE(std::ranges::all_of(counts, [](size_t c) { return c == n_seqs; }));
+}
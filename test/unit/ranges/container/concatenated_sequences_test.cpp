@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/custom/char.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/container/concatenated_sequences_sort.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <bio/ranges/reverse_complement.hpp>
+#include <bio/ranges/views/complement.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename T>
+class concatenated_sequences_test : public ::testing::Test
+{};
+
+using concatenated_sequences_types =
+  ::testing::Types<bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>,
+                   bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>>;
+
+TYPED_TEST_SUITE(concatenated_sequences_test, concatenated_sequences_types, );
+
+TYPED_TEST(concatenated_sequences_test, permute)
+{
+    TypeParam t1{"ACGT"_dna4, ""_dna4, "GAGGA"_dna4, "T"_dna4};
+
+    t1.permute(std::vector<size_t>{3, 0, 1, 2});
+    EXPECT_EQ(t1, (TypeParam{"T"_dna4, "ACGT"_dna4, ""_dna4, "GAGGA"_dna4}));
+
+    // subsets and repetitions
+    t1.permute(std::vector<int>{3, 3, 0});
+    EXPECT_EQ(t1, (TypeParam{"GAGGA"_dna4, "GAGGA"_dna4, "T"_dna4}));
+
+    t1.permute(std::vector<int>{});
+    EXPECT_TRUE(t1.empty());
+    EXPECT_EQ(t1.concat_size(), 0u);
+}
+
+TYPED_TEST(concatenated_sequences_test, sort)
+{
+    TypeParam t1{"ACGT"_dna4, ""_dna4, "GAGGA"_dna4, "AC"_dna4, "T"_dna4, "ACGT"_dna4, "ACGTA"_dna4};
+    bio::ranges::sort_sequences(t1);
+    EXPECT_EQ(t1,
+              (TypeParam{""_dna4, "AC"_dna4, "ACGT"_dna4, "ACGT"_dna4, "ACGTA"_dna4, "GAGGA"_dna4, "T"_dna4}));
+
+    TypeParam t2{};
+    bio::ranges::sort_sequences(t2);
+    EXPECT_TRUE(t2.empty());
+}
+
+TYPED_TEST(concatenated_sequences_test, sort_large)
+{
+    // many sequences with long common prefixes, so that radix passes and prefix skipping are exercised
+    std::mt19937_64                               gen{42};
+    std::vector<std::vector<bio::alphabet::dna4>> cmp;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        std::vector<bio::alphabet::dna4> seq(70, 'A'_dna4);
+        seq.resize(70 + gen() % 30);
+        for (size_t j = 68; j < seq.size(); ++j)
+            seq[j].assign_rank(gen() % 4);
+        cmp.push_back(seq);
+    }
+
+    TypeParam t1{cmp};
+    TypeParam t2{cmp};
+    std::ranges::sort(cmp);
+
+    bio::ranges::sort_sequences(t1);
+    bio::ranges::thread_pool pool{3};
+    bio::ranges::sort_sequences(t2, pool);
+    EXPECT_EQ(t1, TypeParam{cmp});
+    EXPECT_EQ(t2, TypeParam{cmp});
+}
+
+TYPED_TEST(concatenated_sequences_test, unique)
+{
+    TypeParam t1{"ACGT"_dna4, ""_dna4, "ACGT"_dna4, "AC"_dna4, ""_dna4, "T"_dna4, "AC"_dna4};
+    EXPECT_EQ(bio::ranges::unique_sequences(t1), 3u);
+    EXPECT_EQ(t1, (TypeParam{"ACGT"_dna4, ""_dna4, "AC"_dna4, "T"_dna4}));
+    EXPECT_EQ(bio::ranges::unique_sequences(t1), 0u);
+    EXPECT_EQ(t1, (TypeParam{"ACGT"_dna4, ""_dna4, "AC"_dna4, "T"_dna4}));
+}
+
+TEST(concatenated_sequences, sort_other_alphabets)
+{
+    using namespace std::string_literals;
+
+    bio::ranges::concatenated_sequences<std::string> t1{"foo"s, "bar"s, "fo"s, "baz"s};
+    bio::ranges::sort_sequences(t1);
+    EXPECT_EQ(t1, (bio::ranges::concatenated_sequences<std::string>{"bar"s, "baz"s, "fo"s, "foo"s}));
+
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::aa27>> t2{"WAR"_aa27, "PEACE"_aa27, "WA"_aa27};
+    bio::ranges::sort_sequences(t2);
+    EXPECT_EQ(t2,
+              (bio::ranges::concatenated_sequences<std::vector<bio::alphabet::aa27>>{"PEACE"_aa27,
+                                                                                        "WA"_aa27,
+                                                                                        "WAR"_aa27}));
+}
+
+TYPED_TEST(concatenated_sequences_test, packed_access)
+{
+    TypeParam t1{"ACGT"_dna4, ""_dna4, "GAGGAACGTTTACGATCGATCGATCAGCTAGCTAGCATCGACTAC"_dna4, "T"_dna4};
+
+    std::hash<std::vector<bio::alphabet::dna4>> h{};
+    std::vector<bio::alphabet::dna4> const      s2 = "GAGGAACGTTTACGATCGATCGATCAGCTAGCTAGCATCGACTAC"_dna4;
+    EXPECT_EQ(h(t1[2]), h(s2));
+    EXPECT_EQ(h(std::as_const(t1)[2]), h(s2));
+    EXPECT_EQ(h(t1[1]), 0u);
+    EXPECT_RANGE_EQ(t1.concat(), "ACGTGAGGAACGTTTACGATCGATCGATCAGCTAGCTAGCATCGACTACT"_dna4);
+}
+
+TEST(concatenated_sequences, bitcompressed_slices)
+{
+    using vector_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+    using seqs_t   = bio::ranges::concatenated_sequences<vector_t>;
+
+    seqs_t t1{"ACGT"_dna4, ""_dna4, "GAGGAACGTTTACGATCGATCGATCAGCTAGCTAGCATCGACTAC"_dna4, "T"_dna4};
+
+    // the elements are bitcompressed_slices that give access to the packed storage
+    EXPECT_TRUE((std::same_as<seqs_t::value_type, bio::ranges::bitcompressed_slice<vector_t>>));
+    EXPECT_EQ(t1[2].packed_ranks(0, 3), t1.raw_data().first.packed_ranks(4, 3));
+}
+
+template <typename alph_t>
+void check_reverse_complement()
+{
+    std::mt19937_64                                                                gen{7};
+    bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<alph_t>> t1;
+    std::vector<std::vector<alph_t>>                                               cmp;
+
+    // lengths around the word size; the odd lengths shift the following elements within the packed words
+    for (size_t const size : {0, 1, 2, 3, 7, 31, 32, 33, 63, 64, 65, 100, 129})
+    {
+        std::vector<alph_t> seq(size);
+        for (auto & l : seq)
+            l.assign_rank(gen() % bio::alphabet::size<alph_t>);
+        t1.push_back(seq);
+        cmp.push_back(seq);
+    }
+
+    for (size_t i = 0; i < cmp.size(); ++i)
+    {
+        auto const expected = cmp[i] | std::views::reverse | bio::ranges::views::complement;
+        EXPECT_RANGE_EQ(bio::ranges::reverse_complement(t1[i]), expected);
+        EXPECT_RANGE_EQ(bio::ranges::reverse_complement(bio::ranges::bitcompressed_vector<alph_t>{cmp[i]}), expected);
+    }
+}
+
+TEST(concatenated_sequences, bitcompressed_reverse_complement)
+{
+    using seqs_t = bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
+
+    // neither reversing nor complementing alone gives the right result for these
+    seqs_t t1{"AACGTTTG"_dna4, "T"_dna4, "GATTACAGATTACAGATTACAGATTACAGATTACAGATTACA"_dna4};
+    EXPECT_RANGE_EQ(bio::ranges::reverse_complement(t1[0]), "CAAACGTT"_dna4);
+    EXPECT_RANGE_EQ(bio::ranges::reverse_complement(t1[1]), "A"_dna4);
+    EXPECT_RANGE_EQ(bio::ranges::reverse_complement(t1[2]), "TGTAATCTGTAATCTGTAATCTGTAATCTGTAATCTGTAATC"_dna4);
+
+    check_reverse_complement<bio::alphabet::dna4>(); // complement is an XOR, letters are reversed by bit swaps
+    check_reverse_complement<bio::alphabet::dna5>(); // complement by table, letters are reversed one by one
+}
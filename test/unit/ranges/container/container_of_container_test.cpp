@@ -437,17 +437,14 @@ TEST(concatenated_sequences_, associated_types)
     }
 
     {
-        using t     = bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
-        using it_t  = std::ranges::iterator_t<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
-        using sen_t = std::ranges::sentinel_t<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
+        using vec_t = bio::ranges::bitcompressed_vector<bio::alphabet::dna4>;
+        using t     = bio::ranges::concatenated_sequences<vec_t>;
 
-        using c_it_t  = std::ranges::iterator_t<bio::ranges::bitcompressed_vector<bio::alphabet::dna4> const>;
-        using c_sen_t = std::ranges::sentinel_t<bio::ranges::bitcompressed_vector<bio::alphabet::dna4> const>;
+        EXPECT_TRUE((std::same_as<std::ranges::range_value_t<t>, bio::ranges::bitcompressed_slice<vec_t>>));
+        EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<t>, bio::ranges::bitcompressed_slice<vec_t>>));
 
-        EXPECT_TRUE((std::same_as<std::ranges::range_value_t<t>, std::ranges::subrange<it_t, sen_t>>));
-        EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<t>, std::ranges::subrange<it_t, sen_t>>));
-
-        EXPECT_TRUE((std::same_as<std::ranges::range_value_t<t const>, std::ranges::subrange<it_t, sen_t>>));
-        EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<t const>, std::ranges::subrange<c_it_t, c_sen_t>>));
+        EXPECT_TRUE((std::same_as<std::ranges::range_value_t<t const>, bio::ranges::bitcompressed_slice<vec_t>>));
+        EXPECT_TRUE(
+          (std::same_as<std::ranges::range_reference_t<t const>, bio::ranges::bitcompressed_slice<vec_t const>>));
     }
 }
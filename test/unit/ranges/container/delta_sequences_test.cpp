@@ -0,0 +1,196 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/delta_sequences.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using delta_t = bio::ranges::delta_sequences<bio::alphabet::dna4>;
+
+//!\brief Check iteration, subscript access and decode() of every sequence.
+template <typename seqs_t>
+void check_all(delta_t const & d, seqs_t const & seqs)
+{
+    ASSERT_EQ(d.size(), seqs.size());
+    for (size_t i = 0; i < seqs.size(); ++i)
+    {
+        auto const v = d[i];
+        EXPECT_EQ(v.size(), seqs[i].size());
+        EXPECT_RANGE_EQ(v, seqs[i]);
+        EXPECT_RANGE_EQ(d.decode(i), seqs[i]);
+        for (size_t j = 0; j < seqs[i].size(); ++j)
+            EXPECT_EQ(v[j], seqs[i][j]) << "sequence " << i << " position " << j;
+    }
+}
+
+TEST(delta_sequences, concepts)
+{
+    EXPECT_TRUE(std::ranges::random_access_range<delta_t const>);
+    EXPECT_TRUE(std::ranges::sized_range<delta_t const>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<delta_t const>, delta_t::sequence_view>));
+
+    EXPECT_TRUE(std::ranges::forward_range<delta_t::sequence_view>);
+    EXPECT_TRUE(std::ranges::sized_range<delta_t::sequence_view>);
+    EXPECT_TRUE(std::ranges::view<delta_t::sequence_view>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<delta_t::sequence_view>, bio::alphabet::dna4>));
+}
+
+TEST(delta_sequences, edits)
+{
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{"ACGTACGTACGTACGT"_dna4}};
+    EXPECT_EQ(d.reference_sequence().size(), 16u);
+    EXPECT_TRUE(d.empty());
+
+    std::vector<std::vector<bio::alphabet::dna4>> const seqs{
+      "ACGTACGTACGTACGT"_dna4, // identical
+      "ACGTACGTTCGTACGT"_dna4, // substitution
+      "ACGTACGGGTACGTACGT"_dna4, // insertion
+      "ACGTAGTACGTACGT"_dna4,  // deletion
+      "TTACGTACGTACGTACGTCC"_dna4, // insertions at both ends
+      "GTACGTACGTAC"_dna4,     // deletions at both ends
+      ""_dna4,                 // empty
+    };
+    for (auto const & s : seqs)
+        d.push_back(s);
+
+    EXPECT_EQ(d[0].edit_count(), 0u);
+    EXPECT_EQ(d[1].edit_count(), 1u);
+    EXPECT_EQ(d[2].edit_count(), 1u);
+    EXPECT_EQ(d[3].edit_count(), 1u);
+    EXPECT_EQ(d[4].edit_count(), 2u);
+    EXPECT_EQ(d[5].edit_count(), 2u);
+    EXPECT_EQ(d[6].edit_count(), 1u);
+    EXPECT_EQ(d.inserted_letter_count(), 1u + 2u + 4u);
+
+    check_all(d, seqs);
+    EXPECT_RANGE_EQ(d.front(), seqs.front());
+    EXPECT_RANGE_EQ(d.back(), seqs.back());
+    EXPECT_THROW(d.at(seqs.size()), std::out_of_range);
+}
+
+TEST(delta_sequences, region)
+{
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{"TTTTTACGTACGTTTTTT"_dna4}};
+
+    d.push_back("ACGTACGT"_dna4, 5, 13);
+    d.push_back("ACGAACGT"_dna4, 5, 13);
+    d.push_back("ACGT"_dna4, 5, 5);
+    EXPECT_EQ(d[0].edit_count(), 0u);
+    EXPECT_EQ(d[1].edit_count(), 1u);
+    EXPECT_EQ(d[2].edit_count(), 1u);
+
+    check_all(d, std::vector{"ACGTACGT"_dna4, "ACGAACGT"_dna4, "ACGT"_dna4});
+
+    EXPECT_THROW(d.push_back("ACGT"_dna4, 5, 19), std::out_of_range);
+    EXPECT_THROW(d.push_back("ACGT"_dna4, 6, 5), std::out_of_range);
+}
+
+TEST(delta_sequences, random)
+{
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> rank_dist{0, 3};
+    std::uniform_int_distribution<size_t> op_dist{0, 99};
+
+    std::vector<bio::alphabet::dna4> ref(3000);
+    for (auto & l : ref)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+
+    // ~2% substitutions, ~1% insertions and ~1% deletions
+    std::vector<std::vector<bio::alphabet::dna4>> seqs(20);
+    for (auto & s : seqs)
+    {
+        for (bio::alphabet::dna4 const l : ref)
+        {
+            size_t const op = op_dist(gen);
+            if (op < 2)
+                s.push_back(bio::alphabet::dna4{}.assign_rank((l.to_rank() + 1) % 4));
+            else if (op < 3)
+                s.insert(s.end(), {l, bio::alphabet::dna4{}.assign_rank(rank_dist(gen))});
+            else if (op >= 4)
+                s.push_back(l);
+        }
+    }
+
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{ref}};
+    for (auto const & s : seqs)
+        d.push_back(s);
+
+    EXPECT_GT(d.edit_count(), 20u * delta_t::checkpoint_interval); // every sequence has checkpoints
+    EXPECT_LT(d.edit_count(), 20u * 3000u / 10u);
+    check_all(d, seqs);
+
+    // iterating over the container
+    size_t i = 0;
+    for (auto && v : d)
+        EXPECT_RANGE_EQ(v, seqs[i++]);
+}
+
+TEST(delta_sequences, long_edits)
+{
+    // edit lengths beyond the length byte and distances between edits that need multiple bytes
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> rank_dist{0, 3};
+
+    std::vector<bio::alphabet::dna4> ref(40'000);
+    for (auto & l : ref)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+
+    // 300 inserted letters after position 20'000 and 40 deleted letters after position 30'000
+    std::vector<bio::alphabet::dna4> s(ref.size() + 300 - 40, 'T'_dna4);
+    std::ranges::copy(ref.begin(), ref.begin() + 20'000, s.begin());
+    std::ranges::copy(ref.begin() + 20'000, ref.begin() + 30'000, s.begin() + 20'300);
+    std::ranges::copy(ref.begin() + 30'040, ref.end(), s.begin() + 30'300);
+    s.back() = s.back() == 'A'_dna4 ? 'C'_dna4 : 'A'_dna4; // substitution at the end
+
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{ref}};
+    d.push_back(s);
+    d.push_back(s | std::views::drop(17'000), 17'000, 40'000);
+
+    EXPECT_LT(d.edit_count(), 30u); // the alignment of the insertion and deletion is ambiguous
+    EXPECT_GE(d.inserted_letter_count(), 2u * 300u);
+    check_all(d, std::vector{s, std::vector<bio::alphabet::dna4>{s.begin() + 17'000, s.end()}});
+}
+
+TEST(delta_sequences, unrelated)
+{
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{"AAAAAAAA"_dna4}};
+    d.push_back("CCCC"_dna4);
+    d.push_back("CACACACAC"_dna4);
+    check_all(d, std::vector{"CCCC"_dna4, "CACACACAC"_dna4});
+    EXPECT_EQ(d[0].edit_count(), 1u);
+}
+
+TEST(delta_sequences, dna5)
+{
+    bio::ranges::delta_sequences<bio::alphabet::dna5> d{
+      bio::ranges::bitcompressed_vector<bio::alphabet::dna5>{"ACGTNNNNACGT"_dna5}};
+    d.push_back("ACGTNNACGGT"_dna5);
+    EXPECT_RANGE_EQ(d[0], "ACGTNNACGGT"_dna5);
+    EXPECT_RANGE_EQ(d.decode(0), "ACGTNNACGGT"_dna5);
+}
+
+TEST(delta_sequences, clear_and_compare)
+{
+    delta_t d{bio::ranges::bitcompressed_vector<bio::alphabet::dna4>{"ACGTACGT"_dna4}};
+    delta_t d2 = d;
+    d.push_back("ACGAACGT"_dna4);
+    EXPECT_NE(d, d2);
+
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.reference_sequence().size(), 8u);
+    EXPECT_EQ(d, d2);
+}
@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/page_allocator.hpp>
+
+using namespace bio::ranges;
+
+size_t memory_alignment(void * value, size_t alignment)
+{
+    return (reinterpret_cast<size_t>(value) & (alignment - 1));
+}
+
+TEST(page_allocator, standard_construction)
+{
+    using alloc_t = page_allocator<int, memory_policy{.pages = page_kind::transparent_huge}, 16>;
+    EXPECT_TRUE((std::is_nothrow_default_constructible_v<alloc_t>));
+    EXPECT_TRUE((std::is_trivially_copy_constructible_v<alloc_t>));
+    EXPECT_TRUE((std::is_trivially_move_constructible_v<alloc_t>));
+    EXPECT_TRUE((std::is_trivially_destructible_v<alloc_t>));
+}
+
+TEST(page_allocator, comparison)
+{
+    constexpr memory_policy huge{.pages = page_kind::transparent_huge};
+    constexpr memory_policy numa{.numa = numa_kind::interleave};
+
+    EXPECT_TRUE((page_allocator<int, huge, 16>{} == page_allocator<char, huge, 16>{}));
+    EXPECT_FALSE((page_allocator<int, huge, 16>{} == page_allocator<int, numa, 16>{}));
+    EXPECT_FALSE((page_allocator<int, huge, 16>{} == page_allocator<int, huge, 32>{}));
+}
+
+template <memory_policy policy, size_t alignment>
+void policy_test()
+{
+    using alloc_t = page_allocator<uint64_t, policy, alignment>;
+
+    // rebinding retains the policy
+    using rebound_t = typename std::allocator_traits<alloc_t>::template rebind_alloc<char>;
+    EXPECT_TRUE((std::same_as<rebound_t, page_allocator<char, policy, alignment>>));
+
+    // small and large allocations
+    for (size_t n : {1ul, 100ul, 4096ul, 1ul << 20})
+    {
+        alloc_t    alloc{};
+        uint64_t * p = alloc.allocate(n);
+        EXPECT_EQ(memory_alignment(p, alignment), 0u);
+        for (size_t i = 0; i < n; ++i)
+            p[i] = i;
+        EXPECT_EQ(p[n - 1], n - 1);
+        alloc.deallocate(p, n);
+    }
+
+    // in containers
+    std::vector<uint64_t, alloc_t> vec(1ul << 20, 3);
+    vec.push_back(4);
+    EXPECT_EQ(vec[1000], 3u);
+    EXPECT_EQ(vec.back(), 4u);
+
+    bitcompressed_vector<bio::alphabet::dna4, alloc_t> bvec(1ul << 24, bio::alphabet::dna4{}.assign_rank(2));
+    bvec.push_back(bio::alphabet::dna4{}.assign_rank(1));
+    EXPECT_EQ(bvec[12345].to_rank(), 2);
+    EXPECT_EQ(bvec.back().to_rank(), 1);
+}
+
+TEST(page_allocator, policies)
+{
+    policy_test<memory_policy{}, 64>();
+    policy_test<memory_policy{.pages = page_kind::transparent_huge}, 64>();
+    policy_test<memory_policy{.pages = page_kind::hugetlb}, 64>();
+    policy_test<memory_policy{.numa = numa_kind::interleave}, 64>();
+    policy_test<memory_policy{.numa = numa_kind::bind, .numa_nodes = 1}, 64>();
+    policy_test<memory_policy{.pages = page_kind::transparent_huge, .numa = numa_kind::interleave}, 64>();
+}
+
+TEST(page_allocator, large_alignment)
+{
+    // explicit huge pages cannot provide alignments above their size; the allocation falls back
+    policy_test<memory_policy{.pages = page_kind::hugetlb}, detail::huge_page_size * 2>();
+    policy_test<memory_policy{.pages = page_kind::standard, .numa = numa_kind::interleave}, 1ul << 16>();
+}
@@ -0,0 +1,167 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/record_batch.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename t>
+struct record_batch_test : public ::testing::Test
+{};
+
+using test_types =
+  ::testing::Types<bio::ranges::record_batch<>,
+                   bio::ranges::record_batch<bio::ranges::bitcompressed_vector<bio::alphabet::dna5>,
+                                             bio::ranges::bitcompressed_vector<bio::alphabet::phred42>>>;
+
+TYPED_TEST_SUITE(record_batch_test, test_types, );
+
+template <typename batch_t>
+void fill(batch_t & batch)
+{
+    batch.push_back(std::string{"r1"}, "ACGT"_dna5, "II#!"_phred42);
+    batch.push_back("read_2", ""_dna5, ""_phred42);
+    batch.push_back(std::string_view{"r3"}, "GGA"_dna5, "!!I"_phred42);
+}
+
+TYPED_TEST(record_batch_test, concepts)
+{
+    EXPECT_TRUE(std::ranges::random_access_range<TypeParam>);
+    EXPECT_TRUE(std::ranges::sized_range<TypeParam>);
+    EXPECT_TRUE(std::ranges::random_access_range<TypeParam const>);
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(std::declval<TypeParam &>().seqs())>);
+}
+
+TYPED_TEST(record_batch_test, push_back_access)
+{
+    TypeParam batch;
+    EXPECT_TRUE(batch.empty());
+    fill(batch);
+
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch.concat_size(), 7u);
+
+    auto [id, seq, qual] = batch[0];
+    EXPECT_RANGE_EQ(id, std::string{"r1"});
+    EXPECT_RANGE_EQ(seq, "ACGT"_dna5);
+    EXPECT_RANGE_EQ(qual, "II#!"_phred42);
+
+    EXPECT_RANGE_EQ(batch[1].id, std::string{"read_2"});
+    EXPECT_TRUE(batch[1].seq.empty());
+    EXPECT_RANGE_EQ(std::as_const(batch)[2].qual, "!!I"_phred42);
+    EXPECT_RANGE_EQ(batch.at(2).seq, "GGA"_dna5);
+    EXPECT_THROW(batch.at(3), std::out_of_range);
+
+    // columns
+    EXPECT_EQ(batch.ids().size(), 3u);
+    EXPECT_EQ(batch.seqs().size(), 3u);
+    EXPECT_RANGE_EQ(batch.seqs()[2], "GGA"_dna5);
+    EXPECT_RANGE_EQ(std::as_const(batch).quals()[0], "II#!"_phred42);
+
+    // letters can be modified
+    batch[2].seq[0] = 'T'_dna5;
+    EXPECT_RANGE_EQ(batch[2].seq, "TGA"_dna5);
+
+    // iteration
+    size_t letters = 0;
+    for (auto && [i, s, q] : std::as_const(batch))
+    {
+        EXPECT_EQ(s.size(), q.size());
+        letters += s.size();
+    }
+    EXPECT_EQ(letters, 7u);
+
+    EXPECT_THROW(batch.push_back("x", "A"_dna5, ""_phred42), std::invalid_argument);
+}
+
+TYPED_TEST(record_batch_test, pop_back)
+{
+    TypeParam batch;
+    fill(batch);
+    batch.pop_back();
+
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.concat_size(), 4u);
+    EXPECT_EQ(std::get<1>(batch.raw_data()).size(), 4u);
+    EXPECT_EQ(std::get<2>(batch.raw_data()).size(), 4u);
+}
+
+TYPED_TEST(record_batch_test, push_back_rollback)
+{
+    TypeParam batch;
+    fill(batch);
+    TypeParam const copy = batch;
+
+    auto throwing_qual = std::views::iota(0, 4) | std::views::transform(
+                                                    [](int const i)
+                                                    {
+                                                        if (i == 2)
+                                                            throw std::runtime_error{"bad quality"};
+                                                        return 'I'_phred42;
+                                                    });
+    EXPECT_THROW(batch.push_back("r4", "ACGT"_dna5, throwing_qual), std::runtime_error);
+
+    EXPECT_EQ(batch, copy);
+    EXPECT_EQ(std::get<0>(batch.raw_data()).concat_size(), std::get<0>(copy.raw_data()).concat_size());
+    EXPECT_EQ(std::get<1>(batch.raw_data()).size(), 7u);
+    EXPECT_EQ(std::get<2>(batch.raw_data()).size(), 7u);
+}
+
+TYPED_TEST(record_batch_test, recycle)
+{
+    TypeParam batch;
+    fill(batch);
+    TypeParam const copy = batch;
+    EXPECT_EQ(copy, batch);
+
+    auto const data = [&]()
+    {
+        auto [ids, seqs, quals, delimiters] = batch.raw_data();
+        return std::tuple{ids.concat_capacity(),
+                          ids.raw_data().second.capacity(),
+                          seqs.capacity(),
+                          quals.capacity(),
+                          delimiters.capacity()};
+    };
+    auto const before = data();
+
+    // refilling a cleared batch does not reallocate
+    for (size_t i = 0; i < 10; ++i)
+    {
+        batch.clear();
+        EXPECT_TRUE(batch.empty());
+        fill(batch);
+        EXPECT_EQ(data(), before);
+    }
+    EXPECT_EQ(copy, batch);
+}
+
+TYPED_TEST(record_batch_test, reserve_swap)
+{
+    TypeParam batch;
+    batch.reserve(100, 1000, 500);
+    EXPECT_GE(std::get<1>(batch.raw_data()).capacity(), 1000u);
+    EXPECT_GE(std::get<0>(batch.raw_data()).concat_capacity(), 500u);
+
+    fill(batch);
+    TypeParam other;
+    batch.swap(other);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(other.size(), 3u);
+}
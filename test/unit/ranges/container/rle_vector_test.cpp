@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <forward_list>
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/rle_vector.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using rle_t = bio::ranges::rle_vector<bio::alphabet::dna5>;
+
+TEST(rle_vector, concepts)
+{
+    EXPECT_TRUE(std::ranges::random_access_range<rle_t const>);
+    EXPECT_TRUE(std::ranges::sized_range<rle_t const>);
+    EXPECT_TRUE(std::ranges::common_range<rle_t const>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<rle_t const>, bio::alphabet::dna5>));
+    EXPECT_FALSE((std::ranges::output_range<rle_t, bio::alphabet::dna5>));
+}
+
+TEST(rle_vector, construction)
+{
+    std::vector<bio::alphabet::dna5> const vec{"NNNNACCGTNN"_dna5};
+
+    rle_t const r{vec};
+    EXPECT_EQ(r.size(), 11u);
+    EXPECT_EQ(r.run_count(), 6u);
+    EXPECT_RANGE_EQ(r, vec);
+
+    // from a non-contiguous range
+    std::forward_list<bio::alphabet::dna5> const list(vec.begin(), vec.end());
+    EXPECT_EQ(rle_t{list}, r);
+
+    // from an input range
+    EXPECT_EQ(rle_t{vec | std::views::filter([](auto) { return true; })}, r);
+
+    // from runs
+    rle_t r2;
+    EXPECT_TRUE(r2.empty());
+    for (auto const [l, len] : vec | bio::ranges::views::rle)
+        r2.append_run(l, len);
+    EXPECT_EQ(r2, r);
+}
+
+TEST(rle_vector, runs)
+{
+    rle_t r;
+    r.append_run('N'_dna5, 100);
+    r.append_run('N'_dna5, 50); // merged
+    r.append_run('A'_dna5, 0);  // ignored
+    r.push_back('A'_dna5);
+    r.append_range("AACCCN"_dna5);
+
+    ASSERT_EQ(r.run_count(), 4u);
+    EXPECT_EQ(r.size(), 157u);
+    EXPECT_EQ(r.run_letter(0), 'N'_dna5);
+    EXPECT_EQ(r.run_length(0), 150u);
+    EXPECT_EQ(r.run_letter(1), 'A'_dna5);
+    EXPECT_EQ(r.run_length(1), 3u);
+    EXPECT_EQ(r.run_of(149), 0u);
+    EXPECT_EQ(r.run_of(150), 1u);
+    EXPECT_EQ(r.run_of(156), 3u);
+
+    EXPECT_EQ(r.front(), 'N'_dna5);
+    EXPECT_EQ(r.back(), 'N'_dna5);
+    EXPECT_EQ(r[152], 'A'_dna5);
+    EXPECT_EQ(r.at(153), 'C'_dna5);
+    EXPECT_THROW(r.at(157), std::out_of_range);
+
+    EXPECT_RANGE_EQ(r.runs() | bio::ranges::views::unrle, r);
+}
+
+TEST(rle_vector, random_access)
+{
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> len_dist{1, 20};
+    std::uniform_int_distribution<size_t> rank_dist{0, 4};
+
+    std::vector<bio::alphabet::dna5> vec;
+    for (size_t i = 0; i < 2000; ++i)
+        vec.insert(vec.end(), len_dist(gen), bio::alphabet::dna5{}.assign_rank(rank_dist(gen)));
+
+    rle_t const r{vec};
+    ASSERT_EQ(r.size(), vec.size());
+    EXPECT_GT(r.run_count(), 2 * rle_t::sample_interval);
+
+    for (size_t i = 0; i < vec.size(); ++i)
+        EXPECT_EQ(r[i], vec[i]) << "position " << i;
+
+    // iterator arithmetic
+    EXPECT_RANGE_EQ(r, vec);
+    EXPECT_TRUE(std::ranges::equal(r | std::views::reverse, vec | std::views::reverse));
+
+    auto it = r.begin() + 5000;
+    EXPECT_EQ(*it, vec[5000]);
+    EXPECT_EQ(it[-3000], vec[2000]);
+    EXPECT_EQ(*--it, vec[4999]);
+    it += 17;
+    EXPECT_EQ(*it, vec[5016]);
+    EXPECT_EQ(r.end() - it, static_cast<ptrdiff_t>(vec.size() - 5016));
+    EXPECT_LT(r.begin(), it);
+}
+
+TEST(rle_vector, clear_and_compare)
+{
+    rle_t r{"ACGT"_dna5};
+    rle_t r2 = r;
+    EXPECT_EQ(r, r2);
+
+    r.push_back('T'_dna5);
+    EXPECT_NE(r, r2);
+
+    r.clear();
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.begin(), r.end());
+    EXPECT_EQ(r, rle_t{});
+}
+
+TEST(rle_vector, dna4)
+{
+    std::vector<bio::alphabet::dna4> const vec{"AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAACGT"_dna4};
+    bio::ranges::rle_vector<bio::alphabet::dna4> const r{vec};
+    EXPECT_EQ(r.run_count(), 4u);
+    EXPECT_RANGE_EQ(r, vec);
+}
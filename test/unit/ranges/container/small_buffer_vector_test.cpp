@@ -0,0 +1,258 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <bio/ranges/container/concept.hpp>
+#include <bio/ranges/container/small_buffer_vector.hpp>
+
+#include "container_test_template.hpp"
+
+using small_buffer_vector_over_dna4_t = bio::ranges::small_buffer_vector<bio::alphabet::dna4, 4>;
+INSTANTIATE_TYPED_TEST_SUITE_P(small_buffer_vector, container_over_dna4_test, small_buffer_vector_over_dna4_t, );
+
+TEST(small_buffer_vector, concepts)
+{
+    EXPECT_TRUE((bio::ranges::detail::reservible_container<bio::ranges::small_buffer_vector<char, 4>>));
+    EXPECT_TRUE((bio::ranges::detail::reservible_container<bio::ranges::small_buffer_vector<std::string, 4>>));
+    EXPECT_TRUE((std::ranges::contiguous_range<bio::ranges::small_buffer_vector<char, 4>>));
+    EXPECT_TRUE((std::is_nothrow_move_constructible_v<bio::ranges::small_buffer_vector<char, 4>>));
+    EXPECT_TRUE((std::is_nothrow_move_constructible_v<bio::ranges::small_buffer_vector<std::string, 4>>));
+}
+
+TEST(small_buffer_vector, spill)
+{
+    bio::ranges::small_buffer_vector<int, 4> v{1, 2, 3};
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 4u);
+
+    v.push_back(4);
+    EXPECT_TRUE(v.is_inline());
+
+    v.push_back(5); // spills
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_GE(v.capacity(), 5u);
+    EXPECT_EQ(v, (bio::ranges::small_buffer_vector<int, 4>{1, 2, 3, 4, 5}));
+
+    // shrink back into the inline buffer
+    v.pop_back();
+    v.pop_back();
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v, (bio::ranges::small_buffer_vector<int, 4>{1, 2, 3}));
+
+    // insertion in the middle that spills
+    v.insert(v.cbegin() + 1, {7, 8, 9});
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(v, (bio::ranges::small_buffer_vector<int, 4>{1, 7, 8, 9, 2, 3}));
+
+    // clear keeps the storage
+    v.clear();
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_TRUE(v.empty());
+}
+
+template <typename value_t>
+void copy_move_swap_test(value_t const a, value_t const b)
+{
+    using vec_t = bio::ranges::small_buffer_vector<value_t, 3>;
+    vec_t inl{a, b};
+    vec_t heap{a, b, a, b, a};
+    ASSERT_TRUE(inl.is_inline());
+    ASSERT_FALSE(heap.is_inline());
+
+    // copy
+    vec_t inl2{inl};
+    vec_t heap2{heap};
+    EXPECT_EQ(inl2, inl);
+    EXPECT_EQ(heap2, heap);
+    EXPECT_TRUE(inl2.is_inline());
+
+    // move steals heap storage
+    value_t const * heap_data = heap2.data();
+    vec_t           heap3{std::move(heap2)};
+    EXPECT_EQ(heap3.data(), heap_data);
+    EXPECT_EQ(heap3, heap);
+    EXPECT_TRUE(heap2.empty()); // NOLINT(bugprone-use-after-move)
+
+    vec_t inl3{std::move(inl2)};
+    EXPECT_EQ(inl3, inl);
+
+    // assignment in all combinations
+    vec_t t;
+    t = heap;
+    EXPECT_EQ(t, heap);
+    t = inl;
+    EXPECT_EQ(t, inl);
+    t = std::move(heap3);
+    EXPECT_EQ(t, heap);
+    t = std::move(inl3);
+    EXPECT_EQ(t, inl);
+
+    // swap in all combinations
+    vec_t x{inl};
+    vec_t y{heap};
+    x.swap(y);
+    EXPECT_EQ(x, heap);
+    EXPECT_EQ(y, inl);
+    swap(x, y);
+    EXPECT_EQ(x, inl);
+    EXPECT_EQ(y, heap);
+
+    vec_t z{b};
+    x.swap(z);
+    EXPECT_EQ(x, vec_t{b});
+    EXPECT_EQ(z, inl);
+
+    vec_t w{heap};
+    w.push_back(b);
+    y.swap(w);
+    EXPECT_EQ(w, heap);
+    EXPECT_EQ(y.size(), heap.size() + 1);
+}
+
+TEST(small_buffer_vector, copy_move_swap)
+{
+    copy_move_swap_test<int>(1, 2);
+    copy_move_swap_test<std::string>("a string that is too long for the small string optimisation", "b");
+}
+
+TEST(small_buffer_vector, non_trivial)
+{
+    using vec_t = bio::ranges::small_buffer_vector<std::string, 2>;
+    vec_t v;
+    for (size_t i = 0; i < 10; ++i)
+        v.emplace_back(20, static_cast<char>('a' + i));
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_EQ(v[9], std::string(20, 'j'));
+
+    v.insert(v.cbegin() + 2, 2, "foo");
+    EXPECT_EQ(v.size(), 12u);
+    EXPECT_EQ(v[2], "foo");
+    EXPECT_EQ(v[3], "foo");
+    EXPECT_EQ(v[4], std::string(20, 'c'));
+
+    v.erase(v.cbegin(), v.cbegin() + 3);
+    EXPECT_EQ(v.size(), 9u);
+    EXPECT_EQ(v[0], "foo");
+
+    // push_back of an own element that triggers reallocation
+    v.shrink_to_fit();
+    v.push_back(v[0]);
+    EXPECT_EQ(v.back(), "foo");
+
+    v.resize(1);
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v, vec_t{"foo"});
+}
+
+// counts allocations and (optionally) the storage that is currently allocated
+template <typename t>
+struct counting_allocator : std::allocator<t>
+{
+    using value_type = t;
+
+    size_t * count = nullptr;
+    size_t * live  = nullptr;
+
+    counting_allocator() = default;
+    explicit counting_allocator(size_t * count_, size_t * live_ = nullptr) : count{count_}, live{live_} {}
+    template <typename u>
+    counting_allocator(counting_allocator<u> const & rhs) : count{rhs.count}, live{rhs.live}
+    {}
+
+    t * allocate(size_t const n)
+    {
+        ++*count;
+        if (live != nullptr)
+            ++*live;
+        return std::allocator<t>::allocate(n);
+    }
+
+    void deallocate(t * const p, size_t const n)
+    {
+        if (live != nullptr)
+            --*live;
+        std::allocator<t>::deallocate(p, n);
+    }
+
+    bool operator==(counting_allocator const &) const = default;
+};
+
+TEST(small_buffer_vector, allocator)
+{
+    size_t                                                          count = 0;
+    bio::ranges::small_buffer_vector<int, 8, counting_allocator<int>> v{counting_allocator<int>{&count}};
+
+    for (int i = 0; i < 8; ++i)
+        v.push_back(i);
+    EXPECT_EQ(count, 0u);
+
+    v.push_back(8);
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(v.get_allocator().count, &count);
+}
+
+// copies throw once the budget is used up; the move constructor may throw, so the container must copy
+struct throwing_copy
+{
+    static inline size_t copies_left = 0;
+    static inline size_t alive       = 0;
+
+    int value = 0;
+
+    throwing_copy(int const v) : value{v} { ++alive; }
+    throwing_copy(throwing_copy const & rhs) : value{rhs.value}
+    {
+        if (copies_left == 0)
+            throw std::runtime_error{"copy"};
+        --copies_left;
+        ++alive;
+    }
+    throwing_copy(throwing_copy && rhs) : throwing_copy{std::as_const(rhs)} {}
+    throwing_copy & operator=(throwing_copy const &) = default;
+    ~throwing_copy() { --alive; }
+
+    bool operator==(throwing_copy const &) const = default;
+};
+
+TEST(small_buffer_vector, insert_throwing_copy)
+{
+    size_t count = 0;
+    size_t live  = 0;
+    using vec_t  = bio::ranges::small_buffer_vector<throwing_copy, 2, counting_allocator<throwing_copy>>;
+    throwing_copy::copies_left = 2;
+    std::vector<throwing_copy> const values{3, 4};
+
+    for (size_t budget = 0; budget < 4; ++budget) // throw while copying the new elements, the prefix or the suffix
+    {
+        {
+            throwing_copy::copies_left = 2;
+            vec_t v{counting_allocator<throwing_copy>{&count, &live}};
+            v.push_back(1);
+            v.push_back(2);
+            ASSERT_TRUE(v.is_inline());
+
+            // reallocation needs 2 copies for the new elements and 1 each for the elements before and after pos
+            throwing_copy::copies_left = budget;
+            EXPECT_THROW(v.insert(v.cbegin() + 1, values.begin(), values.end()), std::runtime_error);
+            EXPECT_EQ(live, 0u);
+
+            throwing_copy::copies_left = 2;
+            EXPECT_EQ(v, (vec_t{1, 2})); // nothing is lost
+        }
+        EXPECT_EQ(throwing_copy::alive, 2u); // values
+    }
+}
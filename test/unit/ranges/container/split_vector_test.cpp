@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <bio/alphabet/mask/masked.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/container/concept.hpp>
+#include <bio/ranges/container/split_vector.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using qualified_t = bio::alphabet::qualified<bio::alphabet::dna4, bio::alphabet::phred42>;
+
+template <typename t>
+using std_vector = std::vector<t>;
+
+template <typename T>
+class split_vector_test : public ::testing::Test
+{};
+
+using split_vector_types = ::testing::Types<bio::ranges::split_vector<qualified_t>,
+                                            bio::ranges::split_vector<qualified_t, std_vector>>;
+
+TYPED_TEST_SUITE(split_vector_test, split_vector_types, );
+
+TYPED_TEST(split_vector_test, concepts)
+{
+    EXPECT_TRUE(bio::ranges::detail::reservible_container<TypeParam>);
+    EXPECT_TRUE(std::ranges::random_access_range<TypeParam const>);
+    EXPECT_TRUE((std::ranges::output_range<TypeParam, qualified_t>));
+    EXPECT_TRUE(bio::alphabet::quality<std::ranges::range_reference_t<TypeParam>>);
+    EXPECT_TRUE(bio::alphabet::alphabet<std::ranges::range_reference_t<TypeParam>>);
+}
+
+TYPED_TEST(split_vector_test, access)
+{
+    TypeParam v{qualified_t{'A'_dna4, 'I'_phred42}, qualified_t{'C'_dna4, '!'_phred42}};
+    v.push_back(qualified_t{'G'_dna4, '#'_phred42});
+
+    ASSERT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[1], (qualified_t{'C'_dna4, '!'_phred42}));
+    EXPECT_EQ(std::as_const(v).back(), (qualified_t{'G'_dna4, '#'_phred42}));
+    EXPECT_THROW(v.at(3), std::out_of_range);
+
+    // assign through proxy
+    v[1] = qualified_t{'T'_dna4, '('_phred42};
+    EXPECT_EQ(v[1], (qualified_t{'T'_dna4, '('_phred42}));
+
+    // assign through column
+    v.template column<0>()[0] = 'T'_dna4;
+    EXPECT_EQ(v[0], (qualified_t{'T'_dna4, 'I'_phred42}));
+
+    EXPECT_RANGE_EQ(v.template column<0>(), "TTG"_dna4);
+    EXPECT_RANGE_EQ(std::as_const(v).template column<bio::alphabet::phred42>(), "I(#"_phred42);
+
+    // both overloads return views, so that the size of a column cannot be changed
+    using column_t = typename TypeParam::template column_type<0>;
+    EXPECT_TRUE((std::same_as<decltype(v.template column<0>()), std::ranges::ref_view<column_t>>));
+    EXPECT_TRUE(
+      (std::same_as<decltype(std::as_const(v).template column<0>()), std::ranges::ref_view<column_t const>>));
+}
+
+TYPED_TEST(split_vector_test, columns)
+{
+    TypeParam v;
+    v.assign_columns("ACGT"_dna4, "II#!"_phred42);
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(v[3], (qualified_t{'T'_dna4, '!'_phred42}));
+
+    // writing a column changes the elements
+    v.template column<1>()[0] = '!'_phred42;
+    EXPECT_EQ(v[0], (qualified_t{'A'_dna4, '!'_phred42}));
+
+    EXPECT_THROW(v.assign_columns("ACGT"_dna4, "II#"_phred42), std::invalid_argument);
+}
+
+TYPED_TEST(split_vector_test, modifiers)
+{
+    std::vector<qualified_t> const values{qualified_t{'A'_dna4, 'I'_phred42},
+                                          qualified_t{'C'_dna4, '!'_phred42},
+                                          qualified_t{'G'_dna4, '#'_phred42}};
+
+    TypeParam v{values};
+    EXPECT_RANGE_EQ(v, values);
+
+    v.insert(v.cbegin() + 1, 2, qualified_t{'T'_dna4, '('_phred42});
+    v.erase(v.cbegin(), v.cbegin() + 1);
+    v.insert(v.cend(), values.begin(), values.begin() + 1);
+    v.pop_back();
+    EXPECT_RANGE_EQ(v.template column<0>(), "TTCG"_dna4);
+    EXPECT_RANGE_EQ(v.template column<1>(), "((!#"_phred42);
+
+    v.resize(5, qualified_t{'A'_dna4, 'I'_phred42});
+    EXPECT_EQ(v.back(), (qualified_t{'A'_dna4, 'I'_phred42}));
+
+    TypeParam w{values};
+    swap(v, w);
+    EXPECT_RANGE_EQ(v, values);
+    EXPECT_EQ(w.size(), 5u);
+    EXPECT_NE(v, w);
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(split_vector, masked)
+{
+    using masked_t = bio::alphabet::masked<bio::alphabet::dna4>;
+    // bio::alphabet::mask is only a semialphabet, so it cannot be stored in a bitcompressed_vector
+    bio::ranges::split_vector<masked_t, std_vector> v{masked_t{'A'_dna4, bio::alphabet::mask::MASKED},
+                                                      masked_t{'C'_dna4, bio::alphabet::mask::UNMASKED}};
+
+    EXPECT_RANGE_EQ(v.column<0>(), "AC"_dna4);
+    EXPECT_EQ(v.column<1>()[0], bio::alphabet::mask::MASKED);
+    EXPECT_EQ(v[0], (masked_t{'A'_dna4, bio::alphabet::mask::MASKED}));
+}
@@ -0,0 +1,188 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/edit_distance.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename alph_t>
+std::vector<alph_t> random_sequence(size_t const size, std::mt19937 & gen)
+{
+    std::uniform_int_distribution<size_t> rank_dist{0, bio::alphabet::size<alph_t> - 1};
+    std::vector<alph_t>                   ret(size);
+    for (auto & l : ret)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+    return ret;
+}
+
+//!\brief Apply `count` random substitutions, insertions and deletions.
+template <typename alph_t>
+std::vector<alph_t> mutate(std::vector<alph_t> seq, size_t const count, std::mt19937 & gen)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t const pos = std::uniform_int_distribution<size_t>{0, seq.size()}(gen);
+        switch (gen() % 3)
+        {
+            case 0:
+                if (pos < seq.size())
+                    seq[pos] = random_sequence<alph_t>(1, gen)[0];
+                break;
+            case 1:
+                seq.insert(seq.begin() + pos, random_sequence<alph_t>(1, gen)[0]);
+                break;
+            default:
+                if (pos < seq.size())
+                    seq.erase(seq.begin() + pos);
+                break;
+        }
+    }
+    return seq;
+}
+
+//!\brief The expected distance (full DP matrix).
+template <typename alph_t>
+size_t naive_distance(std::vector<alph_t> const & a, std::vector<alph_t> const & b)
+{
+    std::vector<size_t> col(a.size() + 1);
+    for (size_t i = 0; i <= a.size(); ++i)
+        col[i] = i;
+    for (size_t j = 1; j <= b.size(); ++j)
+    {
+        size_t diag = col[0];
+        col[0]      = j;
+        for (size_t i = 1; i <= a.size(); ++i)
+        {
+            size_t const up = col[i];
+            col[i]          = std::min({col[i] + 1, col[i - 1] + 1, diag + (a[i - 1] != b[j - 1])});
+            diag            = up;
+        }
+    }
+    return col.back();
+}
+
+template <typename t>
+class edit_distance_test : public ::testing::Test
+{};
+
+using alphabet_types = ::testing::Types<bio::alphabet::dna4, bio::alphabet::dna5, bio::alphabet::aa27>;
+TYPED_TEST_SUITE(edit_distance_test, alphabet_types, );
+
+TYPED_TEST(edit_distance_test, unbanded)
+{
+    std::mt19937 gen{0};
+    for (size_t size : {1, 7, 63, 64, 65, 100, 128, 129, 300})
+    {
+        for (size_t errors : {0, 1, 3, 10, 50})
+        {
+            auto const a = random_sequence<TypeParam>(size, gen);
+            auto const b = mutate(a, errors, gen);
+
+            size_t const expected = naive_distance(a, b);
+            EXPECT_EQ(bio::ranges::edit_distance(a, b), expected) << size << ' ' << errors;
+            EXPECT_EQ(bio::ranges::edit_distance(b, a), expected) << size << ' ' << errors;
+
+            // packed and generic ranges
+            bio::ranges::bitcompressed_vector<TypeParam> const pa{a}, pb{b};
+            std::deque<TypeParam> const                        db{b.begin(), b.end()};
+            EXPECT_EQ(bio::ranges::edit_distance(pa, pb), expected) << size << ' ' << errors;
+            EXPECT_EQ(bio::ranges::edit_distance(a, db), expected) << size << ' ' << errors;
+        }
+    }
+}
+
+TYPED_TEST(edit_distance_test, unrelated)
+{
+    std::mt19937 gen{1};
+    for (size_t size_a : {5, 70, 200})
+    {
+        for (size_t size_b : {1, 60, 150, 260})
+        {
+            auto const a = random_sequence<TypeParam>(size_a, gen);
+            auto const b = random_sequence<TypeParam>(size_b, gen);
+            EXPECT_EQ(bio::ranges::edit_distance(a, b), naive_distance(a, b)) << size_a << ' ' << size_b;
+        }
+    }
+}
+
+TYPED_TEST(edit_distance_test, banded)
+{
+    std::mt19937 gen{2};
+    for (size_t size : {20, 64, 150, 400})
+    {
+        for (size_t errors : {0, 2, 5, 20, 60})
+        {
+            auto const   a        = random_sequence<TypeParam>(size, gen);
+            auto const   b        = mutate(a, errors, gen);
+            size_t const expected = naive_distance(a, b);
+
+            for (size_t const max : {0, 1, 4, 10, 32, 100, 1000})
+            {
+                size_t const result = bio::ranges::edit_distance(a, b, max);
+                EXPECT_EQ(result, expected <= max ? expected : max + 1) << size << ' ' << errors << ' ' << max;
+            }
+        }
+    }
+}
+
+TEST(edit_distance, empty)
+{
+    EXPECT_EQ(bio::ranges::edit_distance(""_dna4, ""_dna4), 0u);
+    EXPECT_EQ(bio::ranges::edit_distance("ACGT"_dna4, ""_dna4), 4u);
+    EXPECT_EQ(bio::ranges::edit_distance(""_dna4, "ACG"_dna4), 3u);
+    EXPECT_EQ(bio::ranges::edit_distance(""_dna4, "ACG"_dna4, 2), 3u);
+    EXPECT_EQ(bio::ranges::edit_distance("ACGT"_dna4, "ACGT"_dna4, 0), 0u);
+    EXPECT_EQ(bio::ranges::edit_distance("ACGT"_dna4, "AGT"_dna4), 1u);
+}
+
+TYPED_TEST(edit_distance_test, batch)
+{
+    std::mt19937 gen{3};
+    for (size_t size : {10, 64, 150, 250})
+    {
+        auto const                          pattern = random_sequence<TypeParam>(size, gen);
+        std::vector<std::vector<TypeParam>> texts;
+        for (size_t i = 0; i < 30; ++i)
+            texts.push_back(mutate(pattern, i, gen));
+        texts.push_back({});
+
+        std::vector<size_t> expected, expected_max5;
+        for (auto const & t : texts)
+        {
+            expected.push_back(naive_distance(pattern, t));
+            expected_max5.push_back(std::min<size_t>(expected.back(), 6));
+        }
+
+        bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<TypeParam>> packed;
+        bio::ranges::concatenated_sequences<std::vector<TypeParam>>                        bytes;
+        for (auto const & t : texts)
+        {
+            packed.push_back(t);
+            bytes.push_back(t);
+        }
+
+        EXPECT_RANGE_EQ(bio::ranges::edit_distances(pattern, texts), expected);
+        EXPECT_RANGE_EQ(bio::ranges::edit_distances(pattern, packed), expected);
+        EXPECT_RANGE_EQ(bio::ranges::edit_distances(pattern, bytes), expected);
+
+        EXPECT_RANGE_EQ(bio::ranges::edit_distances(pattern, texts, 5), expected_max5);
+        EXPECT_RANGE_EQ(bio::ranges::edit_distances(pattern, bytes, 5), expected_max5);
+    }
+}
@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/hamming_distance.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename alph_t>
+std::vector<alph_t> random_sequence(size_t const size, std::mt19937 & gen)
+{
+    std::uniform_int_distribution<size_t> rank_dist{0, bio::alphabet::size<alph_t> - 1};
+    std::vector<alph_t>                   ret(size);
+    for (auto & l : ret)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+    return ret;
+}
+
+//!\brief The expected distance.
+template <typename rng_t>
+size_t naive_distance(rng_t const & lhs, rng_t const & rhs)
+{
+    size_t d = 0;
+    for (size_t i = 0; i < lhs.size(); ++i)
+        d += lhs[i] != rhs[i];
+    return d;
+}
+
+template <typename t>
+class hamming_distance_test : public ::testing::Test
+{};
+
+using alphabet_types = ::testing::Types<bio::alphabet::dna4, bio::alphabet::dna5, bio::alphabet::aa27>;
+TYPED_TEST_SUITE(hamming_distance_test, alphabet_types, );
+
+TYPED_TEST(hamming_distance_test, layouts)
+{
+    std::mt19937 gen{0};
+    for (size_t size : {0, 1, 7, 8, 31, 32, 33, 64, 100, 257})
+    {
+        auto const a = random_sequence<TypeParam>(size, gen);
+        auto       b = a;
+        for (size_t i = 0; i < size; i += 3) // a third of the positions (at most) differ
+            b[i] = random_sequence<TypeParam>(1, gen)[0];
+        size_t const expected = naive_distance(a, b);
+
+        // bytes
+        EXPECT_EQ(bio::ranges::hamming_distance(a, b), expected) << size;
+        // packed
+        bio::ranges::bitcompressed_vector<TypeParam> const pa{a}, pb{b};
+        EXPECT_EQ(bio::ranges::hamming_distance(pa, pb), expected) << size;
+        // packed slices at different offsets
+        bio::ranges::bitcompressed_vector<TypeParam> pb2{random_sequence<TypeParam>(5, gen)};
+        pb2.insert(pb2.end(), b.begin(), b.end());
+        EXPECT_EQ(bio::ranges::hamming_distance(pa.slice(0, size), pb2.slice(5, 5 + size)), expected) << size;
+        // generic
+        std::deque<TypeParam> const da{a.begin(), a.end()};
+        EXPECT_EQ(bio::ranges::hamming_distance(da, b), expected) << size;
+    }
+}
+
+TYPED_TEST(hamming_distance_test, threshold)
+{
+    std::mt19937 gen{1};
+    auto const   a = random_sequence<TypeParam>(200, gen);
+    auto         b = a;
+    for (size_t i = 0; i < 200; i += 10)
+        b[i] = bio::alphabet::assign_rank_to((bio::alphabet::to_rank(b[i]) + 1) % bio::alphabet::size<TypeParam>,
+                                             TypeParam{});
+    bio::ranges::bitcompressed_vector<TypeParam> const pa{a}, pb{b};
+    std::deque<TypeParam> const                        da{a.begin(), a.end()};
+
+    for (size_t const max : {0, 5, 19, 20, 21, 1000})
+    {
+        size_t const expected = max < 20 ? max + 1 : 20;
+        EXPECT_EQ(bio::ranges::hamming_distance(a, b, max), expected) << max;
+        EXPECT_EQ(bio::ranges::hamming_distance(pa, pb, max), expected) << max;
+        EXPECT_EQ(bio::ranges::hamming_distance(da, b, max), expected) << max;
+    }
+}
+
+TYPED_TEST(hamming_distance_test, batch)
+{
+    std::mt19937 gen{2};
+    for (size_t size : {1, 12, 16, 32, 40, 150})
+    {
+        auto const                       query = random_sequence<TypeParam>(size, gen);
+        std::vector<std::vector<TypeParam>> targets;
+        for (size_t i = 0; i < 50; ++i)
+        {
+            targets.push_back(query);
+            for (size_t j = 0; j < i % 7; ++j)
+                targets.back()[(j * 5 + i) % size] = random_sequence<TypeParam>(1, gen)[0];
+        }
+
+        std::vector<size_t> expected, expected_max2;
+        for (auto const & t : targets)
+        {
+            expected.push_back(naive_distance(query, t));
+            expected_max2.push_back(std::min<size_t>(expected.back(), 3));
+        }
+
+        bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<TypeParam>> packed;
+        bio::ranges::concatenated_sequences<std::vector<TypeParam>>                        bytes;
+        for (auto const & t : targets)
+        {
+            packed.push_back(t);
+            bytes.push_back(t);
+        }
+        std::vector<std::deque<TypeParam>> generic;
+        for (auto const & t : targets)
+            generic.emplace_back(t.begin(), t.end());
+
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, targets), expected);
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, packed), expected);
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, bytes), expected);
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, generic), expected);
+
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, targets, 2), expected_max2);
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, packed, 2), expected_max2);
+        EXPECT_RANGE_EQ(bio::ranges::hamming_distances(query, generic, 2), expected_max2);
+    }
+}
+
+TEST(hamming_distance, errors)
+{
+    EXPECT_THROW(bio::ranges::hamming_distance("ACGT"_dna4, "ACG"_dna4), std::invalid_argument);
+    EXPECT_THROW(bio::ranges::hamming_distances("ACGT"_dna4, std::vector{"ACGT"_dna4, "ACG"_dna4}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,183 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/bounded_queue.hpp>
+
+using namespace bio::alphabet::literals;
+
+using bio::ranges::queue_op_status;
+
+TEST(bounded_queue, capacity)
+{
+    EXPECT_EQ(bio::ranges::bounded_queue<int>{0}.capacity(), 2u);
+    EXPECT_EQ(bio::ranges::bounded_queue<int>{5}.capacity(), 8u);
+    EXPECT_EQ(bio::ranges::bounded_queue<int>{64}.capacity(), 64u);
+}
+
+TEST(bounded_queue, try_push_pop)
+{
+    bio::ranges::bounded_queue<int> queue{4};
+    int                             v = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.try_pop(v), queue_op_status::empty);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.try_push(i), queue_op_status::success);
+    EXPECT_EQ(queue.try_push(4), queue_op_status::full);
+    EXPECT_EQ(queue.size(), 4u);
+
+    // FIFO; and wrapping around the ring
+    for (int round = 0; round < 10; ++round)
+    {
+        EXPECT_EQ(queue.try_pop(v), queue_op_status::success);
+        EXPECT_EQ(v, round);
+        EXPECT_EQ(queue.try_push(round + 4), queue_op_status::success);
+    }
+    EXPECT_EQ(queue.size(), 4u);
+}
+
+TEST(bounded_queue, close)
+{
+    bio::ranges::bounded_queue<int> queue{4};
+    int                             v = 0;
+
+    EXPECT_EQ(queue.push(1), queue_op_status::success);
+    EXPECT_EQ(queue.push(2), queue_op_status::success);
+    EXPECT_FALSE(queue.is_closed());
+    queue.close();
+    EXPECT_TRUE(queue.is_closed());
+
+    EXPECT_EQ(queue.try_push(3), queue_op_status::closed);
+    EXPECT_EQ(queue.push(3), queue_op_status::closed);
+
+    // remaining elements can be popped
+    EXPECT_EQ(queue.pop(v), queue_op_status::success);
+    EXPECT_EQ(v, 1);
+    EXPECT_EQ(queue.try_pop(v), queue_op_status::success);
+    EXPECT_EQ(v, 2);
+    EXPECT_EQ(queue.try_pop(v), queue_op_status::closed);
+    EXPECT_EQ(queue.pop(v), queue_op_status::closed);
+}
+
+TEST(bounded_queue, move_only)
+{
+    bio::ranges::bounded_queue<std::unique_ptr<int>> queue{2};
+
+    auto p = std::make_unique<int>(3);
+    EXPECT_EQ(queue.push(std::move(p)), queue_op_status::success);
+    EXPECT_EQ(p, nullptr);
+
+    // not moved from on failure
+    auto q = std::make_unique<int>(4);
+    EXPECT_EQ(queue.try_push(std::make_unique<int>(5)), queue_op_status::success);
+    EXPECT_EQ(queue.try_push(std::move(q)), queue_op_status::full);
+    EXPECT_NE(q, nullptr);
+
+    EXPECT_EQ(queue.pop(p), queue_op_status::success);
+    EXPECT_EQ(*p, 3);
+    // the destructor releases the remaining element (checked by ASAN)
+}
+
+TEST(bounded_queue, concatenated_sequences)
+{
+    using batch_t = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+    bio::ranges::bounded_queue<batch_t> queue{2};
+
+    batch_t batch;
+    batch.push_back("ACGT"_dna4);
+    batch.push_back("GG"_dna4);
+    auto const * data = batch.raw_data().first.data();
+
+    EXPECT_EQ(queue.push(std::move(batch)), queue_op_status::success);
+
+    batch_t out;
+    EXPECT_EQ(queue.pop(out), queue_op_status::success);
+    EXPECT_EQ(out.size(), 2u);
+    EXPECT_EQ(out.raw_data().first.data(), data); // moved, not copied
+}
+
+TEST(bounded_queue, producers_consumers)
+{
+    constexpr size_t producers = 4;
+    constexpr size_t consumers = 3;
+    constexpr size_t per_thread = 10'000;
+
+    bio::ranges::bounded_queue<size_t> queue{8}; // small, so that threads block
+    std::vector<std::vector<size_t>>   received(consumers);
+
+    {
+        std::vector<std::jthread> threads;
+        for (size_t c = 0; c < consumers; ++c)
+        {
+            threads.emplace_back(
+              [&, c]()
+              {
+                  size_t v = 0;
+                  while (queue.pop(v) == queue_op_status::success)
+                      received[c].push_back(v);
+              });
+        }
+
+        std::vector<std::jthread> producer_threads;
+        for (size_t p = 0; p < producers; ++p)
+        {
+            producer_threads.emplace_back(
+              [&, p]()
+              {
+                  for (size_t i = 0; i < per_thread; ++i)
+                      EXPECT_EQ(queue.push(p * per_thread + i), queue_op_status::success);
+              });
+        }
+        producer_threads.clear(); // join
+        queue.close();
+    }
+
+    std::vector<size_t> all;
+    for (auto const & r : received)
+    {
+        // every consumer receives the elements of a producer in order
+        for (size_t p = 0; p < producers; ++p)
+        {
+            std::vector<size_t> from_p;
+            std::ranges::copy_if(r,
+                                 std::back_inserter(from_p),
+                                 [&](size_t const v) { return v / per_thread == p; });
+            EXPECT_TRUE(std::ranges::is_sorted(from_p));
+        }
+        all.insert(all.end(), r.begin(), r.end());
+    }
+
+    std::ranges::sort(all);
+    std::vector<size_t> expected(producers * per_thread);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(all, expected);
+}
+
+TEST(bounded_queue, close_wakes_up)
+{
+    bio::ranges::bounded_queue<int> queue{2};
+
+    std::jthread consumer{[&]()
+                          {
+                              int v = 0;
+                              EXPECT_EQ(queue.pop(v), queue_op_status::closed);
+                          }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    queue.close();
+}
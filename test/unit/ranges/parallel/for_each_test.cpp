@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <list>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/for_each.hpp>
+#include <bio/ranges/views/complement.hpp>
+#include <bio/ranges/views/deep.hpp>
+#include <bio/ranges/views/pairwise_combine.hpp>
+#include <bio/ranges/views/single_pass_input.hpp>
+#include <bio/ranges/views/to_rank.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+// skewed lengths: a few long sequences and many short ones
+bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>> make_seqs()
+{
+    bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>> seqs;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        std::vector<bio::alphabet::dna4> seq(i % 100 == 0 ? 5000 : i % 7);
+        for (size_t j = 0; j < seq.size(); ++j)
+            seq[j].assign_rank((i + j) % 4);
+        seqs.push_back(seq);
+    }
+    return seqs;
+}
+
+TEST(parallel_for_each, concatenated_sequences)
+{
+    auto const seqs = make_seqs();
+
+    size_t letters = 0;
+    for (auto && seq : seqs)
+        letters += seq.size();
+
+    for (size_t threads : {0, 1, 3})
+    {
+        bio::ranges::thread_pool pool{threads};
+        std::atomic<size_t>      count = 0;
+        std::vector<int>         visited(seqs.size());
+
+        bio::ranges::parallel_for_each(pool,
+                                       std::views::iota(size_t{0}, seqs.size()),
+                                       [&](size_t const i) { ++visited[i]; });
+        EXPECT_EQ(visited, std::vector<int>(seqs.size(), 1));
+
+        bio::ranges::parallel_for_each(pool, seqs, [&](auto && seq) { count += seq.size(); });
+        EXPECT_EQ(count, letters);
+    }
+}
+
+TEST(parallel_for_each, views)
+{
+    auto const               seqs = make_seqs();
+    bio::ranges::thread_pool pool{3};
+
+    // deep view (random access)
+    std::atomic<size_t> count = 0;
+    bio::ranges::parallel_for_each(pool,
+                                   seqs | bio::views::complement | bio::views::deep{bio::views::to_rank},
+                                   [&](auto && seq)
+                                   {
+                                       for (auto r : seq)
+                                           count += r;
+                                   });
+    size_t expected = 0;
+    for (auto && seq : seqs)
+        for (auto c : seq)
+            expected += 3 - c.to_rank();
+    EXPECT_EQ(count, expected);
+
+    // forward range
+    count = 0;
+    auto filtered = seqs | std::views::filter([](auto && seq) { return seq.size() > 3; });
+    bio::ranges::parallel_for_each(pool, filtered, [&](auto &&) { ++count; });
+    EXPECT_EQ(count, static_cast<size_t>(std::ranges::distance(filtered)));
+
+    // input range
+    count = 0;
+    std::vector<int> ints(100, 1);
+    bio::ranges::parallel_for_each(pool, ints | bio::views::single_pass_input, [&](int const i) { count += i; });
+    EXPECT_EQ(count, 100u);
+
+    // pairwise_combine
+    count = 0;
+    bio::ranges::parallel_for_each(pool, ints | bio::views::pairwise_combine, [&](auto) { ++count; });
+    EXPECT_EQ(count, 100u * 99 / 2);
+}
+
+TEST(parallel_transform, basic)
+{
+    auto const               seqs = make_seqs();
+    bio::ranges::thread_pool pool{3};
+
+    std::vector<size_t> sizes(seqs.size());
+    bio::ranges::parallel_transform(pool, seqs, sizes, [](auto && seq) { return seq.size(); });
+    for (size_t i = 0; i < seqs.size(); ++i)
+        EXPECT_EQ(sizes[i], seqs[i].size());
+
+    // packed output must not be written concurrently within a word
+    std::vector<bio::alphabet::dna4>                      in(10'000);
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna4> out;
+    out.resize(in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+        in[i].assign_rank(i % 4);
+    bio::ranges::parallel_transform(pool, in, out, [](auto c) { return c.complement(); });
+    EXPECT_RANGE_EQ(out, in | bio::views::complement);
+
+    // output too small
+    std::vector<size_t> small(3);
+    EXPECT_THROW(bio::ranges::parallel_transform(pool, seqs, small, [](auto && seq) { return seq.size(); }),
+                 std::invalid_argument);
+    EXPECT_EQ(small, std::vector<size_t>(3)); // checked before anything is written
+}
+
+TEST(parallel_for_each, exception)
+{
+    bio::ranges::thread_pool pool{2};
+    std::vector<int>         ints(1000);
+
+    EXPECT_THROW(bio::ranges::parallel_for_each(pool,
+                                                ints,
+                                                [](int) { throw std::runtime_error{"error"}; }),
+                 std::runtime_error);
+}
@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/ranges/parallel/thread_pool.hpp>
+
+TEST(thread_pool, run)
+{
+    for (size_t threads : {0, 1, 4})
+    {
+        bio::ranges::thread_pool pool{threads};
+        EXPECT_EQ(pool.size(), threads);
+
+        std::vector<int> hits(1000);
+        pool.run(hits.size(), [&](size_t const i) { ++hits[i]; });
+        EXPECT_EQ(hits, std::vector<int>(1000, 1));
+
+        pool.run(0, [](size_t) { FAIL(); });
+    }
+}
+
+TEST(thread_pool, submit)
+{
+    std::atomic<size_t> count = 0;
+    {
+        bio::ranges::thread_pool pool{3};
+        for (size_t i = 0; i < 500; ++i)
+            pool.submit([&]() { ++count; });
+    } // the destructor executes the remaining tasks
+
+    EXPECT_EQ(count, 500u);
+}
+
+TEST(thread_pool, run_one)
+{
+    bio::ranges::thread_pool pool{0};
+    EXPECT_FALSE(pool.run_one());
+}
+
+TEST(thread_pool, nested)
+{
+    bio::ranges::thread_pool pool{2};
+
+    std::atomic<size_t> count = 0;
+    pool.run(8, [&](size_t) { pool.run(8, [&](size_t) { ++count; }); });
+    EXPECT_EQ(count, 64u);
+}
+
+TEST(thread_pool, exception)
+{
+    bio::ranges::thread_pool pool{4};
+
+    std::atomic<size_t> count = 0;
+    EXPECT_THROW(pool.run(100,
+                          [&](size_t const i)
+                          {
+                              ++count;
+                              if (i % 10 == 3)
+                                  throw std::runtime_error{"error"};
+                          }),
+                 std::runtime_error);
+    EXPECT_EQ(count, 100u); // all tasks have finished
+
+    // the pool is still usable
+    pool.run(10, [&](size_t) { ++count; });
+    EXPECT_EQ(count, 110u);
+}
+
+TEST(thread_pool, uses_threads)
+{
+    bio::ranges::thread_pool pool{2};
+
+    // every task waits until the other one has started, so this only terminates if they run concurrently
+    std::atomic<size_t> started = 0;
+    pool.run(2,
+             [&](size_t)
+             {
+                 ++started;
+                 while (started < 2)
+                     std::this_thread::yield();
+             });
+    EXPECT_EQ(started, 2u);
+}
+
+TEST(thread_pool, run_sleeps)
+{
+    bio::ranges::thread_pool pool{1};
+    std::thread::id const    caller = std::this_thread::get_id();
+    std::atomic_flag         worker_started;
+
+    // the task on the worker takes long, so the calling thread has to wait; it should sleep instead of using the CPU
+    std::clock_t const before = std::clock();
+    pool.run(2,
+             [&](size_t)
+             {
+                 if (std::this_thread::get_id() == caller)
+                 {
+                     worker_started.wait(false);
+                 }
+                 else
+                 {
+                     worker_started.test_and_set();
+                     worker_started.notify_all();
+                     std::this_thread::sleep_for(std::chrono::milliseconds{200});
+                 }
+             });
+    double const cpu_seconds = static_cast<double>(std::clock() - before) / CLOCKS_PER_SEC;
+    EXPECT_LT(cpu_seconds, 0.1);
+}
@@ -0,0 +1,55 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <ranges>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna15.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/nucleotide/rna4.hpp>
+#include <bio/ranges/reverse_complement.hpp>
+#include <bio/ranges/views/complement.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+template <typename alph_t>
+void reverse_complement_test()
+{
+    bio::ranges::bitcompressed_vector<alph_t> v;
+    for (size_t n = 0; n < 100; ++n)
+    {
+        auto const rc = bio::ranges::reverse_complement(v);
+        EXPECT_RANGE_EQ(rc, v | std::views::reverse | bio::views::complement);
+
+        auto const s = v.slice(n / 3, n);
+        EXPECT_RANGE_EQ(bio::ranges::reverse_complement(s), s | std::views::reverse | bio::views::complement);
+
+        v.push_back(alph_t{}.assign_rank((n * 7 + n / 5) % bio::alphabet::size<alph_t>));
+    }
+}
+
+TEST(reverse_complement_test, dna4)
+{
+    reverse_complement_test<bio::alphabet::dna4>();
+}
+
+TEST(reverse_complement_test, dna5)
+{
+    reverse_complement_test<bio::alphabet::dna5>();
+}
+
+TEST(reverse_complement_test, dna15)
+{
+    reverse_complement_test<bio::alphabet::dna15>();
+}
+
+TEST(reverse_complement_test, rna4)
+{
+    reverse_complement_test<bio::alphabet::rna4>();
+}
@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <bio/ranges/suffix_array.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+template <typename alph_t>
+std::vector<alph_t> random_sequence(size_t const size, std::mt19937 & gen, size_t const sigma)
+{
+    std::uniform_int_distribution<size_t> rank_dist{0, sigma - 1};
+    std::vector<alph_t>                   ret(size);
+    for (auto & l : ret)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+    return ret;
+}
+
+//!\brief The expected suffix array: suffixes end at the end of their sequence, ties are broken by position.
+template <typename alph_t>
+std::vector<uint64_t> naive_suffix_array(bio::ranges::concatenated_sequences<std::vector<alph_t>> const & seqs)
+{
+    auto const & [values, delimiters] = seqs.raw_data();
+
+    std::vector<size_t> ends(values.size());
+    for (size_t i = 0; i + 1 < delimiters.size(); ++i)
+        std::fill(ends.begin() + delimiters[i], ends.begin() + delimiters[i + 1], delimiters[i + 1]);
+
+    std::vector<uint64_t> ret(values.size());
+    std::iota(ret.begin(), ret.end(), 0);
+    std::ranges::sort(ret,
+                      [&](size_t const a, size_t const b)
+                      {
+                          auto const cmp = std::lexicographical_compare_three_way(values.begin() + a,
+                                                                                  values.begin() + ends[a],
+                                                                                  values.begin() + b,
+                                                                                  values.begin() + ends[b]);
+                          return cmp < 0 || (cmp == 0 && a < b);
+                      });
+    return ret;
+}
+
+/*!\brief Random sequences with repeats: some sequences are copies of (parts of) earlier ones, some consist of a single
+ *        letter or a short period.
+ */
+template <typename alph_t>
+bio::ranges::concatenated_sequences<std::vector<alph_t>> random_collection(size_t const   count,
+                                                                          size_t const   max_size,
+                                                                          size_t const   sigma,
+                                                                          std::mt19937 & gen)
+{
+    bio::ranges::concatenated_sequences<std::vector<alph_t>> ret;
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t const size = gen() % (max_size + 1);
+        switch (gen() % 4)
+        {
+            case 0:
+                if (i > 0)
+                {
+                    auto const & prev = ret[gen() % i];
+                    size_t const b    = prev.empty() ? 0 : gen() % prev.size();
+                    ret.push_back(prev | std::views::drop(b));
+                    break;
+                }
+                [[fallthrough]];
+            case 1:
+                ret.push_back(random_sequence<alph_t>(size, gen, sigma));
+                break;
+            case 2:
+                ret.push_back(std::vector<alph_t>(size, random_sequence<alph_t>(1, gen, sigma)[0]));
+                break;
+            default:
+            {
+                auto const          period = random_sequence<alph_t>(1 + gen() % 3, gen, sigma);
+                std::vector<alph_t> seq(size);
+                for (size_t j = 0; j < size; ++j)
+                    seq[j] = period[j % period.size()];
+                ret.push_back(seq);
+            }
+        }
+    }
+    return ret;
+}
+
+template <typename t>
+class suffix_array_test : public ::testing::Test
+{};
+
+using alphabet_types = ::testing::Types<bio::alphabet::dna4, bio::alphabet::aa27>;
+TYPED_TEST_SUITE(suffix_array_test, alphabet_types, );
+
+TYPED_TEST(suffix_array_test, random)
+{
+    std::mt19937 gen{0};
+    for (size_t const sigma : {size_t{1}, size_t{2}, bio::alphabet::size<TypeParam>})
+    {
+        for (auto const & [count, max_size] : {std::pair{1, 1}, {1, 300}, {5, 50}, {50, 20}, {300, 8}, {30, 200}})
+        {
+            for (size_t rep = 0; rep < 5; ++rep)
+            {
+                auto const seqs     = random_collection<TypeParam>(count, max_size, sigma, gen);
+                auto const expected = naive_suffix_array(seqs);
+
+                EXPECT_RANGE_EQ(bio::ranges::suffix_array(seqs), expected);
+                EXPECT_RANGE_EQ(bio::ranges::suffix_array<uint32_t>(seqs), expected);
+            }
+        }
+    }
+}
+
+TYPED_TEST(suffix_array_test, parallel)
+{
+    std::mt19937             gen{1};
+    bio::ranges::thread_pool pool{3};
+    for (size_t const sigma : {size_t{2}, bio::alphabet::size<TypeParam>})
+    {
+        // large enough for the parallel code paths
+        auto const seqs     = random_collection<TypeParam>(2000, 200, sigma, gen);
+        auto const expected = naive_suffix_array(seqs);
+        ASSERT_GT(expected.size(), bio::ranges::detail::sais_parallel_threshold);
+
+        EXPECT_RANGE_EQ(bio::ranges::suffix_array(seqs), expected);
+        EXPECT_RANGE_EQ(bio::ranges::suffix_array(pool, seqs), expected);
+        EXPECT_RANGE_EQ(bio::ranges::suffix_array<uint32_t>(pool, seqs), expected);
+    }
+}
+
+TEST(suffix_array, basic)
+{
+    // single sequences
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array("ACAACG"_dna4), (std::vector<uint64_t>{2, 0, 3, 1, 4, 5}));
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array("AAAA"_dna4), (std::vector<uint64_t>{3, 2, 1, 0}));
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array("TGCA"_dna4 | std::views::reverse), (std::vector<uint64_t>{0, 1, 2, 3}));
+    EXPECT_TRUE(bio::ranges::suffix_array(std::vector<bio::alphabet::dna4>{}).empty());
+
+    // equal suffixes are ordered by position, empty sequences are skipped
+    bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>> seqs;
+    seqs.push_back("ACG"_dna4);
+    seqs.push_back(""_dna4);
+    seqs.push_back("ACG"_dna4);
+    seqs.push_back("A"_dna4);
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array(seqs), (std::vector<uint64_t>{6, 0, 3, 1, 4, 2, 5}));
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array<uint32_t>(seqs), (std::vector<uint32_t>{6, 0, 3, 1, 4, 2, 5}));
+
+    seqs.clear();
+    EXPECT_TRUE(bio::ranges::suffix_array(seqs).empty());
+    seqs.push_back(""_dna4);
+    EXPECT_TRUE(bio::ranges::suffix_array(seqs).empty());
+}
+
+TEST(suffix_array, bitcompressed)
+{
+    std::mt19937 gen{2};
+    auto const   seqs = random_collection<bio::alphabet::dna4>(100, 50, 4, gen);
+
+    bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>> packed;
+    for (auto const & seq : seqs)
+        packed.push_back(seq);
+
+    EXPECT_RANGE_EQ(bio::ranges::suffix_array(packed), naive_suffix_array(seqs));
+}
@@ -0,0 +1,245 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2022, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2022, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <deque>
+#include <list>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/container/concatenated_sequences.hpp>
+#include <bio/ranges/parallel/thread_pool.hpp>
+#include <bio/ranges/to.hpp>
+#include <bio/ranges/views/to_char.hpp>
+#include <bio/ranges/views/zip.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+TEST(to, contiguous)
+{
+    std::vector<bio::alphabet::dna4> const in = "ACGTTA"_dna4;
+
+    // memcpy
+    EXPECT_RANGE_EQ(in | bio::ranges::to<std::vector>(), in);
+    EXPECT_RANGE_EQ(std::span{in} | bio::ranges::to<std::vector<bio::alphabet::dna4>>(), in);
+    EXPECT_RANGE_EQ(std::string_view{"foo"} | bio::ranges::to<std::string>(), std::string{"foo"});
+    EXPECT_TRUE((std::vector<int>{} | bio::ranges::to<std::vector>()).empty());
+
+    // insert
+    EXPECT_RANGE_EQ(in | bio::ranges::to<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>(), in);
+    EXPECT_RANGE_EQ(in | bio::ranges::to<std::deque>(), in);
+    EXPECT_RANGE_EQ(in | bio::views::to_char | bio::ranges::to<std::string>(), std::string{"ACGTTA"});
+}
+
+TEST(to, not_sized)
+{
+    auto v = std::views::iota(0, 10) | std::views::filter([](int const i) { return i % 2 == 0; });
+
+    EXPECT_RANGE_EQ(v | bio::ranges::to<std::vector>(), (std::vector<int>{0, 2, 4, 6, 8}));
+    EXPECT_RANGE_EQ(v | bio::ranges::to<std::list<int>>(), (std::vector<int>{0, 2, 4, 6, 8}));
+}
+
+//!\brief Whether bio::ranges::to finds a function to append a `rng_t` to a `container_t` in bulk.
+template <typename container_t, typename rng_t>
+concept bulk_appendable = requires(container_t & c, rng_t const & r) { to_bulk_append(c, r); };
+
+TEST(to, zip_of_components)
+{
+    using qualified_t = bio::alphabet::qualified<bio::alphabet::dna4, bio::alphabet::phred42>;
+    std::vector<bio::alphabet::dna4> const    seq  = "ACGTTA"_dna4;
+    std::vector<bio::alphabet::phred42> const qual = "II#!(+"_phred42;
+
+    std::vector<qualified_t> expected;
+    for (size_t i = 0; i < seq.size(); ++i)
+        expected.push_back(qualified_t{seq[i], qual[i]});
+
+    // uses bio::ranges::zip_components (without including its header)
+    EXPECT_TRUE((bulk_appendable<std::vector<qualified_t>, decltype(bio::views::zip(seq, qual))>));
+    EXPECT_FALSE((bulk_appendable<std::vector<qualified_t>, decltype(bio::views::zip(qual, seq))>));
+    EXPECT_RANGE_EQ(bio::views::zip(seq, qual) | bio::ranges::to<std::vector<qualified_t>>(), expected);
+    EXPECT_RANGE_EQ(bio::views::zip(seq, qual) | bio::ranges::to<bio::ranges::bitcompressed_vector<qualified_t>>(),
+                    expected);
+
+    // the shorter range determines the size
+    auto zipped = bio::views::zip(seq, qual | std::views::take(2));
+    EXPECT_RANGE_EQ(zipped | bio::ranges::to<std::vector<qualified_t>>(), expected | std::views::take(2));
+}
+
+TEST(to, nested)
+{
+    std::vector<std::vector<bio::alphabet::dna4>> const in{"ACGT"_dna4, ""_dna4, "GG"_dna4};
+
+    EXPECT_EQ(in | bio::ranges::to<std::vector>(), in);
+    EXPECT_EQ(in | bio::ranges::to<std::vector<std::vector<bio::alphabet::dna4>>>(), in);
+    EXPECT_EQ((in | bio::ranges::to<std::list<std::deque<bio::alphabet::dna4>>>()).size(), 3u);
+}
+
+TEST(to, concatenated_sequences)
+{
+    std::vector<std::vector<bio::alphabet::dna4>> const in{"ACGT"_dna4, ""_dna4, "GG"_dna4};
+
+    auto check = [&](auto const & out)
+    {
+        ASSERT_EQ(out.size(), in.size());
+        EXPECT_EQ(out.concat_size(), 6u);
+        for (size_t i = 0; i < in.size(); ++i)
+            EXPECT_RANGE_EQ(out[i], in[i]);
+    };
+
+    using cs_t  = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+    using bcs_t = bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
+
+    cs_t const out = in | bio::ranges::to<cs_t>();
+    check(out);
+    EXPECT_GE(out.concat_capacity(), 6u);
+    check(in | bio::ranges::to<bcs_t>());
+
+    // inner ranges are computed on-the-fly
+    auto v = in | std::views::transform([](auto const & r) { return r; });
+    check(v | bio::ranges::to<cs_t>());
+
+    // from a different concatenated_sequences
+    check(out | bio::ranges::to<bcs_t>());
+}
+
+TEST(to, parallel)
+{
+    // large enough to actually use multiple threads
+    auto const in = std::views::iota(0u, 100'000u) |
+                    std::views::transform([](unsigned const i)
+                                          { return bio::alphabet::dna4{}.assign_rank(i % 7 % 4); });
+    std::vector<bio::alphabet::dna4> const expected = in | bio::ranges::to<std::vector>();
+
+    for (size_t threads : {0, 1, 2, 7})
+    {
+        bio::ranges::thread_pool           pool{threads};
+        bio::ranges::parallel_policy const policy = bio::ranges::par(pool);
+
+        EXPECT_RANGE_EQ(in | bio::ranges::to<std::vector>(policy), expected);
+        EXPECT_RANGE_EQ(in | bio::ranges::to<std::deque>(policy), expected);
+        EXPECT_RANGE_EQ(in | bio::ranges::to<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>(policy),
+                        expected);
+
+        // not random access
+        EXPECT_RANGE_EQ(in | bio::ranges::to<std::list>(policy), expected);
+    }
+
+    bio::ranges::thread_pool pool{2};
+    EXPECT_RANGE_EQ(in | bio::ranges::to<std::vector>(bio::ranges::par(pool)), expected);
+    EXPECT_RANGE_EQ(bio::ranges::to<std::vector>(in, bio::ranges::par(pool)), expected);
+}
+
+TEST(to, parallel_nested)
+{
+    std::vector<std::vector<bio::alphabet::dna4>> in;
+    for (size_t i = 0; i < 3000; ++i)
+        in.push_back(std::vector<bio::alphabet::dna4>(i % 50, bio::alphabet::dna4{}.assign_rank(i % 4)));
+    in[17].clear();
+
+    using cs_t  = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+    using bcs_t = bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
+
+    auto check = [&](auto const & out)
+    {
+        ASSERT_EQ(out.size(), in.size());
+        for (size_t i = 0; i < in.size(); ++i)
+            EXPECT_RANGE_EQ(out[i], in[i]);
+    };
+
+    for (size_t threads : {0, 1, 2, 7})
+    {
+        bio::ranges::thread_pool           pool{threads};
+        bio::ranges::parallel_policy const policy = bio::ranges::par(pool);
+
+        check(in | bio::ranges::to<cs_t>(policy));
+        check(in | bio::ranges::to<bcs_t>(policy));
+        check(in | bio::ranges::to<std::vector<std::vector<bio::alphabet::dna4>>>(policy));
+        check(in | std::views::transform(std::views::all) | bio::ranges::to<bcs_t>(policy));
+    }
+}
+
+TEST(to, parallel_append)
+{
+    // the container is created from the extra arguments; its size is not a multiple of the packing granularity
+    std::vector<bool> const in(65536, true);
+    for (size_t threads : {1, 2, 3})
+    {
+        bio::ranges::thread_pool           pool{threads};
+        bio::ranges::parallel_policy const policy = bio::ranges::par(pool);
+
+        std::vector<bool> expected(10, false);
+        expected.insert(expected.end(), in.begin(), in.end());
+        EXPECT_RANGE_EQ(bio::ranges::to<std::vector<bool>>(in, policy, size_t{10}, false), expected);
+
+        auto const dna = in | std::views::transform([](bool const b) { return bio::alphabet::dna4{}.assign_rank(b); });
+        std::vector<bio::alphabet::dna4> expected_dna(33, 'A'_dna4);
+        expected_dna.insert(expected_dna.end(), dna.begin(), dna.end());
+        EXPECT_RANGE_EQ(bio::ranges::to<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>(dna,
+                                                                                              policy,
+                                                                                              size_t{33},
+                                                                                              'A'_dna4),
+                        expected_dna);
+    }
+}
+
+TEST(to, parallel_nested_append)
+{
+    // 2^16 letters: split among 2 or 4 threads, the chunks have no slack beyond the letters
+    std::vector<std::vector<bio::alphabet::dna4>> in(2048);
+    for (size_t i = 0; i < in.size(); ++i)
+        for (size_t j = 0; j < 32; ++j)
+            in[i].push_back(bio::alphabet::dna4{}.assign_rank((i + j) % 4));
+
+    // 13 letters, so the appended letters do not begin at a word boundary
+    std::vector<std::vector<bio::alphabet::dna4>> const prefix{"ACGTA"_dna4, "CCCCGGG"_dna4, "T"_dna4};
+    std::vector<std::vector<bio::alphabet::dna4>>       expected = prefix;
+    expected.insert(expected.end(), in.begin(), in.end());
+
+    using cs_t  = bio::ranges::concatenated_sequences<std::vector<bio::alphabet::dna4>>;
+    using bcs_t = bio::ranges::concatenated_sequences<bio::ranges::bitcompressed_vector<bio::alphabet::dna4>>;
+
+    auto check = [&](auto const & out)
+    {
+        ASSERT_EQ(out.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_RANGE_EQ(out[i], expected[i]);
+    };
+
+    for (size_t threads : {1, 2, 3})
+    {
+        bio::ranges::thread_pool           pool{threads};
+        bio::ranges::parallel_policy const policy = bio::ranges::par(pool);
+
+        check(bio::ranges::to<cs_t>(in, policy, prefix));
+        check(bio::ranges::to<bcs_t>(in, policy, prefix));
+    }
+}
+
+TEST(to, parallel_exception)
+{
+    auto in = std::views::iota(0, 100'000) |
+              std::views::transform(
+                [](int const i)
+                {
+                    if (i == 77'777)
+                        throw std::runtime_error{"error"};
+                    return i;
+                });
+
+    bio::ranges::thread_pool pool{3};
+    EXPECT_THROW((in | bio::ranges::to<std::vector>(bio::ranges::par(pool))), std::runtime_error);
+}
@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <forward_list>
+#include <ranges>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/alphabet/quality/all.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/to.hpp>
+#include <bio/ranges/views/bin_quality.hpp>
+#include <bio/ranges/views/convert.hpp>
+#include <bio/ranges/views/to_char.hpp>
+
+#include "../iterator_test_template.hpp"
+
+using namespace bio::alphabet::literals;
+
+using pblock_view_t = decltype(std::declval<std::vector<bio::alphabet::phred42> &>() |
+                               bio::ranges::views::pblock_quality(2));
+
+template <>
+struct iterator_fixture<pblock_view_t> : public ::testing::Test
+{
+    using iterator_tag = std::forward_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    std::vector<bio::alphabet::phred42> vec{"IIGHA5.+++"_phred42};
+    std::vector<bio::alphabet::phred42> expected_range{"HHHHA5,,,,"_phred42};
+
+    pblock_view_t test_range = vec | bio::ranges::views::pblock_quality(2);
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(view_pblock_quality, iterator_fixture, pblock_view_t, );
+
+TEST(view_bin_quality, basic)
+{
+    std::vector<bio::alphabet::phred42> vec{"I@5+$!"_phred42};
+    std::vector<bio::alphabet::phred42> const cmp{"IB70'#"_phred42};
+
+    // pipe notation
+    auto v1 = vec | bio::ranges::views::bin_quality(bio::ranges::quality_bins::illumina8());
+    EXPECT_RANGE_EQ(v1, cmp);
+
+    // function notation
+    auto v2 = bio::ranges::views::bin_quality(vec, bio::ranges::quality_bins::illumina8());
+    EXPECT_RANGE_EQ(v2, cmp);
+
+    // combinability
+    std::string v3 = vec | bio::ranges::views::bin_quality(bio::ranges::quality_bins::illumina8()) |
+                     bio::ranges::views::to_char | bio::ranges::to<std::string>();
+    EXPECT_EQ(v3, "IB70'#");
+
+    // into the smaller alphabet
+    auto v4 = vec | bio::ranges::views::convert<bio::alphabet::phred8binned>;
+    EXPECT_RANGE_EQ(v4 | bio::ranges::views::to_char, std::string_view{"IB70'#"});
+
+    // the underlying range is unchanged
+    EXPECT_EQ(vec, "I@5+$!"_phred42);
+}
+
+TEST(view_bin_quality, deep)
+{
+    std::vector<std::vector<bio::alphabet::dna4q>> vec{
+      {{'A'_dna4, bio::alphabet::phred42{41}}, {'C'_dna4, bio::alphabet::phred42{3}}},
+      {{'G'_dna4, bio::alphabet::phred42{23}}}
+    };
+    std::vector<std::vector<bio::alphabet::dna4q>> const cmp{
+      {{'A'_dna4, bio::alphabet::phred42{40}}, {'C'_dna4, bio::alphabet::phred42{6}}},
+      {{'G'_dna4, bio::alphabet::phred42{22}}}
+    };
+
+    auto v = vec | bio::ranges::views::bin_quality(bio::ranges::quality_bins::illumina8());
+    EXPECT_EQ(v | bio::ranges::to<std::vector<std::vector<bio::alphabet::dna4q>>>(), cmp);
+}
+
+TEST(view_bin_quality, concepts)
+{
+    std::vector<bio::alphabet::phred42> vec{"I@5+$!"_phred42};
+
+    auto v1 = vec | bio::ranges::views::bin_quality(bio::ranges::quality_bins{});
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(v1)>);
+    EXPECT_TRUE(std::ranges::sized_range<decltype(v1)>);
+    EXPECT_TRUE(std::ranges::common_range<decltype(v1)>);
+    EXPECT_TRUE(std::ranges::view<decltype(v1)>);
+    EXPECT_TRUE(bio::ranges::const_iterable_range<decltype(v1)>);
+    EXPECT_FALSE((std::ranges::output_range<decltype(v1), bio::alphabet::phred42>));
+}
+
+TEST(view_pblock_quality, basic)
+{
+    std::vector<bio::alphabet::phred42> vec{"IIGHA5.+++"_phred42};
+    std::vector<bio::alphabet::phred42> const cmp{"HHHHA5,,,,"_phred42};
+
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::pblock_quality(2), cmp);
+    EXPECT_RANGE_EQ(bio::ranges::views::pblock_quality(vec, 2), cmp);
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::pblock_quality(0), vec);
+
+    // same result as the in-place algorithm
+    std::vector<bio::alphabet::phred42> vec2 = vec;
+    bio::ranges::pblock_quality(vec2, 5);
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::pblock_quality(5), vec2);
+
+    // forward range, empty range
+    std::forward_list<bio::alphabet::phred42> list(vec.begin(), vec.end());
+    EXPECT_RANGE_EQ(list | bio::ranges::views::pblock_quality(2), cmp);
+    std::vector<bio::alphabet::phred42> empty;
+    EXPECT_TRUE(std::ranges::empty(empty | bio::ranges::views::pblock_quality(2)));
+
+    EXPECT_THROW(bio::ranges::views::pblock_quality(-1), std::invalid_argument);
+}
+
+TEST(view_rblock_quality, basic)
+{
+    std::vector<bio::alphabet::phred42> vec{"II5+!!$"_phred42};
+    std::vector<bio::alphabet::phred42> const cmp{"===+!!$"_phred42};
+
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rblock_quality(1.5), cmp);
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rblock_quality(1), vec);
+
+    std::vector<std::vector<bio::alphabet::phred42>> deep{vec, vec};
+    auto v = deep | bio::ranges::views::rblock_quality(1.5);
+    EXPECT_RANGE_EQ(v[0], cmp);
+    EXPECT_RANGE_EQ(v[1], cmp);
+
+    EXPECT_THROW(bio::ranges::views::rblock_quality(0.5), std::invalid_argument);
+}
+
+TEST(view_pblock_quality, concepts)
+{
+    std::vector<bio::alphabet::phred42> vec{"IIGHA5.+++"_phred42};
+
+    auto v1 = vec | bio::ranges::views::pblock_quality(2);
+    EXPECT_TRUE(std::ranges::forward_range<decltype(v1)>);
+    EXPECT_FALSE(std::ranges::bidirectional_range<decltype(v1)>);
+    EXPECT_TRUE(std::ranges::sized_range<decltype(v1)>);
+    EXPECT_FALSE(std::ranges::common_range<decltype(v1)>);
+    EXPECT_TRUE(std::ranges::view<decltype(v1)>);
+    EXPECT_TRUE(bio::ranges::const_iterable_range<decltype(v1)>);
+    EXPECT_FALSE((std::ranges::output_range<decltype(v1), bio::alphabet::phred42>));
+    EXPECT_EQ(std::ranges::size(v1), vec.size());
+}
@@ -0,0 +1,214 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <forward_list>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/alphabet/aminoacid/aa27.hpp>
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/views/find_all.hpp>
+
+#include "../iterator_test_template.hpp"
+
+using namespace bio::alphabet::literals;
+
+using find_all_view_t = decltype(std::declval<std::vector<bio::alphabet::dna4> &>() |
+                                 bio::ranges::views::find_all("ACG"_dna4));
+
+template <>
+struct iterator_fixture<find_all_view_t> : public ::testing::Test
+{
+    using iterator_tag = std::forward_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    std::vector<bio::alphabet::dna4> vec{"ACGTACGACGT"_dna4};
+    std::vector<size_t>              expected_range{3, 7, 10};
+
+    find_all_view_t test_range = vec | bio::ranges::views::find_all("ACG"_dna4);
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(view_find_all, iterator_fixture, find_all_view_t, );
+
+template <typename alph_t>
+std::vector<alph_t> random_sequence(size_t const size, std::mt19937 & gen)
+{
+    std::uniform_int_distribution<size_t> rank_dist{0, bio::alphabet::size<alph_t> - 1};
+    std::vector<alph_t>                   ret(size);
+    for (auto & l : ret)
+        bio::alphabet::assign_rank_to(rank_dist(gen), l);
+    return ret;
+}
+
+//!\brief The expected end positions of occurrences with up to `k` mismatches.
+template <typename alph_t>
+std::vector<size_t> naive_mismatches(std::vector<alph_t> const & text, std::vector<alph_t> const & pattern, size_t k)
+{
+    std::vector<size_t> ret;
+    for (size_t e = pattern.size(); e <= text.size(); ++e)
+    {
+        size_t d = 0;
+        for (size_t i = 0; i < pattern.size(); ++i)
+            d += text[e - pattern.size() + i] != pattern[i];
+        if (d <= k)
+            ret.push_back(e);
+    }
+    return ret;
+}
+
+//!\brief The expected end positions of occurrences with up to `k` edits (semi-global DP).
+template <typename alph_t>
+std::vector<size_t> naive_edits(std::vector<alph_t> const & text, std::vector<alph_t> const & pattern, size_t k)
+{
+    std::vector<size_t> ret;
+    std::vector<size_t> col(pattern.size() + 1);
+    for (size_t i = 0; i <= pattern.size(); ++i)
+        col[i] = i;
+    for (size_t j = 1; j <= text.size(); ++j)
+    {
+        size_t diag = col[0]; // always 0
+        for (size_t i = 1; i <= pattern.size(); ++i)
+        {
+            size_t const up = col[i];
+            col[i]          = std::min({col[i] + 1, col[i - 1] + 1, diag + (pattern[i - 1] != text[j - 1])});
+            diag            = up;
+        }
+        if (col.back() <= k)
+            ret.push_back(j);
+    }
+    return ret;
+}
+
+template <typename t>
+class view_find_all_test : public ::testing::Test
+{};
+
+using alphabet_types = ::testing::Types<bio::alphabet::dna4, bio::alphabet::dna5, bio::alphabet::aa27>;
+TYPED_TEST_SUITE(view_find_all_test, alphabet_types, );
+
+TYPED_TEST(view_find_all_test, exact)
+{
+    std::mt19937 gen{0};
+    for (size_t size : {1, 2, 5, 12, 31, 63, 64})
+    {
+        auto const pattern = random_sequence<TypeParam>(size, gen);
+
+        // a random text with copies of the pattern, some overlapping
+        auto text = random_sequence<TypeParam>(2000, gen);
+        for (size_t p = 7; p + size <= text.size(); p += 3 * size + 1)
+            std::ranges::copy(pattern, text.begin() + p);
+        for (size_t p = 1500; p < 1500 + 2 * size && p + size <= text.size(); p += std::max<size_t>(1, size / 2))
+            std::ranges::copy(pattern, text.begin() + p);
+
+        auto const expected = naive_mismatches(text, pattern, 0);
+
+        // BNDM (long patterns) or Shift-And
+        EXPECT_RANGE_EQ(text | bio::ranges::views::find_all(pattern), expected);
+        bio::ranges::bitcompressed_vector<TypeParam> const packed{text};
+        EXPECT_RANGE_EQ(packed | bio::ranges::views::find_all(pattern), expected);
+        // Shift-And (not random access)
+        std::forward_list<TypeParam> const list{text.begin(), text.end()};
+        EXPECT_RANGE_EQ(list | bio::ranges::views::find_all(pattern), expected);
+    }
+}
+
+TYPED_TEST(view_find_all_test, mismatches)
+{
+    std::mt19937 gen{1};
+    for (size_t size : {3, 8, 20, 64})
+    {
+        for (size_t k : {1, 2, 4})
+        {
+            auto const pattern = random_sequence<TypeParam>(size, gen);
+            auto       text    = random_sequence<TypeParam>(1000, gen);
+            for (size_t p = 3; p + size <= text.size(); p += 2 * size + 5)
+            {
+                std::ranges::copy(pattern, text.begin() + p);
+                text[p + (p % size)] = random_sequence<TypeParam>(1, gen)[0];
+            }
+
+            auto const expected = naive_mismatches(text, pattern, k);
+            EXPECT_RANGE_EQ(text | bio::ranges::views::find_all(pattern, k), expected);
+            EXPECT_RANGE_EQ(text | bio::ranges::views::find_all(pattern, k, bio::ranges::search_errors::mismatches),
+                            expected);
+        }
+    }
+}
+
+TYPED_TEST(view_find_all_test, edits)
+{
+    std::mt19937 gen{2};
+    for (size_t size : {3, 8, 20, 64})
+    {
+        for (size_t k : {1, 2, 4})
+        {
+            auto const pattern = random_sequence<TypeParam>(size, gen);
+            auto       text    = random_sequence<TypeParam>(1000, gen);
+            for (size_t p = 3; p + size + 1 <= text.size(); p += 2 * size + 5)
+            {
+                std::ranges::copy(pattern, text.begin() + p);
+                if (p % 3 == 0) // deletion
+                    text.erase(text.begin() + p + (p % size));
+                else if (p % 3 == 1) // insertion
+                    text.insert(text.begin() + p + (p % size), random_sequence<TypeParam>(1, gen)[0]);
+            }
+
+            auto const expected = naive_edits(text, pattern, k);
+            EXPECT_RANGE_EQ(text | bio::ranges::views::find_all(pattern, k, bio::ranges::search_errors::edits),
+                            expected);
+        }
+    }
+}
+
+TEST(view_find_all, basic)
+{
+    std::vector<bio::alphabet::dna4> const text{"AACGTTACGTAACGA"_dna4};
+
+    // pipe notation
+    EXPECT_RANGE_EQ(text | bio::ranges::views::find_all("ACGT"_dna4), (std::vector<size_t>{5, 10}));
+    // function notation
+    EXPECT_RANGE_EQ(bio::ranges::views::find_all(text, "ACGT"_dna4), (std::vector<size_t>{5, 10}));
+    EXPECT_RANGE_EQ(bio::ranges::views::find_all(text, "ACGT"_dna4, 1), (std::vector<size_t>{5, 10, 15}));
+    // edits
+    EXPECT_RANGE_EQ(text | bio::ranges::views::find_all("ACGTT"_dna4, 1, bio::ranges::search_errors::edits),
+                    (std::vector<size_t>{5, 6, 7, 10, 11}));
+    // more errors than letters
+    EXPECT_EQ(std::ranges::distance(text | bio::ranges::views::find_all("AC"_dna4, 5)), 14);
+    auto edits = text | bio::ranges::views::find_all("AC"_dna4, 5, bio::ranges::search_errors::edits);
+    EXPECT_EQ(std::ranges::distance(edits), 15);
+
+    // no occurrences
+    EXPECT_TRUE(std::ranges::empty(text | bio::ranges::views::find_all("GGG"_dna4)));
+    EXPECT_TRUE(std::ranges::empty(std::vector<bio::alphabet::dna4>{} | bio::ranges::views::find_all("A"_dna4)));
+    EXPECT_TRUE(std::ranges::empty("AC"_dna4 | bio::ranges::views::find_all("ACG"_dna4)));
+}
+
+TEST(view_find_all, errors)
+{
+    EXPECT_THROW(bio::ranges::views::find_all(std::vector<bio::alphabet::dna4>{}), std::invalid_argument);
+    EXPECT_THROW(bio::ranges::views::find_all(std::vector<bio::alphabet::dna4>(65)), std::invalid_argument);
+}
+
+TEST(view_find_all, concepts)
+{
+    EXPECT_TRUE(std::ranges::forward_range<find_all_view_t>);
+    EXPECT_FALSE(std::ranges::bidirectional_range<find_all_view_t>);
+    EXPECT_TRUE(std::ranges::view<find_all_view_t>);
+    EXPECT_FALSE(std::ranges::sized_range<find_all_view_t>);
+    EXPECT_TRUE(bio::ranges::const_iterable_range<find_all_view_t>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<find_all_view_t>, size_t>));
+}
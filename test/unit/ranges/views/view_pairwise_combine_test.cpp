@@ -514,3 +514,64 @@ TEST(pairwise_combine_fn_test, const_source)
     EXPECT_EQ(*++it, (bio::meta::tuple{'b', 'd'}));
     EXPECT_EQ(*++it, (bio::meta::tuple{'c', 'd'}));
 }
+
+TEST(pairwise_combine_index, roundtrip)
+{
+    for (size_t n = 0; n < 50; ++n)
+    {
+        size_t index = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = i + 1; j < n; ++j, ++index)
+            {
+                EXPECT_EQ(bio::ranges::pairwise_combine_index(n, i, j), index);
+                EXPECT_EQ(bio::ranges::pairwise_combine_pair(n, index), (std::pair{i, j}));
+            }
+        }
+    }
+
+    // large n, where the floating point estimate is not exact
+    for (size_t n : {100'000ull, 3'000'001ull, (1ull << 31) - 1})
+    {
+        size_t const total = n * (n - 1) / 2;
+        for (size_t i : {size_t{0}, size_t{1}, n / 3, n / 2, n - 3, n - 2})
+        {
+            for (size_t j : {i + 1, i + 2, n - 1})
+            {
+                if (j <= i || j >= n)
+                    continue;
+                size_t const index = bio::ranges::pairwise_combine_index(n, i, j);
+                EXPECT_EQ(bio::ranges::pairwise_combine_pair(n, index), (std::pair{i, j}));
+            }
+        }
+        EXPECT_EQ(bio::ranges::pairwise_combine_pair(n, total - 1), (std::pair{n - 2, n - 1}));
+        EXPECT_EQ(bio::ranges::pairwise_combine_pair(n, total), (std::pair{n - 1, n}));
+    }
+}
+
+TEST(pairwise_combine_index, chunk)
+{
+    for (size_t n : {0, 1, 2, 5, 100})
+    {
+        for (size_t count : {1, 2, 3, 7, 1000})
+        {
+            size_t const total = n < 2 ? 0 : n * (n - 1) / 2;
+            size_t       next  = 0;
+            for (size_t c = 0; c < count; ++c)
+            {
+                auto [first, last] = bio::ranges::pairwise_combine_chunk(n, c, count);
+                EXPECT_EQ(first, next);
+                EXPECT_LE(last - first, total / count + 1);
+                next = last;
+            }
+            EXPECT_EQ(next, total);
+        }
+    }
+
+    // chunks of the view
+    std::vector<int> vec{1, 2, 3, 4, 5, 6};
+    auto             v = vec | bio::views::pairwise_combine;
+    auto [first, last] = bio::ranges::pairwise_combine_chunk(vec.size(), 1, 3);
+    EXPECT_EQ(*(v.begin() + first), (bio::meta::tuple{2, 3}));
+    EXPECT_EQ(last - first, 5u);
+}
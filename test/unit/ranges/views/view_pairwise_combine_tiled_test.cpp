@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <bio/ranges/views/pairwise_combine_tiled.hpp>
+#include <bio/ranges/views/slice.hpp>
+
+TEST(pairwise_combine_tiled, concepts)
+{
+    std::vector<int> vec{1, 2, 3};
+    auto             v = vec | bio::views::pairwise_combine_tiled(2);
+
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(v)>);
+    EXPECT_TRUE(std::ranges::sized_range<decltype(v)>);
+    EXPECT_TRUE(std::ranges::common_range<decltype(v)>);
+    EXPECT_TRUE(std::ranges::view<decltype(v)>);
+    EXPECT_TRUE(bio::ranges::const_iterable_range<decltype(v)>);
+    EXPECT_TRUE((std::ranges::output_range<decltype(v), bio::meta::tuple<int, int>>));
+    EXPECT_FALSE(std::ranges::contiguous_range<decltype(v)>);
+
+    EXPECT_THROW(vec | bio::views::pairwise_combine_tiled(0), std::invalid_argument);
+}
+
+TEST(pairwise_combine_tiled, order)
+{
+    std::vector<size_t> vec(5);
+    std::iota(vec.begin(), vec.end(), 0);
+
+    std::vector<bio::meta::tuple<size_t, size_t>> const expected{{0, 1},
+                                                                 {0, 2},
+                                                                 {0, 3},
+                                                                 {1, 2},
+                                                                 {1, 3},
+                                                                 {2, 3},
+                                                                 {0, 4},
+                                                                 {1, 4},
+                                                                 {2, 4},
+                                                                 {3, 4}};
+    std::vector<bio::meta::tuple<size_t, size_t>> res;
+    for (auto [a, b] : vec | bio::views::pairwise_combine_tiled(4))
+        res.emplace_back(a, b);
+    EXPECT_EQ(res, expected);
+
+    // tile size 1 and >= n is row order
+    for (size_t tile_size : {1, 5, 100})
+    {
+        res.clear();
+        for (auto [a, b] : vec | bio::views::pairwise_combine_tiled(tile_size))
+            res.emplace_back(a, b);
+        EXPECT_TRUE(std::ranges::equal(res, vec | bio::views::pairwise_combine));
+    }
+}
+
+TEST(pairwise_combine_tiled, all_pairs)
+{
+    for (size_t n = 0; n < 40; ++n)
+    {
+        std::vector<size_t> vec(n);
+        std::iota(vec.begin(), vec.end(), 0);
+
+        for (size_t tile_size = 1; tile_size < n + 2; ++tile_size)
+        {
+            auto v = vec | bio::views::pairwise_combine_tiled(tile_size);
+            ASSERT_EQ(v.size(), n < 2 ? 0 : n * (n - 1) / 2);
+
+            std::set<std::pair<size_t, size_t>> seen;
+            size_t                              index = 0;
+            for (auto it = v.begin(); it != v.end(); ++it, ++index)
+            {
+                auto [a, b] = *it;
+                ASSERT_LT(a, b);
+                ASSERT_TRUE(seen.emplace(a, b).second);
+                ASSERT_EQ(it.positions(), (std::pair{a, b}));
+
+                // random access agrees with iteration
+                ASSERT_EQ(v.begin() + index, it);
+                ASSERT_EQ(v[index], *it);
+                ASSERT_EQ(it - v.begin(), static_cast<ptrdiff_t>(index));
+            }
+            ASSERT_EQ(seen.size(), v.size());
+            ASSERT_EQ(index, v.size());
+        }
+    }
+}
+
+TEST(pairwise_combine_tiled, reverse)
+{
+    std::vector<int> vec{1, 2, 3, 4, 5, 6, 7};
+    auto             v = vec | bio::views::pairwise_combine_tiled(3);
+
+    std::vector<bio::meta::tuple<int, int>> fwd(v.begin(), v.end());
+    std::vector<bio::meta::tuple<int, int>> rev;
+    for (auto r : v | std::views::reverse)
+        rev.push_back(r);
+    std::ranges::reverse(rev);
+    EXPECT_EQ(fwd, rev);
+}
+
+TEST(pairwise_combine_tiled, chunks)
+{
+    std::vector<int> vec(23);
+    std::iota(vec.begin(), vec.end(), 0);
+    auto v = std::as_const(vec) | bio::views::pairwise_combine_tiled(4);
+
+    std::vector<bio::meta::tuple<int, int>> all(v.begin(), v.end());
+    std::vector<bio::meta::tuple<int, int>> joined;
+    for (size_t c = 0; c < 7; ++c)
+    {
+        auto [first, last] = bio::ranges::pairwise_combine_chunk(vec.size(), c, 7);
+        EXPECT_LE(last - first, all.size() / 7 + 1);
+        EXPECT_GE(last - first, all.size() / 7);
+        for (auto p : v | bio::views::slice(first, last))
+            joined.push_back(p);
+    }
+    EXPECT_EQ(joined, all);
+}
+
+TEST(pairwise_combine_tiled, output)
+{
+    std::vector<int> vec{1, 2, 3, 4};
+    auto             v = vec | bio::views::pairwise_combine_tiled(2);
+
+    *v.begin() = bio::meta::tuple{8, 9};
+    EXPECT_EQ(vec, (std::vector<int>{8, 9, 3, 4}));
+}
+
+TEST(pairwise_combine_tiled, large)
+{
+    for (auto [n, tile_size] : {std::pair<size_t, size_t>{100'000, 256}, {100'003, 1000}, {3'000'001, 4096}})
+    {
+        bio::ranges::detail::pairwise_tiling const tiling{n, tile_size};
+        size_t const                               total = tiling.size();
+
+        for (size_t index = 0; index < total; index += total / 9973 + 1)
+        {
+            auto [i, j] = tiling.pair(index);
+            ASSERT_LT(i, j);
+            ASSERT_LT(j, n);
+            ASSERT_EQ(tiling.index(i, j), index);
+        }
+
+        // first and last pair of every tile-row
+        for (size_t I = 0; I < tiling.tiles(); ++I)
+        {
+            size_t const b = tiling.row_begin(I);
+            EXPECT_EQ(tiling.pair(b), (std::pair{I * tile_size, I * tile_size + 1}));
+            if (b > 0)
+            {
+                EXPECT_EQ(tiling.pair(b - 1), (std::pair{I * tile_size - 1, n - 1}));
+            }
+        }
+        EXPECT_EQ(tiling.pair(total - 1), (std::pair{n - 2, n - 1}));
+    }
+}
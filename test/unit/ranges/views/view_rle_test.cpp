@@ -0,0 +1,150 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <forward_list>
+#include <random>
+#include <ranges>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <bio/test/expect_range_eq.hpp>
+
+#include <bio/alphabet/nucleotide/dna4.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/nucleotide/dna15.hpp>
+#include <bio/ranges/concept.hpp>
+#include <bio/ranges/to.hpp>
+#include <bio/ranges/views/rle.hpp>
+#include <bio/ranges/views/to_char.hpp>
+
+#include "../iterator_test_template.hpp"
+
+using namespace bio::alphabet::literals;
+
+using run_t = bio::meta::tuple<bio::alphabet::dna4, size_t>;
+
+using rle_view_t = decltype(std::declval<std::vector<bio::alphabet::dna4> &>() | bio::ranges::views::rle);
+
+template <>
+struct iterator_fixture<rle_view_t> : public ::testing::Test
+{
+    using iterator_tag = std::forward_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    std::vector<bio::alphabet::dna4> vec{"AAACGGGGT"_dna4};
+    std::vector<run_t> expected_range{{'A'_dna4, 3}, {'C'_dna4, 1}, {'G'_dna4, 4}, {'T'_dna4, 1}};
+
+    rle_view_t test_range = vec | bio::ranges::views::rle;
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(view_rle, iterator_fixture, rle_view_t, );
+
+using unrle_view_t = decltype(std::declval<std::vector<run_t> &>() | bio::ranges::views::unrle);
+
+template <>
+struct iterator_fixture<unrle_view_t> : public ::testing::Test
+{
+    using iterator_tag = std::forward_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    std::vector<run_t> vec{{'A'_dna4, 3}, {'C'_dna4, 0}, {'G'_dna4, 2}, {'T'_dna4, 1}};
+    std::vector<bio::alphabet::dna4> expected_range{"AAAGGT"_dna4};
+
+    unrle_view_t test_range = vec | bio::ranges::views::unrle;
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(view_unrle, iterator_fixture, unrle_view_t, );
+
+TEST(view_rle, basic)
+{
+    std::vector<bio::alphabet::dna5> const vec{"NNNNACCGTNN"_dna5};
+    std::vector<bio::meta::tuple<bio::alphabet::dna5, size_t>> const cmp{
+      {'N'_dna5, 4}, {'A'_dna5, 1}, {'C'_dna5, 2}, {'G'_dna5, 1}, {'T'_dna5, 1}, {'N'_dna5, 2}};
+
+    // pipe notation
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rle, cmp);
+
+    // function notation
+    EXPECT_RANGE_EQ(bio::ranges::views::rle(vec), cmp);
+
+    // round trip
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rle | bio::ranges::views::unrle, vec);
+
+    // empty
+    EXPECT_TRUE(std::ranges::empty(std::vector<bio::alphabet::dna5>{} | bio::ranges::views::rle));
+}
+
+TEST(view_rle, non_contiguous)
+{
+    std::forward_list<bio::alphabet::dna15> const list{'A'_dna15, 'A'_dna15, 'N'_dna15, 'A'_dna15};
+    std::vector<bio::meta::tuple<bio::alphabet::dna15, size_t>> const cmp{
+      {'A'_dna15, 2}, {'N'_dna15, 1}, {'A'_dna15, 1}};
+
+    EXPECT_RANGE_EQ(list | bio::ranges::views::rle, cmp);
+    EXPECT_RANGE_EQ(list | bio::ranges::views::rle | bio::ranges::views::unrle, list);
+}
+
+TEST(view_rle, long_runs)
+{
+    // runs of all lengths around the block sizes of the bytewise comparison
+    std::mt19937                          gen{42};
+    std::uniform_int_distribution<size_t> len_dist{0, 80};
+
+    std::vector<bio::alphabet::dna4> vec;
+    std::vector<run_t>               cmp;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        bio::alphabet::dna4 const l   = bio::alphabet::dna4{}.assign_rank(i % 4);
+        size_t const              len = len_dist(gen) + 1;
+        vec.insert(vec.end(), len, l);
+        cmp.emplace_back(l, len);
+    }
+
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rle, cmp);
+    EXPECT_RANGE_EQ(vec | bio::ranges::views::rle | bio::ranges::views::unrle, vec);
+
+    // the same through a non-contiguous view
+    EXPECT_RANGE_EQ(vec | std::views::filter([](auto) { return true; }) | bio::ranges::views::rle, cmp);
+}
+
+TEST(view_rle, char)
+{
+    std::string const str{"aaab   bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbc"};
+    std::vector<std::pair<char, size_t>> runs;
+    for (auto const [c, len] : str | bio::ranges::views::rle)
+        runs.emplace_back(c, len);
+
+    EXPECT_EQ(runs, (std::vector<std::pair<char, size_t>>{{'a', 3}, {'b', 1}, {' ', 3}, {'b', 55}, {'c', 1}}));
+    EXPECT_EQ(runs | bio::ranges::views::unrle | bio::ranges::to<std::string>(), str);
+}
+
+TEST(view_rle, deep)
+{
+    std::vector<std::vector<bio::alphabet::dna4>> const vec{"AAC"_dna4, "GGGG"_dna4};
+
+    auto v = vec | bio::ranges::views::rle;
+    ASSERT_EQ(std::ranges::size(v), 2u);
+    EXPECT_RANGE_EQ(v[0], (std::vector<run_t>{{'A'_dna4, 2}, {'C'_dna4, 1}}));
+    EXPECT_RANGE_EQ(v[1], (std::vector<run_t>{{'G'_dna4, 4}}));
+}
+
+TEST(view_rle, concepts)
+{
+    EXPECT_TRUE(std::ranges::forward_range<rle_view_t>);
+    EXPECT_FALSE(std::ranges::bidirectional_range<rle_view_t>);
+    EXPECT_TRUE(std::ranges::view<rle_view_t>);
+    EXPECT_FALSE(std::ranges::sized_range<rle_view_t>);
+    EXPECT_TRUE(bio::ranges::const_iterable_range<rle_view_t>);
+
+    EXPECT_TRUE(std::ranges::forward_range<unrle_view_t>);
+    EXPECT_TRUE(std::ranges::view<unrle_view_t>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<unrle_view_t>, bio::alphabet::dna4>));
+}
@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2022 deCODE Genetics
+// Copyright (c) 2006-2020, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2020, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/biocpp/biocpp-core/blob/main/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <bio/alphabet/mask/masked.hpp>
+#include <bio/alphabet/nucleotide/dna5.hpp>
+#include <bio/alphabet/quality/phred42.hpp>
+#include <bio/alphabet/quality/qualified.hpp>
+#include <bio/ranges/container/bitcompressed_vector.hpp>
+#include <bio/ranges/zip_components.hpp>
+#include <bio/test/expect_range_eq.hpp>
+
+using namespace bio::alphabet::literals;
+
+using qualified_t = bio::alphabet::qualified<bio::alphabet::dna5, bio::alphabet::phred42>;
+
+// all combinations of ranks
+struct zip_components_test : public ::testing::Test
+{
+    std::vector<bio::alphabet::dna5>    seq;
+    std::vector<bio::alphabet::phred42> qual;
+    std::vector<qualified_t>            expected;
+
+    zip_components_test()
+    {
+        for (size_t i = 0; i < bio::alphabet::size<bio::alphabet::dna5>; ++i)
+        {
+            for (size_t j = 0; j < bio::alphabet::size<bio::alphabet::phred42>; ++j)
+            {
+                seq.push_back(bio::alphabet::assign_rank_to(i, bio::alphabet::dna5{}));
+                qual.push_back(bio::alphabet::assign_rank_to(j, bio::alphabet::phred42{}));
+                expected.push_back(qualified_t{seq.back(), qual.back()});
+            }
+        }
+    }
+};
+
+TEST_F(zip_components_test, contiguous)
+{
+    std::vector<qualified_t> out(seq.size());
+    bio::ranges::zip_components(out, seq, qual);
+    EXPECT_RANGE_EQ(out, expected);
+
+    std::vector<bio::alphabet::dna5>    seq_out(seq.size());
+    std::vector<bio::alphabet::phred42> qual_out(seq.size());
+    bio::ranges::unzip_components(out, seq_out, qual_out);
+    EXPECT_RANGE_EQ(seq_out, seq);
+    EXPECT_RANGE_EQ(qual_out, qual);
+}
+
+TEST_F(zip_components_test, not_contiguous)
+{
+    bio::ranges::bitcompressed_vector<qualified_t>         out(seq.size(), qualified_t{});
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna5> seq2{seq};
+    bio::ranges::zip_components(out, seq2, qual);
+    EXPECT_RANGE_EQ(out, expected);
+
+    bio::ranges::bitcompressed_vector<bio::alphabet::dna5> seq_out(seq.size(), bio::alphabet::dna5{});
+    std::vector<bio::alphabet::phred42>                    qual_out(seq.size());
+    bio::ranges::unzip_components(out, seq_out, qual_out);
+    EXPECT_RANGE_EQ(seq_out, seq);
+    EXPECT_RANGE_EQ(qual_out, qual);
+}
+
+TEST_F(zip_components_test, sizes)
+{
+    std::vector<qualified_t> out(seq.size() - 1);
+    EXPECT_THROW(bio::ranges::zip_components(out, seq, qual), std::invalid_argument);
+    EXPECT_THROW(bio::ranges::zip_components(expected, seq, qual | std::views::take(3)), std::invalid_argument);
+
+    std::vector<bio::alphabet::dna5> seq_out(seq.size() - 1);
+    EXPECT_THROW(bio::ranges::unzip_components(expected, seq_out, qual), std::invalid_argument);
+}
+
+TEST(zip_components, nested_composite)
+{
+    using masked_t = bio::alphabet::masked<qualified_t>;
+    EXPECT_FALSE((bio::ranges::detail::components_of<masked_t,
+                                                      std::vector<bio::alphabet::dna5>,
+                                                      std::vector<bio::alphabet::phred42>>));
+
+    std::vector<qualified_t>         q{qualified_t{'A'_dna5, 'I'_phred42}, qualified_t{'N'_dna5, '!'_phred42}};
+    std::vector<bio::alphabet::mask> m{bio::alphabet::mask::MASKED, bio::alphabet::mask::UNMASKED};
+    std::vector<masked_t>            out(2);
+    bio::ranges::zip_components(out, q, m);
+    EXPECT_EQ(out[0], (masked_t{q[0], m[0]}));
+    EXPECT_EQ(out[1], (masked_t{q[1], m[1]}));
+}